@@ -0,0 +1,247 @@
+#pragma once
+
+#include "VoxelGrid.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Autosave incremental em um journal ao lado do projeto (.vxm)
+ *
+ * O journal guarda apenas o que mudou desde a última gravação do projeto. A thread
+ * principal só copia as células dos chunks com revisão nova (snapshot); uma thread
+ * dedicada descarta os que não mudaram de fato (CRC-32 das células), comprime o resto com
+ * ChunkCodec e anexa registros ao arquivo, encerrados por um registro de commit. A thread
+ * principal nunca espera pelo disco: se a gravação anterior ainda não terminou, o snapshot
+ * fica para a próxima vez.
+ *
+ * Registros: cabeçalho, tipo, tamanho e CRC-32 do conteúdo (dimensões, entradas novas da
+ * paleta, chunk, chunk removido, commit). Um chunk regravado torna o registro anterior obsoleto;
+ * quando o arquivo passa de COMPACT_RATIO vezes o conteúdo vivo, a thread reescreve só os
+ * registros mais recentes em um temporário que substitui o journal.
+ *
+ * Na abertura, o journal existente é reaplicado sobre o projeto carregado até o último
+ * commit íntegro (uma cauda cortada por queda é descartada). Gravar o projeto zera o
+ * journal. A paleta só cresce entre gravações, então o journal registra apenas as entradas
+ * novas e os índices de todos os chunks valem para a paleta acumulada; uma paleta
+ * substituída recomeça o journal.
+ */
+class AutosaveJournal {
+public:
+    static constexpr uint32_t JOURNAL_MAGIC = 0x4C4A5856;      ///< "VXJL"
+    static constexpr uint32_t JOURNAL_VERSION = 1;
+    static constexpr double DEFAULT_INTERVAL = 30.0;            ///< Segundos entre snapshots
+    static constexpr size_t MAX_SNAPSHOT_CHUNKS = 1024;         ///< Limita a cópia por snapshot (64 MB)
+    static constexpr uint64_t COMPACT_RATIO = 2;
+    static constexpr uint64_t MIN_COMPACT_BYTES = 4 * 1024 * 1024;
+
+    /**
+     * @brief Contadores do journal
+     */
+    struct Stats {
+        uint64_t snapshots;
+        uint64_t skippedSnapshots;  ///< Adiados porque a gravação anterior não terminou
+        uint64_t chunksCopied;      ///< Chunks copiados pela thread principal
+        uint64_t chunksWritten;     ///< Chunks gravados (os demais não mudaram)
+        uint64_t chunksRemoved;
+        uint64_t bytesWritten;
+        uint64_t compactions;
+        uint64_t journalBytes;      ///< Tamanho atual do arquivo
+        uint64_t liveBytes;         ///< Registros ainda válidos
+        size_t recoveredChunks;     ///< Chunks restaurados na abertura
+        double lastSnapshotMs;      ///< Tempo do último snapshot (thread principal)
+        double lastWriteMs;         ///< Tempo da última gravação (thread do journal)
+
+        Stats()
+            : snapshots(0)
+            , skippedSnapshots(0)
+            , chunksCopied(0)
+            , chunksWritten(0)
+            , chunksRemoved(0)
+            , bytesWritten(0)
+            , compactions(0)
+            , journalBytes(0)
+            , liveBytes(0)
+            , recoveredChunks(0)
+            , lastSnapshotMs(0.0)
+            , lastWriteMs(0.0) {}
+    };
+
+private:
+    /**
+     * @brief Trabalho entregue à thread do journal
+     */
+    struct Snapshot {
+        bool reset;                             ///< Recomeçar o journal antes de gravar
+        bool hasGridInfo;
+        int32_t gridInfo[6];                    ///< Dimensões e origem
+        uint32_t paletteFirst;                  ///< Índice da primeira entrada nova
+        uint32_t paletteCount;                  ///< Entradas novas (0 = paleta inalterada)
+        std::vector<uint8_t> palette;           ///< VoxelFile::encodePalette das entradas novas
+        std::vector<glm::ivec3> coords;
+        std::vector<VoxelChunk::Cell> cells;    ///< VOLUME células por coordenada
+        std::vector<glm::ivec3> removed;
+
+        Snapshot()
+            : reset(false)
+            , hasGridInfo(false)
+            , gridInfo()
+            , paletteFirst(1)
+            , paletteCount(0)
+            , palette()
+            , coords()
+            , cells()
+            , removed() {}
+    };
+
+    /**
+     * @brief Último registro gravado de uma coordenada (ou da paleta/dimensões)
+     */
+    struct RecordRef {
+        uint64_t offset;
+        uint32_t size;          ///< Cabeçalho incluso
+        uint32_t cellsCrc;      ///< CRC-32 das células (chunks)
+    };
+
+    using RecordIndex = std::unordered_map<glm::ivec3, RecordRef, Vec3Hash>;
+
+    std::string path;
+
+    // Estado da thread principal
+    std::unordered_map<glm::ivec3, uint64_t, Vec3Hash> savedRevisions;  ///< Chunks conhecidos -> revisão gravada
+    uint64_t lastSnapshotRevision;
+    size_t journaledPaletteSize;    ///< Entradas já no journal (1 = só a vazia)
+    int32_t journaledGridInfo[6];
+    bool gridInfoJournaled;
+    bool resetPending;
+    double elapsedSinceSnapshot;
+    double interval;
+
+    // Estado da thread do journal (e de open() antes de ela existir)
+    std::FILE* file;
+    uint64_t fileBytes;
+    RecordIndex chunkRecords;
+    RecordIndex removedRecords;
+    std::vector<RecordRef> paletteRecords;  ///< Partes da paleta, em ordem
+    RecordRef gridRecord;
+
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Snapshot> queue;
+    bool busy;
+    bool stopping;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    AutosaveJournal();
+
+    /**
+     * @brief Destrutor (grava o que estiver pendente e para a thread)
+     */
+    ~AutosaveJournal();
+
+    AutosaveJournal(const AutosaveJournal&) = delete;
+    AutosaveJournal& operator=(const AutosaveJournal&) = delete;
+
+    // Getters
+    const std::string& getPath() const { return path; }
+    bool isOpen() const { return thread.joinable(); }
+    double getInterval() const { return interval; }
+    Stats getStats() const;
+
+    // Setters
+    void setInterval(double seconds) { interval = seconds; }
+
+    /**
+     * @brief Caminho do journal de um projeto
+     */
+    static std::string journalPathFor(const std::string& projectPath) { return projectPath + ".journal"; }
+
+    /**
+     * @brief Abre o journal, reaplicando sobre o grid o que um journal existente registrou,
+     *        e inicia a thread de gravação
+     * @param journalPath Caminho do journal
+     * @param grid Grid com o projeto já carregado (recebe as alterações recuperadas)
+     * @return true se aberto
+     */
+    bool open(const std::string& journalPath, VoxelGrid& grid);
+
+    /**
+     * @brief Grava o que estiver pendente e para a thread (o journal continua no disco)
+     * @param grid Se dado, espera a gravação em andamento e tira um último snapshot
+     */
+    void close(const VoxelGrid* grid = nullptr);
+
+    /**
+     * @brief Avança o relógio e tira um snapshot a cada intervalo se o grid mudou
+     * @param grid Grid de voxels
+     * @param deltaTime Tempo decorrido em segundos
+     */
+    void update(const VoxelGrid& grid, double deltaTime);
+
+    /**
+     * @brief Copia os chunks alterados e os entrega à thread do journal (não bloqueia)
+     * @param grid Grid de voxels
+     * @return false se adiado porque a gravação anterior ainda não terminou
+     */
+    bool snapshot(const VoxelGrid& grid);
+
+    /**
+     * @brief Marca o estado atual como gravado no projeto; o journal recomeça vazio
+     * @param grid Grid recém-gravado
+     */
+    void markSaved(const VoxelGrid& grid);
+
+private:
+    /**
+     * @brief Lê o journal existente e aplica os commits íntegros ao grid
+     * @param grid Grid de destino
+     * @param recovered Coordenadas dos chunks restaurados ou removidos
+     * @return Tamanho da parte íntegra do arquivo (0 se inexistente ou inválido)
+     */
+    uint64_t recover(VoxelGrid& grid, std::vector<glm::ivec3>& recovered);
+
+    /**
+     * @brief Laço da thread do journal
+     */
+    void workerLoop();
+
+    /**
+     * @brief Grava um snapshot (thread do journal)
+     */
+    void writeSnapshot(Snapshot& snapshot);
+
+    /**
+     * @brief Substitui o journal por um arquivo novo com os registros dados
+     */
+    bool rewrite(const std::vector<uint8_t>& records);
+
+    /**
+     * @brief Anexa registros ao arquivo e os força para o disco
+     */
+    bool append(const std::vector<uint8_t>& records);
+
+    /**
+     * @brief Reescreve só os registros vivos se o arquivo cresceu demais
+     */
+    void compactIfNeeded();
+
+    /**
+     * @brief Soma o tamanho dos registros vivos
+     */
+    uint64_t getLiveBytes() const;
+};
+
+} // namespace VoxelMaker
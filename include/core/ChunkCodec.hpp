@@ -0,0 +1,147 @@
+#pragma once
+
+#include "VoxelChunk.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelMaker {
+
+class VoxelGrid;
+
+/**
+ * @brief Codecs das células de um chunk, para arquivos e para chunks frios em memória
+ *
+ * Chunks de voxels têm poucas cores distintas e longas sequências iguais. Os codecs
+ * exploram isso de formas diferentes:
+ * - PALETTE: paleta local do chunk e índices empacotados com 0, 1, 2, 4, 8 ou 16 bits;
+ * - MORTON_RLE: paleta local e sequências na ordem de Morton (Z-order), que agrupa
+ *   vizinhos nos três eixos, com comprimentos em varint;
+ * - PALETTE_LZ: o fluxo de PALETTE comprimido por um LZ genérico (estilo LZ4).
+ * RAW e RLE (sequências lineares de 16 bits) continuam decodificáveis por compatibilidade.
+ *
+ * encodeBest() estima os tamanhos de PALETTE e MORTON_RLE em uma passada e só tenta o LZ
+ * quando os dois ainda ficam grandes. Toda decodificação valida os limites da entrada.
+ */
+class ChunkCodec {
+public:
+    /**
+     * @brief Codec de um bloco (o valor é gravado em arquivos; não reordenar)
+     */
+    enum class Codec : uint8_t {
+        RAW = 0,            ///< Células de 16 bits sem compressão
+        RLE = 1,            ///< Pares (repetições, célula) de 16 bits em ordem linear
+        PALETTE = 2,        ///< Paleta local + índices empacotados
+        MORTON_RLE = 3,     ///< Paleta local + sequências em ordem de Morton
+        PALETTE_LZ = 4      ///< PALETTE comprimido com lzCompress
+    };
+
+    static constexpr int CODEC_COUNT = 5;
+    static constexpr size_t RAW_BYTES = VoxelChunk::VOLUME * sizeof(VoxelChunk::Cell);
+    static constexpr size_t LZ_THRESHOLD = 1024;    ///< encodeBest só tenta o LZ acima disso
+
+    /**
+     * @brief Células comprimidas de um chunk frio (fonte de um chunk em memória)
+     */
+    class MemorySource : public VoxelChunk::Source {
+    private:
+        Codec codec;
+        std::vector<uint8_t> data;
+
+    public:
+        MemorySource(Codec blockCodec, std::vector<uint8_t> block)
+            : codec(blockCodec)
+            , data(std::move(block)) {}
+
+        bool decodeChunk(size_t entry, VoxelChunk::Cell* cells) const override;
+        size_t getMemoryUsage() const override { return data.capacity(); }
+    };
+
+    /**
+     * @brief Resultado de um codec no benchmark
+     */
+    struct BenchmarkResult {
+        std::string name;
+        size_t chunks;
+        uint64_t rawBytes;
+        uint64_t encodedBytes;
+        double encodeMs;
+        double decodeMs;
+        bool verified;              ///< Todas as células decodificadas conferem
+
+        BenchmarkResult()
+            : name()
+            , chunks(0)
+            , rawBytes(0)
+            , encodedBytes(0)
+            , encodeMs(0.0)
+            , decodeMs(0.0)
+            , verified(true) {}
+
+        double getRatio() const { return encodedBytes > 0 ? static_cast<double>(rawBytes) / encodedBytes : 0.0; }
+        double getEncodeGBps() const { return encodeMs > 0.0 ? rawBytes / (encodeMs * 1.0e6) : 0.0; }
+        double getDecodeGBps() const { return decodeMs > 0.0 ? rawBytes / (decodeMs * 1.0e6) : 0.0; }
+    };
+
+    /**
+     * @brief Codifica as células com um codec específico
+     * @param codec Codec
+     * @param cells VOLUME células
+     * @param out Bloco codificado (substituído)
+     */
+    static void encode(Codec codec, const VoxelChunk::Cell* cells, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Codifica com o codec que gera o menor bloco (PALETTE_LZ só é tentado quando o
+     *        melhor entre PALETTE e MORTON_RLE fica entre LZ_THRESHOLD e RAW_BYTES)
+     * @param cells VOLUME células
+     * @param out Bloco codificado (substituído)
+     * @return Codec escolhido
+     */
+    static Codec encodeBest(const VoxelChunk::Cell* cells, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Decodifica um bloco
+     * @param codec Codec do bloco
+     * @param data Bloco
+     * @param size Tamanho do bloco
+     * @param cells Destino com VOLUME células
+     * @return true se o bloco é válido e cobre exatamente VOLUME células
+     */
+    static bool decode(Codec codec, const uint8_t* data, size_t size, VoxelChunk::Cell* cells);
+
+    /**
+     * @brief Compressor LZ genérico (literais e cópias com janela de 64 KB)
+     * @param data Entrada
+     * @param size Tamanho da entrada
+     * @param out Saída (os bytes são anexados)
+     */
+    static void lzCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Descomprime um bloco de lzCompress
+     * @param data Bloco comprimido
+     * @param size Tamanho do bloco
+     * @param out Destino
+     * @param outSize Tamanho exato esperado da saída
+     * @return true se o bloco é válido, termina em uma sequência de literais e produz
+     *         exatamente outSize bytes
+     */
+    static bool lzDecompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize);
+
+    /**
+     * @brief Nome de um codec
+     */
+    static const char* getName(Codec codec);
+
+    /**
+     * @brief Mede taxa de compressão e vazão de cada codec (e de encodeBest) nos chunks do grid
+     *
+     * Roda em uma thread, de modo que GB/s é por núcleo.
+     * @param grid Grid de voxels
+     * @return Um resultado por codec, seguido de "auto" (encodeBest)
+     */
+    static std::vector<BenchmarkResult> benchmark(const VoxelGrid& grid);
+};
+
+} // namespace VoxelMaker
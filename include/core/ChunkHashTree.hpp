@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Árvore de Merkle sobre a tabela de chunks de um grid
+ *
+ * As folhas são os hashes de conteúdo dos chunks (VoxelChunk::getContentHash). Cada nível
+ * agrupa blocos de 4³ nós do nível abaixo pela coordenada (coord >> 2 por nível), até
+ * LEVELS níveis; a raiz resume os nós do último nível. O hash de um nó é a soma (módulo
+ * 2⁶⁴) de um termo misturado por filho, de coordenada e hash, então trocar uma folha só
+ * ajusta os LEVELS nós acima dela, sem reler os irmãos.
+ *
+ * Duas árvores com a mesma raiz têm os mesmos chunks. diff() desce só pelos nós com hash
+ * diferente e visita O(chunks alterados) nós, usando a máscara de filhos de cada nó para
+ * não procurar filhos inexistentes.
+ */
+class ChunkHashTree {
+public:
+    static constexpr int LEVELS = 6;            ///< Níveis acima das folhas (4⁶ chunks por eixo no topo)
+    static constexpr int BRANCH_SHIFT = 2;      ///< 4 filhos por eixo, 64 por nó
+
+    /**
+     * @brief Nó interno
+     */
+    struct Node {
+        uint64_t hash;
+        uint64_t children;      ///< Bit (x + 4y + 16z) por filho presente
+
+        Node() : hash(0), children(0) {}
+    };
+
+    /**
+     * @brief Resultado de diff()
+     */
+    struct Difference {
+        std::vector<glm::ivec3> changed;    ///< Chunks novos ou com conteúdo diferente
+        std::vector<glm::ivec3> removed;    ///< Chunks que só existem na base
+        size_t visitedNodes;                ///< Nós comparados (mede o custo da descida)
+
+        Difference() : changed(), removed(), visitedNodes(0) {}
+    };
+
+    /**
+     * @brief Hash de coordenadas misturado (os níveis altos têm coordenadas pequenas e próximas)
+     */
+    struct CoordHash {
+        size_t operator()(const glm::ivec3& v) const {
+            uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(v.x)) * 0x9E3779B97F4A7C15ull ^
+                           static_cast<uint64_t>(static_cast<uint32_t>(v.y)) * 0xC2B2AE3D27D4EB4Full ^
+                           static_cast<uint64_t>(static_cast<uint32_t>(v.z)) * 0x165667B19E3779F9ull;
+            return static_cast<size_t>(key ^ (key >> 29));
+        }
+    };
+
+    using LeafMap = std::unordered_map<glm::ivec3, uint64_t, CoordHash>;
+    using NodeMap = std::unordered_map<glm::ivec3, Node, CoordHash>;
+
+private:
+    LeafMap leaves;
+    NodeMap levels[LEVELS];     ///< levels[0] agrupa as folhas; levels[LEVELS - 1] fica abaixo da raiz
+    uint64_t root;
+
+public:
+    /**
+     * @brief Construtor (árvore vazia)
+     */
+    ChunkHashTree();
+
+    /**
+     * @brief Destrutor
+     */
+    ~ChunkHashTree() = default;
+
+    // Getters
+    uint64_t getRoot() const { return root; }
+    size_t getLeafCount() const { return leaves.size(); }
+    const LeafMap& getLeaves() const { return leaves; }
+
+    /**
+     * @brief Hash de conteúdo de um chunk
+     * @param coord Coordenada do chunk
+     * @param hash Hash encontrado
+     * @return false se o chunk não está na árvore
+     */
+    bool findLeaf(const glm::ivec3& coord, uint64_t& hash) const;
+
+    /**
+     * @brief Define o hash de um chunk (adicionando-o se preciso)
+     * @param coord Coordenada do chunk
+     * @param hash Hash de conteúdo
+     */
+    void set(const glm::ivec3& coord, uint64_t hash);
+
+    /**
+     * @brief Remove um chunk
+     * @param coord Coordenada do chunk
+     */
+    void remove(const glm::ivec3& coord);
+
+    /**
+     * @brief Remove todos os chunks
+     */
+    void clear();
+
+    /**
+     * @brief Compara duas árvores descendo só pelos nós diferentes
+     * @param base Árvore de partida
+     * @param target Árvore de chegada
+     * @return Chunks a reescrever e a remover para levar base a target
+     */
+    static Difference diff(const ChunkHashTree& base, const ChunkHashTree& target);
+
+private:
+    /**
+     * @brief Ajusta os nós acima de um filho que trocou de termo
+     * @param coord Coordenada do filho no nível de baixo
+     * @param oldHash Hash anterior do filho (ignorado se não existia)
+     * @param newHash Hash novo do filho (ignorado se foi removido)
+     * @param existed O filho existia antes
+     * @param exists O filho existe depois
+     */
+    void propagate(glm::ivec3 coord, uint64_t oldHash, uint64_t newHash, bool existed, bool exists);
+
+    /**
+     * @brief Desce por um nó presente em uma das árvores (ou nas duas, com hashes diferentes)
+     */
+    static void diffNode(const ChunkHashTree& base, const ChunkHashTree& target, int level,
+                         const glm::ivec3& coord, Difference& difference);
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "VoxelGrid.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Diferença compacta entre duas versões de um grid, aplicável a outra cópia da base
+ *
+ * compute() compara as árvores de hashes dos dois grids (ChunkHashTree::diff) e visita só
+ * os ramos que mudaram: o custo é proporcional aos chunks alterados, não ao tamanho da
+ * cena. Os hashes usam os índices da paleta, então só valem entre paletas que concordam nos
+ * índices em comum (versões de um mesmo projeto); caso contrário o delta leva todos os
+ * chunks do destino (FLAG_FULL).
+ *
+ * Formato (.vxd, ordem de bytes da máquina): DeltaHeader, entradas da paleta do destino
+ * que a base não tem (VoxelFile::encodePalette; a paleta inteira em um delta FLAG_FULL),
+ * coordenadas dos chunks removidos, chunks alterados com os índices do destino (coordenada,
+ * codec e bloco do ChunkCodec) e CRC-32 de tudo. apply() só aceita um grid com o hash de
+ * conteúdo e a paleta da base; as entradas enviadas continuam a paleta dele nos mesmos
+ * índices, então o grid resultante tem o hash do destino e aceita o delta seguinte.
+ */
+class GridDelta {
+public:
+    static constexpr uint32_t DELTA_MAGIC = 0x4C445856;     ///< "VXDL"
+    static constexpr uint32_t DELTA_VERSION = 2;            ///< 1: paleta compactada e células remapeadas
+    static constexpr uint32_t FLAG_FULL = 1;                ///< Paletas incompatíveis: todos os chunks do destino
+
+    /**
+     * @brief Contadores da última operação
+     */
+    struct Stats {
+        size_t changedChunks;
+        size_t removedChunks;
+        size_t visitedNodes;        ///< Nós comparados na descida pelas árvores
+        size_t paletteEntries;      ///< Entradas da paleta do destino enviadas
+        size_t encodedBytes;
+        bool full;                  ///< Delta com todos os chunks (paletas incompatíveis)
+        double diffMs;              ///< Comparação das árvores (inclui atualizar os hashes)
+        double encodeMs;
+        double applyMs;             ///< Inclui atualizar os hashes do grid recebido
+
+        Stats()
+            : changedChunks(0)
+            , removedChunks(0)
+            , visitedNodes(0)
+            , paletteEntries(0)
+            , encodedBytes(0)
+            , full(false)
+            , diffMs(0.0)
+            , encodeMs(0.0)
+            , applyMs(0.0) {}
+    };
+
+private:
+    std::vector<uint8_t> data;      ///< Delta codificado
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor (delta vazio)
+     */
+    GridDelta() = default;
+
+    /**
+     * @brief Destrutor
+     */
+    ~GridDelta() = default;
+
+    // Getters
+    const std::vector<uint8_t>& getData() const { return data; }
+    const Stats& getStats() const { return stats; }
+
+    /**
+     * @brief Calcula o delta que leva base a target
+     * @param base Grid de partida
+     * @param target Grid de chegada
+     * @return true se calculado
+     */
+    bool compute(const VoxelGrid& base, const VoxelGrid& target);
+
+    /**
+     * @brief Aplica o delta a um grid no estado da base
+     * @param grid Grid de destino (recebe os chunks, as cores, as dimensões e a origem)
+     * @return false se o delta é inválido ou o grid não é a base do delta (conteúdo ou
+     *         paleta diferentes; grid intacto)
+     */
+    bool apply(VoxelGrid& grid);
+
+    /**
+     * @brief Grava o delta codificado
+     * @param path Caminho do arquivo (.vxd)
+     * @return true se gravado
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Lê e valida um delta gravado
+     * @param path Caminho do arquivo (.vxd)
+     * @return true se lido
+     */
+    bool load(const std::string& path);
+
+private:
+    /**
+     * @brief Valida cabeçalho, tamanhos e CRC-32 do delta codificado
+     */
+    bool validate() const;
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "VoxelGrid.hpp"
+#include "VoxelObject.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Importação e exportação de arquivos MagicaVoxel (.vox)
+ *
+ * A leitura percorre o arquivo chunk a chunk (SIZE/XYZI de cada modelo, RGBA e o grafo de
+ * cena nTRN/nGRP/nSHP), sem carregá-lo inteiro. Como o grafo de cena vem depois dos
+ * modelos, os voxels de cada modelo ficam guardados no formato compacto do arquivo (4
+ * bytes) até o fim da leitura; então cada instância visível é transformada e escrita
+ * direto nos chunks, que entram no grid de uma vez (sem addVoxel por voxel). Cada
+ * instância vira um VoxelObject. Instâncias ocultas são ignoradas. Grafos com ciclos ou
+ * que se expandem em instâncias demais são recusados; sem o nó raiz, cada modelo é
+ * importado na origem (como em arquivos sem grafo de cena).
+ *
+ * O MagicaVoxel usa Z para cima; no grid Y é para cima: (x, y, z) do arquivo vira
+ * (x, z, -y), deslocado para que o menor voxel fique na origem do grid.
+ *
+ * A gravação faz uma única passada pelos chunks: o grid é dividido em modelos de até
+ * 256³ (o limite do formato), cada um com um nó de transformação no grafo de cena, e os
+ * tamanhos dos chunks do arquivo são corrigidos no lugar ao fim de cada modelo. Paletas com
+ * mais de 255 cores são reduzidas por corte mediano.
+ */
+class MagicaVoxelFile {
+public:
+    static constexpr int FILE_VERSION = 150;
+    static constexpr int MAX_MODEL_SIZE = 256;
+    static constexpr int PALETTE_SIZE = 256;
+    static constexpr size_t READ_BATCH = 65536;     ///< Voxels lidos por vez de um XYZI
+
+    /**
+     * @brief Contadores da última operação
+     */
+    struct Stats {
+        size_t models;
+        size_t instances;
+        size_t hiddenInstances;
+        uint64_t voxels;
+        uint64_t bytes;
+        double elapsedMs;
+        double voxelsPerSecond;
+        double megabytesPerSecond;
+
+        Stats()
+            : models(0)
+            , instances(0)
+            , hiddenInstances(0)
+            , voxels(0)
+            , bytes(0)
+            , elapsedMs(0.0)
+            , voxelsPerSecond(0.0)
+            , megabytesPerSecond(0.0) {}
+    };
+
+private:
+    Stats stats;
+    std::vector<VoxelObject> objects;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    MagicaVoxelFile() = default;
+
+    /**
+     * @brief Destrutor
+     */
+    ~MagicaVoxelFile() = default;
+
+    // Getters
+    const Stats& getStats() const { return stats; }
+    const std::vector<VoxelObject>& getObjects() const { return objects; }
+
+    /**
+     * @brief Importa um arquivo, substituindo o conteúdo do grid
+     * @param path Caminho do arquivo .vox
+     * @param grid Grid de destino (dimensões, origem, paleta e chunks são substituídos)
+     * @return true se importado
+     */
+    bool load(const std::string& path, VoxelGrid& grid);
+
+    /**
+     * @brief Exporta os voxels ativos do grid
+     * @param grid Grid de voxels
+     * @param path Caminho do arquivo .vox
+     * @return true se exportado
+     */
+    bool save(const VoxelGrid& grid, const std::string& path);
+
+private:
+    /**
+     * @brief Calcula as métricas de vazão a partir dos contadores
+     */
+    void finishStats(double elapsedMs);
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Voxel.hpp"
+#include "VoxelGrid.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Converte malhas de triângulos (OBJ ou STL) em voxels
+ *
+ * A malha é escalada para que o maior eixo tenha a resolução pedida (ou pelo tamanho de
+ * voxel dado) e os triângulos são distribuídos nos chunks que sua caixa envolvente toca.
+ * Cada chunk é voxelizado em paralelo com o teste conservador triângulo/caixa (plano do
+ * triângulo e as três projeções das arestas, 26-separável): todo voxel tocado pela
+ * superfície é marcado, sem buracos em triângulos finos ou inclinados.
+ *
+ * Com preenchimento sólido, cada coluna vertical de chunks é processada em paralelo: um
+ * raio pelo centro de cada coluna de voxels cruza os triângulos e os trechos entre
+ * cruzamentos pares e ímpares (paridade) são preenchidos com a cor do triângulo de entrada.
+ * A regra topo-esquerda nas arestas garante que um raio sobre uma aresta compartilhada seja
+ * contado uma só vez; a malha deve ser fechada.
+ *
+ * As células são escritas direto nos chunks, que entram no grid de uma vez. Cores por
+ * vértice do OBJ (v x y z r g b) são quantizadas em 5 bits por canal; sem elas, todos os
+ * voxels usam a cor das configurações. STL é lido como Z para cima (como o MagicaVoxel).
+ */
+class MeshVoxelizer {
+public:
+    static constexpr int DEFAULT_RESOLUTION = 256;
+    static constexpr int MAX_RESOLUTION = 2048;
+
+    /**
+     * @brief Malha indexada em memória
+     */
+    struct TriangleMesh {
+        std::vector<glm::vec3> positions;
+        std::vector<Voxel::Color> colors;   ///< Uma por vértice ou vazio
+        std::vector<uint32_t> indices;      ///< Três por triângulo
+    };
+
+    /**
+     * @brief Configurações da voxelização
+     */
+    struct Settings {
+        int resolution;             ///< Voxels no maior eixo (se voxelSize for 0)
+        float voxelSize;            ///< Tamanho do voxel em unidades da malha (0 = pela resolução)
+        bool solid;                 ///< Preenche o interior por paridade
+        Voxel::Color color;         ///< Cor dos voxels sem cor por vértice
+
+        Settings()
+            : resolution(DEFAULT_RESOLUTION)
+            , voxelSize(0.0f)
+            , solid(false)
+            , color(200, 200, 200) {}
+    };
+
+    /**
+     * @brief Contadores da última operação
+     */
+    struct Stats {
+        size_t vertices;
+        size_t triangles;
+        size_t chunks;
+        uint64_t surfaceVoxels;
+        uint64_t filledVoxels;      ///< Interior preenchido (modo sólido)
+        double parseMs;
+        double binMs;
+        double surfaceMs;
+        double fillMs;
+        double voxelizeMs;          ///< Distribuição + superfície + preenchimento
+        double trianglesPerSecond;  ///< Pela voxelização, sem a leitura do arquivo
+        double voxelsPerSecond;
+
+        Stats()
+            : vertices(0)
+            , triangles(0)
+            , chunks(0)
+            , surfaceVoxels(0)
+            , filledVoxels(0)
+            , parseMs(0.0)
+            , binMs(0.0)
+            , surfaceMs(0.0)
+            , fillMs(0.0)
+            , voxelizeMs(0.0)
+            , trianglesPerSecond(0.0)
+            , voxelsPerSecond(0.0) {}
+    };
+
+private:
+    Settings settings;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    MeshVoxelizer() = default;
+
+    /**
+     * @brief Destrutor
+     */
+    ~MeshVoxelizer() = default;
+
+    // Getters
+    const Settings& getSettings() const { return settings; }
+    const Stats& getStats() const { return stats; }
+
+    // Setters
+    void setSettings(const Settings& newSettings) { settings = newSettings; }
+
+    /**
+     * @brief Verifica se o caminho é de uma malha suportada (.obj ou .stl)
+     */
+    static bool isMeshPath(const std::string& path);
+
+    /**
+     * @brief Lê uma malha OBJ ou STL (binário ou texto) e a voxeliza
+     * @param path Caminho do arquivo
+     * @param grid Grid de destino (dimensões, origem, paleta e chunks são substituídos)
+     * @return true se importada
+     */
+    bool load(const std::string& path, VoxelGrid& grid);
+
+    /**
+     * @brief Voxeliza uma malha em memória
+     * @param mesh Malha de triângulos
+     * @param grid Grid de destino (dimensões, origem, paleta e chunks são substituídos)
+     * @return true se voxelizada
+     */
+    bool voxelize(const TriangleMesh& mesh, VoxelGrid& grid);
+
+    /**
+     * @brief Lê um arquivo OBJ (faces poligonais em leque, índices negativos, cores por vértice)
+     * @param path Caminho do arquivo
+     * @param mesh Malha de destino
+     * @return true se lido
+     */
+    static bool readObj(const std::string& path, TriangleMesh& mesh);
+
+    /**
+     * @brief Lê um arquivo STL binário ou em texto (Z para cima vira Y para cima)
+     * @param path Caminho do arquivo
+     * @param mesh Malha de destino
+     * @return true se lido
+     */
+    static bool readStl(const std::string& path, TriangleMesh& mesh);
+};
+
+} // namespace VoxelMaker
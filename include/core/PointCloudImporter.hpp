@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Voxel.hpp"
+#include "VoxelGrid.hpp"
+#include <cstdint>
+#include <string>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Importação de nuvens de pontos (XYZ/PTS/CSV e PLY) e heightmaps (PGM/PPM)
+ *
+ * A entrada é lida em blocos de BLOCK_BYTES e nunca fica inteira na memória. Cada bloco é
+ * dividido em fatias (em quebras de linha ou registros inteiros) que são lidas em paralelo:
+ * cada ponto é quantizado para coordenadas de voxel e as fatias agrupam pontos seguidos do
+ * mesmo chunk em trechos. Os trechos do bloco são distribuídos por chunk e cada chunk soma
+ * as cores dos seus pontos em paralelo, em acumuladores por voxel alocados em tijolos de 8³
+ * conforme são tocados. No fim, a cor média de cada voxel é quantizada em 5 bits por canal
+ * e os chunks entram no grid de uma vez.
+ *
+ * Nuvens usam Z para cima, como os scanners: (x, y, z) vira (x, z, -y). Sem tamanho de
+ * voxel, o maior eixo ocupa a resolução pedida, o que exige uma primeira passada só para
+ * os limites. Linhas de texto aceitas: "x y z", "x y z i", "x y z r g b" ou
+ * "x y z i r g b" (separadas por espaços ou vírgulas; as demais são ignoradas). Do PLY
+ * (texto ou binário) são lidas as propriedades x, y, z e red, green, blue do elemento vertex.
+ *
+ * Heightmaps PGM/PPM binários (8 ou 16 bits) são lidos em faixas de SIZE linhas: cada
+ * pixel vira uma coluna de voxels, e cada coluna de chunks da faixa é preenchida em
+ * paralelo. A coluna desce até logo acima do vizinho mais baixo (superfície fechada) ou até
+ * o chão no modo sólido. A cor vem do pixel (PPM) ou da cor das configurações, escurecida
+ * com a altura mais baixa (PGM).
+ */
+class PointCloudImporter {
+public:
+    static constexpr size_t BLOCK_BYTES = 16 * 1024 * 1024;     ///< Entrada lida por vez
+    static constexpr size_t SLICE_BYTES = 256 * 1024;           ///< Menor fatia lida por uma tarefa
+    static constexpr int DEFAULT_RESOLUTION = 512;
+    static constexpr int DEFAULT_HEIGHTMAP_HEIGHT = 256;
+    static constexpr int MAX_RESOLUTION = 4096;                 ///< Voxels por eixo
+
+    /**
+     * @brief Configurações da importação
+     */
+    struct Settings {
+        int resolution;             ///< Voxels no maior eixo da nuvem (se voxelSize for 0)
+        double voxelSize;           ///< Tamanho do voxel em unidades da nuvem (0 = pela resolução)
+        int heightmapHeight;        ///< Voxels da altura máxima do heightmap
+        bool solid;                 ///< Heightmap: colunas cheias até o chão
+        Voxel::Color color;         ///< Cor de pontos sem cor e de heightmaps em tons de cinza
+
+        Settings()
+            : resolution(DEFAULT_RESOLUTION)
+            , voxelSize(0.0)
+            , heightmapHeight(DEFAULT_HEIGHTMAP_HEIGHT)
+            , solid(false)
+            , color(200, 200, 200) {}
+    };
+
+    /**
+     * @brief Contadores da última importação
+     */
+    struct Stats {
+        uint64_t points;            ///< Pontos (ou pixels) lidos
+        uint64_t skippedPoints;     ///< Linhas sem coordenadas válidas
+        uint64_t bytesRead;
+        size_t blocks;
+        size_t chunks;
+        uint64_t voxels;
+        double boundsMs;            ///< Passada dos limites (só com resolução)
+        double readMs;              ///< Espera pela leitura do arquivo
+        double parseMs;             ///< Leitura e quantização em paralelo
+        double binMs;               ///< Distribuição dos trechos e soma das cores
+        double finishMs;            ///< Cores médias, paleta e chunks
+        double elapsedMs;
+        double pointsPerSecond;     ///< Pela passada principal
+        double megabytesPerSecond;
+
+        Stats()
+            : points(0)
+            , skippedPoints(0)
+            , bytesRead(0)
+            , blocks(0)
+            , chunks(0)
+            , voxels(0)
+            , boundsMs(0.0)
+            , readMs(0.0)
+            , parseMs(0.0)
+            , binMs(0.0)
+            , finishMs(0.0)
+            , elapsedMs(0.0)
+            , pointsPerSecond(0.0)
+            , megabytesPerSecond(0.0) {}
+    };
+
+private:
+    Settings settings;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    PointCloudImporter() = default;
+
+    /**
+     * @brief Destrutor
+     */
+    ~PointCloudImporter() = default;
+
+    // Getters
+    const Settings& getSettings() const { return settings; }
+    const Stats& getStats() const { return stats; }
+
+    // Setters
+    void setSettings(const Settings& newSettings) { settings = newSettings; }
+
+    /**
+     * @brief Verifica se o caminho é de uma nuvem de pontos (.xyz, .txt, .pts, .csv ou .ply)
+     */
+    static bool isPointCloudPath(const std::string& path);
+
+    /**
+     * @brief Verifica se o caminho é de um heightmap (.pgm ou .ppm)
+     */
+    static bool isHeightmapPath(const std::string& path);
+
+    /**
+     * @brief Importa uma nuvem de pontos ou um heightmap, pela extensão
+     * @param path Caminho do arquivo
+     * @param grid Grid de destino (dimensões, origem, paleta e chunks são substituídos)
+     * @return true se importado
+     */
+    bool load(const std::string& path, VoxelGrid& grid);
+
+    /**
+     * @brief Importa uma nuvem de pontos
+     * @param path Caminho do arquivo (.xyz, .txt, .pts, .csv ou .ply)
+     * @param grid Grid de destino
+     * @return true se importada
+     */
+    bool loadPointCloud(const std::string& path, VoxelGrid& grid);
+
+    /**
+     * @brief Importa um heightmap
+     * @param path Caminho do arquivo (.pgm ou .ppm binário)
+     * @param grid Grid de destino
+     * @return true se importado
+     */
+    bool loadHeightmap(const std::string& path, VoxelGrid& grid);
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "VoxelGrid.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Cabeçalho da região compartilhada (início da região, ordem de bytes da máquina)
+ *
+ * Layout da região, versão 1 (todos os deslocamentos a partir do início):
+ *
+ *     [0, headerSize)                  SharedGridHeader
+ *     [tableOffset, +maxChunks * 32)   SharedGridSlot por slot
+ *     [paletteOffset, +capacity * 4)   Paleta em RGBA, 1 byte por canal (índice 0 = vazio)
+ *     [cellsOffset, +maxChunks * 64K) Células de cada slot: chunkSize³ índices uint16 da
+ *                                      paleta, na ordem x + y * 32 + z * 32²
+ *
+ * O voxel (x, y, z) de um slot está em slot.x * 32 + x (idem y e z) nas coordenadas do
+ * grid. Os deslocamentos são múltiplos de 4096 e a região é esparsa: slots nunca usados
+ * não ocupam memória.
+ *
+ * Sequências (seqlock): o editor deixa `sequence` ímpar enquanto publica e par no fim.
+ * Um leitor que vê o mesmo valor par antes e depois de ler cabeçalho, tabela, paleta e
+ * células leu uma cena consistente; com valor diferente, lê de novo. Cada slot tem a sua
+ * sequência com a mesma regra, então um chunk pode ser lido sozinho durante publicações
+ * que mexem em outros chunks. Um slot com `used` 0 está livre.
+ */
+struct SharedGridHeader {
+    uint32_t magic;                     ///< "VXSH"
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t chunkSize;                 ///< Voxels por aresta de chunk (32)
+    uint64_t regionSize;
+    uint32_t maxChunks;                 ///< Slots na tabela
+    uint32_t paletteCapacity;           ///< Entradas reservadas para a paleta
+    uint64_t tableOffset;
+    uint64_t paletteOffset;
+    uint64_t cellsOffset;
+    std::atomic<uint64_t> sequence;     ///< Ímpar durante uma publicação
+    uint64_t revision;                  ///< Revisão do grid publicada
+    int32_t dimensions[3];
+    int32_t origin[3];
+    uint32_t chunkCount;                ///< Slots em uso
+    uint32_t paletteCount;              ///< Entradas válidas da paleta
+    uint32_t writerPid;
+    uint32_t flags;                     ///< SharedGridExport::FLAG_*
+};
+
+/**
+ * @brief Entrada da tabela de slots (32 bytes)
+ */
+struct SharedGridSlot {
+    std::atomic<uint32_t> sequence;     ///< Ímpar enquanto o slot é reescrito
+    uint32_t used;                      ///< 1 se o slot guarda um chunk
+    int32_t x, y, z;                    ///< Coordenada do chunk
+    uint32_t solidCells;                ///< Células não vazias
+    uint64_t revision;                  ///< Revisão do grid em que as células mudaram
+};
+
+/**
+ * @brief Publica os chunks do grid em memória compartilhada POSIX com nome
+ *
+ * Outros processos mapeiam a região somente para leitura (SharedGridView ou qualquer
+ * leitor que siga o layout de SharedGridHeader) e leem as células sem cópia enquanto o
+ * editor continua editando. O grid continua dono dos chunks: a cada update() com revisão
+ * nova, só os chunks com revisão diferente da publicada são copiados para os seus slots,
+ * em paralelo (e só se o hash de conteúdo mudou), e os removidos liberam o slot. A
+ * paleta é republicada a partir da primeira entrada diferente.
+ *
+ * Disponível em sistemas POSIX (shm_open + mmap); nos demais open() falha. Fechar remove
+ * o nome da região: leitores que já a mapearam continuam lendo o último estado publicado,
+ * com FLAG_CLOSED marcado.
+ */
+class SharedGridExport {
+public:
+    static constexpr uint32_t SHARED_MAGIC = 0x48535856;       ///< "VXSH"
+    static constexpr uint32_t SHARED_VERSION = 1;
+    static constexpr uint32_t FLAG_CLOSED = 1;                  ///< O editor fechou a região
+    static constexpr uint32_t FLAG_TRUNCATED = 2;               ///< Chunks além de maxChunks ficaram de fora
+    static constexpr size_t PAGE_BYTES = 4096;
+    static constexpr size_t DEFAULT_MAX_CHUNKS = 16384;         ///< 1 GB de células reservados (esparsos)
+    static constexpr size_t PALETTE_CAPACITY = VoxelPalette::MAX_ENTRIES;
+
+    /**
+     * @brief Contadores da publicação
+     */
+    struct Stats {
+        uint64_t publishes;
+        uint64_t chunksCopied;
+        uint64_t chunksUnchanged;   ///< Revisão nova com o mesmo hash de conteúdo (vizinhos de edições)
+        uint64_t chunksRemoved;
+        uint64_t paletteUpdates;
+        size_t chunksPublished;     ///< Slots em uso
+        size_t chunksDropped;       ///< Sem slot livre na última publicação
+        double lastPublishMs;
+
+        Stats()
+            : publishes(0)
+            , chunksCopied(0)
+            , chunksUnchanged(0)
+            , chunksRemoved(0)
+            , paletteUpdates(0)
+            , chunksPublished(0)
+            , chunksDropped(0)
+            , lastPublishMs(0.0) {}
+    };
+
+private:
+    /**
+     * @brief Slot ocupado por uma coordenada
+     */
+    struct SlotRef {
+        uint32_t slot;
+        uint64_t revision;
+        uint64_t contentHash;   ///< VoxelChunk::getContentHash publicado
+        uint64_t generation;    ///< Última publicação em que o chunk estava no grid
+    };
+
+    std::string name;
+    uint8_t* region;
+    size_t regionSize;
+    int descriptor;
+    size_t maxChunks;
+    std::unordered_map<glm::ivec3, SlotRef, Vec3Hash> slots;
+    std::vector<uint32_t> freeSlots;        ///< Pilha de slots livres
+    std::vector<uint32_t> publishedPalette; ///< RGBA publicado
+    uint64_t publishedRevision;
+    uint64_t generation;
+    bool published;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    SharedGridExport();
+
+    /**
+     * @brief Destrutor (fecha a região)
+     */
+    ~SharedGridExport();
+
+    SharedGridExport(const SharedGridExport&) = delete;
+    SharedGridExport& operator=(const SharedGridExport&) = delete;
+
+    // Getters
+    const std::string& getName() const { return name; }
+    bool isOpen() const { return region != nullptr; }
+    size_t getMaxChunks() const { return maxChunks; }
+    size_t getRegionSize() const { return regionSize; }
+    const Stats& getStats() const { return stats; }
+
+    // Setters
+    void setMaxChunks(size_t count) { maxChunks = count; }  ///< Vale a partir do próximo open()
+
+    /**
+     * @brief Normaliza o nome de uma região POSIX (uma barra no início e nenhuma depois)
+     * @return Nome normalizado ou vazio se inválido
+     */
+    static std::string regionNameFor(const std::string& regionName);
+
+    /**
+     * @brief Calcula o tamanho da região para um número de slots
+     */
+    static size_t regionSizeFor(size_t slotCount);
+
+    /**
+     * @brief Cria a região (substituindo uma anterior com o mesmo nome)
+     * @param regionName Nome da região (ex.: "voxelmaker" vira "/voxelmaker")
+     * @return true se criada
+     */
+    bool open(const std::string& regionName);
+
+    /**
+     * @brief Marca a região como fechada, desfaz o mapeamento e remove o nome
+     */
+    void close();
+
+    /**
+     * @brief Publica as mudanças se a revisão do grid mudou desde a última publicação
+     * @param grid Grid de voxels
+     * @return true se algo foi publicado
+     */
+    bool update(const VoxelGrid& grid);
+
+private:
+    /**
+     * @brief Cabeçalho dentro da região
+     */
+    SharedGridHeader& header() const { return *reinterpret_cast<SharedGridHeader*>(region); }
+
+    /**
+     * @brief Entrada da tabela de um slot
+     */
+    SharedGridSlot& slotAt(uint32_t slot) const;
+
+    /**
+     * @brief Células de um slot
+     */
+    VoxelChunk::Cell* cellsAt(uint32_t slot) const;
+
+    /**
+     * @brief Converte a paleta do grid em RGBA
+     */
+    static void encodePalette(const VoxelPalette& palette, std::vector<uint32_t>& rgba);
+};
+
+/**
+ * @brief Leitor somente leitura de uma região publicada por SharedGridExport
+ *
+ * Usado pelo modo --shared-info e como referência para leitores externos: as células são
+ * lidas direto do mapeamento e validadas pelas sequências do layout.
+ */
+class SharedGridView {
+private:
+    std::string name;
+    const uint8_t* region;
+    size_t regionSize;
+    int descriptor;
+
+public:
+    /**
+     * @brief Cópia consistente dos campos variáveis do cabeçalho
+     */
+    struct Snapshot {
+        uint64_t sequence;
+        uint64_t revision;
+        int32_t dimensions[3];
+        int32_t origin[3];
+        uint32_t chunkCount;
+        uint32_t paletteCount;
+        uint32_t writerPid;
+        uint32_t flags;
+    };
+
+    /**
+     * @brief Construtor
+     */
+    SharedGridView();
+
+    /**
+     * @brief Destrutor (desfaz o mapeamento)
+     */
+    ~SharedGridView();
+
+    SharedGridView(const SharedGridView&) = delete;
+    SharedGridView& operator=(const SharedGridView&) = delete;
+
+    // Getters
+    bool isOpen() const { return region != nullptr; }
+    const std::string& getName() const { return name; }
+    const SharedGridHeader& getHeader() const { return *reinterpret_cast<const SharedGridHeader*>(region); }
+    uint32_t getMaxChunks() const { return getHeader().maxChunks; }
+
+    /**
+     * @brief Mapeia uma região existente somente para leitura e valida o layout
+     * @param regionName Nome da região
+     * @return true se mapeada
+     */
+    bool open(const std::string& regionName);
+
+    /**
+     * @brief Desfaz o mapeamento
+     */
+    void close();
+
+    /**
+     * @brief Lê os campos variáveis do cabeçalho com o seqlock global
+     * @param out Campos lidos
+     * @return false se o editor estava publicando em todas as tentativas
+     */
+    bool readSnapshot(Snapshot& out) const;
+
+    /**
+     * @brief Entrada da tabela de um slot (ler sob a sequência do slot)
+     */
+    const SharedGridSlot& getSlot(uint32_t slot) const;
+
+    /**
+     * @brief Células de um slot, sem cópia (ler sob a sequência do slot)
+     */
+    const VoxelChunk::Cell* getCells(uint32_t slot) const;
+
+    /**
+     * @brief Paleta em RGBA, sem cópia (ler sob a sequência global)
+     */
+    const uint32_t* getPalette() const;
+
+    /**
+     * @brief Copia um slot com o seqlock do slot
+     * @param slot Índice do slot
+     * @param entry Entrada da tabela lida
+     * @param cells Destino de VOLUME células (ou nullptr para ler só a entrada)
+     * @return false se o slot está livre ou mudou em todas as tentativas
+     */
+    bool readSlot(uint32_t slot, SharedGridSlot& entry, VoxelChunk::Cell* cells) const;
+};
+
+} // namespace VoxelMaker
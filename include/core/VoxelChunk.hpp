@@ -0,0 +1,218 @@
+#pragma once
+
+#include "VoxelPalette.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Bloco cúbico denso de células do grid
+ *
+ * Cada célula guarda um índice na VoxelPalette do grid (0 = vazio). As células são
+ * armazenadas em ordem x, depois y, depois z.
+ *
+ * Um chunk pode ser preguiçoso: criado a partir de uma Source (ex.: arquivo mapeado em
+ * memória, ou as próprias células comprimidas por compress()), só decodifica suas células
+ * no primeiro acesso. A decodificação é segura entre threads; a primeira edição desliga o
+ * chunk da fonte.
+ *
+ * O hash de conteúdo é a soma (módulo 2⁶⁴) de hashCell de cada célula não vazia: é
+ * calculado uma vez, sob demanda (ou vem pronto da fonte, como no diretório do .vxm), e
+ * depois cada set() o ajusta em O(1).
+ */
+class VoxelChunk {
+public:
+    using Cell = VoxelPalette::Index;
+
+    static constexpr int SIZE = 32;
+    static constexpr int AREA = SIZE * SIZE;
+    static constexpr int VOLUME = SIZE * SIZE * SIZE;
+
+    /**
+     * @brief Origem das células de chunks preguiçosos
+     */
+    class Source {
+    public:
+        virtual ~Source() = default;
+
+        /**
+         * @brief Decodifica as células de um chunk
+         * @param entry Identificador do chunk na fonte
+         * @param cells Destino com VOLUME células
+         * @return true se decodificado (false deixa o chunk vazio)
+         */
+        virtual bool decodeChunk(size_t entry, Cell* cells) const = 0;
+
+        /**
+         * @brief Memória própria da fonte (0 para fontes compartilhadas, como arquivos)
+         */
+        virtual size_t getMemoryUsage() const { return 0; }
+    };
+
+private:
+    glm::ivec3 coord;           ///< Coordenada do chunk (em unidades de chunk)
+    mutable std::vector<Cell> cells;
+    mutable int cellCount;      ///< Número de células não vazias (zerado se a fonte estiver corrompida)
+    uint64_t revision;          ///< Revisão da última edição que afeta este chunk
+    std::shared_ptr<const Source> source;   ///< Fonte das células (nulo se editado ou criado vazio)
+    size_t sourceEntry;
+    mutable std::atomic<bool> resident;     ///< Células decodificadas em memória
+    mutable std::mutex loadMutex;
+    mutable uint64_t contentHash;           ///< Válido se hashValid
+    mutable bool hashValid;
+
+public:
+    /**
+     * @brief Construtor
+     * @param chunkCoord Coordenada do chunk
+     */
+    explicit VoxelChunk(const glm::ivec3& chunkCoord);
+
+    /**
+     * @brief Construtor de chunk preguiçoso
+     * @param chunkCoord Coordenada do chunk
+     * @param chunkSource Fonte das células
+     * @param entry Identificador do chunk na fonte
+     * @param count Número de células não vazias (conhecido sem decodificar)
+     */
+    VoxelChunk(const glm::ivec3& chunkCoord, std::shared_ptr<const Source> chunkSource, size_t entry, int count);
+
+    /**
+     * @brief Construtor de chunk preguiçoso com hash de conteúdo conhecido
+     * @param chunkCoord Coordenada do chunk
+     * @param chunkSource Fonte das células
+     * @param entry Identificador do chunk na fonte
+     * @param count Número de células não vazias (conhecido sem decodificar)
+     * @param hash Hash de conteúdo das células (getContentHash não precisa decodificar)
+     */
+    VoxelChunk(const glm::ivec3& chunkCoord, std::shared_ptr<const Source> chunkSource, size_t entry, int count,
+               uint64_t hash);
+
+    /**
+     * @brief Construtor a partir de células prontas (ex.: preenchidas por um importador)
+     * @param chunkCoord Coordenada do chunk
+     * @param chunkCells VOLUME células
+     */
+    VoxelChunk(const glm::ivec3& chunkCoord, std::vector<Cell> chunkCells);
+
+    /**
+     * @brief Destrutor
+     */
+    ~VoxelChunk() = default;
+
+    // Getters
+    const glm::ivec3& getCoord() const { return coord; }
+    glm::ivec3 getOrigin() const { return coord * SIZE; }
+    int getCellCount() const { return cellCount; }
+    bool isEmpty() const { return cellCount == 0; }
+    uint64_t getRevision() const { return revision; }
+    const Cell* getCells() const { ensureResident(); return cells.data(); }
+    bool isResident() const { return resident.load(std::memory_order_acquire); }
+    bool hasSource() const { return source != nullptr; }
+    size_t getMemoryUsage() const {
+        return (isResident() ? cells.capacity() * sizeof(Cell) : 0) + (source ? source->getMemoryUsage() : 0);
+    }
+
+    // Setters
+    void setRevision(uint64_t rev) { revision = rev; }
+
+    /**
+     * @brief Índice linear de uma coordenada local
+     */
+    static int index(int x, int y, int z) { return x + SIZE * (y + SIZE * z); }
+
+    /**
+     * @brief Contribuição de uma célula para o hash de conteúdo (0 para células vazias)
+     * @param cellIndex Índice linear da célula
+     * @param cell Índice na paleta
+     */
+    static uint64_t hashCell(int cellIndex, Cell cell) {
+        if (cell == VoxelPalette::EMPTY) {
+            return 0;
+        }
+        uint64_t value = (static_cast<uint64_t>(cellIndex) << 16 | cell) * 0x9E3779B97F4A7C15ull;
+        value ^= value >> 32;
+        value *= 0xD6E8FEB86659FD93ull;
+        value ^= value >> 32;
+        return value;
+    }
+
+    /**
+     * @brief Hash de conteúdo de VOLUME células (soma de hashCell)
+     */
+    static uint64_t hashCells(const Cell* data) {
+        uint64_t hash = 0;
+        for (int i = 0; i < VOLUME; i++) {
+            hash += hashCell(i, data[i]);
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Hash do conteúdo das células (independe da coordenada e da revisão)
+     *
+     * Na primeira chamada percorre as células (decodificando chunks preguiçosos sem
+     * torná-los residentes); depois é mantido por set(). Não deve concorrer com edições
+     * nem com outra chamada no mesmo chunk.
+     */
+    uint64_t getContentHash() const;
+
+    /**
+     * @brief Obtém a célula em uma coordenada local
+     * @param local Coordenada local (0..SIZE-1)
+     * @return Índice na paleta
+     */
+    Cell get(const glm::ivec3& local) const { ensureResident(); return cells[index(local.x, local.y, local.z)]; }
+
+    /**
+     * @brief Define a célula em uma coordenada local
+     * @param local Coordenada local (0..SIZE-1)
+     * @param cell Índice na paleta
+     * @return Célula anterior
+     */
+    Cell set(const glm::ivec3& local, Cell cell);
+
+    /**
+     * @brief Copia as células sem torná-las residentes (decodifica da fonte se preciso)
+     * @param out Destino com VOLUME células
+     * @return false se a fonte estiver corrompida (destino vazio)
+     */
+    bool copyCells(Cell* out) const;
+
+    /**
+     * @brief Libera as células decodificadas de um chunk não editado (voltam da fonte
+     *        no próximo acesso). Não deve concorrer com leituras do chunk.
+     * @return true se a memória foi liberada
+     */
+    bool release();
+
+    /**
+     * @brief Comprime as células de um chunk residente em memória (ChunkCodec) e as
+     *        libera; voltam no próximo acesso. Chunks não editados só são liberados.
+     *        Não deve concorrer com leituras do chunk.
+     * @return true se a memória das células foi liberada
+     */
+    bool compress();
+
+private:
+    /**
+     * @brief Decodifica as células da fonte se ainda não estiverem em memória
+     */
+    void ensureResident() const {
+        if (!resident.load(std::memory_order_acquire)) {
+            load();
+        }
+    }
+
+    /**
+     * @brief Decodifica as células da fonte (uma única vez entre threads)
+     */
+    void load() const;
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "ChunkCodec.hpp"
+#include "VoxelGrid.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Formato binário nativo de projetos (.vxm)
+ *
+ * Layout: cabeçalho fixo, paleta, blocos de cada chunk comprimidos por ChunkCodec e, no
+ * fim, o diretório de chunks (coordenada, deslocamento, tamanho, codec, contagem de células,
+ * hash de conteúdo e CRC-32). Cabeçalho,
+ * paleta e diretório têm checksums próprios, verificados ao abrir; cada bloco de chunk é
+ * verificado quando decodificado.
+ *
+ * load() mapeia o arquivo em memória e lê apenas o cabeçalho, a paleta e o diretório: os
+ * chunks entram no grid como chunks preguiçosos e só são decodificados no primeiro acesso.
+ * Abrir um projeto grande é quase instantâneo, e o hash de conteúdo (cache de malhas,
+ * deltas) vem do diretório sem decodificar nada. Chunks lidos e não editados podem ser
+ * liberados de novo (VoxelGrid::releaseChunksOutside; o editor libera os distantes da
+ * câmera após gerar as malhas), de modo que a memória acompanha a região vista e o que foi
+ * editado. O mapeamento fica vivo enquanto algum chunk depender dele.
+ *
+ * Os campos são gravados na ordem de bytes da máquina (como o cache de shaders).
+ */
+class VoxelFile {
+public:
+    static constexpr uint32_t FILE_MAGIC = 0x4D584F56;     ///< "VOXM"
+    static constexpr uint32_t FILE_VERSION = 3;             ///< 2: diretório sem hashes; 1: só blocos RAW e RLE
+    static constexpr size_t SAVE_BATCH = 256;               ///< Chunks codificados por lote ao gravar
+
+    /**
+     * @brief Contadores da última operação
+     */
+    struct Stats {
+        size_t chunks;
+        size_t corruptChunks;       ///< Blocos com checksum ou conteúdo inválido (verify)
+        uint64_t fileBytes;
+        uint64_t rawBytes;          ///< Tamanho das células sem compressão
+        double elapsedMs;
+
+        Stats()
+            : chunks(0)
+            , corruptChunks(0)
+            , fileBytes(0)
+            , rawBytes(0)
+            , elapsedMs(0.0) {}
+    };
+
+private:
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    VoxelFile() = default;
+
+    /**
+     * @brief Destrutor
+     */
+    ~VoxelFile() = default;
+
+    // Getters
+    const Stats& getStats() const { return stats; }
+
+    /**
+     * @brief Grava o grid (arquivo temporário renomeado ao final)
+     *
+     * Chunks ainda não decodificados de um arquivo aberto são copiados sem ficarem
+     * residentes, então gravar um projeto grande não o carrega inteiro na memória.
+     * @param grid Grid de voxels
+     * @param path Caminho do arquivo
+     * @return true se gravado
+     */
+    bool save(const VoxelGrid& grid, const std::string& path);
+
+    /**
+     * @brief Abre um arquivo, substituindo o conteúdo do grid por chunks preguiçosos
+     * @param path Caminho do arquivo
+     * @param grid Grid de destino (dimensões, origem, paleta e chunks são substituídos)
+     * @return true se aberto
+     */
+    bool load(const std::string& path, VoxelGrid& grid);
+
+    /**
+     * @brief Verifica o checksum e a decodificação de todos os chunks de um arquivo
+     * @param path Caminho do arquivo
+     * @return true se o arquivo está íntegro
+     */
+    bool verify(const std::string& path);
+
+    /**
+     * @brief Serializa as entradas da paleta (exceto a vazia), como gravadas no arquivo
+     * @param palette Paleta
+     * @param first Primeiro índice serializado (entradas seguintes a uma parte já gravada)
+     * @return Entradas serializadas
+     */
+    static std::vector<uint8_t> encodePalette(const VoxelPalette& palette, size_t first = 1);
+
+    /**
+     * @brief Reconstrói uma paleta serializada por encodePalette
+     * @param data Entradas serializadas
+     * @param size Tamanho em bytes
+     * @param count Número de entradas gravadas
+     * @param palette Paleta de destino (substituída)
+     * @param remap Leva o índice gravado ao índice na nova paleta
+     * @return true se os dados são válidos
+     */
+    static bool decodePalette(const uint8_t* data, size_t size, uint32_t count,
+                              VoxelPalette& palette, std::vector<VoxelPalette::Index>& remap);
+};
+
+} // namespace VoxelMaker
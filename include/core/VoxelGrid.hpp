@@ -1,9 +1,14 @@
 #pragma once
 
 #include "Voxel.hpp"
+#include "ChunkHashTree.hpp"
+#include "VoxelChunk.hpp"
+#include "VoxelPalette.hpp"
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
+#include <mutex>
 
 namespace VoxelMaker {
 
@@ -19,6 +24,15 @@ struct Vec3Hash {
 
 /**
  * @brief Gerencia um grid 3D de voxels
+ *
+ * Os voxels são armazenados em chunks densos (VoxelChunk) indexados pela coordenada do
+ * chunk; cada célula referencia uma entrada da VoxelPalette do grid. Toda edição carimba
+ * uma nova revisão nos chunks afetados (inclusive vizinhos que a enxergam pela borda),
+ * permitindo que consumidores como o mesher detectem mudanças incrementalmente.
+ *
+ * Além da revisão, que também muda quando só um vizinho mudou, o grid mantém uma árvore
+ * de Merkle com o hash de conteúdo de cada chunk (ChunkHashTree). Edições só anotam o
+ * chunk; a árvore é atualizada na próxima consulta, recalculando apenas os anotados.
  */
 class VoxelGrid {
 public:
@@ -34,10 +48,20 @@ public:
         int getVolume() const { return width * height * depth; }
     };
 
+    using ChunkMap = std::unordered_map<glm::ivec3, std::unique_ptr<VoxelChunk>, Vec3Hash>;
+
 private:
     Dimensions dimensions;
-    std::unordered_map<glm::ivec3, std::shared_ptr<Voxel>, Vec3Hash> voxels;
+    ChunkMap chunks;
+    VoxelPalette palette;
     glm::ivec3 origin;  ///< Origem do grid no espaço mundial
+    size_t voxelCount;
+    uint64_t revision;  ///< Contador global de edições
+
+    mutable ChunkHashTree hashTree;
+    mutable std::unordered_set<glm::ivec3, Vec3Hash> hashPending;  ///< Chunks editados fora da árvore
+    glm::ivec3 lastHashPending;         ///< Evita procurar o mesmo chunk a cada célula de uma edição
+    mutable std::mutex hashMutex;
 
 public:
     /**
@@ -66,12 +90,78 @@ public:
     // Getters
     const Dimensions& getDimensions() const { return dimensions; }
     const glm::ivec3& getOrigin() const { return origin; }
-    size_t getVoxelCount() const { return voxels.size(); }
+    size_t getVoxelCount() const { return voxelCount; }
+    const VoxelPalette& getPalette() const { return palette; }
+    const ChunkMap& getChunks() const { return chunks; }
+    uint64_t getRevision() const { return revision; }
+
+    /**
+     * @brief Árvore de hashes dos chunks, atualizada com os chunks editados desde a última
+     *        consulta (em paralelo). Pode ser chamada de várias threads, mas não durante edições.
+     */
+    const ChunkHashTree& getHashTree() const;
+
+    /**
+     * @brief Hash de todos os chunks (raiz da árvore): mesmo valor, mesmos chunks
+     */
+    uint64_t getContentHash() const { return getHashTree().getRoot(); }
 
     // Setters
     void setDimensions(const Dimensions& dim) { dimensions = dim; }
     void setOrigin(const glm::ivec3& orig) { origin = orig; }
 
+    /**
+     * @brief Substitui a paleta (carregamento de arquivos; os chunks existentes são removidos)
+     * @param newPalette Paleta com os índices referenciados pelos chunks a inserir
+     */
+    void setPalette(const VoxelPalette& newPalette);
+
+    /**
+     * @brief Insere um chunk pronto (ex.: carregado de arquivo), substituindo o existente
+     * @param chunk Chunk com índices da paleta do grid
+     */
+    void insertChunk(std::unique_ptr<VoxelChunk> chunk);
+
+    /**
+     * @brief Registra uma aparência na paleta sem criar voxels (ex.: remapear chunks lidos)
+     * @param voxel Voxel cuja aparência será registrada
+     * @return Índice na paleta ou VoxelPalette::EMPTY se a paleta estiver cheia
+     */
+    VoxelPalette::Index addPaletteEntry(const Voxel& voxel) { return palette.findOrAdd(voxel); }
+
+    /**
+     * @brief Libera as células decodificadas de chunks não editados fora de uma região
+     *
+     * Os chunks continuam no grid e voltam a ser decodificados da fonte quando acessados.
+     * Não deve concorrer com leituras do grid (ex.: remalhagem em andamento).
+     * @param minPos Posição mínima da região mantida
+     * @param maxPos Posição máxima da região mantida
+     * @return Número de chunks liberados
+     */
+    size_t releaseChunksOutside(const glm::ivec3& minPos, const glm::ivec3& maxPos);
+
+    /**
+     * @brief Comprime em memória os chunks fora de uma região (chunks frios)
+     *
+     * Chunks editados são codificados com ChunkCodec::encodeBest; os não editados só são
+     * liberados. Todos voltam a ser decodificados quando acessados. Não deve concorrer com
+     * leituras do grid.
+     * @param minPos Posição mínima da região mantida
+     * @param maxPos Posição máxima da região mantida
+     * @return Número de chunks comprimidos ou liberados
+     */
+    size_t compressChunksOutside(const glm::ivec3& minPos, const glm::ivec3& maxPos);
+
+    /**
+     * @brief Memória ocupada pelas células dos chunks (residentes e comprimidas)
+     */
+    size_t getChunkMemoryUsage() const;
+
+    /**
+     * @brief Número de chunks com células em memória
+     */
+    size_t getResidentChunkCount() const;
+
     /**
      * @brief Adiciona um voxel ao grid
      * @param voxel Voxel a ser adicionado
@@ -89,7 +179,7 @@ public:
     /**
      * @brief Obtém um voxel do grid
      * @param position Posição do voxel
-     * @return Ponteiro para o voxel ou nullptr se não existir
+     * @return Cópia do voxel ou nullptr se não existir
      */
     std::shared_ptr<Voxel> getVoxel(const glm::ivec3& position) const;
 
@@ -141,6 +231,51 @@ public:
      * @param transform Matriz de transformação
      */
     void applyTransform(const glm::mat4& transform);
+
+    /**
+     * @brief Obtém o índice de paleta armazenado em uma posição
+     * @param position Posição no grid
+     * @return Índice na paleta (VoxelPalette::EMPTY se vazio)
+     */
+    VoxelPalette::Index getCell(const glm::ivec3& position) const;
+
+    /**
+     * @brief Obtém um chunk pela sua coordenada
+     * @param chunkCoord Coordenada do chunk
+     * @return Ponteiro para o chunk ou nullptr se não existir
+     */
+    const VoxelChunk* getChunk(const glm::ivec3& chunkCoord) const;
+
+    /**
+     * @brief Converte uma posição do grid na coordenada do chunk que a contém
+     */
+    static glm::ivec3 chunkCoordOf(const glm::ivec3& position);
+
+    /**
+     * @brief Converte uma posição do grid na coordenada local dentro do seu chunk
+     */
+    static glm::ivec3 localCoordOf(const glm::ivec3& position);
+
+private:
+    /**
+     * @brief Escreve uma célula, criando/removendo o chunk conforme necessário
+     * @param position Posição no grid
+     * @param cell Novo índice de paleta
+     * @return true se o conteúdo mudou
+     */
+    bool writeCell(const glm::ivec3& position, VoxelPalette::Index cell);
+
+    /**
+     * @brief Carimba uma nova revisão no chunk da posição e nos vizinhos que a enxergam
+     * @param position Posição editada
+     */
+    void touch(const glm::ivec3& position);
+
+    /**
+     * @brief Anota um chunk criado, editado ou removido para a árvore de hashes
+     * @param chunkCoord Coordenada do chunk
+     */
+    void markHashPending(const glm::ivec3& chunkCoord);
 };
 
 } // namespace VoxelMaker 
\ No newline at end of file
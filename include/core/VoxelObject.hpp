@@ -1,16 +1,73 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <glm/glm.hpp>
+
 namespace VoxelMaker {
 
 /**
  * @brief Representa um objeto composto por múltiplos voxels
+ *
+ * Um objeto nomeia uma região do grid ocupada por um modelo (ex.: uma instância do grafo
+ * de cena de um arquivo .vox) e guarda a transformação do espaço do modelo para o grid.
+ * Os voxels em si ficam no VoxelGrid.
  */
 class VoxelObject {
+private:
+    std::string name;
+    glm::ivec3 minBound;        ///< Menor posição ocupada no grid
+    glm::ivec3 maxBound;        ///< Maior posição ocupada no grid
+    glm::mat4 transform;        ///< Índice do voxel no modelo -> índice da célula no grid
+    int sourceModel;            ///< Índice do modelo no arquivo de origem (-1 se nenhum)
+    size_t voxelCount;
+    bool visible;
+
 public:
-    VoxelObject() = default;
+    /**
+     * @brief Construtor padrão
+     */
+    VoxelObject();
+
+    /**
+     * @brief Construtor com nome
+     * @param objectName Nome do objeto
+     */
+    explicit VoxelObject(const std::string& objectName);
+
+    /**
+     * @brief Destrutor
+     */
     ~VoxelObject() = default;
-    
-    // TODO: Implementar funcionalidades
+
+    // Getters
+    const std::string& getName() const { return name; }
+    const glm::ivec3& getMinBound() const { return minBound; }
+    const glm::ivec3& getMaxBound() const { return maxBound; }
+    const glm::mat4& getTransform() const { return transform; }
+    int getSourceModel() const { return sourceModel; }
+    size_t getVoxelCount() const { return voxelCount; }
+    bool isVisible() const { return visible; }
+    bool isEmpty() const { return voxelCount == 0; }
+
+    // Setters
+    void setName(const std::string& objectName) { name = objectName; }
+    void setTransform(const glm::mat4& matrix) { transform = matrix; }
+    void setSourceModel(int model) { sourceModel = model; }
+    void setVisible(bool show) { visible = show; }
+
+    /**
+     * @brief Inclui uma posição ocupada nos limites do objeto
+     * @param position Posição no grid
+     */
+    void include(const glm::ivec3& position);
+
+    /**
+     * @brief Verifica se uma posição está dentro dos limites do objeto
+     * @param position Posição no grid
+     * @return true se está dentro
+     */
+    bool contains(const glm::ivec3& position) const;
 };
 
-} // namespace VoxelMaker 
\ No newline at end of file
+} // namespace VoxelMaker
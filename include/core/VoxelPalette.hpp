@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Voxel.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Paleta de aparências de voxel (cor, material e estado) compartilhada por um grid
+ *
+ * Os chunks armazenam apenas índices nesta paleta, o que mantém cada célula em 16 bits.
+ * O índice 0 é reservado para "vazio".
+ */
+class VoxelPalette {
+public:
+    using Index = uint16_t;
+
+    static constexpr Index EMPTY = 0;
+    static constexpr size_t MAX_ENTRIES = 65536;
+
+private:
+    std::vector<Voxel> entries;                     ///< Protótipos (posição ignorada)
+    std::vector<uint8_t> solid;                     ///< 1 se o índice representa um voxel ativo
+    std::unordered_map<size_t, std::vector<Index>> lookup;
+
+public:
+    /**
+     * @brief Construtor padrão (cria apenas a entrada vazia)
+     */
+    VoxelPalette();
+
+    /**
+     * @brief Destrutor
+     */
+    ~VoxelPalette() = default;
+
+    /**
+     * @brief Procura a aparência do voxel na paleta, adicionando-a se necessário
+     * @param voxel Voxel cuja aparência será registrada
+     * @return Índice na paleta ou EMPTY se a paleta estiver cheia
+     */
+    Index findOrAdd(const Voxel& voxel);
+
+    /**
+     * @brief Obtém o protótipo de um índice
+     * @param index Índice na paleta
+     * @return Voxel com a aparência registrada (posição na origem)
+     */
+    const Voxel& get(Index index) const { return entries[index]; }
+
+    /**
+     * @brief Verifica se o índice representa um voxel ativo (ocupa espaço)
+     * @param index Índice na paleta
+     * @return true se ativo
+     */
+    bool isSolid(Index index) const { return solid[index] != 0; }
+
+    /**
+     * @brief Número de entradas (incluindo a entrada vazia)
+     */
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Remove todas as entradas exceto a vazia
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Calcula o hash da aparência do voxel (sem a posição)
+     */
+    static size_t hashAppearance(const Voxel& voxel);
+
+    /**
+     * @brief Compara a aparência de dois voxels (sem a posição)
+     */
+    static bool sameAppearance(const Voxel& a, const Voxel& b);
+};
+
+} // namespace VoxelMaker
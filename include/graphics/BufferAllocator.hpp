@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Sub-alocador de faixas dentro de um buffer grande (apenas contabilidade em CPU)
+ *
+ * Escolhe o menor bloco livre que comporta o pedido (best-fit) e funde blocos livres
+ * vizinhos na liberação. Os deslocamentos são múltiplos do alinhamento, o que permite
+ * usar o tamanho do vértice como alinhamento e derivar o vértice base de cada faixa.
+ */
+class BufferAllocator {
+public:
+    static constexpr size_t INVALID_OFFSET = ~static_cast<size_t>(0);
+
+    /**
+     * @brief Estado de ocupação
+     */
+    struct Stats {
+        size_t capacity;
+        size_t usedBytes;
+        size_t allocationCount;
+        size_t freeBlockCount;
+        size_t largestFreeBlock;
+
+        Stats()
+            : capacity(0)
+            , usedBytes(0)
+            , allocationCount(0)
+            , freeBlockCount(0)
+            , largestFreeBlock(0) {}
+    };
+
+private:
+    size_t capacity;
+    size_t alignment;
+    size_t usedBytes;
+    std::map<size_t, size_t> freeByOffset;          ///< Deslocamento -> tamanho
+    std::multimap<size_t, size_t> freeBySize;       ///< Tamanho -> deslocamento
+    std::unordered_map<size_t, size_t> allocations; ///< Deslocamento -> tamanho reservado
+
+public:
+    /**
+     * @brief Construtor
+     * @param capacity Tamanho do buffer em bytes
+     * @param alignment Alinhamento das faixas em bytes
+     */
+    explicit BufferAllocator(size_t capacity = 0, size_t alignment = 16);
+
+    /**
+     * @brief Destrutor
+     */
+    ~BufferAllocator() = default;
+
+    // Getters
+    size_t getCapacity() const { return capacity; }
+    size_t getAlignment() const { return alignment; }
+    size_t getUsedBytes() const { return usedBytes; }
+    size_t getAllocationCount() const { return allocations.size(); }
+
+    /**
+     * @brief Descarta todas as faixas e redefine a capacidade
+     * @param newCapacity Tamanho do buffer em bytes
+     * @param newAlignment Alinhamento das faixas em bytes
+     */
+    void reset(size_t newCapacity, size_t newAlignment);
+
+    /**
+     * @brief Reserva uma faixa
+     * @param size Tamanho em bytes
+     * @return Deslocamento da faixa ou INVALID_OFFSET se não houver espaço contíguo
+     */
+    size_t allocate(size_t size);
+
+    /**
+     * @brief Libera uma faixa reservada
+     * @param offset Deslocamento retornado por allocate
+     */
+    void free(size_t offset);
+
+    /**
+     * @brief Tamanho reservado de uma faixa (já arredondado)
+     * @param offset Deslocamento retornado por allocate
+     * @return Tamanho em bytes ou 0 se a faixa não existir
+     */
+    size_t getAllocationSize(size_t offset) const;
+
+    /**
+     * @brief Aumenta a capacidade preservando as faixas existentes
+     * @param newCapacity Nova capacidade (maior que a atual)
+     */
+    void grow(size_t newCapacity);
+
+    /**
+     * @brief Obtém o estado de ocupação
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Insere um bloco livre fundindo com os vizinhos
+     */
+    void insertFree(size_t offset, size_t size);
+
+    /**
+     * @brief Remove um bloco livre dos dois índices
+     */
+    void eraseFree(std::map<size_t, size_t>::iterator it);
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "Camera.hpp"
+#include "ChunkMesher.hpp"
+#include "Mesh.hpp"
+#include "MeshCache.hpp"
+#include "SurfaceNetsMesher.hpp"
+#include "../core/VoxelGrid.hpp"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Mantém as malhas por chunk de um grid, refazendo apenas os chunks alterados
+ *
+ * Compara a revisão de cada chunk do grid com a revisão usada na última geração; chunks
+ * novos ou editados (inclusive por edições na borda de vizinhos) são refeitos e chunks
+ * removidos têm a malha descartada. Os chunks pendentes são processados em paralelo
+ * no ThreadPool global.
+ *
+ * Quando uma câmera é informada, cada chunk recebe um nível de detalhe pela distância
+ * (cada duplicação da distância base sobe um nível, mantendo o número de triângulos por
+ * anel aproximadamente constante). Se a estimativa total passar do orçamento de
+ * triângulos, as distâncias são encurtadas até caber.
+ *
+ * Com o cache de malhas aberto, cada chunk pendente é procurado antes no disco pela chave
+ * de cacheKey (hashes de conteúdo do chunk e dos 26 vizinhos, cuja borda entra no culling
+ * e na oclusão, mais posição, nível e configurações); os encontrados não contam no limite
+ * por atualização. storeMeshes() grava as malhas geradas, sem repetir as que vieram do
+ * cache, para a próxima abertura do projeto.
+ */
+class ChunkMeshManager {
+public:
+    static constexpr uint64_t NOT_MESHED = ~static_cast<uint64_t>(0);
+
+    /**
+     * @brief Tipo de superfície gerada
+     */
+    enum class MeshingMode {
+        BLOCKY,     ///< Cubos com oclusão ambiente (ChunkMesher)
+        SMOOTH      ///< Superfície suave (SurfaceNetsMesher)
+    };
+
+    /**
+     * @brief Malha de um chunk e metadados associados
+     */
+    struct ChunkMesh {
+        std::shared_ptr<Mesh> mesh;     ///< Compartilhada com comandos de renderização em voo
+        uint64_t revision;      ///< Revisão do chunk usada para gerar a malha
+        glm::vec3 boundsMin;    ///< Limites do chunk no espaço mundial
+        glm::vec3 boundsMax;
+        int lod;                ///< Nível de detalhe usado na malha
+        uint64_t version;       ///< Muda a cada regeneração (identifica a cópia enviada à GPU)
+        uint32_t paletteCount;  ///< Entradas da paleta quando a malha foi gerada
+        bool cached;            ///< A malha está no cache em disco (lida de lá ou já gravada)
+
+        ChunkMesh()
+            : mesh(std::make_shared<Mesh>())
+            , revision(NOT_MESHED)
+            , boundsMin(0.0f)
+            , boundsMax(0.0f)
+            , lod(0)
+            , version(0)
+            , paletteCount(0)
+            , cached(false) {}
+    };
+
+    /**
+     * @brief Configurações de nível de detalhe
+     */
+    struct LodSettings {
+        bool enabled;
+        float baseDistance;         ///< Distância (em voxels) a partir da qual o nível 1 é usado
+        int maxLevel;
+        size_t triangleBudget;      ///< Orçamento total de triângulos (0 = sem limite)
+
+        LodSettings()
+            : enabled(true)
+            , baseDistance(128.0f)
+            , maxLevel(ChunkMesher::MAX_LOD_LEVEL)
+            , triangleBudget(4000000) {}
+    };
+
+    /**
+     * @brief Estatísticas da última atualização
+     */
+    struct Stats {
+        size_t chunksMeshed;
+        size_t chunksLoaded;        ///< Malhas lidas do cache em disco em vez de geradas
+        size_t chunksDeferred;      ///< Chunks pendentes deixados para as próximas atualizações
+        size_t chunksRemoved;
+        size_t meshCount;
+        size_t triangleCount;
+        size_t chunksPerLevel[ChunkMesher::MAX_LOD_LEVEL + 1];
+        float lodBias;              ///< Multiplicador aplicado às distâncias para caber no orçamento
+        float acmrBefore;           ///< ACMR médio das malhas otimizadas nesta atualização
+        float acmrAfter;
+        double lastUpdateMs;
+
+        Stats()
+            : chunksMeshed(0)
+            , chunksLoaded(0)
+            , chunksDeferred(0)
+            , chunksRemoved(0)
+            , meshCount(0)
+            , triangleCount(0)
+            , chunksPerLevel()
+            , lodBias(1.0f)
+            , acmrBefore(0.0f)
+            , acmrAfter(0.0f)
+            , lastUpdateMs(0.0) {}
+    };
+
+    using ChunkMeshMap = std::unordered_map<glm::ivec3, ChunkMesh, Vec3Hash>;
+
+private:
+    ChunkMesher mesher;
+    SurfaceNetsMesher smoothMesher;
+    SurfaceNetsMesher::BorderCache borderCache;
+    MeshingMode meshingMode;
+    LodSettings lodSettings;
+    bool optimizeMeshes;        ///< Executa Mesh::optimize em cada malha gerada
+    size_t maxChunksPerUpdate;  ///< Limite de chunks refeitos por atualização (0 = sem limite)
+    ChunkMeshMap meshes;
+    const VoxelGrid* sourceGrid;
+    uint64_t sourceRevision;
+    uint64_t meshVersion;       ///< Última versão atribuída a uma malha
+    MeshCache meshCache;
+    std::vector<uint64_t> paletteHashes;    ///< MeshCache::hashPalette da paleta do grid
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    ChunkMeshManager();
+
+    /**
+     * @brief Destrutor
+     */
+    ~ChunkMeshManager() = default;
+
+    /**
+     * @brief Atualiza as malhas dos chunks alterados
+     * @param grid Grid de origem
+     * @return Número de chunks refeitos
+     */
+    size_t update(const VoxelGrid& grid);
+
+    /**
+     * @brief Atualiza as malhas escolhendo o nível de detalhe pela posição da câmera
+     * @param grid Grid de origem
+     * @param camera Câmera usada para calcular as distâncias
+     * @return Número de chunks refeitos
+     */
+    size_t update(const VoxelGrid& grid, const Camera& camera);
+
+    /**
+     * @brief Obtém a malha de um chunk
+     * @param chunkCoord Coordenada do chunk
+     * @return Ponteiro para a malha ou nullptr se não existir
+     */
+    const Mesh* getMesh(const glm::ivec3& chunkCoord) const;
+
+    /**
+     * @brief Obtém todas as malhas
+     */
+    const ChunkMeshMap& getMeshes() const { return meshes; }
+
+    /**
+     * @brief Obtém as estatísticas da última atualização
+     */
+    const Stats& getStats() const { return stats; }
+
+    /**
+     * @brief Cache de malhas em disco (fechado até open())
+     */
+    MeshCache& getMeshCache() { return meshCache; }
+
+    /**
+     * @brief Grava no cache em disco as malhas geradas que ainda não estão nele
+     * @return Número de malhas gravadas
+     */
+    size_t storeMeshes();
+
+    /**
+     * @brief Obtém as configurações do mesher
+     */
+    const ChunkMesher::Settings& getMesherSettings() const { return mesher.getSettings(); }
+
+    /**
+     * @brief Define as configurações do mesher (força a regeneração de tudo)
+     * @param settings Novas configurações
+     */
+    void setMesherSettings(const ChunkMesher::Settings& settings);
+
+    /**
+     * @brief Obtém o tipo de superfície gerada
+     */
+    MeshingMode getMeshingMode() const { return meshingMode; }
+
+    /**
+     * @brief Define o tipo de superfície gerada (força a regeneração de tudo)
+     * @param mode Novo modo
+     */
+    void setMeshingMode(MeshingMode mode);
+
+    /**
+     * @brief Obtém as configurações de nível de detalhe
+     */
+    const LodSettings& getLodSettings() const { return lodSettings; }
+
+    /**
+     * @brief Define as configurações de nível de detalhe
+     * @param settings Novas configurações
+     */
+    void setLodSettings(const LodSettings& settings) { lodSettings = settings; }
+
+    /**
+     * @brief Verifica se as malhas são otimizadas para o cache de vértices e overdraw
+     */
+    bool getOptimizeMeshes() const { return optimizeMeshes; }
+
+    /**
+     * @brief Ativa a otimização das malhas (custa cerca de duas vezes a geração)
+     * @param enabled true para otimizar as próximas malhas geradas
+     */
+    void setOptimizeMeshes(bool enabled) { optimizeMeshes = enabled; }
+
+    /**
+     * @brief Obtém o limite de chunks refeitos por atualização
+     */
+    size_t getMaxChunksPerUpdate() const { return maxChunksPerUpdate; }
+
+    /**
+     * @brief Limita os chunks refeitos por atualização, espalhando o trabalho entre quadros
+     *
+     * Quando há mais chunks pendentes que o limite, os mais próximos da câmera são refeitos
+     * primeiro; os demais continuam com a malha anterior até as próximas atualizações.
+     *
+     * @param limit Número máximo de chunks (0 = sem limite)
+     */
+    void setMaxChunksPerUpdate(size_t limit) { maxChunksPerUpdate = limit; }
+
+    /**
+     * @brief Marca todas as malhas para regeneração
+     */
+    void invalidate();
+
+    /**
+     * @brief Descarta todas as malhas
+     */
+    void clear();
+
+    /**
+     * @brief Nível de detalhe para uma distância
+     * @param distance Distância até a câmera
+     * @return Nível (0..maxLevel)
+     */
+    int levelForDistance(float distance) const;
+
+private:
+    /**
+     * @brief Implementação comum das atualizações
+     * @param grid Grid de origem
+     * @param viewer Posição da câmera (nullptr = resolução completa)
+     */
+    size_t updateMeshes(const VoxelGrid& grid, const glm::vec3* viewer);
+
+    /**
+     * @brief Escolhe o nível de cada chunk respeitando o orçamento de triângulos
+     * @param entries Chunks e entradas correspondentes
+     * @param viewer Posição da câmera
+     * @param levels Saída com o nível de cada entrada
+     */
+    void selectLevels(const std::vector<std::pair<const VoxelChunk*, ChunkMesh*>>& entries,
+                      const glm::vec3& viewer,
+                      std::vector<int>& levels);
+
+    /**
+     * @brief Lê do cache em disco as malhas pendentes que estão nele
+     * @param grid Grid de origem
+     * @param entries Chunks e entradas correspondentes
+     * @param levels Nível de cada entrada
+     * @param pending Índices pendentes (saem só os que faltaram no cache)
+     * @return Índices das entradas lidas do cache
+     */
+    std::vector<size_t> loadCachedMeshes(const VoxelGrid& grid,
+                                         const std::vector<std::pair<const VoxelChunk*, ChunkMesh*>>& entries,
+                                         const std::vector<int>& levels,
+                                         std::vector<size_t>& pending);
+
+    /**
+     * @brief Chave da malha de um chunk no cache em disco
+     * @param tree Árvore de hashes do grid (VoxelGrid::getHashTree)
+     * @param gridOrigin Origem do grid (as malhas estão no espaço mundial)
+     * @param chunkCoord Coordenada do chunk
+     * @param level Nível de detalhe
+     */
+    uint64_t cacheKey(const ChunkHashTree& tree, const glm::ivec3& gridOrigin, const glm::ivec3& chunkCoord, int level) const;
+};
+
+} // namespace VoxelMaker
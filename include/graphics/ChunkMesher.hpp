@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "../core/VoxelGrid.hpp"
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Gera a malha "blocada" de um chunk com oclusão ambiente por vértice
+ *
+ * O chunk é copiado junto com uma borda de uma célula dos 26 vizinhos, de modo que o
+ * culling de faces e a oclusão ambiente (3 vizinhos por canto) enxerguem além da
+ * fronteira sem consultas ao mapa de chunks no laço interno.
+ *
+ * Para níveis de detalhe (LOD) o chunk é reduzido em blocos de 2^nível voxels. Como um
+ * bloco reduzido é sólido quando qualquer voxel dele é sólido, a versão grossa sempre
+ * contém a fina; as faces na fronteira do chunk são mantidas ("saias") sempre que o
+ * bloco vizinho não é totalmente sólido, fechando as frestas entre chunks de níveis
+ * diferentes.
+ */
+class ChunkMesher {
+public:
+    /**
+     * @brief Configurações de geração de malha
+     */
+    struct Settings {
+        bool ambientOcclusion;
+        float aoStrength;       ///< Quanto um canto totalmente ocluído escurece (0..1)
+
+        Settings()
+            : ambientOcclusion(true)
+            , aoStrength(0.75f) {}
+    };
+
+    static constexpr int PADDED_SIZE = VoxelChunk::SIZE + 2;
+    static constexpr int PADDED_AREA = PADDED_SIZE * PADDED_SIZE;
+    static constexpr int PADDED_VOLUME = PADDED_SIZE * PADDED_SIZE * PADDED_SIZE;
+    static constexpr int MAX_LOD_LEVEL = 4;     ///< Nível 4 = blocos de 16³ voxels
+
+private:
+    Settings settings;
+
+public:
+    /**
+     * @brief Construtor padrão
+     */
+    ChunkMesher();
+
+    /**
+     * @brief Construtor com configurações
+     * @param settings Configurações de geração
+     */
+    explicit ChunkMesher(const Settings& settings);
+
+    /**
+     * @brief Destrutor
+     */
+    ~ChunkMesher() = default;
+
+    // Getters
+    const Settings& getSettings() const { return settings; }
+
+    // Setters
+    void setSettings(const Settings& newSettings) { settings = newSettings; }
+
+    /**
+     * @brief Gera a malha de um chunk do grid
+     * @param grid Grid de origem
+     * @param chunkCoord Coordenada do chunk
+     * @param out Malha de saída (é limpa antes)
+     */
+    void meshChunk(const VoxelGrid& grid, const glm::ivec3& chunkCoord, Mesh& out) const;
+
+    /**
+     * @brief Gera a malha de um chunk a partir dos dados reduzidos de um nível de detalhe
+     * @param grid Grid de origem
+     * @param chunkCoord Coordenada do chunk
+     * @param level Nível de detalhe (0 = resolução completa, até MAX_LOD_LEVEL)
+     * @param out Malha de saída (é limpa antes)
+     */
+    void meshChunkLod(const VoxelGrid& grid, const glm::ivec3& chunkCoord, int level, Mesh& out) const;
+
+    /**
+     * @brief Copia o chunk e uma borda de uma célula dos vizinhos
+     * @param grid Grid de origem
+     * @param chunkCoord Coordenada do chunk
+     * @param padded Saída com PADDED_VOLUME células (índice x + P*(y + P*z), origem em -1)
+     */
+    static void gatherNeighbourhood(const VoxelGrid& grid,
+                                    const glm::ivec3& chunkCoord,
+                                    std::vector<VoxelChunk::Cell>& padded);
+
+    /**
+     * @brief Reduz o chunk e a borda dos vizinhos em blocos de 2^nível voxels
+     * @param grid Grid de origem
+     * @param chunkCoord Coordenada do chunk
+     * @param level Nível de detalhe
+     * @param padded Saída com (SIZE/2^nível + 2)³ células (cor mais frequente do bloco)
+     * @param full Saída com 1 para blocos totalmente sólidos
+     */
+    static void gatherDownsampled(const VoxelGrid& grid,
+                                  const glm::ivec3& chunkCoord,
+                                  int level,
+                                  std::vector<VoxelChunk::Cell>& padded,
+                                  std::vector<uint8_t>& full);
+
+    /**
+     * @brief Gera a malha a partir de uma vizinhança já copiada
+     * @param padded Células com borda (ver gatherNeighbourhood)
+     * @param palette Paleta do grid
+     * @param offset Posição mundial da célula local (0, 0, 0)
+     * @param out Malha de saída (é limpa antes)
+     */
+    void meshNeighbourhood(const std::vector<VoxelChunk::Cell>& padded,
+                           const VoxelPalette& palette,
+                           const glm::vec3& offset,
+                           Mesh& out) const;
+
+private:
+    /**
+     * @brief Gera faces para uma vizinhança de tamanho arbitrário
+     * @param padded Células com borda ((size + 2)³)
+     * @param full Blocos totalmente sólidos (nullptr desativa as saias)
+     * @param size Células por eixo no interior
+     * @param scale Tamanho de uma célula em voxels
+     * @param palette Paleta do grid
+     * @param offset Posição mundial da célula local (0, 0, 0)
+     * @param out Malha de saída (é limpa antes)
+     */
+    void meshCells(const VoxelChunk::Cell* padded,
+                   const uint8_t* full,
+                   int size,
+                   float scale,
+                   const VoxelPalette& palette,
+                   const glm::vec3& offset,
+                   Mesh& out) const;
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Ajusta a qualidade para manter o tempo de quadro perto de um alvo
+ *
+ * O laço principal marca as fases de cada quadro na CPU (eventos, atualização, gravação e
+ * espera pela thread de renderização). A cada intervalo de quadros o controlador compara a
+ * média móvel do tempo de quadro com o alvo e mexe em um dos três controles: distância de
+ * LOD, chunks refeitos por quadro e bytes de malhas enviados por quadro.
+ *
+ * Acima do alvo a qualidade cai rápido (metade ou 80%), escolhendo o controle pela fase
+ * dominante; abaixo da folga ela sobe devagar, um controle por vez e a distância de LOD por
+ * último (mudá-la refaz malhas). Entre os dois limites nada muda, o que evita oscilar quando
+ * o quadro está preso à sincronização vertical. Cada decisão fica registrada como métrica.
+ */
+class FrameBudgetController {
+public:
+    /**
+     * @brief Fases medidas de um quadro
+     */
+    enum class Phase : uint8_t {
+        EVENTS,         ///< Processamento de eventos da janela
+        UPDATE,         ///< Lógica da aplicação
+        RECORD,         ///< Malhas, descarte e gravação dos comandos
+        SUBMIT          ///< Espera pela thread de renderização
+    };
+
+    static constexpr size_t PHASE_COUNT = 4;
+    static constexpr size_t HISTORY_SIZE = 256;
+
+    /**
+     * @brief Ação tomada em uma decisão
+     */
+    enum class Action : uint8_t {
+        NONE,
+        DEGRADE,
+        IMPROVE
+    };
+
+    /**
+     * @brief Controles de qualidade
+     */
+    struct Quality {
+        float lodDistance;              ///< Distância em que o primeiro nível de LOD começa
+        size_t meshJobsPerFrame;        ///< Chunks refeitos por quadro
+        size_t uploadBytesPerFrame;     ///< Bytes de malhas enviados por quadro
+
+        Quality()
+            : lodDistance(128.0f)
+            , meshJobsPerFrame(64)
+            , uploadBytesPerFrame(16 * 1024 * 1024) {}
+    };
+
+    /**
+     * @brief Configurações do controlador
+     */
+    struct Settings {
+        double targetFrameMs;
+        double tolerance;           ///< Fração acima do alvo tolerada antes de reduzir
+        double headroom;            ///< Fração do alvo abaixo da qual a qualidade sobe
+        double smoothing;           ///< Peso de cada quadro na média móvel (0..1)
+        int adjustInterval;         ///< Quadros entre decisões
+        Quality minQuality;
+        Quality maxQuality;
+
+        Settings()
+            : targetFrameMs(1000.0 / 60.0)
+            , tolerance(0.1)
+            , headroom(0.75)
+            , smoothing(0.2)
+            , adjustInterval(15)
+            , minQuality()
+            , maxQuality() {
+            minQuality.lodDistance = 32.0f;
+            minQuality.meshJobsPerFrame = 2;
+            minQuality.uploadBytesPerFrame = 256 * 1024;
+        }
+    };
+
+    /**
+     * @brief Registro de uma decisão (métrica para ajuste fino)
+     */
+    struct Decision {
+        uint64_t frame;
+        double frameMs;                 ///< Média móvel do tempo de quadro
+        double phaseMs[PHASE_COUNT];    ///< Média móvel de cada fase
+        Phase dominantPhase;
+        Action action;
+        Quality quality;                ///< Qualidade após a decisão
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Settings settings;
+    Quality quality;
+    Clock::time_point frameStart;
+    Clock::time_point phaseStart;
+    Phase currentPhase;
+    bool inFrame;
+    double framePhaseMs[PHASE_COUNT];
+    double averagePhaseMs[PHASE_COUNT];
+    double averageFrameMs;
+    uint64_t frameCount;
+    int framesSinceDecision;
+    std::deque<Decision> history;
+    std::ofstream metricsFile;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    FrameBudgetController();
+
+    /**
+     * @brief Construtor com configurações
+     * @param settings Configurações iniciais
+     */
+    explicit FrameBudgetController(const Settings& settings);
+
+    /**
+     * @brief Destrutor
+     */
+    ~FrameBudgetController() = default;
+
+    // Getters
+    const Settings& getSettings() const { return settings; }
+    const Quality& getQuality() const { return quality; }
+    double getAverageFrameMs() const { return averageFrameMs; }
+    double getAveragePhaseMs(Phase phase) const { return averagePhaseMs[static_cast<size_t>(phase)]; }
+    uint64_t getFrameCount() const { return frameCount; }
+    const std::deque<Decision>& getHistory() const { return history; }
+
+    // Setters
+    void setSettings(const Settings& newSettings) { settings = newSettings; }
+
+    /**
+     * @brief Define a qualidade atual (limitada pelas configurações)
+     * @param newQuality Qualidade
+     */
+    void setQuality(const Quality& newQuality);
+
+    /**
+     * @brief Grava cada decisão em um arquivo CSV
+     * @param path Caminho do arquivo
+     * @return true se o arquivo foi aberto
+     */
+    bool openMetricsFile(const std::string& path);
+
+    /**
+     * @brief Marca o início de um quadro
+     */
+    void beginFrame();
+
+    /**
+     * @brief Marca o início de uma fase (encerra a anterior)
+     * @param phase Fase iniciada
+     */
+    void beginPhase(Phase phase);
+
+    /**
+     * @brief Encerra o quadro e, no fim de cada intervalo, decide a nova qualidade
+     * @return true se a qualidade mudou
+     */
+    bool endFrame();
+
+    /**
+     * @brief Descarta o quadro em andamento (iteração sem desenho, fora das médias)
+     */
+    void discardFrame() { inFrame = false; }
+
+    /**
+     * @brief Nome de uma fase
+     */
+    static const char* getPhaseName(Phase phase);
+
+private:
+    /**
+     * @brief Reduz o controle ligado à fase dominante
+     * @return true se algum controle mudou
+     */
+    bool degrade(Phase dominant);
+
+    /**
+     * @brief Aumenta um controle (envio, depois malhas, depois LOD)
+     * @return true se algum controle mudou
+     */
+    bool improve();
+
+    /**
+     * @brief Registra uma decisão no histórico e no arquivo de métricas
+     */
+    void record(const Decision& decision);
+};
+
+} // namespace VoxelMaker
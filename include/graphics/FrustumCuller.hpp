@@ -0,0 +1,106 @@
+#pragma once
+
+#include "ChunkMeshManager.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Descarta chunks fora do frustum da câmera
+ *
+ * Os 6 planos são extraídos da matriz view-projection (Gribb/Hartmann). As caixas dos
+ * chunks são copiadas em estrutura de arrays e testadas em lotes de 4 (SSE) ou 8 (AVX)
+ * contra o vértice positivo de cada plano; o resultado é uma lista de chunks visíveis
+ * ordenada da frente para trás.
+ */
+class FrustumCuller {
+public:
+    /**
+     * @brief Chunk visível e sua distância até a câmera
+     */
+    struct VisibleChunk {
+        glm::ivec3 coord;
+        const ChunkMeshManager::ChunkMesh* mesh;
+        float distance;         ///< Distância da câmera até a caixa do chunk
+    };
+
+    /**
+     * @brief Contadores do último descarte
+     */
+    struct Stats {
+        size_t chunksTested;
+        size_t chunksCulled;
+        size_t chunksVisible;
+
+        Stats()
+            : chunksTested(0)
+            , chunksCulled(0)
+            , chunksVisible(0) {}
+    };
+
+    static constexpr int PLANE_COUNT = 6;
+
+private:
+    glm::vec4 planes[PLANE_COUNT];  ///< (normal, d) com a normal apontando para dentro
+
+    // Caixas em estrutura de arrays (reaproveitadas entre quadros)
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    std::vector<uint8_t> visible;
+    std::vector<const ChunkMeshManager::ChunkMeshMap::value_type*> candidates;
+
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor (frustum que aceita tudo até o primeiro setViewProjection)
+     */
+    FrustumCuller();
+
+    /**
+     * @brief Destrutor
+     */
+    ~FrustumCuller() = default;
+
+    // Getters
+    const glm::vec4& getPlane(int index) const { return planes[index]; }
+    const Stats& getStats() const { return stats; }
+
+    /**
+     * @brief Extrai os planos do frustum
+     * @param viewProjection Matriz projeção * view (profundidade em -1..1, OpenGL)
+     */
+    void setViewProjection(const glm::mat4& viewProjection);
+
+    /**
+     * @brief Testa uma única caixa
+     * @param boxMin Canto mínimo
+     * @param boxMax Canto máximo
+     * @return true se a caixa intersecta o frustum
+     */
+    bool testBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+    /**
+     * @brief Testa caixas em estrutura de arrays
+     * @param count Número de caixas
+     * @param result Saída com 1 para caixas visíveis (count bytes)
+     * @return Número de caixas visíveis
+     */
+    size_t testBoxes(const float* boxMinX, const float* boxMinY, const float* boxMinZ,
+                     const float* boxMaxX, const float* boxMaxY, const float* boxMaxZ,
+                     size_t count, uint8_t* result) const;
+
+    /**
+     * @brief Seleciona as malhas visíveis e as ordena da frente para trás
+     * @param meshes Malhas por chunk
+     * @param viewer Posição da câmera
+     * @param out Lista de chunks visíveis (é limpa antes)
+     */
+    void cullChunks(const ChunkMeshManager::ChunkMeshMap& meshes,
+                    const glm::vec3& viewer,
+                    std::vector<VisibleChunk>& out);
+};
+
+} // namespace VoxelMaker
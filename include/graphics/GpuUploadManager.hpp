@@ -0,0 +1,169 @@
+#pragma once
+
+#include "BufferAllocator.hpp"
+#include "Mesh.hpp"
+#include "UploadRing.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Envia malhas de chunks para dois buffers grandes compartilhados (vértices e índices)
+ *
+ * Cada chunk recebe uma faixa em cada buffer (BufferAllocator) e os dados chegam pelo
+ * anel de staging (UploadRing): a CPU copia direto dos vetores gerados pelo mesher para
+ * a memória mapeada e a GPU copia do anel para a faixa, sem glBufferData por chunk e sem
+ * esperar o quadro anterior. Todos os chunks compartilham um único VAO e são desenhados
+ * com glDrawElementsBaseVertex.
+ *
+ * Quando uma faixa não cabe, o buffer correspondente dobra de tamanho (cópia na GPU) e as
+ * faixas existentes continuam válidas. Deve ser usado apenas na thread dona do contexto.
+ */
+class GpuUploadManager {
+public:
+    /**
+     * @brief Faixas de um chunk nos buffers compartilhados
+     */
+    struct Allocation {
+        size_t vertexOffset;        ///< Em bytes (múltiplo de sizeof(Mesh::Vertex))
+        size_t indexOffset;         ///< Em bytes
+        size_t indexCount;
+        int32_t baseVertex;
+
+        Allocation()
+            : vertexOffset(BufferAllocator::INVALID_OFFSET)
+            , indexOffset(BufferAllocator::INVALID_OFFSET)
+            , indexCount(0)
+            , baseVertex(0) {}
+
+        bool isValid() const { return vertexOffset != BufferAllocator::INVALID_OFFSET; }
+    };
+
+    /**
+     * @brief Configurações dos buffers
+     */
+    struct Settings {
+        size_t ringCapacity;
+        size_t vertexCapacity;      ///< Capacidade inicial do buffer de vértices
+        size_t indexCapacity;       ///< Capacidade inicial do buffer de índices
+        bool allowPersistentMapping;
+
+        Settings()
+            : ringCapacity(UploadRing::DEFAULT_CAPACITY)
+            , vertexCapacity(64 * 1024 * 1024)
+            , indexCapacity(32 * 1024 * 1024)
+            , allowPersistentMapping(true) {}
+    };
+
+    /**
+     * @brief Estatísticas acumuladas e ocupação atual dos buffers
+     */
+    struct Stats {
+        size_t meshesUploaded;
+        size_t bytesUploaded;
+        size_t directUploads;       ///< Faixas maiores que o anel (glBufferSubData)
+        size_t bufferGrowths;       ///< Total de vezes que um buffer dobrou
+        BufferAllocator::Stats vertexBuffer;
+        BufferAllocator::Stats indexBuffer;
+
+        Stats()
+            : meshesUploaded(0)
+            , bytesUploaded(0)
+            , directUploads(0)
+            , bufferGrowths(0)
+            , vertexBuffer()
+            , indexBuffer() {}
+    };
+
+private:
+    Settings settings;
+    UploadRing ring;
+    BufferAllocator vertexAllocator;
+    BufferAllocator indexAllocator;
+    unsigned int vertexBuffer, indexBuffer;
+    unsigned int vertexArray;
+    Stats stats;
+    bool initialized;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    GpuUploadManager();
+
+    /**
+     * @brief Destrutor
+     */
+    ~GpuUploadManager();
+
+    GpuUploadManager(const GpuUploadManager&) = delete;
+    GpuUploadManager& operator=(const GpuUploadManager&) = delete;
+
+    /**
+     * @brief Cria o anel, os buffers compartilhados e o VAO
+     * @param newSettings Configurações
+     * @return true se inicializado com sucesso
+     */
+    bool initialize(const Settings& newSettings = Settings());
+
+    /**
+     * @brief Libera os recursos OpenGL
+     */
+    void cleanup();
+
+    /**
+     * @brief Envia uma malha, reaproveitando a faixa anterior do chunk se couber
+     * @param mesh Malha gerada
+     * @param allocation Faixas do chunk (atualizadas)
+     * @return true se enviada
+     */
+    bool upload(const Mesh& mesh, Allocation& allocation);
+
+    /**
+     * @brief Libera as faixas de um chunk
+     * @param allocation Faixas do chunk (invalidadas)
+     */
+    void release(Allocation& allocation);
+
+    /**
+     * @brief Desenha as faixas de um chunk (o VAO compartilhado deve estar ativo)
+     * @param allocation Faixas do chunk
+     */
+    void draw(const Allocation& allocation) const;
+
+    /**
+     * @brief Fecha o quadro: protege as escritas no anel com um fence
+     */
+    void endFrame();
+
+    // Getters
+    unsigned int getVertexArray() const { return vertexArray; }
+    unsigned int getVertexBuffer() const { return vertexBuffer; }
+    unsigned int getIndexBuffer() const { return indexBuffer; }
+    bool isPersistent() const { return ring.isPersistent(); }
+    const UploadRing& getRing() const { return ring; }
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Reserva uma faixa, dobrando o buffer se necessário
+     * @param allocator Sub-alocador do buffer
+     * @param buffer Buffer OpenGL (recriado se crescer)
+     * @param size Tamanho em bytes
+     * @return Deslocamento da faixa
+     */
+    size_t allocateRange(BufferAllocator& allocator, unsigned int& buffer, size_t size);
+
+    /**
+     * @brief Copia dados para uma faixa de um buffer passando pelo anel
+     */
+    void writeRange(unsigned int buffer, size_t offset, const void* data, size_t size, size_t alignment);
+
+    /**
+     * @brief Configura os atributos de vértice do VAO compartilhado
+     */
+    void setupVertexArray();
+};
+
+} // namespace VoxelMaker
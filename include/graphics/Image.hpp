@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Imagem RGB8 em memória (linhas de cima para baixo)
+ *
+ * Usada pela renderização em CPU para miniaturas e prévias. Grava PPM binário (P6) e PNG
+ * sem compressão (blocos deflate armazenados), sem dependências externas.
+ */
+class Image {
+private:
+    int width;
+    int height;
+    std::vector<uint8_t> pixels;    ///< 3 bytes por pixel
+
+public:
+    /**
+     * @brief Construtor (imagem vazia)
+     */
+    Image();
+
+    /**
+     * @brief Construtor
+     * @param w Largura
+     * @param h Altura
+     */
+    Image(int w, int h);
+
+    /**
+     * @brief Destrutor
+     */
+    ~Image() = default;
+
+    // Getters
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const std::vector<uint8_t>& getPixels() const { return pixels; }
+    bool isEmpty() const { return pixels.empty(); }
+
+    /**
+     * @brief Redimensiona a imagem (conteúdo descartado)
+     * @param w Largura
+     * @param h Altura
+     */
+    void resize(int w, int h);
+
+    /**
+     * @brief Define a cor de um pixel
+     * @param x Coluna
+     * @param y Linha (0 = topo)
+     * @param r Vermelho
+     * @param g Verde
+     * @param b Azul
+     */
+    void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+        uint8_t* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 3];
+        pixel[0] = r;
+        pixel[1] = g;
+        pixel[2] = b;
+    }
+
+    /**
+     * @brief Ponteiro para o primeiro pixel de uma linha
+     * @param y Linha (0 = topo)
+     */
+    const uint8_t* getRow(int y) const { return &pixels[static_cast<size_t>(y) * width * 3]; }
+
+    /**
+     * @brief Grava a imagem escolhendo o formato pela extensão (.png ou .ppm)
+     * @param path Caminho do arquivo
+     * @return true se gravada com sucesso
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Grava em PPM binário (P6)
+     * @param path Caminho do arquivo
+     * @return true se gravada com sucesso
+     */
+    bool savePPM(const std::string& path) const;
+
+    /**
+     * @brief Grava em PNG RGB8 sem compressão
+     * @param path Caminho do arquivo
+     * @return true se gravada com sucesso
+     */
+    bool savePNG(const std::string& path) const;
+};
+
+} // namespace VoxelMaker
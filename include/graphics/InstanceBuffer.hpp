@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../core/VoxelGrid.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Buffer de instâncias compactadas para desenhar N voxels com uma chamada
+ *
+ * Cada voxel vira uma instância de 8 bytes (posição local ao grid em 3 x 16 bits e
+ * índice da paleta em 16 bits); as cores ficam em uma tabela RGBA8 indexada pela
+ * paleta. Pensado para grids pequenos e que mudam a cada quadro (prévias, seleções,
+ * fantasmas de pincel), onde gerar malhas custaria mais que desenhar cubos.
+ *
+ * A montagem é feita em paralelo por chunk e só é refeita quando a revisão do grid muda;
+ * as instâncias de cada chunk ocupam uma faixa contígua do buffer (getChunkOffsets). Só
+ * entradas sólidas da paleta geram instâncias e escondem faces, como no ChunkMesher.
+ */
+class InstanceBuffer {
+public:
+    /**
+     * @brief Instância compactada (atributo uvec4 no shader)
+     */
+    struct Instance {
+        uint16_t x, y, z;
+        uint16_t paletteIndex;
+    };
+
+    static constexpr int MAX_COORDINATE = 0xFFFF;  ///< Voxels fora de 0..MAX_COORDINATE são ignorados
+
+private:
+    std::vector<Instance> instances;
+    std::vector<uint32_t> paletteColors;    ///< RGBA8 (r no byte menos significativo)
+    std::vector<glm::ivec3> chunkCoords;    ///< Chunks na ordem do buffer (z, y, x crescentes)
+    std::vector<size_t> chunkOffsets;       ///< Início de cada chunk no buffer (+ total no fim)
+    const VoxelGrid* sourceGrid;
+    uint64_t sourceRevision;
+    bool exposedOnly;
+    bool sourceExposedOnly;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    InstanceBuffer();
+
+    /**
+     * @brief Destrutor
+     */
+    ~InstanceBuffer() = default;
+
+    // Getters
+    const std::vector<Instance>& getInstances() const { return instances; }
+    const std::vector<uint32_t>& getPaletteColors() const { return paletteColors; }
+    size_t getInstanceCount() const { return instances.size(); }
+    const std::vector<glm::ivec3>& getChunkCoords() const { return chunkCoords; }
+    const std::vector<size_t>& getChunkOffsets() const { return chunkOffsets; }
+    bool getExposedOnly() const { return exposedOnly; }
+
+    // Setters
+    void setExposedOnly(bool enabled) { exposedOnly = enabled; }
+
+    /**
+     * @brief Remonta o buffer se o grid mudou desde a última chamada
+     * @param grid Grid de origem
+     * @return true se o buffer foi remontado (e precisa ser reenviado à GPU)
+     */
+    bool update(const VoxelGrid& grid);
+
+    /**
+     * @brief Monta o buffer a partir do grid
+     * @param grid Grid de origem
+     */
+    void build(const VoxelGrid& grid);
+
+    /**
+     * @brief Descarta as instâncias
+     */
+    void clear();
+
+    /**
+     * @brief Compacta um voxel
+     * @param position Posição local ao grid (0..MAX_COORDINATE)
+     * @param paletteIndex Índice na paleta
+     */
+    static Instance pack(const glm::ivec3& position, VoxelPalette::Index paletteIndex);
+
+    /**
+     * @brief Recupera a posição de uma instância
+     */
+    static glm::ivec3 unpackPosition(const Instance& instance);
+
+    /**
+     * @brief Compacta uma cor em RGBA8
+     */
+    static uint32_t packColor(const Voxel::Color& color);
+};
+
+} // namespace VoxelMaker
@@ -1,16 +1,168 @@
 #pragma once
 
+#include "../core/Voxel.hpp"
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
 namespace VoxelMaker {
 
 /**
  * @brief Gerencia geometria de malhas 3D
+ *
+ * Malha indexada de triângulos (sentido anti-horário visto de fora).
  */
 class Mesh {
+public:
+    /**
+     * @brief Vértice usado pelas malhas de voxels
+     */
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        Voxel::Color color;
+        float ao;           ///< Oclusão ambiente pré-calculada (0 = ocluído, 1 = livre)
+
+        Vertex() : position(0.0f), normal(0.0f), color(), ao(1.0f) {}
+        Vertex(const glm::vec3& pos, const glm::vec3& norm, const Voxel::Color& col, float occlusion = 1.0f)
+            : position(pos), normal(norm), color(col), ao(occlusion) {}
+    };
+
+    /**
+     * @brief Resultado de uma otimização de malha
+     */
+    struct OptimizeStats {
+        size_t verticesBefore;
+        size_t verticesAfter;
+        size_t clusterCount;    ///< Agrupamentos ordenados para reduzir overdraw
+        float acmrBefore;       ///< Misses médios do cache de vértices por triângulo
+        float acmrAfter;
+
+        OptimizeStats()
+            : verticesBefore(0)
+            , verticesAfter(0)
+            , clusterCount(0)
+            , acmrBefore(0.0f)
+            , acmrAfter(0.0f) {}
+    };
+
+    static constexpr size_t DEFAULT_CACHE_SIZE = 16;   ///< Cache pós-transformação típico (FIFO)
+
+private:
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+
 public:
     Mesh() = default;
     ~Mesh() = default;
-    
-    // TODO: Implementar funcionalidades
+
+    // Getters
+    const std::vector<Vertex>& getVertices() const { return vertices; }
+    const std::vector<uint32_t>& getIndices() const { return indices; }
+    size_t getVertexCount() const { return vertices.size(); }
+    size_t getIndexCount() const { return indices.size(); }
+    size_t getTriangleCount() const { return indices.size() / 3; }
+    bool isEmpty() const { return indices.empty(); }
+
+    /**
+     * @brief Remove toda a geometria (mantém a capacidade alocada)
+     */
+    void clear();
+
+    /**
+     * @brief Substitui a geometria por buffers já prontos (mantém a capacidade alocada)
+     * @param vertexData Vértices
+     * @param vertexCount Número de vértices
+     * @param indexData Índices (menores que vertexCount)
+     * @param indexCount Número de índices
+     */
+    void assign(const Vertex* vertexData, size_t vertexCount, const uint32_t* indexData, size_t indexCount);
+
+    /**
+     * @brief Reserva espaço para um número de quads
+     * @param quadCount Número de quads esperados
+     */
+    void reserveQuads(size_t quadCount);
+
+    /**
+     * @brief Adiciona um vértice
+     * @param vertex Vértice
+     * @return Índice do vértice adicionado
+     */
+    uint32_t addVertex(const Vertex& vertex);
+
+    /**
+     * @brief Adiciona um triângulo a partir de índices existentes
+     */
+    void addTriangle(uint32_t a, uint32_t b, uint32_t c);
+
+    /**
+     * @brief Adiciona um quad (4 vértices em sentido anti-horário)
+     * @param quad Vértices do quad
+     * @param flipDiagonal Se true, divide o quad pela diagonal 1-3 em vez de 0-2
+     */
+    void addQuad(const Vertex quad[4], bool flipDiagonal = false);
+
+    /**
+     * @brief Anexa outra malha a esta, deslocando os índices
+     * @param other Malha a anexar
+     */
+    void append(const Mesh& other);
+
+    /**
+     * @brief Calcula a caixa envolvente dos vértices
+     * @param minPos Canto mínimo (saída)
+     * @param maxPos Canto máximo (saída)
+     * @return false se a malha não tem vértices
+     */
+    bool computeBounds(glm::vec3& minPos, glm::vec3& maxPos) const;
+
+    /**
+     * @brief Executa todas as etapas de otimização em ordem
+     *
+     * Remove vértices duplicados, reordena os triângulos para o cache de vértices
+     * (Tipsify), ordena os agrupamentos resultantes para reduzir overdraw e, por fim,
+     * reordena os vértices pela ordem de primeiro uso.
+     *
+     * @param cacheSize Tamanho do cache de vértices simulado
+     * @return Estatísticas antes/depois
+     */
+    OptimizeStats optimize(size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief Funde vértices idênticos (bit a bit) e remapeia os índices
+     * @return Número de vértices removidos
+     */
+    size_t deduplicateVertices();
+
+    /**
+     * @brief Reordena os triângulos para localidade no cache de vértices (Tipsify)
+     * @param cacheSize Tamanho do cache de vértices
+     * @param clusters Saída opcional com o primeiro triângulo de cada agrupamento
+     */
+    void optimizeVertexCache(size_t cacheSize, std::vector<size_t>* clusters = nullptr);
+
+    /**
+     * @brief Ordena agrupamentos de triângulos de fora para dentro da malha
+     *
+     * Agrupamentos voltados para fora e distantes do centro são desenhados primeiro, de
+     * modo que ocultem os demais e o teste de profundidade descarte mais fragmentos.
+     *
+     * @param clusters Primeiro triângulo de cada agrupamento (crescente, começando em 0)
+     */
+    void optimizeOverdraw(const std::vector<size_t>& clusters);
+
+    /**
+     * @brief Reordena os vértices pela ordem em que os índices os usam
+     */
+    void optimizeVertexFetch();
+
+    /**
+     * @brief Calcula o ACMR (misses por triângulo) simulando um cache FIFO
+     * @param cacheSize Tamanho do cache de vértices
+     * @return ACMR (entre ~0.5 e 3.0; 0 para malhas vazias)
+     */
+    float computeACMR(size_t cacheSize = DEFAULT_CACHE_SIZE) const;
 };
 
-} // namespace VoxelMaker 
\ No newline at end of file
+} // namespace VoxelMaker
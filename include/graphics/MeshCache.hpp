@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "../core/VoxelPalette.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Cache em disco de malhas de chunk, com limite de tamanho e descarte LRU
+ *
+ * Um único arquivo de registros (cabeçalho, tipo, tamanho e CRC-32 do conteúdo, como o
+ * AutosaveJournal): cada registro de malha guarda a chave, a paleta com que a malha foi
+ * gerada e os buffers de vértices e índices da Mesh como estão na memória. A chave vem de
+ * quem gera as malhas (ChunkMeshManager: hashes de conteúdo do chunk e dos vizinhos,
+ * posição e configurações do mesher).
+ *
+ * As cores vêm da paleta, que só cresce enquanto os chunks existem: uma malha vale para
+ * qualquer paleta cujas primeiras paletteCount entradas tenham o mesmo hash
+ * (hashPalette). Só a tabela de registros fica em memória; o conteúdo é lido e conferido
+ * no load().
+ *
+ * A ordem de uso sobrevive entre execuções: registros novos vão para o fim, close()
+ * anexa as chaves usadas na sessão e a compactação reescreve os registros do menos para o
+ * mais recente. Passar de maxBytes descarta os menos usados até sobrar 3/4 do limite.
+ */
+class MeshCache {
+public:
+    static constexpr uint32_t CACHE_MAGIC = 0x434D4D56;        ///< "VMMC"
+    static constexpr uint32_t CACHE_VERSION = 1;
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 256ull * 1024 * 1024;
+    static constexpr uint64_t COMPACT_RATIO = 2;                ///< Compacta quando o arquivo passa de 2x o conteúdo vivo
+    static constexpr uint64_t MIN_COMPACT_BYTES = 4 * 1024 * 1024;
+
+    /**
+     * @brief Contadores desde open()
+     */
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t stale;           ///< Chave encontrada com outra paleta
+        size_t invalidated;     ///< Registros corrompidos descartados
+        size_t stored;
+        size_t evicted;         ///< Malhas descartadas pelo limite de tamanho
+        uint64_t bytesRead;
+        uint64_t bytesWritten;
+        uint64_t fileBytes;
+        uint64_t liveBytes;     ///< Registros ainda referenciados
+        size_t entries;
+        size_t compactions;
+        double loadMs;          ///< Soma dos tempos de load() com acerto (todas as threads)
+
+        Stats()
+            : hits(0)
+            , misses(0)
+            , stale(0)
+            , invalidated(0)
+            , stored(0)
+            , evicted(0)
+            , bytesRead(0)
+            , bytesWritten(0)
+            , fileBytes(0)
+            , liveBytes(0)
+            , entries(0)
+            , compactions(0)
+            , loadMs(0.0) {}
+    };
+
+private:
+    /**
+     * @brief Registro de malha no arquivo
+     */
+    struct Entry {
+        uint64_t offset;        ///< Início do registro (cabeçalho incluso)
+        uint32_t size;          ///< Bytes do registro, cabeçalho incluso
+        uint32_t paletteCount;
+        uint64_t paletteHash;
+        uint64_t lastUse;       ///< Relógio de uso (maior = mais recente)
+        bool touched;           ///< Usada desde o último registro de uso
+    };
+
+    std::string path;
+    std::FILE* file;
+    uint64_t fileBytes;
+    uint64_t liveBytes;
+    uint64_t maxBytes;
+    uint64_t useClock;
+    std::unordered_map<uint64_t, Entry> entries;
+    mutable std::mutex mutex;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    MeshCache();
+
+    /**
+     * @brief Destrutor (fecha o arquivo)
+     */
+    ~MeshCache();
+
+    MeshCache(const MeshCache&) = delete;
+    MeshCache& operator=(const MeshCache&) = delete;
+
+    // Getters
+    bool isOpen() const { return file != nullptr; }
+    const std::string& getPath() const { return path; }
+    uint64_t getMaxBytes() const { return maxBytes; }
+
+    /**
+     * @brief Obtém uma cópia dos contadores
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Abre ou cria o arquivo do cache (e o diretório dele)
+     * @param cachePath Caminho do arquivo
+     * @param limit Tamanho máximo do arquivo em bytes
+     * @return true se aberto
+     */
+    bool open(const std::string& cachePath, uint64_t limit = DEFAULT_MAX_BYTES);
+
+    /**
+     * @brief Registra as malhas usadas na sessão, compacta se preciso e fecha o arquivo
+     */
+    void close();
+
+    /**
+     * @brief Procura uma malha (seguro entre threads)
+     * @param key Chave da malha
+     * @param paletteHashes Hashes dos prefixos da paleta atual (hashPalette)
+     * @param out Malha de saída (só é alterada em caso de acerto)
+     * @return true se encontrada, gerada com uma paleta compatível e íntegra
+     */
+    bool load(uint64_t key, const std::vector<uint64_t>& paletteHashes, Mesh& out);
+
+    /**
+     * @brief Grava uma malha, substituindo a anterior com a mesma chave (seguro entre threads)
+     * @param key Chave da malha
+     * @param paletteCount Entradas da paleta existentes quando a malha foi gerada
+     * @param paletteHashes Hashes dos prefixos da paleta atual (hashPalette)
+     * @param mesh Malha
+     * @return true se gravada
+     */
+    bool store(uint64_t key, uint32_t paletteCount, const std::vector<uint64_t>& paletteHashes, const Mesh& mesh);
+
+    /**
+     * @brief Abre espaço para um lote de malhas, compactando no máximo uma vez
+     *
+     * Sem isso, cada store() que passa do limite reescreve o arquivo.
+     * @param bytes Soma de recordBytes das malhas do lote
+     */
+    void reserve(uint64_t bytes);
+
+    /**
+     * @brief Apaga todas as malhas
+     */
+    void clear();
+
+    /**
+     * @brief Bytes que uma malha ocupa no arquivo
+     */
+    static uint64_t recordBytes(const Mesh& mesh);
+
+    /**
+     * @brief Calcula o hash de cada prefixo da paleta (cor e estado sólido de cada entrada)
+     * @param palette Paleta
+     * @param prefixes Saída com palette.size() + 1 hashes (prefixes[n] cobre as n primeiras entradas)
+     */
+    static void hashPalette(const VoxelPalette& palette, std::vector<uint64_t>& prefixes);
+
+private:
+    /**
+     * @brief Lê a tabela de registros e descarta uma cauda incompleta
+     * @return false se o arquivo não é um cache válido
+     */
+    bool scan();
+
+    /**
+     * @brief Reescreve o arquivo só com as malhas mais recentes que cabem em target bytes
+     *
+     * Chamar com o mutex travado.
+     * @param target Tamanho máximo do arquivo reescrito
+     * @return true se reescrito
+     */
+    bool compact(uint64_t target);
+
+    /**
+     * @brief Anexa registros de uso das malhas lidas desde o último registro (mutex travado)
+     */
+    void appendTouches();
+};
+
+} // namespace VoxelMaker
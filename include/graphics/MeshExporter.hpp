@@ -0,0 +1,140 @@
+#pragma once
+
+#include "ChunkMeshManager.hpp"
+#include "Mesh.hpp"
+#include "../core/VoxelGrid.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Exportação da malha do grid para OBJ, PLY e glTF
+ *
+ * Os chunks são processados em lotes: as malhas de um lote são geradas em paralelo no
+ * pool de threads, os deslocamentos globais de índices saem de uma soma de prefixos das
+ * contagens de vértices e cada chunk é formatado (também em paralelo) no seu próprio
+ * buffer, que vai para o disco em ordem com uma única escrita vetorizada (writev) por
+ * lote. Os buffers ficam limitados ao lote, qualquer que seja o tamanho do modelo; os
+ * chunks preguiçosos decodificados para a exportação são liberados assim que nenhum lote
+ * seguinte os lê, então ficam em memória só as camadas de chunks em torno do lote atual.
+ *
+ * Quando o formato exige todos os vértices antes dos triângulos (faces do PLY, índices
+ * do glTF), os triângulos vão para um arquivo temporário ao lado da saída, anexado no
+ * final. Números são formatados à mão (sem iostream nem locale).
+ */
+class MeshExporter {
+public:
+    static constexpr size_t BATCH_CHUNKS = 32;      ///< Chunks gerados e gravados por lote
+
+    /**
+     * @brief Formato de saída
+     */
+    enum class Format {
+        OBJ,        ///< Texto: v x y z r g b, vn, f v//n (índices globais)
+        PLY,        ///< Binário (ordem de bytes da máquina, declarada no cabeçalho) com cor por vértice
+        GLTF        ///< .gltf (JSON) + .bin com posições, normais, cores e índices
+    };
+
+    /**
+     * @brief Configurações de exportação
+     */
+    struct Settings {
+        ChunkMeshManager::MeshingMode meshingMode;
+        bool bakeAmbientOcclusion;  ///< Multiplica a cor pela oclusão ambiente
+        bool weldVertices;          ///< Remove vértices duplicados de cada chunk
+        int decimals;               ///< Casas decimais nos formatos de texto
+
+        Settings()
+            : meshingMode(ChunkMeshManager::MeshingMode::BLOCKY)
+            , bakeAmbientOcclusion(true)
+            , weldVertices(true)
+            , decimals(4) {}
+    };
+
+    /**
+     * @brief Contadores da última exportação
+     */
+    struct Stats {
+        size_t chunks;
+        uint64_t vertices;
+        uint64_t triangles;
+        uint64_t bytes;
+        size_t batches;
+        size_t peakBatchBytes;      ///< Maior volume formatado em memória de uma vez
+        size_t releasedChunks;      ///< Chunks preguiçosos decodificados e liberados de novo
+        double meshingMs;
+        double formattingMs;
+        double writingMs;
+        double elapsedMs;
+
+        Stats()
+            : chunks(0)
+            , vertices(0)
+            , triangles(0)
+            , bytes(0)
+            , batches(0)
+            , peakBatchBytes(0)
+            , releasedChunks(0)
+            , meshingMs(0.0)
+            , formattingMs(0.0)
+            , writingMs(0.0)
+            , elapsedMs(0.0) {}
+    };
+
+private:
+    Settings settings;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor padrão
+     */
+    MeshExporter() = default;
+
+    /**
+     * @brief Construtor com configurações
+     * @param settings Configurações de exportação
+     */
+    explicit MeshExporter(const Settings& settings);
+
+    /**
+     * @brief Destrutor
+     */
+    ~MeshExporter() = default;
+
+    // Getters
+    const Settings& getSettings() const { return settings; }
+    const Stats& getStats() const { return stats; }
+
+    // Setters
+    void setSettings(const Settings& newSettings) { settings = newSettings; }
+
+    /**
+     * @brief Exporta a malha do grid
+     * @param grid Grid de voxels (chunks preguiçosos voltam a ser liberados depois de lidos)
+     * @param path Caminho do arquivo (para glTF, o .bin é gravado ao lado)
+     * @param format Formato de saída
+     * @return true se exportado
+     */
+    bool exportGrid(VoxelGrid& grid, const std::string& path, Format format);
+
+    /**
+     * @brief Exporta escolhendo o formato pela extensão (.obj, .ply ou .gltf)
+     * @param grid Grid de voxels
+     * @param path Caminho do arquivo
+     * @return true se exportado
+     */
+    bool exportGrid(VoxelGrid& grid, const std::string& path);
+
+    /**
+     * @brief Deduz o formato pela extensão do caminho
+     * @param path Caminho do arquivo
+     * @param format Formato encontrado
+     * @return true se a extensão é conhecida
+     */
+    static bool formatFromPath(const std::string& path, Format& format);
+};
+
+} // namespace VoxelMaker
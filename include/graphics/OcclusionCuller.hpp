@@ -0,0 +1,196 @@
+#pragma once
+
+#include "FrustumCuller.hpp"
+#include "../core/VoxelGrid.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Descarte por oclusão em CPU com um buffer de profundidade hierárquico (Hi-Z)
+ *
+ * Os chunks mais próximos contribuem com grandes quads oclusores (retângulos de faces de
+ * voxels sólidos, extraídos uma vez por revisão do chunk). Os quads são rasterizados de
+ * forma conservadora em um buffer de profundidade de baixa resolução: só pixels cobertos
+ * por inteiro são escritos, com a maior profundidade do quad. Em seguida é montada
+ * uma pirâmide de máximos e a caixa de cada chunk é comparada com o nível cujo texel
+ * cobre a projeção da caixa em poucos passos.
+ *
+ * Não depende de OpenGL; a profundidade segue a convenção do OpenGL (0 = perto, 1 = longe).
+ */
+class OcclusionCuller {
+public:
+    /**
+     * @brief Configurações do descarte
+     */
+    struct Settings {
+        int width;                  ///< Largura do buffer de profundidade (arredondada para múltiplo de 4)
+        int height;
+        size_t maxOccluderChunks;   ///< Quantos chunks próximos contribuem com oclusores
+        int minOccluderArea;        ///< Área mínima (em faces de voxel) de um quad oclusor
+
+        Settings()
+            : width(256)
+            , height(128)
+            , maxOccluderChunks(32)
+            , minOccluderArea(64) {}
+    };
+
+    /**
+     * @brief Quad oclusor (4 cantos em sentido qualquer, coordenadas locais ao chunk)
+     */
+    struct Occluder {
+        glm::vec3 corners[4];
+    };
+
+    /**
+     * @brief Contadores do último descarte
+     */
+    struct Stats {
+        size_t chunksTested;
+        size_t chunksCulled;
+        size_t occludersRasterized;
+        double lastCullMs;
+
+        Stats()
+            : chunksTested(0)
+            , chunksCulled(0)
+            , occludersRasterized(0)
+            , lastCullMs(0.0) {}
+
+        /**
+         * @brief Fração dos chunks testados que foi descartada
+         */
+        float getCullRate() const {
+            return chunksTested > 0 ? static_cast<float>(chunksCulled) / static_cast<float>(chunksTested) : 0.0f;
+        }
+    };
+
+private:
+    /**
+     * @brief Oclusores de um chunk e a revisão usada para extraí-los
+     */
+    struct CachedOccluders {
+        uint64_t revision;
+        std::vector<Occluder> occluders;
+
+        CachedOccluders() : revision(~static_cast<uint64_t>(0)), occluders() {}
+    };
+
+    Settings settings;
+    glm::mat4 viewProjection;
+    std::vector<std::vector<float>> levels;    ///< Nível 0 = buffer de profundidade, depois máximos 2x2
+    std::vector<int> levelWidths;
+    std::vector<int> levelHeights;
+    std::unordered_map<glm::ivec3, CachedOccluders, Vec3Hash> occluderCache;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor padrão
+     */
+    OcclusionCuller();
+
+    /**
+     * @brief Construtor com configurações
+     * @param settings Configurações do descarte
+     */
+    explicit OcclusionCuller(const Settings& settings);
+
+    /**
+     * @brief Destrutor
+     */
+    ~OcclusionCuller() = default;
+
+    // Getters
+    const Settings& getSettings() const { return settings; }
+    const Stats& getStats() const { return stats; }
+    int getWidth() const { return levelWidths[0]; }
+    int getHeight() const { return levelHeights[0]; }
+    size_t getLevelCount() const { return levels.size(); }
+    const std::vector<float>& getDepth(size_t level = 0) const { return levels[level]; }
+
+    // Setters
+    void setSettings(const Settings& newSettings);
+
+    /**
+     * @brief Inicia um quadro: guarda a matriz e limpa a profundidade
+     * @param viewProjectionMatrix Matriz projeção * view
+     */
+    void beginFrame(const glm::mat4& viewProjectionMatrix);
+
+    /**
+     * @brief Rasteriza um quad oclusor no buffer de profundidade
+     * @param occluder Quad
+     * @param offset Deslocamento aplicado aos cantos (origem mundial do chunk)
+     * @return false se o quad foi ignorado (atrás do plano próximo ou fora da tela)
+     */
+    bool rasterizeOccluder(const Occluder& occluder, const glm::vec3& offset);
+
+    /**
+     * @brief Monta a pirâmide de máximos a partir do buffer de profundidade
+     */
+    void buildHierarchy();
+
+    /**
+     * @brief Testa uma caixa contra a pirâmide (requer buildHierarchy)
+     * @param boxMin Canto mínimo no espaço mundial
+     * @param boxMax Canto máximo no espaço mundial
+     * @return true se a caixa pode estar visível
+     */
+    bool testBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+    /**
+     * @brief Remove os chunks ocultos de uma lista ordenada da frente para trás
+     *
+     * Executa o quadro completo: limpa a profundidade, rasteriza os oclusores dos
+     * primeiros chunks, monta a pirâmide e testa todas as caixas.
+     *
+     * @param grid Grid de origem dos oclusores
+     * @param viewProjectionMatrix Matriz projeção * view
+     * @param chunks Lista de chunks visíveis (filtrada no lugar, ordem preservada)
+     */
+    void cullChunks(const VoxelGrid& grid,
+                    const glm::mat4& viewProjectionMatrix,
+                    std::vector<FrustumCuller::VisibleChunk>& chunks);
+
+    /**
+     * @brief Extrai os quads oclusores de um chunk
+     *
+     * Para cada eixo, os planos entre camadas de voxels são reduzidos a retângulos onde
+     * algum dos lados é sólido (esses pontos estão na face de um voxel, logo são opacos).
+     * São mantidos o maior retângulo do plano mais baixo e do plano mais alto de cada eixo.
+     *
+     * @param chunk Chunk de origem
+     * @param palette Paleta do grid (só entradas sólidas ocluem, como no ChunkMesher)
+     * @param minArea Área mínima em faces de voxel
+     * @param out Quads em coordenadas locais (é limpo antes)
+     */
+    static void extractOccluders(const VoxelChunk& chunk,
+                                 const VoxelPalette& palette,
+                                 int minArea,
+                                 std::vector<Occluder>& out);
+
+    /**
+     * @brief Descarta os oclusores guardados
+     */
+    void clearCache() { occluderCache.clear(); }
+
+private:
+    /**
+     * @brief Rasteriza um quadrilátero convexo já em coordenadas de tela
+     * @param corners Vértices em ordem ao redor do quad (x, y em pixels)
+     * @param depth Profundidade conservadora escrita nos pixels cobertos
+     */
+    void rasterizeQuad(const glm::vec2 (&corners)[4], float depth);
+
+    /**
+     * @brief Aloca os níveis da pirâmide para a resolução configurada
+     */
+    void allocateLevels();
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "InstanceBuffer.hpp"
+#include "Mesh.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Tipo de comando de renderização
+ */
+enum class RenderCommandType : uint8_t {
+    RELEASE_CHUNK,      ///< Descarta a cópia na GPU de um chunk removido ou sem triângulos
+    DRAW_CHUNK,         ///< Malha de um chunk
+    DRAW_INSTANCED,     ///< Voxels instanciados
+    DRAW_GRID,          ///< Grid de referência
+    DRAW_AXES           ///< Eixos de coordenadas
+};
+
+/**
+ * @brief Dados novos do caminho instanciado (enviados só quando mudam)
+ */
+struct InstanceUpload {
+    std::vector<InstanceBuffer::Instance> instances;
+    std::vector<uint32_t> paletteColors;
+};
+
+/**
+ * @brief Comando gravado na thread principal e executado na thread de renderização
+ *
+ * Os comandos não apontam para dados da thread principal: tudo o que muda entre quadros
+ * (malhas refeitas, instâncias) segue como dado imutável compartilhado, e o restante é
+ * referenciado pela cópia que a thread de renderização já mantém na GPU.
+ */
+struct RenderCommand {
+    uint64_t sortKey;
+    RenderCommandType type;
+    glm::ivec3 chunkCoord;
+    uint64_t version;                                   ///< Versão dos dados desenhados
+    std::shared_ptr<const Mesh> mesh;                   ///< Malha nova (nullptr = reutilizar a da GPU)
+    std::shared_ptr<const InstanceUpload> instances;    ///< Instâncias novas (nullptr = reutilizar)
+
+    RenderCommand()
+        : sortKey(0)
+        , type(RenderCommandType::DRAW_CHUNK)
+        , chunkCoord(0)
+        , version(0)
+        , mesh(nullptr)
+        , instances(nullptr) {}
+};
+
+/**
+ * @brief Lista de comandos de um quadro, ordenável por chave
+ *
+ * A chave de 64 bits é, do bit mais alto para o mais baixo: camada (4 bits), shader
+ * (8 bits), material (16 bits) e profundidade quantizada (24 bits). Ordenar pela chave
+ * agrupa os comandos por shader e material (poucas trocas de estado) e, dentro de cada
+ * grupo, desenha da frente para trás.
+ */
+class RenderCommandList {
+public:
+    /**
+     * @brief Estado do quadro capturado no momento da gravação
+     */
+    struct FrameState {
+        glm::mat4 viewProjection;
+        glm::vec3 cameraPosition;
+        glm::vec3 gridOrigin;
+        glm::vec4 clearColor;
+        float farPlane;
+        bool lighting;
+        bool wireframe;
+
+        FrameState()
+            : viewProjection(1.0f)
+            , cameraPosition(0.0f)
+            , gridOrigin(0.0f)
+            , clearColor(0.2f, 0.3f, 0.3f, 1.0f)
+            , farPlane(1000.0f)
+            , lighting(true)
+            , wireframe(false) {}
+    };
+
+    // Camadas (executadas em ordem)
+    static constexpr uint8_t LAYER_SETUP = 0;       ///< Liberação de recursos
+    static constexpr uint8_t LAYER_OPAQUE = 1;
+    static constexpr uint8_t LAYER_OVERLAY = 2;     ///< Grid e eixos
+
+    // Shaders
+    static constexpr uint8_t SHADER_NONE = 0;
+    static constexpr uint8_t SHADER_CHUNK = 1;
+    static constexpr uint8_t SHADER_INSTANCED = 2;
+    static constexpr uint8_t SHADER_LINES = 3;
+
+    static constexpr uint32_t DEPTH_BITS = 24;
+
+private:
+    FrameState frameState;
+    std::vector<RenderCommand> commands;
+    bool sorted;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    RenderCommandList();
+
+    /**
+     * @brief Destrutor
+     */
+    ~RenderCommandList() = default;
+
+    // Getters
+    const FrameState& getFrameState() const { return frameState; }
+    const std::vector<RenderCommand>& getCommands() const { return commands; }
+    size_t size() const { return commands.size(); }
+    bool isEmpty() const { return commands.empty(); }
+    bool isSorted() const { return sorted; }
+
+    // Setters
+    void setFrameState(const FrameState& state) { frameState = state; }
+
+    /**
+     * @brief Remove os comandos (mantém a capacidade alocada)
+     */
+    void clear();
+
+    /**
+     * @brief Adiciona um comando
+     * @param command Comando
+     */
+    void push(const RenderCommand& command);
+
+    /**
+     * @brief Ordena os comandos pela chave (estável)
+     */
+    void sort();
+
+    /**
+     * @brief Conta as trocas de shader ou material na ordem atual
+     * @return Número de trocas de estado
+     */
+    size_t countStateChanges() const;
+
+    /**
+     * @brief Monta uma chave de ordenação
+     * @param layer Camada
+     * @param shader Shader
+     * @param material Material
+     * @param depth Profundidade normalizada (0 = perto, 1 = longe)
+     * @param backToFront true para inverter a ordem de profundidade (transparência)
+     * @return Chave de 64 bits
+     */
+    static uint64_t makeSortKey(uint8_t layer, uint8_t shader, uint16_t material,
+                                float depth, bool backToFront = false);
+
+    /**
+     * @brief Extrai o shader de uma chave
+     */
+    static uint8_t shaderOf(uint64_t sortKey) { return static_cast<uint8_t>(sortKey >> 52); }
+
+    /**
+     * @brief Extrai o material de uma chave
+     */
+    static uint16_t materialOf(uint64_t sortKey) { return static_cast<uint16_t>(sortKey >> 36); }
+};
+
+} // namespace VoxelMaker
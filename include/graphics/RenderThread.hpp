@@ -0,0 +1,113 @@
+#pragma once
+
+#include "RenderCommand.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Thread dona do contexto OpenGL que executa as listas de comandos
+ *
+ * A thread principal grava o quadro N+1 enquanto esta thread executa o quadro N. Há no
+ * máximo uma lista pendente: submit troca a lista gravada pela vaga pendente e só
+ * bloqueia se a thread de renderização ainda não pegou o quadro anterior, o que limita
+ * a latência a um quadro. As listas trocam de dono por swap, então a memória dos
+ * comandos é reaproveitada entre quadros.
+ */
+class RenderThread {
+public:
+    using ContextFunction = std::function<void()>;
+    using ExecuteFunction = std::function<void(RenderCommandList&)>;
+
+    /**
+     * @brief Estatísticas de execução
+     */
+    struct Stats {
+        uint64_t framesSubmitted;
+        uint64_t framesExecuted;
+        double lastExecuteMs;       ///< Tempo da última execução (thread de renderização)
+        double lastSubmitWaitMs;    ///< Tempo que a thread principal esperou no último submit
+
+        Stats()
+            : framesSubmitted(0)
+            , framesExecuted(0)
+            , lastExecuteMs(0.0)
+            , lastSubmitWaitMs(0.0) {}
+    };
+
+private:
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    RenderCommandList pending;
+    RenderCommandList executing;    ///< Só acessada pela thread de renderização
+    bool hasPending;
+    bool busy;
+    bool stopping;
+    bool running;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    RenderThread();
+
+    /**
+     * @brief Destrutor (para a thread se estiver rodando)
+     */
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+     * @brief Inicia a thread de renderização
+     * @param onStart Executada na nova thread antes do primeiro quadro (ativar o contexto)
+     * @param execute Executa uma lista (desenho e troca de buffers)
+     * @param onStop Executada na thread antes de terminar (liberar o contexto)
+     * @return true se iniciada
+     */
+    bool start(ContextFunction onStart, ExecuteFunction execute, ContextFunction onStop);
+
+    /**
+     * @brief Entrega uma lista gravada para execução
+     *
+     * Ao retornar, list contém uma lista vazia que pode ser gravada em seguida.
+     *
+     * @param list Lista gravada
+     */
+    void submit(RenderCommandList& list);
+
+    /**
+     * @brief Aguarda até que todas as listas entregues tenham sido executadas
+     */
+    void waitIdle();
+
+    /**
+     * @brief Executa as listas pendentes e encerra a thread
+     */
+    void stop();
+
+    /**
+     * @brief Verifica se a thread está rodando
+     */
+    bool isRunning() const { return running; }
+
+    /**
+     * @brief Obtém uma cópia das estatísticas
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Laço principal da thread de renderização
+     */
+    void renderLoop(ContextFunction onStart, ExecuteFunction execute, ContextFunction onStop);
+};
+
+} // namespace VoxelMaker
@@ -2,14 +2,29 @@
 
 #include "../core/VoxelGrid.hpp"
 #include "Camera.hpp"
+#include "ChunkMeshManager.hpp"
+#include "FrustumCuller.hpp"
+#include "GpuUploadManager.hpp"
+#include "InstanceBuffer.hpp"
+#include "OcclusionCuller.hpp"
+#include "RenderCommand.hpp"
 #include "Shader.hpp"
+#include "UniformBuffer.hpp"
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace VoxelMaker {
 
 /**
  * @brief Gerencia a renderização dos voxels
+ *
+ * O trabalho é dividido em dois lados. A gravação (record*) roda na thread principal:
+ * atualiza malhas, faz o descarte e grava comandos em uma RenderCommandList. A execução
+ * (execute) roda na thread dona do contexto OpenGL: ordena a lista, envia os dados novos
+ * e desenha. As funções render* gravam e executam em seguida, na mesma thread.
  */
 class Renderer {
 public:
@@ -22,13 +37,51 @@ public:
         bool showAxes;
         bool enableLighting;
         float voxelSize;
+        size_t uploadBudget;        ///< Bytes de malhas enviados por quadro (0 = sem limite)
         
         RenderSettings() 
             : wireframeMode(false)
             , showGrid(true)
             , showAxes(true)
             , enableLighting(true)
-            , voxelSize(1.0f) {}
+            , voxelSize(1.0f)
+            , uploadBudget(0) {}
+    };
+
+    /**
+     * @brief Contadores do último recordVoxelGrid
+     */
+    struct RecordStats {
+        size_t chunksRecorded;
+        size_t uploadsQueued;
+        size_t uploadsDeferred;     ///< Malhas novas adiadas pelo orçamento de envio
+        size_t bytesQueued;
+
+        RecordStats()
+            : chunksRecorded(0)
+            , uploadsQueued(0)
+            , uploadsDeferred(0)
+            , bytesQueued(0) {}
+    };
+
+    /**
+     * @brief Estatísticas da última lista executada
+     */
+    struct ExecuteStats {
+        size_t commandCount;
+        size_t stateChanges;        ///< Trocas de shader ou material
+        size_t chunksDrawn;
+        size_t trianglesDrawn;
+        size_t chunksUploaded;
+        size_t bytesUploaded;
+
+        ExecuteStats()
+            : commandCount(0)
+            , stateChanges(0)
+            , chunksDrawn(0)
+            , trianglesDrawn(0)
+            , chunksUploaded(0)
+            , bytesUploaded(0) {}
     };
 
 private:
@@ -36,13 +89,35 @@ private:
     std::shared_ptr<Shader> voxelShader;
     std::shared_ptr<Shader> gridShader;
     std::shared_ptr<Shader> axesShader;
+    std::shared_ptr<Shader> instanceShader;
     
     RenderSettings settings;
+    ChunkMeshManager meshManager;
+    FrustumCuller frustumCuller;
+    OcclusionCuller occlusionCuller;
+    std::vector<FrustumCuller::VisibleChunk> visibleChunks;    ///< Chunks visíveis no último quadro
+    InstanceBuffer instanceBuffer;
+
+    // Lado da gravação (thread principal)
+    std::unordered_map<glm::ivec3, uint64_t, Vec3Hash> submittedVersions;    ///< Versão da malha já enviada por chunk
+    uint64_t instanceVersion;
+    RenderCommandList immediateList;    ///< Lista usada pelas funções render*
+    RecordStats recordStats;
+
+    // Lado da execução (thread do contexto OpenGL)
+    GpuUploadManager uploadManager;
+    UniformBuffer frameUniforms;        ///< Câmera e iluminação do quadro (bloco FrameData)
+    std::unordered_map<glm::ivec3, GpuUploadManager::Allocation, Vec3Hash> gpuMeshes;
+    size_t gpuInstanceCount;
+    mutable std::mutex executeStatsMutex;
+    ExecuteStats executeStats;
     
     // OpenGL buffers
     unsigned int voxelVAO, voxelVBO, voxelEBO;
     unsigned int gridVAO, gridVBO;
     unsigned int axesVAO, axesVBO;
+    unsigned int instanceVBO;
+    unsigned int paletteBuffer, paletteTexture;    ///< Cores da paleta (texture buffer RGBA8)
     
     bool initialized;
 
@@ -74,12 +149,66 @@ public:
      */
     void setCamera(std::shared_ptr<Camera> cam) { camera = cam; }
 
+    /**
+     * @brief Inicia a gravação de um quadro (captura câmera e configurações)
+     * @param list Lista a ser gravada (é esvaziada)
+     */
+    void beginFrame(RenderCommandList& list);
+
+    /**
+     * @brief Grava o desenho de um grid de voxels (malhas por chunk)
+     *
+     * Atualiza as malhas alteradas, descarta os chunks invisíveis e grava um comando por
+     * chunk visível. Só malhas refeitas desde o último envio seguem no comando, da frente
+     * para trás até o orçamento de envio; as demais seguem nos próximos quadros e, até lá,
+     * o chunk é desenhado com a cópia anterior.
+     *
+     * @param grid Grid a ser desenhado
+     * @param list Lista de destino
+     */
+    void recordVoxelGrid(const VoxelGrid& grid, RenderCommandList& list);
+
+    /**
+     * @brief Grava o desenho instanciado de um grid (um cubo por voxel)
+     * @param grid Grid a ser desenhado
+     * @param list Lista de destino
+     */
+    void recordVoxelGridInstanced(const VoxelGrid& grid, RenderCommandList& list);
+
+    /**
+     * @brief Grava o desenho do grid de referência
+     * @param list Lista de destino
+     */
+    void recordGrid(RenderCommandList& list);
+
+    /**
+     * @brief Grava o desenho dos eixos de coordenadas
+     * @param list Lista de destino
+     */
+    void recordAxes(RenderCommandList& list);
+
+    /**
+     * @brief Ordena e executa uma lista (na thread dona do contexto OpenGL)
+     * @param list Lista gravada
+     */
+    void execute(RenderCommandList& list);
+
     /**
      * @brief Renderiza um grid de voxels
      * @param grid Grid a ser renderizado
      */
     void renderVoxelGrid(const VoxelGrid& grid);
 
+    /**
+     * @brief Renderiza um grid com um cubo instanciado por voxel (uma chamada de desenho)
+     *
+     * Alternativa às malhas para grids pequenos que mudam a cada quadro (prévias,
+     * seleções, fantasmas de pincel). Usa apenas recursos do OpenGL 3.3 core.
+     *
+     * @param grid Grid a ser renderizado
+     */
+    void renderVoxelGridInstanced(const VoxelGrid& grid);
+
     /**
      * @brief Renderiza um voxel individual
      * @param voxel Voxel a ser renderizado
@@ -114,6 +243,54 @@ public:
      */
     bool isInitialized() const { return initialized; }
 
+    /**
+     * @brief Obtém o gerenciador de malhas por chunk
+     * @return Gerenciador de malhas
+     */
+    ChunkMeshManager& getMeshManager() { return meshManager; }
+
+    /**
+     * @brief Obtém o buffer de instâncias do caminho instanciado
+     * @return Buffer de instâncias
+     */
+    InstanceBuffer& getInstanceBuffer() { return instanceBuffer; }
+
+    /**
+     * @brief Obtém o descarte por frustum (contadores do último quadro)
+     * @return Descarte por frustum
+     */
+    const FrustumCuller& getFrustumCuller() const { return frustumCuller; }
+
+    /**
+     * @brief Obtém o descarte por oclusão (contadores do último quadro)
+     * @return Descarte por oclusão
+     */
+    OcclusionCuller& getOcclusionCuller() { return occlusionCuller; }
+
+    /**
+     * @brief Obtém os chunks visíveis do último quadro, da frente para trás
+     * @return Lista de chunks visíveis
+     */
+    const std::vector<FrustumCuller::VisibleChunk>& getVisibleChunks() const { return visibleChunks; }
+
+    /**
+     * @brief Obtém os contadores da última gravação do grid
+     * @return Contadores
+     */
+    const RecordStats& getRecordStats() const { return recordStats; }
+
+    /**
+     * @brief Obtém as estatísticas da última lista executada (seguro entre threads)
+     * @return Cópia das estatísticas
+     */
+    ExecuteStats getExecuteStats() const;
+
+    /**
+     * @brief Obtém o gerenciador de envio das malhas (usar apenas na thread do contexto)
+     * @return Gerenciador de envio
+     */
+    GpuUploadManager& getUploadManager() { return uploadManager; }
+
 private:
     /**
      * @brief Inicializa os shaders
@@ -142,6 +319,24 @@ private:
      */
     void createAxesGeometry();
 
+    /**
+     * @brief Envia as instâncias e a paleta para a GPU
+     * @param data Instâncias e cores da paleta
+     */
+    void uploadInstances(const InstanceUpload& data);
+
+    /**
+     * @brief Libera a cópia na GPU de um chunk
+     * @param chunkCoord Coordenada do chunk
+     */
+    void releaseChunkMesh(const glm::ivec3& chunkCoord);
+
+    /**
+     * @brief Ativa um shader (os uniforms do quadro já estão no bloco FrameData)
+     * @param shader Identificador do shader (RenderCommandList::SHADER_*)
+     */
+    void bindShader(uint8_t shader);
+
     /**
      * @brief Atualiza as matrizes de transformação
      */
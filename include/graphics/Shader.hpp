@@ -1,11 +1,40 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace VoxelMaker {
 
+/**
+ * @brief Identificador de uniform com hash FNV-1a calculado em tempo de compilação
+ *
+ * Declarado uma vez como constexpr (ex.: constexpr UniformId U_COLOR("uColor")), evita
+ * montar e fazer hash de std::string a cada chamada de set*: a busca da localização compara
+ * o hash e, para descartar colisões, o ponteiro do nome (ou o texto, se o ponteiro diferir).
+ */
+struct UniformId {
+    uint32_t hash;
+    const char* name;
+
+    constexpr explicit UniformId(const char* uniformName)
+        : hash(fnv1a(uniformName))
+        , name(uniformName) {}
+
+    /**
+     * @brief Hash FNV-1a de 32 bits
+     */
+    static constexpr uint32_t fnv1a(const char* text) {
+        uint32_t value = 2166136261u;
+        for (; *text; ++text) {
+            value = (value ^ static_cast<uint8_t>(*text)) * 16777619u;
+        }
+        return value;
+    }
+};
+
 /**
  * @brief Gerencia shaders OpenGL
  */
@@ -13,6 +42,16 @@ class Shader {
 private:
     unsigned int programID;
     std::unordered_map<std::string, int> uniformLocations;
+    /**
+     * @brief Localização em cache de um UniformId (o nome desfaz colisões de hash)
+     */
+    struct HashedLocation {
+        uint32_t hash;
+        const char* name;
+        int location;
+    };
+
+    std::vector<HashedLocation> hashedLocations;
     bool compiled;
 
 public:
@@ -108,6 +147,77 @@ public:
      */
     void setMat4(const std::string& name, const glm::mat4& value);
 
+    /**
+     * @brief Define um uniform float
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setFloat(const UniformId& id, float value);
+
+    /**
+     * @brief Define um uniform int
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setInt(const UniformId& id, int value);
+
+    /**
+     * @brief Define um uniform bool
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setBool(const UniformId& id, bool value);
+
+    /**
+     * @brief Define um uniform vec2
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setVec2(const UniformId& id, const glm::vec2& value);
+
+    /**
+     * @brief Define um uniform vec3
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setVec3(const UniformId& id, const glm::vec3& value);
+
+    /**
+     * @brief Define um uniform vec4
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setVec4(const UniformId& id, const glm::vec4& value);
+
+    /**
+     * @brief Define um uniform mat3
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setMat3(const UniformId& id, const glm::mat3& value);
+
+    /**
+     * @brief Define um uniform mat4
+     * @param id Identificador do uniform
+     * @param value Valor
+     */
+    void setMat4(const UniformId& id, const glm::mat4& value);
+
+    /**
+     * @brief Liga um bloco de uniforms (std140) a um ponto de ligação de UBO
+     * @param blockName Nome do bloco no shader
+     * @param bindingPoint Ponto de ligação (o mesmo usado pelo UniformBuffer)
+     * @return true se o bloco existe no programa
+     */
+    bool bindUniformBlock(const char* blockName, unsigned int bindingPoint);
+
+    /**
+     * @brief Obtém a localização de um uniform (consultada uma vez e mantida em cache)
+     * @param id Identificador do uniform
+     * @return Localização (-1 se não existir)
+     */
+    int getUniformLocation(const UniformId& id);
+
     /**
      * @brief Obtém o ID do programa
      * @return ID do programa
@@ -128,6 +238,12 @@ private:
      */
     int getUniformLocation(const std::string& name);
 
+    /**
+     * @brief Substitui o programa atual por um programa já linkado
+     * @param program ID do novo programa
+     */
+    void adoptProgram(unsigned int program);
+
     /**
      * @brief Compila um shader individual
      * @param source Código fonte
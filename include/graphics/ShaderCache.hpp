@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Cache em disco de binários de programas OpenGL (glGetProgramBinary)
+ *
+ * A chave combina o hash dos fontes GLSL com o hash do driver (fornecedor, renderer e
+ * versão): trocar o shader ou atualizar o driver gera outra chave. Um binário que o
+ * driver recusa (link falha ao carregar) é apagado e o programa é compilado a partir do
+ * fonte, como se não houvesse cache. Binários de outros drivers nunca seriam lidos de
+ * novo: são apagados ao definir o diretório (com contexto ativo) ou na primeira gravação.
+ * Requer OpenGL 4.1 ou ARB_get_program_binary; sem suporte o cache fica inativo.
+ */
+class ShaderCache {
+public:
+    /**
+     * @brief Estatísticas desde o início da execução
+     */
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t invalidated;     ///< Binários recusados pelo driver ou corrompidos
+        size_t stored;
+        size_t pruned;          ///< Binários de outros drivers apagados
+        size_t compiles;        ///< Programas compilados a partir do fonte
+        double loadMs;          ///< Tempo criando programas a partir do cache
+        double compileMs;       ///< Tempo compilando programas a partir do fonte
+
+        Stats()
+            : hits(0)
+            , misses(0)
+            , invalidated(0)
+            , stored(0)
+            , pruned(0)
+            , compiles(0)
+            , loadMs(0.0)
+            , compileMs(0.0) {}
+    };
+
+    static constexpr uint32_t FILE_MAGIC = 0x42534D56;     ///< "VMSB"
+    static constexpr uint32_t FILE_VERSION = 1;
+
+private:
+    std::string directory;      ///< Vazio = cache desativado
+    uint64_t prunedDriver;      ///< Driver já usado para limpar o diretório (0 = nenhum)
+    mutable std::mutex mutex;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    ShaderCache();
+
+    /**
+     * @brief Destrutor
+     */
+    ~ShaderCache() = default;
+
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    /**
+     * @brief Obtém a instância compartilhada pela aplicação
+     * @return Cache global
+     */
+    static ShaderCache& getInstance();
+
+    /**
+     * @brief Define o diretório do cache (criado se não existir)
+     *
+     * Com um contexto OpenGL ativo, apaga os binários gerados por outros drivers.
+     * @param path Diretório (vazio desativa o cache)
+     * @return true se o diretório pode ser usado
+     */
+    bool setDirectory(const std::string& path);
+
+    /**
+     * @brief Obtém o diretório do cache
+     */
+    std::string getDirectory() const;
+
+    /**
+     * @brief Verifica se o cache está ativo e o contexto atual suporta binários de programa
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Tenta criar um programa a partir do cache
+     * @param program Programa já criado (glCreateProgram), sem shaders anexados
+     * @param vertexSource Fonte do vertex shader
+     * @param fragmentSource Fonte do fragment shader
+     * @return true se o binário foi carregado e o programa está linkado
+     */
+    bool load(unsigned int program, const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * @brief Pede ao driver que mantenha o binário do programa (chamar antes de linkar)
+     * @param program Programa ainda não linkado
+     */
+    void prepareForStore(unsigned int program) const;
+
+    /**
+     * @brief Grava o binário de um programa recém-linkado
+     * @param program Programa linkado com GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+     * @param vertexSource Fonte do vertex shader
+     * @param fragmentSource Fonte do fragment shader
+     * @return true se gravado
+     */
+    bool store(unsigned int program, const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * @brief Registra o tempo de uma compilação a partir do fonte
+     * @param milliseconds Duração
+     */
+    void recordCompile(double milliseconds);
+
+    /**
+     * @brief Apaga todos os binários do diretório
+     */
+    void clear();
+
+    /**
+     * @brief Obtém uma cópia das estatísticas
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Hash FNV-1a de 64 bits
+     * @param data Dados
+     * @param size Tamanho em bytes
+     * @param seed Valor inicial (para encadear)
+     */
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+private:
+    /**
+     * @brief Hash do driver atual (fornecedor, renderer e versão)
+     * @return Hash, ou 0 sem contexto OpenGL ativo
+     */
+    static uint64_t driverHash();
+
+    /**
+     * @brief Apaga os binários (e temporários) de drivers diferentes do atual
+     * @param driver Hash do driver atual
+     */
+    void pruneForeign(uint64_t driver);
+
+    /**
+     * @brief Caminho do arquivo de uma chave
+     */
+    std::string pathFor(uint64_t sourceHash, uint64_t driver) const;
+};
+
+} // namespace VoxelMaker
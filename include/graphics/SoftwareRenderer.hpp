@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Camera.hpp"
+#include "Image.hpp"
+#include "../core/VoxelGrid.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Renderização do grid em CPU, sem OpenGL (miniaturas e prévias em servidores)
+ *
+ * Cada pixel lança um raio que percorre o grid com DDA em dois níveis: chunks vazios ou
+ * ausentes são atravessados de uma vez e só chunks com conteúdo são percorridos voxel a
+ * voxel. O sombreamento usa luz direcional com sombra (um raio extra por pixel), oclusão
+ * ambiente a partir das células vizinhas da face atingida e a cor da paleta.
+ *
+ * A imagem é dividida em blocos quadrados processados em paralelo pelo ThreadPool. A
+ * câmera segue as mesmas convenções do Renderer (perspectiva ou ortográfica).
+ */
+class SoftwareRenderer {
+public:
+    /**
+     * @brief Configurações da renderização
+     */
+    struct Settings {
+        int tileSize;               ///< Lado dos blocos distribuídos entre as threads
+        glm::vec3 lightDirection;   ///< Direção em que a luz viaja
+        glm::vec3 backgroundColor;
+        float ambient;              ///< Fração da luz que não depende da direção
+        bool shadows;
+        bool ambientOcclusion;
+
+        Settings()
+            : tileSize(32)
+            , lightDirection(-0.4f, -1.0f, -0.3f)
+            , backgroundColor(0.2f, 0.3f, 0.3f)
+            , ambient(0.35f)
+            , shadows(true)
+            , ambientOcclusion(true) {}
+    };
+
+    /**
+     * @brief Contadores da última renderização
+     */
+    struct Stats {
+        size_t tiles;
+        size_t threads;
+        uint64_t rays;              ///< Raios primários e de sombra
+        uint64_t voxelSteps;        ///< Células visitadas dentro de chunks com conteúdo
+        uint64_t chunksSkipped;     ///< Chunks vazios atravessados de uma vez
+        double renderMs;
+        double megapixelsPerSecond;
+
+        Stats()
+            : tiles(0)
+            , threads(0)
+            , rays(0)
+            , voxelSteps(0)
+            , chunksSkipped(0)
+            , renderMs(0.0)
+            , megapixelsPerSecond(0.0) {}
+    };
+
+private:
+    Settings settings;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    SoftwareRenderer();
+
+    /**
+     * @brief Construtor com configurações
+     * @param settings Configurações iniciais
+     */
+    explicit SoftwareRenderer(const Settings& settings);
+
+    /**
+     * @brief Destrutor
+     */
+    ~SoftwareRenderer() = default;
+
+    // Getters
+    const Settings& getSettings() const { return settings; }
+    const Stats& getStats() const { return stats; }
+
+    // Setters
+    void setSettings(const Settings& newSettings) { settings = newSettings; }
+
+    /**
+     * @brief Renderiza o grid visto pela câmera
+     * @param grid Grid de voxels
+     * @param camera Câmera (a proporção usada é a da imagem)
+     * @param image Imagem de saída, já dimensionada
+     * @return true se renderizada
+     */
+    bool render(const VoxelGrid& grid, const Camera& camera, Image& image);
+};
+
+} // namespace VoxelMaker
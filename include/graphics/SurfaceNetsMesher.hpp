@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "../core/VoxelGrid.hpp"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Extrai uma superfície suave (Naive Surface Nets) da ocupação do grid
+ *
+ * A densidade é amostrada no centro de cada voxel (1 = ocupado, 0 = vazio). Cada célula
+ * dual com troca de sinal recebe um vértice na média dos cruzamentos de suas arestas, e
+ * cada aresta do grid que cruza a superfície gera um quad ligando as 4 células em volta.
+ *
+ * Uma aresta pertence ao chunk que contém sua amostra ocupada, então cada quad é gerado
+ * exatamente uma vez mesmo quando o vizinho vazio não tem chunk.
+ */
+class SurfaceNetsMesher {
+public:
+    /**
+     * @brief Vértice de célula dual já calculado
+     */
+    struct CellVertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        Voxel::Color color;
+    };
+
+    /**
+     * @brief Cache de vértices das células na fronteira entre chunks
+     *
+     * Compartilhado pelos chunks refeitos em uma mesma atualização (inclusive entre
+     * threads): o vértice de uma célula de borda é calculado uma vez e reutilizado pelo
+     * vizinho, o que garante posições idênticas dos dois lados da costura.
+     */
+    class BorderCache {
+    public:
+        static constexpr size_t SHARD_COUNT = 16;
+
+    private:
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<glm::ivec3, CellVertex, Vec3Hash> vertices;
+        };
+        Shard shards[SHARD_COUNT];
+
+    public:
+        /**
+         * @brief Procura o vértice de uma célula global
+         * @return true se encontrado
+         */
+        bool find(const glm::ivec3& cell, CellVertex& vertex);
+
+        /**
+         * @brief Registra o vértice de uma célula global
+         */
+        void insert(const glm::ivec3& cell, const CellVertex& vertex);
+
+        /**
+         * @brief Esvazia o cache
+         */
+        void clear();
+
+    private:
+        Shard& shardFor(const glm::ivec3& cell);
+    };
+
+    static constexpr int PADDED_SIZE = VoxelChunk::SIZE + 2;
+    static constexpr int CELL_SIZE = VoxelChunk::SIZE + 1;    ///< Células duais -1..SIZE-1 por eixo
+
+public:
+    SurfaceNetsMesher() = default;
+    ~SurfaceNetsMesher() = default;
+
+    /**
+     * @brief Gera a malha suave de um chunk do grid
+     * @param grid Grid de origem
+     * @param chunkCoord Coordenada do chunk
+     * @param out Malha de saída (é limpa antes)
+     * @param cache Cache de vértices de borda opcional
+     */
+    void meshChunk(const VoxelGrid& grid,
+                   const glm::ivec3& chunkCoord,
+                   Mesh& out,
+                   BorderCache* cache = nullptr) const;
+
+    /**
+     * @brief Gera a malha a partir de uma vizinhança já copiada
+     * @param padded Células com borda (ver ChunkMesher::gatherNeighbourhood)
+     * @param palette Paleta do grid
+     * @param chunkOrigin Posição da célula local (0, 0, 0) no grid
+     * @param gridOrigin Origem do grid no espaço mundial
+     * @param out Malha de saída (é limpa antes)
+     * @param cache Cache de vértices de borda opcional
+     */
+    void meshNeighbourhood(const std::vector<VoxelChunk::Cell>& padded,
+                           const VoxelPalette& palette,
+                           const glm::ivec3& chunkOrigin,
+                           const glm::vec3& gridOrigin,
+                           Mesh& out,
+                           BorderCache* cache = nullptr) const;
+};
+
+} // namespace VoxelMaker
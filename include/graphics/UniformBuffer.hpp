@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Buffer de uniforms (UBO) ligado a um ponto de ligação fixo
+ *
+ * Dados compartilhados por vários shaders (câmera, iluminação) são enviados uma vez por
+ * quadro; os programas que declaram o bloco o leem do ponto de ligação sem nenhuma
+ * chamada glUniform* por desenho. A estrutura enviada deve seguir o layout std140.
+ */
+class UniformBuffer {
+private:
+    unsigned int buffer;
+    unsigned int bindingPoint;
+    size_t size;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    UniformBuffer();
+
+    /**
+     * @brief Destrutor
+     */
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    /**
+     * @brief Cria o buffer e o liga ao ponto de ligação
+     * @param bufferSize Tamanho do bloco em bytes
+     * @param binding Ponto de ligação
+     * @return true se criado com sucesso
+     */
+    bool initialize(size_t bufferSize, unsigned int binding);
+
+    /**
+     * @brief Libera o buffer
+     */
+    void cleanup();
+
+    /**
+     * @brief Substitui o conteúdo do bloco
+     * @param data Dados no layout std140
+     * @param dataSize Tamanho em bytes (até o tamanho do bloco)
+     */
+    void update(const void* data, size_t dataSize);
+
+    /**
+     * @brief Substitui o conteúdo do bloco por uma estrutura std140
+     * @param data Estrutura com o mesmo layout do bloco no shader
+     */
+    template<typename T>
+    void update(const T& data) { update(&data, sizeof(T)); }
+
+    // Getters
+    unsigned int getBuffer() const { return buffer; }
+    unsigned int getBindingPoint() const { return bindingPoint; }
+    size_t getSize() const { return size; }
+};
+
+} // namespace VoxelMaker
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Buffer de staging circular para envio de dados à GPU
+ *
+ * Os dados são escritos sequencialmente no anel e copiados pela GPU para o destino
+ * final (glCopyBufferSubData). Cada lote de escritas é protegido por um fence; uma
+ * escrita só reaproveita uma região depois que o fence que a cobre foi sinalizado, então
+ * a CPU nunca espera a GPU terminar um quadro inteiro, só a região que precisa.
+ *
+ * Com OpenGL 4.4 (ou ARB_buffer_storage) o anel é mapeado uma única vez de forma
+ * persistente e coerente. No OpenGL 3.3 cada escrita mapeia só a sua faixa com
+ * GL_MAP_UNSYNCHRONIZED_BIT (seguro porque os fences já garantem que a faixa está livre).
+ *
+ * Deve ser usado apenas na thread dona do contexto OpenGL.
+ */
+class UploadRing {
+public:
+    static constexpr size_t INVALID_OFFSET = ~static_cast<size_t>(0);
+    static constexpr size_t DEFAULT_CAPACITY = 16 * 1024 * 1024;
+
+    /**
+     * @brief Estatísticas acumuladas
+     */
+    struct Stats {
+        size_t bytesWritten;
+        size_t writes;
+        size_t fenceWaits;      ///< Escritas que precisaram esperar a GPU
+        double waitMs;          ///< Tempo total esperando fences
+
+        Stats()
+            : bytesWritten(0)
+            , writes(0)
+            , fenceWaits(0)
+            , waitMs(0.0) {}
+    };
+
+private:
+    /**
+     * @brief Região escrita e ainda possivelmente em uso pela GPU
+     */
+    struct Region {
+        size_t size;
+        void* fence;            ///< GLsync
+
+        Region() : size(0), fence(nullptr) {}
+    };
+
+    unsigned int buffer;
+    size_t capacity;
+    uint8_t* mapped;            ///< Ponteiro persistente (nullptr no modo OpenGL 3.3)
+    bool persistent;
+    size_t head;                ///< Próxima posição de escrita
+    size_t usedBytes;           ///< Bytes em regiões não liberadas (inclui o lote atual)
+    size_t pendingBytes;        ///< Bytes do lote atual (ainda sem fence)
+    std::deque<Region> regions;
+    Stats stats;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    UploadRing();
+
+    /**
+     * @brief Destrutor
+     */
+    ~UploadRing();
+
+    UploadRing(const UploadRing&) = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+
+    /**
+     * @brief Cria o buffer do anel
+     * @param ringCapacity Tamanho em bytes
+     * @param allowPersistent Usa mapeamento persistente quando suportado
+     * @return true se criado com sucesso
+     */
+    bool initialize(size_t ringCapacity = DEFAULT_CAPACITY, bool allowPersistent = true);
+
+    /**
+     * @brief Espera a GPU e libera o buffer
+     */
+    void cleanup();
+
+    /**
+     * @brief Copia dados para o anel
+     * @param data Dados de origem
+     * @param size Tamanho em bytes
+     * @param alignment Alinhamento do deslocamento no anel
+     * @return Deslocamento no anel ou INVALID_OFFSET se o pedido for maior que o anel
+     */
+    size_t write(const void* data, size_t size, size_t alignment = 4);
+
+    /**
+     * @brief Fecha o lote atual com um fence (chamar após emitir as cópias que leem o anel)
+     */
+    void fence();
+
+    // Getters
+    unsigned int getBuffer() const { return buffer; }
+    size_t getCapacity() const { return capacity; }
+    size_t getUsedBytes() const { return usedBytes; }
+    bool isPersistent() const { return persistent; }
+    const Stats& getStats() const { return stats; }
+
+    /**
+     * @brief Verifica se o contexto atual suporta mapeamento persistente
+     */
+    static bool supportsPersistentMapping();
+
+private:
+    /**
+     * @brief Libera, sem esperar, as regiões cujos fences já foram sinalizados
+     */
+    void retireCompleted();
+
+    /**
+     * @brief Espera o fence da região mais antiga e a libera
+     */
+    void waitOldest();
+};
+
+} // namespace VoxelMaker
@@ -1,16 +1,235 @@
 #pragma once
 
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace VoxelMaker {
 
 /**
  * @brief Sistema de processamento de entrada
+ *
+ * Os callbacks da janela apenas enfileiram eventos; uma vez por quadro beginFrame() entrega
+ * a fila ao laço principal e monta um retrato do estado (teclas, botões, cursor, scroll).
+ * Movimentos do mouse e scrolls consecutivos viram um único evento por quadro, então um
+ * mouse de 1000 Hz não multiplica o trabalho dos handlers. As amostras brutas do cursor
+ * continuam disponíveis para ferramentas que interpolam traços (pincel).
+ *
+ * Todos os métodos devem ser chamados da thread que processa os eventos da janela.
  */
 class Input {
 public:
-    Input() = default;
+    static constexpr size_t MAX_KEYS = 512;                 ///< Cobre GLFW_KEY_LAST
+    static constexpr size_t MAX_BUTTONS = 8;                ///< Cobre GLFW_MOUSE_BUTTON_LAST
+    static constexpr size_t MAX_SAMPLES_PER_FRAME = 4096;   ///< Limite de amostras brutas guardadas
+
+    // Ações (mesmos valores do GLFW)
+    static constexpr int ACTION_RELEASE = 0;
+    static constexpr int ACTION_PRESS = 1;
+    static constexpr int ACTION_REPEAT = 2;
+
+    /**
+     * @brief Tipos de evento
+     */
+    enum class EventType : uint8_t {
+        KEY,
+        MOUSE_BUTTON,
+        MOUSE_MOVE,
+        SCROLL,
+        RESIZE
+    };
+
+    /**
+     * @brief Evento de entrada enfileirado
+     */
+    struct Event {
+        EventType type;
+        double time;        ///< Segundos desde a criação do Input
+        int key;            ///< Tecla (KEY) ou botão (MOUSE_BUTTON)
+        int scancode;
+        int action;
+        int mods;
+        double x;           ///< Posição do cursor, deslocamento do scroll ou largura
+        double y;           ///< Posição do cursor, deslocamento do scroll ou altura
+        uint32_t samples;   ///< Eventos brutos agrupados neste evento
+
+        Event()
+            : type(EventType::KEY)
+            , time(0.0)
+            , key(0)
+            , scancode(0)
+            , action(0)
+            , mods(0)
+            , x(0.0)
+            , y(0.0)
+            , samples(1) {}
+    };
+
+    /**
+     * @brief Amostra bruta do cursor
+     */
+    struct MouseSample {
+        double x;
+        double y;
+        double time;
+
+        MouseSample() : x(0.0), y(0.0), time(0.0) {}
+        MouseSample(double x, double y, double time) : x(x), y(y), time(time) {}
+    };
+
+    /**
+     * @brief Retrato da entrada no início de um quadro
+     */
+    struct State {
+        double mouseX;
+        double mouseY;
+        double mouseDeltaX;         ///< Deslocamento do cursor desde o quadro anterior
+        double mouseDeltaY;
+        double scrollX;             ///< Scroll acumulado no quadro
+        double scrollY;
+        int mods;                   ///< Modificadores do último evento de tecla ou botão
+        std::bitset<MAX_KEYS> keysDown;
+        std::bitset<MAX_KEYS> keysPressed;      ///< Pressionadas neste quadro
+        std::bitset<MAX_KEYS> keysReleased;     ///< Soltas neste quadro
+        std::bitset<MAX_BUTTONS> buttonsDown;
+        std::bitset<MAX_BUTTONS> buttonsPressed;
+        std::bitset<MAX_BUTTONS> buttonsReleased;
+
+        State()
+            : mouseX(0.0)
+            , mouseY(0.0)
+            , mouseDeltaX(0.0)
+            , mouseDeltaY(0.0)
+            , scrollX(0.0)
+            , scrollY(0.0)
+            , mods(0) {}
+
+        bool isKeyDown(int key) const { return validKey(key) && keysDown.test(static_cast<size_t>(key)); }
+        bool wasKeyPressed(int key) const { return validKey(key) && keysPressed.test(static_cast<size_t>(key)); }
+        bool wasKeyReleased(int key) const { return validKey(key) && keysReleased.test(static_cast<size_t>(key)); }
+        bool isButtonDown(int button) const { return validButton(button) && buttonsDown.test(static_cast<size_t>(button)); }
+        bool wasButtonPressed(int button) const { return validButton(button) && buttonsPressed.test(static_cast<size_t>(button)); }
+        bool wasButtonReleased(int button) const { return validButton(button) && buttonsReleased.test(static_cast<size_t>(button)); }
+
+        static bool validKey(int key) { return key >= 0 && static_cast<size_t>(key) < MAX_KEYS; }
+        static bool validButton(int button) { return button >= 0 && static_cast<size_t>(button) < MAX_BUTTONS; }
+    };
+
+    /**
+     * @brief Contadores do último quadro
+     */
+    struct Stats {
+        size_t received;        ///< Eventos brutos recebidos
+        size_t delivered;       ///< Eventos entregues após o agrupamento
+        size_t coalesced;       ///< Eventos absorvidos por outro
+        size_t samplesDropped;  ///< Amostras brutas além do limite
+
+        Stats() : received(0), delivered(0), coalesced(0), samplesDropped(0) {}
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point startTime;
+    std::vector<Event> pending;             ///< Fila preenchida pelos callbacks
+    std::vector<Event> frameEvents;         ///< Eventos entregues no quadro atual
+    std::vector<MouseSample> pendingSamples;
+    std::vector<MouseSample> frameSamples;
+    State state;
+    Stats pendingStats;
+    Stats stats;
+    MouseSample lastSample;                 ///< Última posição entregue
+    bool hasLastSample;
+    bool coalescing;
+    bool recordSamples;
+
+public:
+    /**
+     * @brief Construtor
+     */
+    Input();
+
+    /**
+     * @brief Destrutor
+     */
     ~Input() = default;
-    
-    // TODO: Implementar funcionalidades
+
+    // Getters
+    const State& getState() const { return state; }
+    const Stats& getStats() const { return stats; }
+    const std::vector<Event>& getEvents() const { return frameEvents; }
+    /**
+     * @brief Amostras brutas do cursor no quadro, precedidas da última posição do quadro
+     *        anterior (vazio se o cursor não se moveu)
+     */
+    const std::vector<MouseSample>& getMouseSamples() const { return frameSamples; }
+    bool hasPendingEvents() const { return !pending.empty(); }
+    bool isCoalescing() const { return coalescing; }
+    bool isRecordingSamples() const { return recordSamples; }
+
+    // Setters
+    void setCoalescing(bool enabled) { coalescing = enabled; }
+    void setRecordSamples(bool enabled) { recordSamples = enabled; }
+
+    /**
+     * @brief Enfileira um evento de tecla
+     */
+    void pushKey(int key, int scancode, int action, int mods);
+
+    /**
+     * @brief Enfileira um evento de botão do mouse
+     */
+    void pushMouseButton(int button, int action, int mods);
+
+    /**
+     * @brief Enfileira um movimento do cursor (agrupado com o anterior se consecutivo)
+     */
+    void pushMouseMove(double x, double y);
+
+    /**
+     * @brief Enfileira um scroll (somado ao anterior se consecutivo)
+     */
+    void pushScroll(double xoffset, double yoffset);
+
+    /**
+     * @brief Enfileira um redimensionamento (só o último de uma sequência é mantido)
+     */
+    void pushResize(int width, int height);
+
+    /**
+     * @brief Entrega a fila ao quadro e atualiza o retrato do estado
+     */
+    void beginFrame();
+
+    /**
+     * @brief Descarta eventos, amostras e teclas pressionadas (ex.: janela perdeu o foco)
+     */
+    void reset();
+
+    /**
+     * @brief Redistribui um traço em pontos igualmente espaçados
+     * @param samples Amostras brutas em ordem
+     * @param spacing Distância entre pontos (pixels)
+     * @param carry Distância percorrida desde o último ponto emitido; atualizado para
+     *              manter o espaçamento entre chamadas sucessivas do mesmo traço. Um valor
+     *              negativo inicia um traço novo, emitindo a primeira amostra
+     * @return Pontos interpolados (tempo interpolado junto)
+     */
+    static std::vector<MouseSample> resampleStroke(const std::vector<MouseSample>& samples,
+                                                   double spacing, double& carry);
+
+private:
+    /**
+     * @brief Segundos desde a criação
+     */
+    double now() const;
+
+    /**
+     * @brief Adiciona um evento sem agrupar
+     */
+    void enqueue(const Event& event);
 };
 
-} // namespace VoxelMaker 
\ No newline at end of file
+} // namespace VoxelMaker
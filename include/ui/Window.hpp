@@ -41,6 +41,7 @@ public:
         std::function<void(double, double)> onScroll;
         std::function<void(int, int, int, int)> onKey;
         std::function<void()> onClose;
+        std::function<void()> onRefresh;    ///< Conteúdo da janela precisa ser redesenhado
     };
 
 private:
@@ -82,11 +83,32 @@ public:
      */
     void pollEvents();
 
+    /**
+     * @brief Bloqueia até chegar um evento ou até o tempo limite, e os processa
+     * @param timeoutSeconds Tempo máximo de espera em segundos
+     */
+    void waitEvents(double timeoutSeconds);
+
+    /**
+     * @brief Acorda uma espera em waitEvents (pode ser chamado de qualquer thread)
+     */
+    void postEmptyEvent();
+
     /**
      * @brief Troca os buffers da janela
      */
     void swapBuffers();
 
+    /**
+     * @brief Ativa o contexto OpenGL da janela na thread atual
+     */
+    void makeContextCurrent();
+
+    /**
+     * @brief Desativa o contexto OpenGL na thread atual (para ativá-lo em outra thread)
+     */
+    void detachContext();
+
     /**
      * @brief Verifica se a janela deve ser fechada
      * @return true se deve ser fechada
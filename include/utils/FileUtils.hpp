@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace VoxelMaker {
 
 /**
@@ -9,8 +14,73 @@ class FileUtils {
 public:
     FileUtils() = default;
     ~FileUtils() = default;
-    
-    // TODO: Implementar funcionalidades
+
+    /**
+     * @brief CRC-32 (polinômio do zlib/PNG)
+     * @param data Dados
+     * @param size Tamanho em bytes
+     * @param crc CRC acumulado de blocos anteriores (0 no primeiro bloco)
+     * @return CRC-32 dos dados
+     */
+    static uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
+
+    /**
+     * @brief Grava um arquivo por inteiro via arquivo temporário e renomeação
+     *
+     * Leitores nunca veem o arquivo pela metade; em caso de erro o original fica intacto.
+     * @param path Caminho do arquivo
+     * @param data Conteúdo
+     * @return true se gravado
+     */
+    static bool writeFileAtomic(const std::string& path, const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Renomeia um arquivo temporário sobre o destino (substituindo-o)
+     * @param temporary Arquivo temporário já fechado
+     * @param path Destino
+     * @return true se renomeado; em caso de erro o temporário é removido
+     */
+    static bool replaceFile(const std::string& temporary, const std::string& path);
+
+    /**
+     * @brief Verifica a extensão de um caminho, sem diferenciar maiúsculas
+     * @param path Caminho do arquivo
+     * @param extension Extensão em minúsculas, com o ponto (ex.: ".obj")
+     */
+    static bool hasExtension(const std::string& path, const char* extension);
+
+    /**
+     * @brief Pula espaços e tabulações (não quebras de linha)
+     */
+    static const char* skipSpaces(const char* p, const char* end);
+
+    /**
+     * @brief Início da linha seguinte (ou end)
+     */
+    static const char* nextLine(const char* p, const char* end);
+
+    /**
+     * @brief Lê um número decimal (sinal, fração e expoente), independente de locale
+     * @param p Posição de leitura, avançada após o número
+     * @param end Fim do texto
+     * @param value Número lido
+     * @return false se não houver número na posição (p não muda)
+     */
+    static bool parseFloat(const char*& p, const char* end, float& value);
+
+    /**
+     * @brief Como parseFloat, em precisão dupla (ex.: coordenadas georreferenciadas)
+     */
+    static bool parseDouble(const char*& p, const char* end, double& value);
+
+    /**
+     * @brief Lê um inteiro com sinal, limitado a INT32_MAX em módulo
+     * @param p Posição de leitura, avançada após o número
+     * @param end Fim do texto
+     * @param value Número lido
+     * @return false se não houver número na posição (p não muda)
+     */
+    static bool parseInt(const char*& p, const char* end, int64_t& value);
 };
 
-} // namespace VoxelMaker 
\ No newline at end of file
+} // namespace VoxelMaker
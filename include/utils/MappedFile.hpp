@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Arquivo mapeado em memória somente para leitura
+ *
+ * Em sistemas POSIX usa mmap: abrir é instantâneo e só as páginas lidas ocupam memória
+ * (o sistema pode descartá-las sob pressão). Em outros sistemas o arquivo é lido por
+ * inteiro. O conteúdo nunca muda enquanto o objeto existir e pode ser lido de várias
+ * threads ao mesmo tempo.
+ */
+class MappedFile {
+private:
+    std::string path;
+    const uint8_t* data;
+    size_t size;
+    int descriptor;                 ///< -1 sem mapeamento
+    bool opened;
+    std::vector<uint8_t> fallback;  ///< Conteúdo lido quando mmap não está disponível
+
+public:
+    /**
+     * @brief Construtor
+     */
+    MappedFile();
+
+    /**
+     * @brief Destrutor (desfaz o mapeamento)
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Mapeia um arquivo
+     * @param filePath Caminho do arquivo
+     * @return true se mapeado
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @brief Desfaz o mapeamento
+     */
+    void close();
+
+    // Getters
+    bool isOpen() const { return opened; }
+    const std::string& getPath() const { return path; }
+    const uint8_t* getData() const { return data; }
+    size_t getSize() const { return size; }
+
+    /**
+     * @brief Verifica se o intervalo [offset, offset + length) está dentro do arquivo
+     */
+    bool contains(uint64_t offset, uint64_t length) const {
+        return offset <= size && length <= size - offset;
+    }
+};
+
+} // namespace VoxelMaker
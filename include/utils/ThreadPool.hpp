@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Pool de threads de trabalho para tarefas paralelas (malhas, importação, exportação)
+ *
+ * parallelFor não bloqueia indefinidamente quando chamado de dentro de uma tarefa do
+ * próprio pool: a thread chamadora também consome índices e só espera pelos índices que
+ * já estão sendo processados por outras threads.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+
+public:
+    /**
+     * @brief Construtor
+     * @param threadCount Número de threads (0 = número de núcleos)
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Destrutor (aguarda as tarefas pendentes)
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Obtém a instância compartilhada pela aplicação
+     * @return Pool global
+     */
+    static ThreadPool& getInstance();
+
+    /**
+     * @brief Número de threads de trabalho
+     */
+    size_t getThreadCount() const { return workers.size(); }
+
+    /**
+     * @brief Enfileira uma tarefa para execução assíncrona
+     * @param task Tarefa
+     */
+    void enqueue(std::function<void()> task);
+
+    /**
+     * @brief Executa fn(i) para i em [0, count) em paralelo e aguarda o término
+     *
+     * Se fn lança uma exceção, os índices ainda não iniciados são pulados e a primeira
+     * exceção é relançada na thread chamadora depois que todas as threads terminaram.
+     * @param count Número de índices
+     * @param fn Função a executar por índice
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+private:
+    /**
+     * @brief Laço principal de cada thread de trabalho
+     */
+    void workerLoop();
+};
+
+} // namespace VoxelMaker
@@ -1,6 +1,13 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 // OpenGL e GLFW
 #include <GLFW/glfw3.h>
@@ -8,22 +15,114 @@
 // Incluir headers principais
 #include "core/Voxel.hpp"
 #include "core/VoxelGrid.hpp"
+#include "core/AutosaveJournal.hpp"
+#include "core/ChunkCodec.hpp"
+#include "core/VoxelFile.hpp"
+#include "core/MagicaVoxelFile.hpp"
+#include "core/MeshVoxelizer.hpp"
+#include "core/PointCloudImporter.hpp"
+#include "core/SharedGridExport.hpp"
+#include "core/GridDelta.hpp"
 #include "graphics/Renderer.hpp"
+#include "graphics/RenderCommand.hpp"
+#include "graphics/RenderThread.hpp"
 #include "graphics/Camera.hpp"
+#include "graphics/ChunkMesher.hpp"
+#include "graphics/FrameBudgetController.hpp"
+#include "graphics/MeshExporter.hpp"
 #include "graphics/Shader.hpp"
+#include "graphics/ShaderCache.hpp"
+#include "graphics/SoftwareRenderer.hpp"
+#include "ui/Input.hpp"
 #include "ui/Window.hpp"
 
 using namespace VoxelMaker;
 
+/**
+ * @brief Verifica se o caminho é de um arquivo MagicaVoxel (.vox)
+ */
+static bool isMagicaVoxelPath(const std::string& path) {
+    return path.size() > 4 && path.compare(path.size() - 4, 4, ".vox") == 0;
+}
+
+/**
+ * @brief Carrega um projeto .vxm ou .vox conforme a extensão
+ */
+static bool loadProject(const std::string& path, VoxelGrid& grid) {
+    if (isMagicaVoxelPath(path)) {
+        MagicaVoxelFile file;
+        return file.load(path, grid);
+    }
+    VoxelFile file;
+    return file.load(path, grid);
+}
+
+/**
+ * @brief Grava um projeto .vxm ou .vox conforme a extensão
+ */
+static bool saveProject(const VoxelGrid& grid, const std::string& path) {
+    if (isMagicaVoxelPath(path)) {
+        MagicaVoxelFile file;
+        return file.save(grid, path);
+    }
+    VoxelFile file;
+    return file.save(grid, path);
+}
+
+/**
+ * @brief Preenche o grid com o terreno procedural 256x64x256 usado pelos benchmarks
+ */
+static void buildBenchmarkTerrain(VoxelGrid& grid) {
+    const int SIZE = 256;
+
+    grid.setDimensions(VoxelGrid::Dimensions(SIZE, 64, SIZE));
+    for (int x = 0; x < SIZE; x++) {
+        for (int z = 0; z < SIZE; z++) {
+            int columnHeight = 8 + (x * 7 + z * 3) % 23 + ((x / 16 + z / 16) % 2) * 12;
+            for (int y = 0; y < columnHeight; y++) {
+                // Cores quantizadas para caber na paleta do grid
+                Voxel::Color color(static_cast<uint8_t>(x & 0xF0), static_cast<uint8_t>(60 + y * 3), static_cast<uint8_t>(z & 0xF0));
+                grid.addVoxel(Voxel(glm::ivec3(x, y, z), color));
+            }
+        }
+    }
+}
+
 /**
  * @brief Classe principal da aplicação
  */
 class VoxelMakerApp {
 private:
+    static constexpr double FIXED_TIMESTEP = 1.0 / 60.0;   ///< Passo de update() em segundos
+    static constexpr int MAX_UPDATES_PER_FRAME = 5;        ///< Evita a espiral após travamentos
+    static constexpr double IDLE_WAIT_SECONDS = 0.5;       ///< Espera máxima por eventos sem redesenho
+    static constexpr float RESIDENT_DISTANCE_FACTOR = 2.0f; ///< Raio residente em distâncias base de LOD
+
     std::unique_ptr<Window> window;
     std::unique_ptr<Renderer> renderer;
     std::shared_ptr<Camera> camera;
     std::unique_ptr<VoxelGrid> voxelGrid;
+    Input input;                      ///< Fila de eventos da janela, entregue uma vez por quadro
+    RenderThread renderThread;
+    RenderCommandList commandList;    ///< Quadro sendo gravado na thread principal
+    FrameBudgetController frameBudget;
+    std::string frameMetricsPath;     ///< CSV com as decisões do orçamento (vazio = não grava)
+    std::string projectPath;          ///< Arquivo .vxm ou .vox aberto e gravado com Ctrl+S
+    AutosaveJournal autosave;         ///< Alterações ainda não gravadas em projectPath (.vxm)
+    std::string sharedName;           ///< Memória compartilhada com a cena (vazio = não publica)
+    SharedGridExport sharedGrid;
+    std::chrono::steady_clock::time_point startTime;
+    bool firstFrameReported;          ///< Acessado só pela thread de renderização
+
+    // Laço orientado a eventos
+    std::chrono::steady_clock::time_point lastTick;
+    double updateAccumulator;         ///< Tempo ainda não consumido por update()
+    bool redrawRequested;             ///< Entrada ou janela pediram um novo quadro
+    bool animating;                   ///< Ferramentas que precisam de ticks contínuos
+    glm::mat4 lastViewProjection;     ///< Câmera do último quadro gravado
+    uint64_t lastGridRevision;        ///< Revisão do grid no último quadro gravado
+    glm::ivec3 residentCenter;        ///< Chunk da câmera na última liberação de chunks distantes
+    uint64_t residentRevision;        ///< Revisão do grid na última liberação
     
     bool running;
 
@@ -31,19 +130,47 @@ public:
     /**
      * @brief Construtor
      */
-    VoxelMakerApp() : running(false) {}
+    VoxelMakerApp()
+        : firstFrameReported(false)
+        , updateAccumulator(0.0)
+        , redrawRequested(true)
+        , animating(false)
+        , lastViewProjection(1.0f)
+        , lastGridRevision(0)
+        , residentCenter(0)
+        , residentRevision(0)
+        , running(false) {}
 
     /**
      * @brief Destrutor
      */
     ~VoxelMakerApp() = default;
 
+    /**
+     * @brief Grava as decisões do orçamento de quadro em CSV (chamar antes de initialize)
+     * @param path Caminho do arquivo
+     */
+    void setFrameMetricsPath(const std::string& path) { frameMetricsPath = path; }
+
+    /**
+     * @brief Define o projeto aberto na inicialização e gravado com Ctrl+S
+     * @param path Caminho do arquivo .vxm (criado ao gravar se não existir)
+     */
+    void setProjectPath(const std::string& path) { projectPath = path; }
+
+    /**
+     * @brief Publica a cena em memória compartilhada para outros processos (chamar antes de initialize)
+     * @param name Nome da região POSIX
+     */
+    void setSharedName(const std::string& name) { sharedName = name; }
+
     /**
      * @brief Inicializa a aplicação
      * @return true se inicializada com sucesso
      */
     bool initialize() {
         try {
+            startTime = std::chrono::steady_clock::now();
             std::cout << "Inicializando VoxelMaker..." << std::endl;
 
             // Criar janela
@@ -68,6 +195,69 @@ public:
             // Criar grid de voxels
             VoxelGrid::Dimensions gridDim(32, 32, 32);
             voxelGrid = std::make_unique<VoxelGrid>(gridDim);
+            if (isMagicaVoxelPath(projectPath) && std::ifstream(projectPath).good()) {
+                MagicaVoxelFile file;
+                if (!file.load(projectPath, *voxelGrid)) {
+                    std::cerr << "Erro ao importar arquivo .vox: " << projectPath << std::endl;
+                    return false;
+                }
+                const MagicaVoxelFile::Stats& stats = file.getStats();
+                std::cout << "Arquivo .vox importado: " << projectPath << " (" << stats.models << " modelos, "
+                          << stats.instances << " instâncias, " << stats.voxels << " voxels, "
+                          << stats.voxelsPerSecond / 1.0e6 << " Mvoxels/s)" << std::endl;
+            } else if (MeshVoxelizer::isMeshPath(projectPath) && std::ifstream(projectPath).good()) {
+                MeshVoxelizer voxelizer;
+                if (!voxelizer.load(projectPath, *voxelGrid)) {
+                    std::cerr << "Erro ao voxelizar malha: " << projectPath << std::endl;
+                    return false;
+                }
+                const MeshVoxelizer::Stats& stats = voxelizer.getStats();
+                std::cout << "Malha voxelizada: " << projectPath << " (" << stats.triangles << " triângulos, "
+                          << voxelGrid->getVoxelCount() << " voxels, " << stats.trianglesPerSecond / 1.0e6
+                          << " Mtri/s)" << std::endl;
+                // Ctrl+S grava um projeto ao lado da malha, nunca sobre ela
+                projectPath = projectPath.substr(0, projectPath.size() - 4) + ".vxm";
+            } else if ((PointCloudImporter::isPointCloudPath(projectPath) || PointCloudImporter::isHeightmapPath(projectPath)) &&
+                       std::ifstream(projectPath).good()) {
+                PointCloudImporter importer;
+                if (!importer.load(projectPath, *voxelGrid)) {
+                    std::cerr << "Erro ao importar: " << projectPath << std::endl;
+                    return false;
+                }
+                const PointCloudImporter::Stats& stats = importer.getStats();
+                std::cout << "Importado: " << projectPath << " (" << stats.points << " pontos, " << stats.voxels
+                          << " voxels, " << stats.pointsPerSecond / 1.0e6 << " Mpontos/s)" << std::endl;
+                projectPath = projectPath.substr(0, projectPath.find_last_of('.')) + ".vxm";
+            } else if (!projectPath.empty() && std::ifstream(projectPath).good()) {
+                // Só o diretório é lido; os chunks são decodificados quando acessados
+                VoxelFile file;
+                if (!file.load(projectPath, *voxelGrid)) {
+                    std::cerr << "Erro ao abrir projeto: " << projectPath << std::endl;
+                    return false;
+                }
+                std::cout << "Projeto aberto: " << projectPath << " (" << file.getStats().chunks << " chunks, "
+                          << voxelGrid->getVoxelCount() << " voxels, " << file.getStats().elapsedMs << " ms)" << std::endl;
+            }
+
+            // Alterações não gravadas da sessão anterior (queda ou saída sem Ctrl+S) voltam do journal
+            if (!projectPath.empty() && !isMagicaVoxelPath(projectPath)) {
+                openAutosave();
+            }
+
+            // Leitores externos mapeiam a cena sem cópia; falhar aqui não impede a edição
+            if (!sharedName.empty()) {
+                if (sharedGrid.open(sharedName)) {
+                    sharedGrid.update(*voxelGrid);
+                    std::cout << "Cena publicada em memória compartilhada: " << sharedGrid.getName() << " ("
+                              << sharedGrid.getStats().chunksPublished << " chunks, "
+                              << sharedGrid.getStats().lastPublishMs << " ms)" << std::endl;
+                } else {
+                    std::cerr << "Publicação em memória compartilhada desativada" << std::endl;
+                }
+            }
+
+            // Programas já compilados em execuções anteriores são lidos do disco
+            ShaderCache::getInstance().setDirectory("cache/shaders");
 
             // Criar renderer
             renderer = std::make_unique<Renderer>();
@@ -77,6 +267,20 @@ public:
             }
             renderer->setCamera(camera);
 
+            // Malhas de chunks que não mudaram desde a última execução são lidas do disco
+            if (!renderer->getMeshManager().getMeshCache().open("cache/meshes.bin")) {
+                std::cerr << "Cache de malhas desativado" << std::endl;
+            }
+
+            // Qualidade inicial: a máxima permitida pelo orçamento de quadro
+            FrameBudgetController::Quality quality = frameBudget.getSettings().maxQuality;
+            quality.lodDistance = renderer->getMeshManager().getLodSettings().baseDistance;
+            frameBudget.setQuality(quality);
+            applyFrameBudget();
+            if (!frameMetricsPath.empty()) {
+                frameBudget.openMetricsFile(frameMetricsPath);
+            }
+
             // Configurar callbacks da janela
             setupWindowCallbacks();
 
@@ -101,20 +305,57 @@ public:
         running = true;
         std::cout << "Iniciando loop principal..." << std::endl;
 
+        // O contexto OpenGL passa para a thread de renderização, que executa o quadro N
+        // (e troca os buffers) enquanto esta thread processa eventos e grava o quadro N+1
+        window->detachContext();
+        renderThread.start(
+            [this]() { window->makeContextCurrent(); },
+            [this](RenderCommandList& list) {
+                renderer->execute(list);
+                window->swapBuffers();
+                if (!firstFrameReported) {
+                    reportFirstFrame();
+                }
+            },
+            [this]() { window->detachContext(); });
+
+        lastTick = std::chrono::steady_clock::now();
         while (running && !window->shouldClose()) {
+            // Sem nada para desenhar, a thread dorme até chegar um evento (ou o tempo limite)
+            bool idle = !needsRedraw();
+            if (idle) {
+                window->waitEvents(IDLE_WAIT_SECONDS);
+            }
+
+            frameBudget.beginFrame();
+
             // Processar eventos
-            window->pollEvents();
+            if (!idle) {
+                window->pollEvents();
+            }
+            processInput();
 
-            // Atualizar lógica da aplicação
-            update();
+            // Atualizar lógica da aplicação em passos fixos
+            frameBudget.beginPhase(FrameBudgetController::Phase::UPDATE);
+            tick(idle);
 
-            // Renderizar
+            // Gravar o quadro e entregá-lo à thread de renderização
+            if (!needsRedraw()) {
+                // Iteração sem desenho não entra nas médias do orçamento
+                frameBudget.discardFrame();
+                continue;
+            }
             render();
 
-            // Trocar buffers
-            window->swapBuffers();
+            // Ajustar LOD, malhas e envios por quadro ao tempo medido
+            if (frameBudget.endFrame()) {
+                applyFrameBudget();
+            }
         }
 
+        renderThread.stop();
+        window->makeContextCurrent();
+
         std::cout << "Loop principal finalizado" << std::endl;
     }
 
@@ -123,8 +364,16 @@ public:
      */
     void cleanup() {
         std::cout << "Limpando recursos..." << std::endl;
+
+        // Últimas alterações vão para o journal; o projeto só muda com Ctrl+S
+        if (voxelGrid) {
+            autosave.close(voxelGrid.get());
+        }
+        sharedGrid.close();
         
         if (renderer) {
+            storeMeshCache();
+            renderer->getMeshManager().getMeshCache().close();
             renderer->cleanup();
         }
         
@@ -136,6 +385,81 @@ public:
     }
 
 private:
+    /**
+     * @brief Aplica ao renderer a qualidade escolhida pelo orçamento de quadro
+     */
+    void applyFrameBudget() {
+        const FrameBudgetController::Quality& quality = frameBudget.getQuality();
+
+        ChunkMeshManager& meshManager = renderer->getMeshManager();
+        ChunkMeshManager::LodSettings lodSettings = meshManager.getLodSettings();
+        lodSettings.baseDistance = quality.lodDistance;
+        meshManager.setLodSettings(lodSettings);
+        meshManager.setMaxChunksPerUpdate(quality.meshJobsPerFrame);
+
+        Renderer::RenderSettings renderSettings = renderer->getRenderSettings();
+        renderSettings.uploadBudget = quality.uploadBytesPerFrame;
+        renderer->setRenderSettings(renderSettings);
+    }
+
+    /**
+     * @brief Mostra o tempo entre o início e o primeiro quadro apresentado
+     */
+    void reportFirstFrame() {
+        firstFrameReported = true;
+        double elapsedMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count();
+        ShaderCache::Stats shaderStats = ShaderCache::getInstance().getStats();
+        std::cout << "Primeiro quadro em " << elapsedMs << " ms (shaders: "
+                  << shaderStats.hits << " do cache em " << shaderStats.loadMs << " ms, "
+                  << shaderStats.compiles << " compilados em " << shaderStats.compileMs << " ms)" << std::endl;
+    }
+
+    /**
+     * @brief Indica se o próximo quadro precisa ser gravado
+     *
+     * Redesenha quando a entrada ou a janela pediram, durante animações, quando a câmera
+     * ou o grid mudaram desde o último quadro e enquanto houver malhas ou envios adiados.
+     */
+    bool needsRedraw() {
+        if (redrawRequested || animating) return true;
+        if (camera && camera->getViewProjectionMatrix() != lastViewProjection) return true;
+        if (voxelGrid && voxelGrid->getRevision() != lastGridRevision) return true;
+        if (renderer) {
+            if (renderer->getMeshManager().getStats().chunksDeferred > 0) return true;
+            if (renderer->getRecordStats().uploadsDeferred > 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Chama update() com passo fixo pelo tempo decorrido desde o último tick
+     * @param resumed true se a thread acabou de sair da espera ociosa
+     */
+    void tick(bool resumed) {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - lastTick).count();
+        lastTick = now;
+
+        // O autosave conta o tempo real, inclusive o parado esperando eventos
+        autosave.update(*voxelGrid, elapsed);
+
+        // Só os chunks alterados desde a última publicação são copiados
+        sharedGrid.update(*voxelGrid);
+
+        // O tempo parado esperando eventos não vira uma rajada de updates
+        if (resumed && !animating) {
+            updateAccumulator = 0.0;
+            elapsed = std::min(elapsed, FIXED_TIMESTEP);
+        }
+
+        updateAccumulator = std::min(updateAccumulator + elapsed, FIXED_TIMESTEP * MAX_UPDATES_PER_FRAME);
+        while (updateAccumulator >= FIXED_TIMESTEP) {
+            update(FIXED_TIMESTEP);
+            updateAccumulator -= FIXED_TIMESTEP;
+        }
+    }
+
     /**
      * @brief Configura os callbacks da janela
      */
@@ -144,26 +468,29 @@ private:
 
         Window::EventCallbacks callbacks;
         
+        // Os eventos só são enfileirados; processInput() os entrega uma vez por quadro
         callbacks.onResize = [this](int width, int height) {
-            if (camera) {
-                camera->setAspectRatio(static_cast<float>(width) / static_cast<float>(height));
-            }
+            input.pushResize(width, height);
         };
 
         callbacks.onKey = [this](int key, int scancode, int action, int mods) {
-            handleKeyInput(key, scancode, action, mods);
+            input.pushKey(key, scancode, action, mods);
         };
 
         callbacks.onMouseMove = [this](int x, int y) {
-            handleMouseMove(x, y);
+            input.pushMouseMove(x, y);
         };
 
         callbacks.onMouseButton = [this](int button, int action, int mods) {
-            handleMouseButton(button, action, mods);
+            input.pushMouseButton(button, action, mods);
         };
 
         callbacks.onScroll = [this](double xoffset, double yoffset) {
-            handleScroll(xoffset, yoffset);
+            input.pushScroll(xoffset, yoffset);
+        };
+
+        callbacks.onRefresh = [this]() {
+            redrawRequested = true;
         };
 
         callbacks.onClose = [this]() {
@@ -174,33 +501,111 @@ private:
     }
 
     /**
-     * @brief Atualiza a lógica da aplicação
+     * @brief Entrega os eventos enfileirados no quadro aos handlers
+     *
+     * Movimentos do mouse e scrolls consecutivos já chegam agrupados; ferramentas que
+     * precisam de cada amostra (traços do pincel) usam input.getMouseSamples().
+     */
+    void processInput() {
+        input.beginFrame();
+
+        for (const Input::Event& event : input.getEvents()) {
+            switch (event.type) {
+                case Input::EventType::KEY:
+                    redrawRequested = true;
+                    handleKeyInput(event.key, event.scancode, event.action, event.mods);
+                    break;
+                case Input::EventType::MOUSE_BUTTON:
+                    redrawRequested = true;
+                    handleMouseButton(event.key, event.action, event.mods);
+                    break;
+                case Input::EventType::MOUSE_MOVE:
+                    handleMouseMove(static_cast<int>(event.x), static_cast<int>(event.y));
+                    break;
+                case Input::EventType::SCROLL:
+                    redrawRequested = true;
+                    handleScroll(event.x, event.y);
+                    break;
+                case Input::EventType::RESIZE:
+                    redrawRequested = true;
+                    if (camera && event.y > 0.0) {
+                        camera->setAspectRatio(static_cast<float>(event.x / event.y));
+                    }
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Atualiza a lógica da aplicação (passo fixo)
+     * @param deltaTime Passo em segundos (sempre FIXED_TIMESTEP)
+     *
+     * Ferramentas que precisam de ticks contínuos ligam animating enquanto estiverem ativas;
+     * sem isso o laço volta a dormir assim que a cena para de mudar.
      */
-    void update() {
+    void update(double deltaTime) {
         // TODO: Implementar lógica de atualização
         // - Atualizar ferramentas
         // - Processar input
         // - Atualizar física (se necessário)
+        (void)deltaTime;
     }
 
     /**
-     * @brief Renderiza a cena
+     * @brief Grava a cena e entrega o quadro à thread de renderização
      */
     void render() {
         if (!renderer || !voxelGrid) return;
 
-        // TODO: Implementar limpeza de buffer quando GLAD estiver disponível
-        // glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        // glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        frameBudget.beginPhase(FrameBudgetController::Phase::RECORD);
+        redrawRequested = false;
+        if (camera) {
+            lastViewProjection = camera->getViewProjectionMatrix();
+        }
+        lastGridRevision = voxelGrid->getRevision();
+        renderer->beginFrame(commandList);
 
-        // Renderizar grid de voxels
-        renderer->renderVoxelGrid(*voxelGrid);
+        // Grid de voxels
+        renderer->recordVoxelGrid(*voxelGrid, commandList);
+        releaseDistantChunks();
 
-        // Renderizar grid de referência
-        renderer->renderGrid();
+        // Grid de referência
+        renderer->recordGrid(commandList);
 
-        // Renderizar eixos
-        renderer->renderAxes();
+        // Eixos
+        renderer->recordAxes(commandList);
+
+        frameBudget.beginPhase(FrameBudgetController::Phase::SUBMIT);
+        renderThread.submit(commandList);
+    }
+
+    /**
+     * @brief Libera as células de chunks não editados longe da câmera
+     *
+     * Malhas, oclusores e instâncias decodificam os chunks preguiçosos de um projeto aberto;
+     * sem esta política todos ficariam residentes. Roda depois da gravação do quadro (só a
+     * thread principal lê o grid) e apenas quando algo pode ter decodificado chunks: malhas
+     * refeitas, edição ou câmera em outro chunk. Chunks liberados voltam a ser decodificados
+     * do arquivo quando lidos de novo.
+     */
+    void releaseDistantChunks() {
+        if (!camera) return;
+
+        const ChunkMeshManager& meshManager = renderer->getMeshManager();
+        glm::vec3 viewer = camera->getPosition() - glm::vec3(voxelGrid->getOrigin());
+        glm::ivec3 center = glm::ivec3(glm::floor(viewer / static_cast<float>(VoxelChunk::SIZE)));
+        if (meshManager.getStats().chunksMeshed == 0 && center == residentCenter &&
+            voxelGrid->getRevision() == residentRevision) {
+            return;
+        }
+        residentCenter = center;
+        residentRevision = voxelGrid->getRevision();
+
+        // Além do raio as malhas usam LOD e raramente são refeitas
+        float radius = RESIDENT_DISTANCE_FACTOR * meshManager.getLodSettings().baseDistance;
+        glm::ivec3 extent(static_cast<int>(std::ceil(radius)));
+        glm::ivec3 position = glm::ivec3(glm::floor(viewer));
+        voxelGrid->releaseChunksOutside(position - extent, position + extent);
     }
 
     /**
@@ -216,6 +621,11 @@ private:
                     // Resetar câmera
                     if (camera) camera->reset();
                     break;
+                case GLFW_KEY_S:
+                    if (mods & GLFW_MOD_CONTROL) {
+                        saveProject();
+                    }
+                    break;
                 case GLFW_KEY_SPACE:
                     // TODO: Alternar ferramenta
                     break;
@@ -225,6 +635,70 @@ private:
         }
     }
 
+    /**
+     * @brief Grava o grid no arquivo do projeto (.vox é exportado no formato MagicaVoxel)
+     */
+    void saveProject() {
+        if (!voxelGrid) return;
+        if (projectPath.empty()) {
+            projectPath = "projeto.vxm";
+        }
+
+        if (isMagicaVoxelPath(projectPath)) {
+            MagicaVoxelFile file;
+            if (file.save(*voxelGrid, projectPath)) {
+                const MagicaVoxelFile::Stats& stats = file.getStats();
+                std::cout << "Arquivo .vox exportado: " << projectPath << " (" << stats.models << " modelos, "
+                          << stats.voxels << " voxels, " << stats.megabytesPerSecond << " MB/s)" << std::endl;
+            }
+            return;
+        }
+
+        VoxelFile file;
+        if (file.save(*voxelGrid, projectPath)) {
+            const VoxelFile::Stats& stats = file.getStats();
+            std::cout << "Projeto gravado: " << projectPath << " (" << stats.chunks << " chunks, "
+                      << stats.fileBytes << " bytes, " << stats.elapsedMs << " ms)" << std::endl;
+
+            // O journal só guarda o que mudar depois desta gravação
+            if (autosave.isOpen()) {
+                autosave.markSaved(*voxelGrid);
+            } else {
+                std::remove(AutosaveJournal::journalPathFor(projectPath).c_str());
+                openAutosave();
+            }
+            storeMeshCache();
+        }
+    }
+
+    /**
+     * @brief Grava no cache em disco as malhas geradas nesta sessão
+     */
+    void storeMeshCache() {
+        ChunkMeshManager& meshManager = renderer->getMeshManager();
+        if (!meshManager.getMeshCache().isOpen()) return;
+
+        size_t stored = meshManager.storeMeshes();
+        MeshCache::Stats stats = meshManager.getMeshCache().getStats();
+        std::cout << "Cache de malhas: " << stored << " gravadas, " << stats.hits << " lidas nesta sessão ("
+                  << stats.entries << " malhas, " << stats.fileBytes / (1024 * 1024) << " MB)" << std::endl;
+    }
+
+    /**
+     * @brief Abre o journal do projeto, recuperando alterações de uma sessão interrompida
+     */
+    void openAutosave() {
+        if (!autosave.open(AutosaveJournal::journalPathFor(projectPath), *voxelGrid)) {
+            std::cerr << "Autosave desativado" << std::endl;
+            return;
+        }
+        size_t recovered = autosave.getStats().recoveredChunks;
+        if (recovered > 0) {
+            std::cout << "Alterações recuperadas do autosave: " << recovered << " chunks ("
+                      << AutosaveJournal::journalPathFor(projectPath) << ")" << std::endl;
+        }
+    }
+
     /**
      * @brief Processa movimento do mouse
      */
@@ -249,16 +723,399 @@ private:
     }
 };
 
+/**
+ * @brief Renderiza um terreno procedural em CPU, sem janela, e mede megapixels por segundo
+ * @param width Largura da imagem
+ * @param height Altura da imagem
+ * @param outputPath Arquivo de saída (.png ou .ppm)
+ * @return Código de saída do processo
+ */
+int runCpuBenchmark(int width, int height, const std::string& outputPath) {
+    const int RUNS = 5;
+
+    VoxelGrid grid;
+    buildBenchmarkTerrain(grid);
+
+    Camera camera(glm::vec3(-60.0f, 110.0f, -60.0f), glm::vec3(128.0f, 10.0f, 128.0f));
+    camera.setFOV(50.0f);
+
+    SoftwareRenderer softwareRenderer;
+    Image image(width, height);
+    double best = 0.0;
+    double total = 0.0;
+    for (int run = 0; run < RUNS; run++) {
+        softwareRenderer.render(grid, camera, image);
+        const SoftwareRenderer::Stats& stats = softwareRenderer.getStats();
+        best = std::max(best, stats.megapixelsPerSecond);
+        total += stats.megapixelsPerSecond;
+        std::cout << "Execução " << run + 1 << ": " << stats.renderMs << " ms, "
+                  << stats.megapixelsPerSecond << " MP/s (" << stats.rays << " raios, "
+                  << stats.voxelSteps << " passos, " << stats.chunksSkipped << " chunks pulados)" << std::endl;
+    }
+
+    std::cout << "Renderização em CPU " << width << "x" << height << " com "
+              << softwareRenderer.getStats().threads << " threads: média " << total / RUNS
+              << " MP/s, melhor " << best << " MP/s" << std::endl;
+
+    if (!image.save(outputPath)) {
+        return -1;
+    }
+    std::cout << "Imagem gravada em " << outputPath << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Mede taxa de compressão e GB/s de cada codec de chunk, sem janela
+ * @param inputPath Projeto (.vxm ou .vox); vazio usa um terreno procedural
+ * @return Código de saída do processo
+ */
+int runCodecBenchmark(const std::string& inputPath) {
+    VoxelGrid grid;
+    if (inputPath.empty()) {
+        buildBenchmarkTerrain(grid);
+    } else if (!loadProject(inputPath, grid)) {
+        return -1;
+    }
+
+    std::cout << "Codecs de chunk em " << grid.getChunks().size() << " chunks (" << grid.getVoxelCount()
+              << " voxels), uma thread:" << std::endl;
+    bool verified = true;
+    for (const ChunkCodec::BenchmarkResult& result : ChunkCodec::benchmark(grid)) {
+        std::cout << "  " << result.name << ": taxa " << result.getRatio() << "x, codificação "
+                  << result.getEncodeGBps() << " GB/s, decodificação " << result.getDecodeGBps() << " GB/s"
+                  << (result.verified ? "" : " (FALHOU)") << std::endl;
+        verified = verified && result.verified;
+    }
+    return verified ? 0 : -1;
+}
+
+/**
+ * @brief Mede o custo da oclusão ambiente no ChunkMesher, sem janela
+ *
+ * Gera a malha de todos os chunks com e sem oclusão ambiente, em uma thread, e compara o
+ * melhor tempo de cada modo.
+ * @param inputPath Projeto (.vxm ou .vox); vazio usa um terreno procedural
+ * @return Código de saída do processo
+ */
+int runMeshingBenchmark(const std::string& inputPath) {
+    const int RUNS = 5;
+    const double MAX_AO_OVERHEAD = 0.20;
+
+    VoxelGrid grid;
+    if (inputPath.empty()) {
+        buildBenchmarkTerrain(grid);
+    } else if (!loadProject(inputPath, grid)) {
+        return -1;
+    }
+
+    std::vector<glm::ivec3> coords;
+    for (const auto& pair : grid.getChunks()) {
+        coords.push_back(pair.first);
+    }
+
+    // Tempo de cada modo: melhor de RUNS passadas por todos os chunks, alternando os modos
+    // para que variações da máquina afetem os dois
+    ChunkMesher::Settings plainSettings;
+    plainSettings.ambientOcclusion = false;
+    const ChunkMesher meshers[2] = { ChunkMesher(plainSettings), ChunkMesher() };
+    double bestMs[2] = { 0.0, 0.0 };
+    size_t triangles[2] = { 0, 0 };
+    Mesh mesh;
+    for (int run = 0; run < RUNS; run++) {
+        for (int mode = 0; mode < 2; mode++) {
+            const ChunkMesher& mesher = meshers[mode];
+            size_t runTriangles = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (const glm::ivec3& coord : coords) {
+                mesher.meshChunk(grid, coord, mesh);
+                runTriangles += mesh.getTriangleCount();
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (run == 0 || ms < bestMs[mode]) {
+                bestMs[mode] = ms;
+            }
+            triangles[mode] = runTriangles;
+        }
+    }
+
+    double overhead = bestMs[0] > 0.0 ? bestMs[1] / bestMs[0] - 1.0 : 0.0;
+    std::cout << "Malhas de " << coords.size() << " chunks (" << triangles[0] << " triângulos), uma thread, melhor de "
+              << RUNS << ":" << std::endl;
+    std::cout << "  Sem oclusão ambiente: " << bestMs[0] << " ms" << std::endl;
+    std::cout << "  Com oclusão ambiente: " << bestMs[1] << " ms (" << overhead * 100.0 << "% a mais)" << std::endl;
+    if (overhead > MAX_AO_OVERHEAD) {
+        std::cout << "  Oclusão ambiente acima de " << MAX_AO_OVERHEAD * 100.0 << "% do tempo sem ela" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Converte um projeto (.vxm ou .vox) em malha, sem janela
+ * @param inputPath Projeto de entrada
+ * @param outputPath Malha de saída (.obj, .ply ou .gltf)
+ * @return Código de saída do processo
+ */
+int runExport(const std::string& inputPath, const std::string& outputPath) {
+    VoxelGrid grid;
+    if (!loadProject(inputPath, grid)) {
+        return -1;
+    }
+
+    MeshExporter exporter;
+    if (!exporter.exportGrid(grid, outputPath)) {
+        return -1;
+    }
+
+    const MeshExporter::Stats& stats = exporter.getStats();
+    std::cout << "Malha exportada: " << outputPath << " (" << stats.chunks << " chunks, "
+              << stats.vertices << " vértices, " << stats.triangles << " triângulos, "
+              << stats.bytes << " bytes, " << stats.elapsedMs << " ms: malhas "
+              << stats.meshingMs << ", formatação " << stats.formattingMs << ", escrita "
+              << stats.writingMs << ")" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Converte uma malha (.obj ou .stl) em projeto, sem janela
+ * @param inputPath Malha de entrada
+ * @param outputPath Projeto de saída (.vxm ou .vox)
+ * @param settings Resolução, tamanho de voxel e preenchimento
+ * @return Código de saída do processo
+ */
+int runVoxelize(const std::string& inputPath, const std::string& outputPath, const MeshVoxelizer::Settings& settings) {
+    VoxelGrid grid;
+    MeshVoxelizer voxelizer;
+    voxelizer.setSettings(settings);
+    if (!voxelizer.load(inputPath, grid)) {
+        return -1;
+    }
+
+    const MeshVoxelizer::Stats& stats = voxelizer.getStats();
+    std::cout << "Malha voxelizada: " << stats.triangles << " triângulos -> " << grid.getDimensions().width << "x"
+              << grid.getDimensions().height << "x" << grid.getDimensions().depth << " ("
+              << stats.surfaceVoxels << " voxels de superfície, " << stats.filledVoxels << " preenchidos, "
+              << stats.chunks << " chunks)" << std::endl;
+    std::cout << "Leitura " << stats.parseMs << " ms, voxelização " << stats.voxelizeMs << " ms (distribuição "
+              << stats.binMs << ", superfície " << stats.surfaceMs << ", preenchimento " << stats.fillMs << "): "
+              << stats.trianglesPerSecond / 1e6 << " Mtri/s, " << stats.voxelsPerSecond / 1e6 << " Mvox/s" << std::endl;
+
+    return saveProject(grid, outputPath) ? 0 : -1;
+}
+
+/**
+ * @brief Importa uma nuvem de pontos ou um heightmap para um projeto, sem janela
+ * @param inputPath Nuvem (.xyz, .txt, .pts, .csv, .ply) ou heightmap (.pgm, .ppm)
+ * @param outputPath Projeto de saída (.vxm ou .vox)
+ * @param settings Resolução, tamanho de voxel, altura e preenchimento
+ * @return Código de saída do processo
+ */
+int runImport(const std::string& inputPath, const std::string& outputPath, const PointCloudImporter::Settings& settings) {
+    VoxelGrid grid;
+    PointCloudImporter importer;
+    importer.setSettings(settings);
+    if (!importer.load(inputPath, grid)) {
+        return -1;
+    }
+
+    const PointCloudImporter::Stats& stats = importer.getStats();
+    std::cout << "Importado: " << stats.points << " pontos (" << stats.skippedPoints << " linhas ignoradas) -> "
+              << grid.getDimensions().width << "x" << grid.getDimensions().height << "x" << grid.getDimensions().depth
+              << " (" << stats.voxels << " voxels, " << stats.chunks << " chunks)" << std::endl;
+    std::cout << stats.elapsedMs << " ms (limites " << stats.boundsMs << ", leitura " << stats.readMs << ", pontos "
+              << stats.parseMs << ", distribuição " << stats.binMs << ", chunks " << stats.finishMs << "): "
+              << stats.pointsPerSecond / 1e6 << " Mpontos/s, " << stats.megabytesPerSecond << " MB/s" << std::endl;
+
+    return saveProject(grid, outputPath) ? 0 : -1;
+}
+
+/**
+ * @brief Mapeia a cena publicada por outra instância (--share) e lê todos os chunks, sem janela
+ * @param name Nome da região POSIX
+ * @return Código de saída do processo
+ */
+int runSharedInfo(const std::string& name) {
+    SharedGridView view;
+    if (!view.open(name)) {
+        return -1;
+    }
+
+    SharedGridView::Snapshot snapshot;
+    if (!view.readSnapshot(snapshot)) {
+        std::cerr << "Cena em publicação contínua, tente de novo" << std::endl;
+        return -1;
+    }
+    std::cout << "Cena " << view.getName() << " (processo " << snapshot.writerPid
+              << ((snapshot.flags & SharedGridExport::FLAG_CLOSED) ? ", fechada" : "") << "): revisão "
+              << snapshot.revision << ", " << snapshot.dimensions[0] << "x" << snapshot.dimensions[1] << "x"
+              << snapshot.dimensions[2] << ", " << snapshot.chunkCount << " chunks, " << snapshot.paletteCount
+              << " cores" << ((snapshot.flags & SharedGridExport::FLAG_TRUNCATED) ? " (incompleta)" : "") << std::endl;
+
+    // Cópia de cada slot com o seqlock do slot, como um leitor externo faria
+    auto start = std::chrono::steady_clock::now();
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME);
+    size_t chunks = 0;
+    uint64_t voxels = 0;
+    for (uint32_t slot = 0; slot < view.getMaxChunks() && chunks < snapshot.chunkCount; slot++) {
+        SharedGridSlot entry;
+        if (!view.readSlot(slot, entry, cells.data())) {
+            continue;
+        }
+        chunks++;
+        for (VoxelChunk::Cell cell : cells) {
+            voxels += cell != VoxelPalette::EMPTY ? 1 : 0;
+        }
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double megabytes = static_cast<double>(chunks * VoxelChunk::VOLUME * sizeof(VoxelChunk::Cell)) / (1024.0 * 1024.0);
+    std::cout << "Lidos " << chunks << " chunks (" << voxels << " voxels) em " << elapsedMs << " ms: "
+              << (elapsedMs > 0.0 ? megabytes * 1000.0 / elapsedMs : 0.0) << " MB/s" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Compara dois projetos pelas árvores de hashes e grava o delta entre eles, sem janela
+ * @param basePath Projeto de partida
+ * @param targetPath Projeto de chegada
+ * @param deltaPath Delta de saída (.vxd) ou vazio para só comparar
+ * @return Código de saída do processo (1 se os projetos são iguais)
+ */
+int runDiff(const std::string& basePath, const std::string& targetPath, const std::string& deltaPath) {
+    VoxelGrid base;
+    VoxelGrid target;
+    if (!loadProject(basePath, base) || !loadProject(targetPath, target)) {
+        return -1;
+    }
+
+    GridDelta delta;
+    if (!delta.compute(base, target)) {
+        return -1;
+    }
+    const GridDelta::Stats& stats = delta.getStats();
+    std::cout << "Hashes: base " << std::hex << base.getContentHash() << ", novo " << target.getContentHash()
+              << std::dec << std::endl;
+    std::cout << "Diferença: " << stats.changedChunks << " chunks alterados, " << stats.removedChunks
+              << " removidos de " << target.getChunks().size() << " (" << stats.visitedNodes << " nós visitados"
+              << (stats.full ? ", paletas incompatíveis: delta completo" : "") << ")" << std::endl;
+    std::cout << "Delta: " << stats.encodedBytes << " bytes, " << stats.paletteEntries << " cores; comparação "
+              << stats.diffMs << " ms, codificação " << stats.encodeMs << " ms" << std::endl;
+
+    if (!deltaPath.empty() && !delta.save(deltaPath)) {
+        return -1;
+    }
+    return stats.changedChunks + stats.removedChunks > 0 ? 0 : 1;
+}
+
+/**
+ * @brief Aplica um delta (.vxd) a um projeto e grava o resultado, sem janela
+ * @param basePath Projeto no estado da base do delta
+ * @param deltaPath Delta gravado por --diff
+ * @param outputPath Projeto de saída (.vxm ou .vox)
+ * @return Código de saída do processo
+ */
+int runPatch(const std::string& basePath, const std::string& deltaPath, const std::string& outputPath) {
+    VoxelGrid grid;
+    GridDelta delta;
+    if (!loadProject(basePath, grid) || !delta.load(deltaPath) || !delta.apply(grid)) {
+        return -1;
+    }
+
+    const GridDelta::Stats& stats = delta.getStats();
+    std::cout << "Delta aplicado: " << stats.changedChunks << " chunks alterados, " << stats.removedChunks
+              << " removidos em " << stats.applyMs << " ms (hash " << std::hex << grid.getContentHash() << std::dec
+              << ")" << std::endl;
+    return saveProject(grid, outputPath) ? 0 : -1;
+}
+
 /**
  * @brief Função principal
  */
-int main() {
+int main(int argc, char** argv) {
     std::cout << "=== VoxelMaker - Editor de Voxels 3D ===" << std::endl;
     std::cout << "Versão: 1.0.0" << std::endl;
     std::cout << "Desenvolvido em C++" << std::endl;
     std::cout << "========================================" << std::endl;
 
+    // Modo sem janela: VoxelMaker --benchmark-cpu [largura altura [saida]]
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-cpu") {
+        int width = argc > 3 ? std::atoi(argv[2]) : 512;
+        int height = argc > 3 ? std::atoi(argv[3]) : 512;
+        std::string outputPath = argc > 4 ? argv[4] : "benchmark.png";
+        return runCpuBenchmark(std::max(1, width), std::max(1, height), outputPath);
+    }
+
+    // Modo sem janela: VoxelMaker --benchmark-codecs [projeto]
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-codecs") {
+        return runCodecBenchmark(argc > 2 ? argv[2] : "");
+    }
+
+    // Modo sem janela: VoxelMaker --benchmark-meshing [projeto]
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-meshing") {
+        return runMeshingBenchmark(argc > 2 ? argv[2] : "");
+    }
+
+    // Modo sem janela: VoxelMaker --export <projeto> <saida.obj|.ply|.gltf>
+    if (argc > 3 && std::string(argv[1]) == "--export") {
+        return runExport(argv[2], argv[3]);
+    }
+
+    // Modo sem janela: VoxelMaker --voxelize <malha.obj|.stl> <saida.vxm|.vox> [resolução] [--solid]
+    if (argc > 3 && std::string(argv[1]) == "--voxelize") {
+        MeshVoxelizer::Settings settings;
+        for (int i = 4; i < argc; i++) {
+            if (std::string(argv[i]) == "--solid") {
+                settings.solid = true;
+            } else {
+                settings.resolution = std::atoi(argv[i]);
+            }
+        }
+        return runVoxelize(argv[2], argv[3], settings);
+    }
+
+    // Modo sem janela: VoxelMaker --import <nuvem|heightmap> <saida.vxm|.vox> [resolução]
+    //                  [--voxel-size s] [--height n] [--solid]
+    if (argc > 3 && std::string(argv[1]) == "--import") {
+        PointCloudImporter::Settings settings;
+        for (int i = 4; i < argc; i++) {
+            std::string option = argv[i];
+            if (option == "--solid") {
+                settings.solid = true;
+            } else if (option == "--voxel-size" && i + 1 < argc) {
+                settings.voxelSize = std::atof(argv[++i]);
+            } else if (option == "--height" && i + 1 < argc) {
+                settings.heightmapHeight = std::atoi(argv[++i]);
+            } else {
+                settings.resolution = std::atoi(argv[i]);
+            }
+        }
+        return runImport(argv[2], argv[3], settings);
+    }
+
+    // Modo sem janela: VoxelMaker --shared-info <nome>
+    if (argc > 2 && std::string(argv[1]) == "--shared-info") {
+        return runSharedInfo(argv[2]);
+    }
+
+    // Modo sem janela: VoxelMaker --diff <base> <novo> [delta.vxd]
+    if (argc > 3 && std::string(argv[1]) == "--diff") {
+        return runDiff(argv[2], argv[3], argc > 4 ? argv[4] : "");
+    }
+
+    // Modo sem janela: VoxelMaker --patch <base> <delta.vxd> <saida.vxm|.vox>
+    if (argc > 4 && std::string(argv[1]) == "--patch") {
+        return runPatch(argv[2], argv[3], argv[4]);
+    }
+
     VoxelMakerApp app;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::string(argv[i]) == "--frame-metrics") {
+            app.setFrameMetricsPath(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--open") {
+            app.setProjectPath(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--share") {
+            app.setSharedName(argv[i + 1]);
+        }
+    }
 
     try {
         if (!app.initialize()) {
@@ -0,0 +1,724 @@
+#include "core/AutosaveJournal.hpp"
+#include "core/ChunkCodec.hpp"
+#include "core/VoxelFile.hpp"
+#include "utils/FileUtils.hpp"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define VOXELMAKER_HAS_FSYNC 1
+#endif
+
+namespace VoxelMaker {
+
+namespace {
+
+enum RecordType : uint32_t {
+    RECORD_GRID = 1,        ///< Dimensões e origem
+    RECORD_PALETTE = 2,     ///< Primeiro índice, número de entradas e VoxelFile::encodePalette
+    RECORD_CHUNK = 3,       ///< ChunkRecord + bloco do ChunkCodec
+    RECORD_REMOVE = 4,      ///< Coordenada do chunk removido
+    RECORD_COMMIT = 5       ///< Fecha um snapshot (sem conteúdo)
+};
+
+struct JournalHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+static_assert(sizeof(JournalHeader) == 8, "Cabeçalho do journal mudou de tamanho");
+
+struct RecordHeader {
+    uint32_t type;
+    uint32_t size;          ///< Bytes de conteúdo após o cabeçalho
+    uint32_t checksum;      ///< CRC-32 do conteúdo
+};
+static_assert(sizeof(RecordHeader) == 12, "Cabeçalho de registro mudou de tamanho");
+
+struct ChunkRecord {
+    int32_t coord[3];
+    uint32_t cellCount;
+    uint32_t cellsChecksum; ///< CRC-32 das células decodificadas
+    uint8_t codec;          ///< ChunkCodec::Codec
+    uint8_t reserved[3];
+};
+static_assert(sizeof(ChunkRecord) == 24, "Registro de chunk mudou de tamanho");
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * @brief Anexa um registro com o conteúdo em duas partes (cabeçalho próprio e dados)
+ * @return Tamanho do registro, cabeçalho incluso
+ */
+uint32_t appendRecord(std::vector<uint8_t>& out, uint32_t type,
+                      const void* head, size_t headSize, const void* data = nullptr, size_t dataSize = 0) {
+    RecordHeader header;
+    header.type = type;
+    header.size = static_cast<uint32_t>(headSize + dataSize);
+    header.checksum = FileUtils::crc32(data, dataSize, FileUtils::crc32(head, headSize));
+    appendValue(out, header);
+    const uint8_t* headBytes = static_cast<const uint8_t*>(head);
+    const uint8_t* dataBytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), headBytes, headBytes + headSize);
+    if (dataSize > 0) {
+        out.insert(out.end(), dataBytes, dataBytes + dataSize);
+    }
+    return static_cast<uint32_t>(sizeof(RecordHeader) + headSize + dataSize);
+}
+
+/**
+ * @brief Força os dados gravados para o disco
+ */
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef VOXELMAKER_HAS_FSYNC
+    return ::fsync(fileno(file)) == 0;
+#else
+    return true;
+#endif
+}
+
+/**
+ * @brief Grava cabeçalho e registros em um arquivo novo, forçando-o para o disco
+ */
+bool writeJournalFile(const std::string& path, const std::vector<uint8_t>& records) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    JournalHeader header = { AutosaveJournal::JOURNAL_MAGIC, AutosaveJournal::JOURNAL_VERSION };
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   (records.empty() || std::fwrite(records.data(), records.size(), 1, file) == 1) &&
+                   syncFile(file);
+    return std::fclose(file) == 0 && written;
+}
+
+glm::ivec3 toCoord(const int32_t coord[3]) {
+    return glm::ivec3(coord[0], coord[1], coord[2]);
+}
+
+} // namespace
+
+AutosaveJournal::AutosaveJournal()
+    : path()
+    , savedRevisions()
+    , lastSnapshotRevision(0)
+    , journaledPaletteSize(1)
+    , journaledGridInfo()
+    , gridInfoJournaled(false)
+    , resetPending(false)
+    , elapsedSinceSnapshot(0.0)
+    , interval(DEFAULT_INTERVAL)
+    , file(nullptr)
+    , fileBytes(0)
+    , chunkRecords()
+    , removedRecords()
+    , paletteRecords()
+    , gridRecord()
+    , thread()
+    , mutex()
+    , condition()
+    , queue()
+    , busy(false)
+    , stopping(false)
+    , stats() {
+}
+
+AutosaveJournal::~AutosaveJournal() {
+    close();
+}
+
+AutosaveJournal::Stats AutosaveJournal::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+bool AutosaveJournal::open(const std::string& journalPath, VoxelGrid& grid) {
+    if (isOpen()) {
+        return false;
+    }
+
+    path = journalPath;
+    stats = Stats();
+    chunkRecords.clear();
+    removedRecords.clear();
+    paletteRecords.clear();
+    gridRecord = RecordRef();
+
+    std::vector<glm::ivec3> recovered;
+    uint64_t validBytes = recover(grid, recovered);
+
+    // Chunks recuperados ficam sujos: o journal é reescrito com os índices da paleta atual
+    savedRevisions.clear();
+    for (const auto& pair : grid.getChunks()) {
+        savedRevisions.emplace(pair.first, pair.second->getRevision());
+    }
+    for (const glm::ivec3& coord : recovered) {
+        if (grid.getChunk(coord)) {
+            savedRevisions.erase(coord);
+        } else {
+            savedRevisions[coord] = 0;  // Removido: o próximo snapshot registra a remoção
+        }
+    }
+    journaledPaletteSize = 1;
+    gridInfoJournaled = false;
+    resetPending = !recovered.empty();
+    lastSnapshotRevision = grid.getRevision();
+    elapsedSinceSnapshot = 0.0;
+
+    if (validBytes > sizeof(JournalHeader)) {
+        // Descarta a cauda de um snapshot interrompido
+        std::error_code error;
+        std::filesystem::resize_file(path, validBytes, error);
+        file = error ? nullptr : std::fopen(path.c_str(), "r+b");
+        if (file && std::fseek(file, 0, SEEK_END) != 0) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        fileBytes = validBytes;
+    } else {
+        file = writeJournalFile(path, {}) ? std::fopen(path.c_str(), "r+b") : nullptr;
+        if (file && std::fseek(file, 0, SEEK_END) != 0) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        fileBytes = sizeof(JournalHeader);
+    }
+    if (!file) {
+        std::cerr << "Erro ao abrir journal: " << path << std::endl;
+        return false;
+    }
+    stats.journalBytes = fileBytes;
+
+    stopping = false;
+    busy = false;
+    thread = std::thread(&AutosaveJournal::workerLoop, this);
+
+    if (resetPending) {
+        snapshot(grid);
+    }
+    return true;
+}
+
+void AutosaveJournal::close(const VoxelGrid* grid) {
+    if (!thread.joinable()) {
+        return;
+    }
+
+    if (grid) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return !busy && queue.empty(); });
+        }
+        snapshot(*grid);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    thread.join();
+
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+void AutosaveJournal::update(const VoxelGrid& grid, double deltaTime) {
+    if (!isOpen()) return;
+
+    elapsedSinceSnapshot += deltaTime;
+    if (elapsedSinceSnapshot < interval) {
+        return;
+    }
+    if (grid.getRevision() == lastSnapshotRevision && !resetPending) {
+        elapsedSinceSnapshot = 0.0;
+        return;
+    }
+    // Adiado: tenta de novo no próximo quadro, sem esperar pelo disco
+    if (snapshot(grid)) {
+        elapsedSinceSnapshot = 0.0;
+    }
+}
+
+bool AutosaveJournal::snapshot(const VoxelGrid& grid) {
+    if (!isOpen()) return false;
+    auto start = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (busy || !queue.empty()) {
+            stats.skippedSnapshots++;
+            return false;
+        }
+    }
+
+    Snapshot job;
+    const VoxelPalette& palette = grid.getPalette();
+
+    // A paleta só cresce entre gravações; se encolheu foi substituída e os índices antigos
+    // do journal não valem mais
+    if (palette.size() < journaledPaletteSize) {
+        resetPending = true;
+        for (auto& pair : savedRevisions) {
+            pair.second = 0;
+        }
+    }
+    if (resetPending) {
+        job.reset = true;
+        journaledPaletteSize = 1;
+        gridInfoJournaled = false;
+        resetPending = false;
+    }
+
+    const VoxelGrid::Dimensions& dimensions = grid.getDimensions();
+    const glm::ivec3& origin = grid.getOrigin();
+    int32_t gridInfo[6] = { dimensions.width, dimensions.height, dimensions.depth, origin.x, origin.y, origin.z };
+    if (!gridInfoJournaled || std::memcmp(gridInfo, journaledGridInfo, sizeof(gridInfo)) != 0) {
+        job.hasGridInfo = true;
+        std::memcpy(job.gridInfo, gridInfo, sizeof(gridInfo));
+        std::memcpy(journaledGridInfo, gridInfo, sizeof(gridInfo));
+        gridInfoJournaled = true;
+    }
+
+    for (auto it = savedRevisions.begin(); it != savedRevisions.end();) {
+        if (!grid.getChunk(it->first)) {
+            job.removed.push_back(it->first);
+            it = savedRevisions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Vizinhos carimbados por edições na borda entram aqui; a thread descarta os iguais
+    bool complete = true;
+    for (const auto& pair : grid.getChunks()) {
+        const VoxelChunk& chunk = *pair.second;
+        auto saved = savedRevisions.find(pair.first);
+        if (saved != savedRevisions.end() && chunk.getRevision() <= saved->second) {
+            continue;
+        }
+        if (job.coords.size() >= MAX_SNAPSHOT_CHUNKS) {
+            complete = false;
+            break;
+        }
+        job.coords.push_back(pair.first);
+        job.cells.resize(job.coords.size() * VoxelChunk::VOLUME);
+        chunk.copyCells(job.cells.data() + (job.coords.size() - 1) * VoxelChunk::VOLUME);
+        savedRevisions[pair.first] = chunk.getRevision();
+    }
+
+    if (palette.size() > journaledPaletteSize) {
+        job.palette = VoxelFile::encodePalette(palette, journaledPaletteSize);
+        job.paletteFirst = static_cast<uint32_t>(journaledPaletteSize);
+        job.paletteCount = static_cast<uint32_t>(palette.size() - journaledPaletteSize);
+        journaledPaletteSize = palette.size();
+    }
+
+    // Um snapshot parcial deixa o resto sujo para o próximo intervalo
+    lastSnapshotRevision = complete ? grid.getRevision() : 0;
+
+    bool empty = !job.reset && !job.hasGridInfo && job.palette.empty() &&
+                 job.coords.empty() && job.removed.empty();
+    size_t copied = job.coords.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!empty) {
+            queue.push_back(std::move(job));
+        }
+        stats.snapshots++;
+        stats.chunksCopied += copied;
+        stats.lastSnapshotMs = elapsedMs(start);
+    }
+    condition.notify_all();
+    return true;
+}
+
+void AutosaveJournal::markSaved(const VoxelGrid& grid) {
+    if (!isOpen()) return;
+
+    savedRevisions.clear();
+    for (const auto& pair : grid.getChunks()) {
+        savedRevisions.emplace(pair.first, pair.second->getRevision());
+    }
+    journaledPaletteSize = 1;
+    gridInfoJournaled = false;
+    resetPending = false;
+    lastSnapshotRevision = grid.getRevision();
+    elapsedSinceSnapshot = 0.0;
+
+    // O recomeço nunca é descartado: entra na fila mesmo com uma gravação em andamento
+    Snapshot job;
+    job.reset = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(job));
+    }
+    condition.notify_all();
+}
+
+uint64_t AutosaveJournal::recover(VoxelGrid& grid, std::vector<glm::ivec3>& recovered) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        return 0;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    JournalHeader header;
+    if (data.size() < sizeof(header)) {
+        return 0;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != JOURNAL_MAGIC || header.version != JOURNAL_VERSION) {
+        std::cerr << "Journal inválido ignorado: " << path << std::endl;
+        return 0;
+    }
+
+    struct PendingRecord {
+        uint32_t type;
+        const uint8_t* data;
+        uint32_t size;
+    };
+    std::vector<PendingRecord> pending;
+    std::vector<VoxelPalette::Index> remap(1, VoxelPalette::EMPTY);
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME);
+    size_t corrupt = 0;
+
+    uint64_t cursor = sizeof(header);
+    uint64_t validBytes = cursor;
+    while (data.size() - cursor >= sizeof(RecordHeader)) {
+        RecordHeader record;
+        std::memcpy(&record, data.data() + cursor, sizeof(record));
+        const uint8_t* payload = data.data() + cursor + sizeof(record);
+        if (record.size > data.size() - cursor - sizeof(record) ||
+            FileUtils::crc32(payload, record.size) != record.checksum) {
+            break;  // Cauda cortada: o snapshot em andamento não chegou ao commit
+        }
+        cursor += sizeof(record) + record.size;
+
+        if (record.type != RECORD_COMMIT) {
+            pending.push_back({ record.type, payload, record.size });
+            continue;
+        }
+
+        for (const PendingRecord& entry : pending) {
+            if (entry.type == RECORD_GRID && entry.size == 6 * sizeof(int32_t)) {
+                int32_t info[6];
+                std::memcpy(info, entry.data, sizeof(info));
+                grid.setDimensions(VoxelGrid::Dimensions(info[0], info[1], info[2]));
+                grid.setOrigin(glm::ivec3(info[3], info[4], info[5]));
+            } else if (entry.type == RECORD_PALETTE && entry.size >= 2 * sizeof(uint32_t)) {
+                // Cada parte continua a anterior; a primeira índice 1 recomeça a paleta
+                uint32_t range[2];
+                std::memcpy(range, entry.data, sizeof(range));
+                if (range[0] == 1) {
+                    remap.assign(1, VoxelPalette::EMPTY);
+                }
+                VoxelPalette palette;
+                std::vector<VoxelPalette::Index> decoded;
+                if (range[0] != remap.size() ||
+                    !VoxelFile::decodePalette(entry.data + sizeof(range), entry.size - sizeof(range),
+                                              range[1], palette, decoded)) {
+                    corrupt++;
+                    continue;
+                }
+                for (size_t i = 1; i < decoded.size(); i++) {
+                    remap.push_back(grid.addPaletteEntry(palette.get(decoded[i])));
+                }
+            } else if (entry.type == RECORD_CHUNK && entry.size >= sizeof(ChunkRecord)) {
+                ChunkRecord chunkRecord;
+                std::memcpy(&chunkRecord, entry.data, sizeof(chunkRecord));
+                if (!ChunkCodec::decode(static_cast<ChunkCodec::Codec>(chunkRecord.codec),
+                                        entry.data + sizeof(chunkRecord), entry.size - sizeof(chunkRecord),
+                                        cells.data()) ||
+                    FileUtils::crc32(cells.data(), ChunkCodec::RAW_BYTES) != chunkRecord.cellsChecksum) {
+                    corrupt++;
+                    continue;
+                }
+
+                glm::ivec3 coord = toCoord(chunkRecord.coord);
+                auto chunk = std::make_unique<VoxelChunk>(coord);
+                for (int z = 0; z < VoxelChunk::SIZE; z++) {
+                    for (int y = 0; y < VoxelChunk::SIZE; y++) {
+                        for (int x = 0; x < VoxelChunk::SIZE; x++) {
+                            VoxelChunk::Cell cell = cells[VoxelChunk::index(x, y, z)];
+                            if (cell != VoxelPalette::EMPTY && cell < remap.size()) {
+                                chunk->set(glm::ivec3(x, y, z), remap[cell]);
+                            }
+                        }
+                    }
+                }
+                grid.insertChunk(std::move(chunk));
+                recovered.push_back(coord);
+            } else if (entry.type == RECORD_REMOVE && entry.size == 3 * sizeof(int32_t)) {
+                int32_t coord[3];
+                std::memcpy(coord, entry.data, sizeof(coord));
+                grid.insertChunk(std::make_unique<VoxelChunk>(toCoord(coord)));     // Vazio: remove
+                recovered.push_back(toCoord(coord));
+            } else {
+                corrupt++;
+            }
+        }
+        pending.clear();
+        validBytes = cursor;
+    }
+
+    stats.recoveredChunks = recovered.size();
+    if (corrupt > 0) {
+        std::cerr << "Journal " << path << ": " << corrupt << " registros inválidos ignorados" << std::endl;
+    }
+    return validBytes;
+}
+
+void AutosaveJournal::workerLoop() {
+    while (true) {
+        Snapshot snapshot;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;     // Parando, sem nada pendente
+            }
+            snapshot = std::move(queue.front());
+            queue.pop_front();
+            busy = true;
+        }
+
+        writeSnapshot(snapshot);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+        }
+        condition.notify_all();
+    }
+}
+
+void AutosaveJournal::writeSnapshot(Snapshot& snapshot) {
+    auto start = std::chrono::steady_clock::now();
+
+    if (snapshot.reset) {
+        chunkRecords.clear();
+        removedRecords.clear();
+        paletteRecords.clear();
+        gridRecord = RecordRef();
+    }
+
+    // Deslocamentos são absolutos; um recomeço grava depois do cabeçalho de um arquivo novo
+    uint64_t base = snapshot.reset ? sizeof(JournalHeader) : fileBytes;
+    std::vector<uint8_t> records;
+    RecordRef newGrid = gridRecord;
+    RecordRef newPalette = {};
+    std::vector<std::pair<glm::ivec3, RecordRef>> written;
+    size_t chunksWritten = 0;
+
+    if (snapshot.hasGridInfo) {
+        newGrid.offset = base + records.size();
+        newGrid.size = appendRecord(records, RECORD_GRID, snapshot.gridInfo, sizeof(snapshot.gridInfo));
+    }
+    if (snapshot.paletteCount > 0) {
+        uint32_t range[2] = { snapshot.paletteFirst, snapshot.paletteCount };
+        newPalette.offset = base + records.size();
+        newPalette.size = appendRecord(records, RECORD_PALETTE, range, sizeof(range),
+                                       snapshot.palette.data(), snapshot.palette.size());
+    }
+    for (const glm::ivec3& coord : snapshot.removed) {
+        int32_t values[3] = { coord.x, coord.y, coord.z };
+        RecordRef ref = { base + records.size(), 0, 0 };
+        ref.size = appendRecord(records, RECORD_REMOVE, values, sizeof(values));
+        written.emplace_back(coord, ref);
+    }
+    size_t removedCount = written.size();
+
+    std::vector<uint8_t> block;
+    for (size_t i = 0; i < snapshot.coords.size(); i++) {
+        const glm::ivec3& coord = snapshot.coords[i];
+        const VoxelChunk::Cell* cells = snapshot.cells.data() + i * VoxelChunk::VOLUME;
+        uint32_t cellsChecksum = FileUtils::crc32(cells, ChunkCodec::RAW_BYTES);
+
+        // Carimbado por um vizinho sem ter mudado
+        auto previous = chunkRecords.find(coord);
+        if (previous != chunkRecords.end() && previous->second.cellsCrc == cellsChecksum) {
+            continue;
+        }
+
+        ChunkRecord chunkRecord = {};
+        chunkRecord.coord[0] = coord.x;
+        chunkRecord.coord[1] = coord.y;
+        chunkRecord.coord[2] = coord.z;
+        for (int c = 0; c < VoxelChunk::VOLUME; c++) {
+            chunkRecord.cellCount += cells[c] != VoxelPalette::EMPTY ? 1 : 0;
+        }
+        chunkRecord.cellsChecksum = cellsChecksum;
+        chunkRecord.codec = static_cast<uint8_t>(ChunkCodec::encodeBest(cells, block));
+
+        RecordRef ref = { base + records.size(), 0, cellsChecksum };
+        ref.size = appendRecord(records, RECORD_CHUNK, &chunkRecord, sizeof(chunkRecord), block.data(), block.size());
+        written.emplace_back(coord, ref);
+        chunksWritten++;
+    }
+
+    if (records.empty() && !snapshot.reset) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.lastWriteMs = elapsedMs(start);
+        return;     // Nada mudou de fato
+    }
+    appendRecord(records, RECORD_COMMIT, nullptr, 0);
+
+    bool ok = snapshot.reset ? rewrite(records) : append(records);
+    if (!ok) {
+        std::cerr << "Erro ao gravar journal: " << path << std::endl;
+        return;
+    }
+
+    gridRecord = newGrid;
+    if (newPalette.size > 0) {
+        paletteRecords.push_back(newPalette);
+    }
+    for (size_t i = 0; i < written.size(); i++) {
+        if (i < removedCount) {
+            chunkRecords.erase(written[i].first);
+            removedRecords[written[i].first] = written[i].second;
+        } else {
+            removedRecords.erase(written[i].first);
+            chunkRecords[written[i].first] = written[i].second;
+        }
+    }
+
+    compactIfNeeded();
+
+    uint64_t liveBytes = getLiveBytes();
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.chunksWritten += chunksWritten;
+    stats.chunksRemoved += removedCount;
+    stats.bytesWritten += records.size();
+    stats.journalBytes = fileBytes;
+    stats.liveBytes = liveBytes;
+    stats.lastWriteMs = elapsedMs(start);
+}
+
+bool AutosaveJournal::rewrite(const std::vector<uint8_t>& records) {
+    // Arquivo novo renomeado sobre o journal: uma queda no meio mantém o anterior
+    std::string temporary = path + ".tmp";
+    if (!writeJournalFile(temporary, records)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    std::fclose(file);
+    file = nullptr;
+    bool replaced = FileUtils::replaceFile(temporary, path);
+    file = std::fopen(path.c_str(), "r+b");
+    if (!file || std::fseek(file, 0, SEEK_END) != 0) {
+        return false;
+    }
+    if (!replaced) {
+        return false;
+    }
+    fileBytes = sizeof(JournalHeader) + records.size();
+    return true;
+}
+
+bool AutosaveJournal::append(const std::vector<uint8_t>& records) {
+    if (!file) {
+        return false;
+    }
+    if (std::fwrite(records.data(), records.size(), 1, file) != 1 || !syncFile(file)) {
+        // Remove o pedaço gravado: registros seguintes não podem ficar atrás de lixo
+        std::error_code error;
+        std::filesystem::resize_file(path, fileBytes, error);
+        std::fseek(file, static_cast<long>(fileBytes), SEEK_SET);
+        return false;
+    }
+    fileBytes += records.size();
+    return true;
+}
+
+void AutosaveJournal::compactIfNeeded() {
+    uint64_t liveBytes = getLiveBytes();
+    if (fileBytes < MIN_COMPACT_BYTES || fileBytes <= COMPACT_RATIO * liveBytes) {
+        return;
+    }
+
+    std::vector<uint8_t> records;
+    records.reserve(liveBytes);
+    auto copyRecord = [&](RecordRef& ref) -> bool {
+        if (ref.size == 0) {
+            return true;
+        }
+        size_t start = records.size();
+        records.resize(start + ref.size);
+        if (std::fseek(file, static_cast<long>(ref.offset), SEEK_SET) != 0 ||
+            std::fread(records.data() + start, ref.size, 1, file) != 1) {
+            return false;
+        }
+        ref.offset = sizeof(JournalHeader) + start;
+        return true;
+    };
+
+    // Cópias dos índices: só valem se a reescrita der certo
+    RecordRef newGrid = gridRecord;
+    std::vector<RecordRef> newPalette = paletteRecords;
+    RecordIndex newRemoved = removedRecords;
+    RecordIndex newChunks = chunkRecords;
+    bool ok = copyRecord(newGrid);
+    for (auto it = newPalette.begin(); ok && it != newPalette.end(); ++it) {
+        ok = copyRecord(*it);
+    }
+    for (auto it = newRemoved.begin(); ok && it != newRemoved.end(); ++it) {
+        ok = copyRecord(it->second);
+    }
+    for (auto it = newChunks.begin(); ok && it != newChunks.end(); ++it) {
+        ok = copyRecord(it->second);
+    }
+    std::fseek(file, 0, SEEK_END);
+    if (!ok) {
+        std::cerr << "Erro ao ler journal para compactação: " << path << std::endl;
+        return;
+    }
+    appendRecord(records, RECORD_COMMIT, nullptr, 0);
+
+    if (!rewrite(records)) {
+        std::cerr << "Erro ao compactar journal: " << path << std::endl;
+        return;
+    }
+    gridRecord = newGrid;
+    paletteRecords.swap(newPalette);
+    removedRecords.swap(newRemoved);
+    chunkRecords.swap(newChunks);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.compactions++;
+}
+
+uint64_t AutosaveJournal::getLiveBytes() const {
+    uint64_t bytes = sizeof(JournalHeader) + sizeof(RecordHeader) + gridRecord.size;
+    for (const RecordRef& ref : paletteRecords) {
+        bytes += ref.size;
+    }
+    for (const auto& pair : chunkRecords) {
+        bytes += pair.second.size;
+    }
+    for (const auto& pair : removedRecords) {
+        bytes += pair.second.size;
+    }
+    return bytes;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,594 @@
+#include "core/ChunkCodec.hpp"
+#include "core/VoxelGrid.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace VoxelMaker {
+
+namespace {
+
+using Cell = VoxelChunk::Cell;
+
+constexpr uint16_t NO_LOCAL_INDEX = 0xFFFF;
+constexpr size_t LZ_MIN_MATCH = 4;
+constexpr size_t LZ_MAX_OFFSET = 0xFFFF;
+constexpr int LZ_HASH_BITS = 13;
+
+/**
+ * @brief Ordem de Morton (Z-order) de um chunk: índice de Morton -> índice linear
+ */
+const std::vector<uint16_t>& mortonOrder() {
+    static const std::vector<uint16_t> order = [] {
+        std::vector<uint16_t> table(VoxelChunk::VOLUME);
+        for (int m = 0; m < VoxelChunk::VOLUME; m++) {
+            int x = 0, y = 0, z = 0;
+            for (int bit = 0; (1 << bit) < VoxelChunk::SIZE; bit++) {
+                x |= ((m >> (3 * bit)) & 1) << bit;
+                y |= ((m >> (3 * bit + 1)) & 1) << bit;
+                z |= ((m >> (3 * bit + 2)) & 1) << bit;
+            }
+            table[static_cast<size_t>(m)] = static_cast<uint16_t>(VoxelChunk::index(x, y, z));
+        }
+        return table;
+    }();
+    return order;
+}
+
+/**
+ * @brief Paleta local de um chunk e estatísticas para escolher o codec
+ */
+struct Analysis {
+    std::vector<Cell> entries;          ///< Células distintas, na ordem de aparição
+    std::vector<uint16_t> local;        ///< Índice local de cada célula (ordem linear)
+    int bits;                           ///< Bits por índice em PALETTE
+    size_t mortonRunBytes;              ///< Bytes das sequências de MORTON_RLE
+
+    size_t paletteHeaderBytes() const { return sizeof(uint16_t) * (1 + entries.size()); }
+    size_t indexBytes() const { return entries.size() <= 256 ? 1 : 2; }
+    size_t paletteBytes() const { return paletteHeaderBytes() + VoxelChunk::VOLUME * static_cast<size_t>(bits) / 8; }
+    size_t mortonBytes() const { return paletteHeaderBytes() + mortonRunBytes; }
+};
+
+size_t varintBytes(uint32_t value) {
+    size_t bytes = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+int bitsFor(size_t count) {
+    if (count <= 1) return 0;
+    if (count <= 2) return 1;
+    if (count <= 4) return 2;
+    if (count <= 16) return 4;
+    if (count <= 256) return 8;
+    return 16;
+}
+
+/**
+ * @brief Monta a paleta local e mede as sequências em ordem de Morton
+ * @param runs Se false, mortonRunBytes não é calculado
+ */
+void analyze(const Cell* cells, Analysis& analysis, bool runs) {
+    // Tabela célula -> índice local, reaproveitada por thread e limpa ao final
+    thread_local std::vector<uint16_t> lookup(size_t(1) << (8 * sizeof(Cell)), NO_LOCAL_INDEX);
+
+    analysis.entries.clear();
+    analysis.local.resize(VoxelChunk::VOLUME);
+    for (int i = 0; i < VoxelChunk::VOLUME; i++) {
+        uint16_t& slot = lookup[cells[i]];
+        if (slot == NO_LOCAL_INDEX) {
+            slot = static_cast<uint16_t>(analysis.entries.size());
+            analysis.entries.push_back(cells[i]);
+        }
+        analysis.local[static_cast<size_t>(i)] = slot;
+    }
+    for (Cell cell : analysis.entries) {
+        lookup[cell] = NO_LOCAL_INDEX;
+    }
+    analysis.bits = bitsFor(analysis.entries.size());
+
+    analysis.mortonRunBytes = 0;
+    if (!runs) return;
+
+    const std::vector<uint16_t>& order = mortonOrder();
+    const size_t indexBytes = analysis.indexBytes();
+    uint16_t current = analysis.local[order[0]];
+    uint32_t length = 1;
+    for (int m = 1; m < VoxelChunk::VOLUME; m++) {
+        uint16_t value = analysis.local[order[static_cast<size_t>(m)]];
+        if (value == current) {
+            length++;
+            continue;
+        }
+        analysis.mortonRunBytes += varintBytes(length - 1) + indexBytes;
+        current = value;
+        length = 1;
+    }
+    analysis.mortonRunBytes += varintBytes(length - 1) + indexBytes;
+}
+
+void put16(std::vector<uint8_t>& out, uint16_t value) {
+    uint8_t bytes[2];
+    std::memcpy(bytes, &value, sizeof(value));
+    out.push_back(bytes[0]);
+    out.push_back(bytes[1]);
+}
+
+bool get16(const uint8_t*& cursor, const uint8_t* end, uint16_t& value) {
+    if (end - cursor < 2) return false;
+    std::memcpy(&value, cursor, sizeof(value));
+    cursor += 2;
+    return true;
+}
+
+void putVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& cursor, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 32 && cursor < end; shift += 7) {
+        uint8_t byte = *cursor++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+void writePaletteHeader(const Analysis& analysis, std::vector<uint8_t>& out) {
+    put16(out, static_cast<uint16_t>(analysis.entries.size() - 1));
+    for (Cell cell : analysis.entries) {
+        put16(out, cell);
+    }
+}
+
+bool readPaletteHeader(const uint8_t*& cursor, const uint8_t* end, std::vector<Cell>& entries) {
+    uint16_t countMinusOne;
+    if (!get16(cursor, end, countMinusOne)) return false;
+    size_t count = static_cast<size_t>(countMinusOne) + 1;
+    if (count > static_cast<size_t>(VoxelChunk::VOLUME) || static_cast<size_t>(end - cursor) < count * 2) {
+        return false;
+    }
+    entries.resize(count);
+    std::memcpy(entries.data(), cursor, count * sizeof(Cell));
+    cursor += count * sizeof(Cell);
+    return true;
+}
+
+void encodePalette(const Analysis& analysis, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(analysis.paletteBytes());
+    writePaletteHeader(analysis, out);
+
+    const int bits = analysis.bits;
+    if (bits == 16) {
+        for (uint16_t index : analysis.local) {
+            put16(out, index);
+        }
+    } else if (bits > 0) {
+        const int perByte = 8 / bits;
+        for (int i = 0; i < VoxelChunk::VOLUME; i += perByte) {
+            uint8_t byte = 0;
+            for (int k = 0; k < perByte; k++) {
+                byte |= static_cast<uint8_t>(analysis.local[static_cast<size_t>(i + k)] << (k * bits));
+            }
+            out.push_back(byte);
+        }
+    }
+}
+
+/**
+ * @brief PALETTE com os índices comprimidos por LZ (a paleta local fica sem compressão)
+ */
+void encodePaletteLz(const Analysis& analysis, std::vector<uint8_t>& out) {
+    thread_local std::vector<uint8_t> packed;
+    encodePalette(analysis, packed);
+    const size_t headerBytes = analysis.paletteHeaderBytes();
+    out.assign(packed.begin(), packed.begin() + static_cast<std::ptrdiff_t>(headerBytes));
+    ChunkCodec::lzCompress(packed.data() + headerBytes, packed.size() - headerBytes, out);
+}
+
+/**
+ * @brief Decodifica os índices empacotados de PALETTE (o fluxo após a paleta local)
+ */
+bool decodeIndices(const std::vector<Cell>& entries, const uint8_t* data, size_t size, Cell* cells) {
+    const int bits = bitsFor(entries.size());
+    if (size != VoxelChunk::VOLUME * static_cast<size_t>(bits) / 8) {
+        return false;
+    }
+
+    if (bits == 0) {
+        std::fill(cells, cells + VoxelChunk::VOLUME, entries[0]);
+    } else if (bits == 16) {
+        for (int i = 0; i < VoxelChunk::VOLUME; i++) {
+            uint16_t index;
+            std::memcpy(&index, data + 2 * i, sizeof(index));
+            if (index >= entries.size()) return false;
+            cells[i] = entries[index];
+        }
+    } else {
+        const int perByte = 8 / bits;
+        const uint8_t mask = static_cast<uint8_t>((1 << bits) - 1);
+        for (int i = 0; i < VoxelChunk::VOLUME; i += perByte) {
+            uint8_t byte = *data++;
+            for (int k = 0; k < perByte; k++) {
+                size_t index = (byte >> (k * bits)) & mask;
+                if (index >= entries.size()) return false;
+                cells[i + k] = entries[index];
+            }
+        }
+    }
+    return true;
+}
+
+void encodeMorton(const Analysis& analysis, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(analysis.mortonBytes());
+    writePaletteHeader(analysis, out);
+
+    const std::vector<uint16_t>& order = mortonOrder();
+    const bool wide = analysis.indexBytes() == 2;
+    auto emit = [&](uint16_t value, uint32_t length) {
+        putVarint(out, length - 1);
+        if (wide) {
+            put16(out, value);
+        } else {
+            out.push_back(static_cast<uint8_t>(value));
+        }
+    };
+
+    uint16_t current = analysis.local[order[0]];
+    uint32_t length = 1;
+    for (int m = 1; m < VoxelChunk::VOLUME; m++) {
+        uint16_t value = analysis.local[order[static_cast<size_t>(m)]];
+        if (value == current) {
+            length++;
+            continue;
+        }
+        emit(current, length);
+        current = value;
+        length = 1;
+    }
+    emit(current, length);
+}
+
+bool decodeMorton(const uint8_t* data, size_t size, Cell* cells) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+    std::vector<Cell> entries;
+    if (!readPaletteHeader(cursor, end, entries)) return false;
+
+    const std::vector<uint16_t>& order = mortonOrder();
+    const bool wide = entries.size() > 256;
+    size_t filled = 0;
+    while (cursor < end) {
+        uint32_t lengthMinusOne;
+        uint16_t index;
+        if (!getVarint(cursor, end, lengthMinusOne)) return false;
+        if (wide) {
+            if (!get16(cursor, end, index)) return false;
+        } else {
+            if (cursor >= end) return false;
+            index = *cursor++;
+        }
+
+        size_t length = static_cast<size_t>(lengthMinusOne) + 1;
+        if (index >= entries.size() || length > VoxelChunk::VOLUME - filled) return false;
+        const Cell value = entries[index];
+        for (size_t m = filled; m < filled + length; m++) {
+            cells[order[m]] = value;
+        }
+        filled += length;
+    }
+    return filled == static_cast<size_t>(VoxelChunk::VOLUME);
+}
+
+void encodeLinearRle(const Cell* cells, std::vector<uint8_t>& out) {
+    out.clear();
+    int i = 0;
+    while (i < VoxelChunk::VOLUME) {
+        Cell value = cells[i];
+        int run = 1;
+        while (i + run < VoxelChunk::VOLUME && cells[i + run] == value && run < UINT16_MAX) {
+            run++;
+        }
+        put16(out, static_cast<uint16_t>(run));
+        put16(out, value);
+        i += run;
+    }
+}
+
+bool decodeLinearRle(const uint8_t* data, size_t size, Cell* cells) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+    int filled = 0;
+    while (cursor < end) {
+        uint16_t run;
+        Cell value;
+        if (!get16(cursor, end, run) || !get16(cursor, end, value) ||
+            run == 0 || filled + run > VoxelChunk::VOLUME) {
+            return false;
+        }
+        std::fill(cells + filled, cells + filled + run, value);
+        filled += run;
+    }
+    return filled == VoxelChunk::VOLUME;
+}
+
+uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Comprimento estendido: nibble 15 continua em bytes de 255
+ */
+void putLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+bool getLength(const uint8_t*& cursor, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (cursor >= end) return false;
+        byte = *cursor++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+void emitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                  size_t offset, size_t matchLength) {
+    const size_t matchCode = matchLength >= LZ_MIN_MATCH ? matchLength - LZ_MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+    out.push_back(token);
+    if (literalCount >= 15) putLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0) return;     // Última sequência: só literais
+
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) putLength(out, matchCode - 15);
+}
+
+} // namespace
+
+bool ChunkCodec::MemorySource::decodeChunk(size_t, VoxelChunk::Cell* cells) const {
+    return ChunkCodec::decode(codec, data.data(), data.size(), cells);
+}
+
+void ChunkCodec::encode(Codec codec, const VoxelChunk::Cell* cells, std::vector<uint8_t>& out) {
+    switch (codec) {
+        case Codec::RAW:
+            out.resize(RAW_BYTES);
+            std::memcpy(out.data(), cells, RAW_BYTES);
+            return;
+        case Codec::RLE:
+            encodeLinearRle(cells, out);
+            return;
+        case Codec::PALETTE:
+        case Codec::MORTON_RLE:
+        case Codec::PALETTE_LZ: {
+            thread_local Analysis analysis;
+            analyze(cells, analysis, codec == Codec::MORTON_RLE);
+            if (codec == Codec::MORTON_RLE) {
+                encodeMorton(analysis, out);
+            } else if (codec == Codec::PALETTE) {
+                encodePalette(analysis, out);
+            } else {
+                encodePaletteLz(analysis, out);
+            }
+            return;
+        }
+    }
+}
+
+ChunkCodec::Codec ChunkCodec::encodeBest(const VoxelChunk::Cell* cells, std::vector<uint8_t>& out) {
+    thread_local Analysis analysis;
+    analyze(cells, analysis, true);
+
+    // Tamanhos de PALETTE e MORTON_RLE são conhecidos sem codificar
+    Codec codec = analysis.mortonBytes() <= analysis.paletteBytes() ? Codec::MORTON_RLE : Codec::PALETTE;
+    size_t bestSize = std::min(analysis.mortonBytes(), analysis.paletteBytes());
+    if (bestSize >= RAW_BYTES) {
+        encode(Codec::RAW, cells, out);
+        return Codec::RAW;
+    }
+
+    if (codec == Codec::MORTON_RLE) {
+        encodeMorton(analysis, out);
+    } else {
+        encodePalette(analysis, out);
+    }
+
+    // Padrões sem sequências longas (texturas, ruído repetido): tenta o LZ sobre PALETTE
+    if (bestSize > LZ_THRESHOLD && analysis.bits > 0) {
+        thread_local std::vector<uint8_t> compressed;
+        encodePaletteLz(analysis, compressed);
+        if (compressed.size() < out.size()) {
+            out.swap(compressed);
+            codec = Codec::PALETTE_LZ;
+        }
+    }
+    return codec;
+}
+
+bool ChunkCodec::decode(Codec codec, const uint8_t* data, size_t size, VoxelChunk::Cell* cells) {
+    switch (codec) {
+        case Codec::RAW:
+            if (size != RAW_BYTES) return false;
+            std::memcpy(cells, data, size);
+            return true;
+        case Codec::RLE:
+            return decodeLinearRle(data, size, cells);
+        case Codec::PALETTE:
+        case Codec::PALETTE_LZ: {
+            const uint8_t* cursor = data;
+            const uint8_t* end = data + size;
+            thread_local std::vector<Cell> entries;
+            if (!readPaletteHeader(cursor, end, entries)) return false;
+            if (codec == Codec::PALETTE) {
+                return decodeIndices(entries, cursor, static_cast<size_t>(end - cursor), cells);
+            }
+
+            thread_local std::vector<uint8_t> packed;
+            packed.resize(VoxelChunk::VOLUME * static_cast<size_t>(bitsFor(entries.size())) / 8);
+            return lzDecompress(cursor, static_cast<size_t>(end - cursor), packed.data(), packed.size()) &&
+                   decodeIndices(entries, packed.data(), packed.size(), cells);
+        }
+        case Codec::MORTON_RLE:
+            return decodeMorton(data, size, cells);
+    }
+    return false;
+}
+
+void ChunkCodec::lzCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    std::array<uint32_t, size_t(1) << LZ_HASH_BITS> table;
+    table.fill(0);      // Posição + 1 (0 = vazio)
+
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + LZ_MIN_MATCH <= size) {
+        const uint32_t sequence = read32(data + i);
+        const uint32_t hash = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+        const size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(i + 1);
+
+        if (candidate == 0 || i - (candidate - 1) > LZ_MAX_OFFSET || read32(data + candidate - 1) != sequence) {
+            i++;
+            continue;
+        }
+
+        const size_t reference = candidate - 1;
+        size_t length = LZ_MIN_MATCH;
+        while (i + length < size && data[reference + length] == data[i + length]) {
+            length++;
+        }
+        emitSequence(out, data + anchor, i - anchor, i - reference, length);
+        i += length;
+        anchor = i;
+    }
+
+    emitSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+bool ChunkCodec::lzDecompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+    size_t written = 0;
+    bool terminated = false;    // lzCompress sempre termina com uma sequência só de literais
+
+    while (cursor < end) {
+        uint8_t token = *cursor++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !getLength(cursor, end, literals)) return false;
+        if (literals > static_cast<size_t>(end - cursor) || literals > outSize - written) return false;
+        std::memcpy(out + written, cursor, literals);
+        written += literals;
+        cursor += literals;
+        if (cursor == end) {
+            terminated = true;
+            break;
+        }
+
+        if (end - cursor < 2) return false;
+        size_t offset = cursor[0] | (static_cast<size_t>(cursor[1]) << 8);
+        cursor += 2;
+        size_t match = token & 15;
+        if (match == 15 && !getLength(cursor, end, match)) return false;
+        match += LZ_MIN_MATCH;
+        if (offset == 0 || offset > written || match > outSize - written) return false;
+
+        // Cópias podem se sobrepor (offset < comprimento repete o padrão)
+        uint8_t* target = out + written;
+        const uint8_t* from = target - offset;
+        if (offset >= match) {
+            std::memcpy(target, from, match);
+        } else {
+            for (size_t k = 0; k < match; k++) {
+                target[k] = from[k];
+            }
+        }
+        written += match;
+    }
+    return terminated && written == outSize;
+}
+
+const char* ChunkCodec::getName(Codec codec) {
+    switch (codec) {
+        case Codec::RAW: return "raw";
+        case Codec::RLE: return "rle";
+        case Codec::PALETTE: return "palette";
+        case Codec::MORTON_RLE: return "morton-rle";
+        case Codec::PALETTE_LZ: return "palette-lz";
+    }
+    return "?";
+}
+
+std::vector<ChunkCodec::BenchmarkResult> ChunkCodec::benchmark(const VoxelGrid& grid) {
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    std::vector<std::vector<Cell>> chunks;
+    for (const auto& pair : grid.getChunks()) {
+        chunks.emplace_back(VoxelChunk::VOLUME);
+        pair.second->copyCells(chunks.back().data());
+    }
+
+    std::vector<BenchmarkResult> results;
+    std::vector<std::vector<uint8_t>> blocks(chunks.size());
+    std::vector<Codec> codecs(chunks.size());
+    std::vector<Cell> decoded(VoxelChunk::VOLUME);
+
+    for (int c = 0; c <= CODEC_COUNT; c++) {
+        const bool automatic = c == CODEC_COUNT;
+        BenchmarkResult result;
+        result.name = automatic ? "auto" : getName(static_cast<Codec>(c));
+        result.chunks = chunks.size();
+        result.rawBytes = static_cast<uint64_t>(chunks.size()) * RAW_BYTES;
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < chunks.size(); i++) {
+            if (automatic) {
+                codecs[i] = encodeBest(chunks[i].data(), blocks[i]);
+            } else {
+                codecs[i] = static_cast<Codec>(c);
+                encode(codecs[i], chunks[i].data(), blocks[i]);
+            }
+        }
+        result.encodeMs = elapsedMs(start);
+
+        start = Clock::now();
+        for (size_t i = 0; i < chunks.size(); i++) {
+            result.verified = decode(codecs[i], blocks[i].data(), blocks[i].size(), decoded.data()) && result.verified;
+            result.encodedBytes += blocks[i].size();
+        }
+        result.decodeMs = elapsedMs(start);
+
+        // Conferência fora da medição
+        for (size_t i = 0; i < chunks.size(); i++) {
+            decode(codecs[i], blocks[i].data(), blocks[i].size(), decoded.data());
+            result.verified = result.verified && decoded == chunks[i];
+        }
+        results.push_back(result);
+    }
+    return results;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,182 @@
+#include "core/ChunkHashTree.hpp"
+
+namespace VoxelMaker {
+
+namespace {
+
+constexpr int BRANCH_MASK = (1 << ChunkHashTree::BRANCH_SHIFT) - 1;
+
+uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @brief Contribuição de um filho para o hash do pai (nível 0 = folhas, LEVELS = raiz)
+ */
+uint64_t childTerm(int level, const glm::ivec3& coord, uint64_t hash) {
+    uint64_t position = ChunkHashTree::CoordHash()(coord) + static_cast<uint64_t>(level) * 0x9E3779B97F4A7C15ull;
+    return mix(hash ^ mix(position));
+}
+
+glm::ivec3 parentOf(const glm::ivec3& coord) {
+    return glm::ivec3(coord.x >> ChunkHashTree::BRANCH_SHIFT,
+                      coord.y >> ChunkHashTree::BRANCH_SHIFT,
+                      coord.z >> ChunkHashTree::BRANCH_SHIFT);
+}
+
+uint64_t childBit(const glm::ivec3& coord) {
+    int branch = 1 << ChunkHashTree::BRANCH_SHIFT;
+    return uint64_t(1) << ((coord.x & BRANCH_MASK) + branch * ((coord.y & BRANCH_MASK) + branch * (coord.z & BRANCH_MASK)));
+}
+
+glm::ivec3 childAt(const glm::ivec3& parent, int bit) {
+    int branch = 1 << ChunkHashTree::BRANCH_SHIFT;
+    return glm::ivec3(parent.x * branch + bit % branch,
+                      parent.y * branch + (bit / branch) % branch,
+                      parent.z * branch + bit / (branch * branch));
+}
+
+} // namespace
+
+ChunkHashTree::ChunkHashTree()
+    : leaves()
+    , levels()
+    , root(0) {
+}
+
+bool ChunkHashTree::findLeaf(const glm::ivec3& coord, uint64_t& hash) const {
+    auto it = leaves.find(coord);
+    if (it == leaves.end()) {
+        return false;
+    }
+    hash = it->second;
+    return true;
+}
+
+void ChunkHashTree::set(const glm::ivec3& coord, uint64_t hash) {
+    auto result = leaves.emplace(coord, hash);
+    if (result.second) {
+        propagate(coord, 0, hash, false, true);
+        return;
+    }
+    uint64_t previous = result.first->second;
+    if (previous != hash) {
+        result.first->second = hash;
+        propagate(coord, previous, hash, true, true);
+    }
+}
+
+void ChunkHashTree::remove(const glm::ivec3& coord) {
+    auto it = leaves.find(coord);
+    if (it == leaves.end()) {
+        return;
+    }
+    uint64_t previous = it->second;
+    leaves.erase(it);
+    propagate(coord, previous, 0, true, false);
+}
+
+void ChunkHashTree::clear() {
+    leaves.clear();
+    for (NodeMap& level : levels) {
+        level.clear();
+    }
+    root = 0;
+}
+
+void ChunkHashTree::propagate(glm::ivec3 coord, uint64_t oldHash, uint64_t newHash, bool existed, bool exists) {
+    for (int level = 0; level < LEVELS; level++) {
+        uint64_t oldTerm = existed ? childTerm(level, coord, oldHash) : 0;
+        uint64_t newTerm = exists ? childTerm(level, coord, newHash) : 0;
+        glm::ivec3 parent = parentOf(coord);
+        uint64_t bit = childBit(coord);
+
+        // Um pai sem filhos é removido; a soma dos termos restantes volta exatamente a zero
+        NodeMap& nodes = levels[level];
+        auto it = nodes.emplace(parent, Node()).first;
+        Node& node = it->second;
+        bool parentExisted = node.children != 0;
+        uint64_t parentOld = node.hash;
+        node.hash += newTerm - oldTerm;
+        node.children = exists ? (node.children | bit) : (node.children & ~bit);
+        bool parentExists = node.children != 0;
+        uint64_t parentNew = node.hash;
+        if (!parentExists) {
+            nodes.erase(it);
+        }
+
+        coord = parent;
+        oldHash = parentOld;
+        newHash = parentNew;
+        existed = parentExisted;
+        exists = parentExists;
+    }
+    root += (exists ? childTerm(LEVELS, coord, newHash) : 0) - (existed ? childTerm(LEVELS, coord, oldHash) : 0);
+}
+
+ChunkHashTree::Difference ChunkHashTree::diff(const ChunkHashTree& base, const ChunkHashTree& target) {
+    Difference difference;
+    if (base.root == target.root) {
+        return difference;
+    }
+
+    // Abaixo da raiz há poucos nós (cada um cobre 4⁶ chunks por eixo)
+    const NodeMap& baseTop = base.levels[LEVELS - 1];
+    const NodeMap& targetTop = target.levels[LEVELS - 1];
+    for (const auto& pair : targetTop) {
+        difference.visitedNodes++;
+        auto found = baseTop.find(pair.first);
+        if (found == baseTop.end() || found->second.hash != pair.second.hash) {
+            diffNode(base, target, LEVELS - 1, pair.first, difference);
+        }
+    }
+    for (const auto& pair : baseTop) {
+        if (targetTop.find(pair.first) == targetTop.end()) {
+            difference.visitedNodes++;
+            diffNode(base, target, LEVELS - 1, pair.first, difference);
+        }
+    }
+    return difference;
+}
+
+void ChunkHashTree::diffNode(const ChunkHashTree& base, const ChunkHashTree& target, int level,
+                             const glm::ivec3& coord, Difference& difference) {
+    auto baseNode = base.levels[level].find(coord);
+    auto targetNode = target.levels[level].find(coord);
+    uint64_t baseChildren = baseNode != base.levels[level].end() ? baseNode->second.children : 0;
+    uint64_t targetChildren = targetNode != target.levels[level].end() ? targetNode->second.children : 0;
+    uint64_t children = baseChildren | targetChildren;
+
+    while (children != 0) {
+        int bit = 0;
+        while (((children >> bit) & 1) == 0) {
+            bit++;
+        }
+        children &= children - 1;
+        glm::ivec3 child = childAt(coord, bit);
+        bool inBase = (baseChildren >> bit) & 1;
+        bool inTarget = (targetChildren >> bit) & 1;
+        difference.visitedNodes++;
+
+        if (level == 0) {
+            if (!inTarget) {
+                difference.removed.push_back(child);
+            } else if (!inBase || base.leaves.at(child) != target.leaves.at(child)) {
+                difference.changed.push_back(child);
+            }
+            continue;
+        }
+
+        if (inBase && inTarget && base.levels[level - 1].at(child).hash == target.levels[level - 1].at(child).hash) {
+            continue;
+        }
+        diffNode(base, target, level - 1, child, difference);
+    }
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,361 @@
+#include "core/GridDelta.hpp"
+#include "core/ChunkCodec.hpp"
+#include "core/VoxelFile.hpp"
+#include "utils/FileUtils.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace VoxelMaker {
+
+namespace {
+
+struct DeltaHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t baseHash;          ///< VoxelGrid::getContentHash da base
+    uint64_t targetHash;        ///< VoxelGrid::getContentHash do destino (informativo)
+    int32_t dimensions[3];
+    int32_t origin[3];
+    uint32_t flags;
+    uint32_t paletteFirst;      ///< Índice da primeira entrada enviada (as anteriores são as da base)
+    uint32_t paletteCount;      ///< Entradas enviadas
+    uint32_t paletteBytes;
+    uint32_t removedCount;
+    uint32_t changedCount;
+    uint32_t basePaletteChecksum;   ///< CRC-32 de VoxelFile::encodePalette da paleta da base
+    uint32_t reserved;
+};
+static_assert(sizeof(DeltaHeader) == 80, "Cabeçalho do delta mudou de tamanho");
+
+struct DeltaChunk {
+    int32_t coord[3];
+    uint32_t size;              ///< Bytes do bloco após este registro
+    uint8_t codec;              ///< ChunkCodec::Codec
+    uint8_t reserved[3];
+};
+static_assert(sizeof(DeltaChunk) == 20, "Registro de chunk do delta mudou de tamanho");
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+bool sameEntry(const Voxel& a, const Voxel& b) {
+    const Voxel::Color& ca = a.getColor();
+    const Voxel::Color& cb = b.getColor();
+    const Voxel::Material& ma = a.getMaterial();
+    const Voxel::Material& mb = b.getMaterial();
+    return ca.r == cb.r && ca.g == cb.g && ca.b == cb.b && ca.a == cb.a && a.isActive() == b.isActive() &&
+           ma.roughness == mb.roughness && ma.metallic == mb.metallic &&
+           ma.transparency == mb.transparency && ma.name == mb.name;
+}
+
+/**
+ * @brief CRC-32 das entradas de uma paleta, como gravadas por VoxelFile::encodePalette
+ */
+uint32_t paletteChecksum(const VoxelPalette& palette) {
+    std::vector<uint8_t> bytes = VoxelFile::encodePalette(palette);
+    return FileUtils::crc32(bytes.data(), bytes.size());
+}
+
+/**
+ * @brief Os índices em comum das duas paletas representam a mesma aparência
+ */
+bool palettesCompatible(const VoxelPalette& a, const VoxelPalette& b) {
+    size_t common = std::min(a.size(), b.size());
+    for (size_t i = 1; i < common; i++) {
+        if (!sameEntry(a.get(static_cast<VoxelPalette::Index>(i)), b.get(static_cast<VoxelPalette::Index>(i)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool GridDelta::compute(const VoxelGrid& base, const VoxelGrid& target) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+    data.clear();
+
+    const ChunkHashTree& baseTree = base.getHashTree();
+    const ChunkHashTree& targetTree = target.getHashTree();
+
+    std::vector<glm::ivec3> changed;
+    std::vector<glm::ivec3> removed;
+    if (palettesCompatible(base.getPalette(), target.getPalette())) {
+        ChunkHashTree::Difference difference = ChunkHashTree::diff(baseTree, targetTree);
+        changed.swap(difference.changed);
+        removed.swap(difference.removed);
+        stats.visitedNodes = difference.visitedNodes;
+    } else {
+        // Mesmo índice com cores diferentes: hashes iguais não garantem o mesmo conteúdo
+        stats.full = true;
+        for (const auto& pair : target.getChunks()) {
+            changed.push_back(pair.first);
+        }
+        for (const auto& pair : base.getChunks()) {
+            if (!target.getChunk(pair.first)) {
+                removed.push_back(pair.first);
+            }
+        }
+    }
+    stats.changedChunks = changed.size();
+    stats.removedChunks = removed.size();
+    stats.diffMs = elapsedMs(start);
+
+    auto encodeStart = std::chrono::steady_clock::now();
+
+    // Células com os índices do destino: o delta leva as entradas da paleta do destino
+    // que a base não tem (ou a paleta inteira, se incompatíveis) e o grid que recebe o
+    // delta termina com os mesmos índices, e portanto o mesmo hash, que o destino
+    const VoxelPalette& targetPalette = target.getPalette();
+    size_t paletteFirst = stats.full ? 1 : base.getPalette().size();
+    std::vector<uint8_t> paletteBytes;
+    if (targetPalette.size() > paletteFirst) {
+        paletteBytes = VoxelFile::encodePalette(targetPalette, paletteFirst);
+    }
+    size_t paletteCount = targetPalette.size() > paletteFirst ? targetPalette.size() - paletteFirst : 0;
+
+    std::vector<std::vector<uint8_t>> blocks(changed.size());
+    std::vector<uint8_t> codecs(changed.size(), 0);
+    ThreadPool::getInstance().parallelFor(changed.size(), [&](size_t i) {
+        thread_local std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME);
+        target.getChunk(changed[i])->copyCells(cells.data());
+        codecs[i] = static_cast<uint8_t>(ChunkCodec::encodeBest(cells.data(), blocks[i]));
+    });
+
+    DeltaHeader header = {};
+    header.magic = DELTA_MAGIC;
+    header.version = DELTA_VERSION;
+    header.baseHash = baseTree.getRoot();
+    header.targetHash = targetTree.getRoot();
+    header.dimensions[0] = target.getDimensions().width;
+    header.dimensions[1] = target.getDimensions().height;
+    header.dimensions[2] = target.getDimensions().depth;
+    header.origin[0] = target.getOrigin().x;
+    header.origin[1] = target.getOrigin().y;
+    header.origin[2] = target.getOrigin().z;
+    header.flags = stats.full ? FLAG_FULL : 0;
+    header.paletteFirst = static_cast<uint32_t>(paletteFirst);
+    header.paletteCount = static_cast<uint32_t>(paletteCount);
+    header.paletteBytes = static_cast<uint32_t>(paletteBytes.size());
+    header.removedCount = static_cast<uint32_t>(removed.size());
+    header.changedCount = static_cast<uint32_t>(changed.size());
+    header.basePaletteChecksum = paletteChecksum(base.getPalette());
+
+    size_t total = sizeof(header) + paletteBytes.size() + removed.size() * 3 * sizeof(int32_t) + sizeof(uint32_t);
+    for (const std::vector<uint8_t>& block : blocks) {
+        total += sizeof(DeltaChunk) + block.size();
+    }
+    data.reserve(total);
+    appendValue(data, header);
+    data.insert(data.end(), paletteBytes.begin(), paletteBytes.end());
+    for (const glm::ivec3& coord : removed) {
+        int32_t values[3] = { coord.x, coord.y, coord.z };
+        appendValue(data, values);
+    }
+    for (size_t i = 0; i < changed.size(); i++) {
+        DeltaChunk record = {};
+        record.coord[0] = changed[i].x;
+        record.coord[1] = changed[i].y;
+        record.coord[2] = changed[i].z;
+        record.size = static_cast<uint32_t>(blocks[i].size());
+        record.codec = codecs[i];
+        appendValue(data, record);
+        data.insert(data.end(), blocks[i].begin(), blocks[i].end());
+    }
+    appendValue(data, FileUtils::crc32(data.data(), data.size()));
+
+    stats.paletteEntries = paletteCount;
+    stats.encodedBytes = data.size();
+    stats.encodeMs = elapsedMs(encodeStart);
+    return true;
+}
+
+bool GridDelta::validate() const {
+    if (data.size() < sizeof(DeltaHeader) + sizeof(uint32_t)) {
+        std::cerr << "Delta truncado" << std::endl;
+        return false;
+    }
+    DeltaHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != DELTA_MAGIC || header.version != DELTA_VERSION) {
+        std::cerr << "Delta com formato desconhecido" << std::endl;
+        return false;
+    }
+
+    size_t body = data.size() - sizeof(uint32_t);
+    uint32_t checksum;
+    std::memcpy(&checksum, data.data() + body, sizeof(checksum));
+    if (FileUtils::crc32(data.data(), body) != checksum) {
+        std::cerr << "Delta corrompido (checksum)" << std::endl;
+        return false;
+    }
+
+    // Os registros de chunk precisam fechar exatamente no checksum
+    uint64_t cursor = sizeof(header) + static_cast<uint64_t>(header.paletteBytes) +
+                      static_cast<uint64_t>(header.removedCount) * 3 * sizeof(int32_t);
+    uint32_t records = 0;
+    for (; records < header.changedCount && cursor + sizeof(DeltaChunk) <= body; records++) {
+        DeltaChunk record;
+        std::memcpy(&record, data.data() + cursor, sizeof(record));
+        cursor += sizeof(record) + record.size;
+    }
+    if (records != header.changedCount || cursor != body) {
+        std::cerr << "Delta corrompido (tamanhos)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool GridDelta::apply(VoxelGrid& grid) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+    if (!validate()) {
+        return false;
+    }
+
+    DeltaHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    const bool full = (header.flags & FLAG_FULL) != 0;
+    if (grid.getContentHash() != header.baseHash || paletteChecksum(grid.getPalette()) != header.basePaletteChecksum) {
+        std::cerr << "Delta não corresponde ao grid: base diferente" << std::endl;
+        return false;
+    }
+
+    const uint8_t* cursor = data.data() + sizeof(header);
+    VoxelPalette palette;
+    std::vector<VoxelPalette::Index> decoded;
+    if ((full ? header.paletteFirst != 1 : header.paletteFirst != grid.getPalette().size()) ||
+        static_cast<uint64_t>(header.paletteFirst) + header.paletteCount > VoxelPalette::MAX_ENTRIES ||
+        !VoxelFile::decodePalette(cursor, header.paletteBytes, header.paletteCount, palette, decoded) ||
+        palette.size() != decoded.size()) {
+        std::cerr << "Delta corrompido (paleta)" << std::endl;
+        return false;
+    }
+    cursor += header.paletteBytes;
+    const size_t paletteSize = full ? palette.size() : std::max<size_t>(grid.getPalette().size(),
+                                                                         header.paletteFirst + header.paletteCount);
+
+    std::vector<glm::ivec3> removed(header.removedCount);
+    for (glm::ivec3& coord : removed) {
+        int32_t values[3];
+        std::memcpy(values, cursor, sizeof(values));
+        coord = glm::ivec3(values[0], values[1], values[2]);
+        cursor += sizeof(values);
+    }
+
+    std::vector<DeltaChunk> records(header.changedCount);
+    std::vector<const uint8_t*> blocks(header.changedCount);
+    for (uint32_t i = 0; i < header.changedCount; i++) {
+        std::memcpy(&records[i], cursor, sizeof(DeltaChunk));
+        blocks[i] = cursor + sizeof(DeltaChunk);
+        cursor += sizeof(DeltaChunk) + records[i].size;
+    }
+
+    // Tudo é decodificado antes de mexer no grid: um bloco inválido deixa o grid intacto
+    std::vector<std::vector<VoxelChunk::Cell>> cells(header.changedCount);
+    std::vector<uint8_t> valid(header.changedCount, 0);
+    ThreadPool::getInstance().parallelFor(header.changedCount, [&](size_t i) {
+        cells[i].resize(VoxelChunk::VOLUME);
+        if (!ChunkCodec::decode(static_cast<ChunkCodec::Codec>(records[i].codec), blocks[i], records[i].size,
+                                cells[i].data())) {
+            return;
+        }
+        for (VoxelChunk::Cell cell : cells[i]) {
+            if (cell >= paletteSize) {
+                return;
+            }
+        }
+        valid[i] = 1;
+    });
+    if (std::count(valid.begin(), valid.end(), 0) > 0) {
+        std::cerr << "Delta corrompido (chunks)" << std::endl;
+        return false;
+    }
+
+    // As entradas enviadas continuam a paleta do grid nos mesmos índices do destino;
+    // conferido em uma cópia para deixar o grid intacto se alguma cair em outro índice
+    if (!full) {
+        VoxelPalette extended = grid.getPalette();
+        for (size_t i = 1; i < decoded.size(); i++) {
+            if (extended.findOrAdd(palette.get(decoded[i])) != header.paletteFirst + i - 1) {
+                std::cerr << "Paleta do grid diverge da do delta" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<VoxelChunk>> chunks(header.changedCount);
+    ThreadPool::getInstance().parallelFor(chunks.size(), [&](size_t i) {
+        glm::ivec3 coord(records[i].coord[0], records[i].coord[1], records[i].coord[2]);
+        chunks[i] = std::make_unique<VoxelChunk>(coord, std::move(cells[i]));
+    });
+
+    // Num delta completo a paleta enviada substitui a do grid (setPalette esvazia o grid)
+    if (full) {
+        grid.setPalette(palette);
+    } else {
+        for (size_t i = 1; i < decoded.size(); i++) {
+            grid.addPaletteEntry(palette.get(decoded[i]));
+        }
+    }
+    grid.setDimensions(VoxelGrid::Dimensions(header.dimensions[0], header.dimensions[1], header.dimensions[2]));
+    grid.setOrigin(glm::ivec3(header.origin[0], header.origin[1], header.origin[2]));
+    for (const glm::ivec3& coord : removed) {
+        grid.insertChunk(std::make_unique<VoxelChunk>(coord));     // Vazio: remove
+    }
+    for (std::unique_ptr<VoxelChunk>& chunk : chunks) {
+        grid.insertChunk(std::move(chunk));
+    }
+
+    stats.changedChunks = header.changedCount;
+    stats.removedChunks = header.removedCount;
+    stats.paletteEntries = header.paletteCount;
+    stats.encodedBytes = data.size();
+    stats.full = full;
+    stats.applyMs = elapsedMs(start);
+    return true;
+}
+
+bool GridDelta::save(const std::string& path) const {
+    if (data.empty()) {
+        std::cerr << "Delta vazio: nada a gravar em " << path << std::endl;
+        return false;
+    }
+    return FileUtils::writeFileAtomic(path, data);
+}
+
+bool GridDelta::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Erro ao abrir delta: " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> contents(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(contents.size()))) {
+        std::cerr << "Erro ao ler delta: " << path << std::endl;
+        return false;
+    }
+    data.swap(contents);
+    stats = Stats();
+    if (!validate()) {
+        data.clear();
+        return false;
+    }
+    stats.encodedBytes = data.size();
+    return true;
+}
+
+} // namespace VoxelMaker
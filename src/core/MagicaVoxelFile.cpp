@@ -0,0 +1,854 @@
+#include "core/MagicaVoxelFile.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
+namespace VoxelMaker {
+
+namespace {
+
+constexpr uint32_t fourCC(const char (&id)[5]) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(id[0])) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(id[1])) << 8) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(id[2])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(id[3])) << 24);
+}
+
+constexpr uint32_t ID_VOX = fourCC("VOX ");
+constexpr uint32_t ID_MAIN = fourCC("MAIN");
+constexpr uint32_t ID_SIZE = fourCC("SIZE");
+constexpr uint32_t ID_XYZI = fourCC("XYZI");
+constexpr uint32_t ID_RGBA = fourCC("RGBA");
+constexpr uint32_t ID_TRANSFORM = fourCC("nTRN");
+constexpr uint32_t ID_GROUP = fourCC("nGRP");
+constexpr uint32_t ID_SHAPE = fourCC("nSHP");
+constexpr uint32_t ID_LAYER = fourCC("LAYR");
+
+constexpr int MAX_SCENE_DEPTH = 64;
+constexpr size_t MAX_SCENE_INSTANCES = 65536;  ///< Grupos que repetem subárvores multiplicam instâncias
+constexpr size_t MAX_SCENE_VISITS = 1 << 20;    ///< Idem para nós visitados (mesmo sem shapes)
+
+using Dictionary = std::map<std::string, std::string>;
+
+int floorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+        quotient--;
+    }
+    return quotient;
+}
+
+/**
+ * @brief Rotação/reflexão inteira do MagicaVoxel (uma entrada ±1 por linha)
+ */
+struct Rotation {
+    int m[3][3];
+
+    static Rotation identity() {
+        Rotation r = {};
+        r.m[0][0] = r.m[1][1] = r.m[2][2] = 1;
+        return r;
+    }
+
+    /**
+     * @brief Decodifica o byte _r: bits 0-1 e 2-3 = coluna não nula das linhas 0 e 1,
+     *        bits 4-6 = sinais das linhas 0, 1 e 2
+     */
+    static Rotation decode(int bits) {
+        int first = bits & 3;
+        int second = (bits >> 2) & 3;
+        if (first > 2 || second > 2 || first == second) {
+            return identity();
+        }
+
+        Rotation r = {};
+        r.m[0][first] = (bits & (1 << 4)) ? -1 : 1;
+        r.m[1][second] = (bits & (1 << 5)) ? -1 : 1;
+        r.m[2][3 - first - second] = (bits & (1 << 6)) ? -1 : 1;
+        return r;
+    }
+
+    glm::ivec3 apply(const glm::ivec3& v) const {
+        return glm::ivec3(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+                          m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+                          m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+    }
+
+    Rotation operator*(const Rotation& other) const {
+        Rotation r = {};
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                for (int k = 0; k < 3; k++) {
+                    r.m[i][j] += m[i][k] * other.m[k][j];
+                }
+            }
+        }
+        return r;
+    }
+};
+
+struct Transform {
+    Rotation rotation;
+    glm::ivec3 translation;
+
+    static Transform identity() { return {Rotation::identity(), glm::ivec3(0)}; }
+
+    Transform operator*(const Transform& child) const {
+        return {rotation * child.rotation, rotation.apply(child.translation) + translation};
+    }
+};
+
+struct Model {
+    glm::ivec3 size;
+    std::vector<uint32_t> voxels;   ///< x, y, z e índice de cor em um byte cada
+};
+
+enum class NodeType { TRANSFORM, GROUP, SHAPE };
+
+struct Node {
+    NodeType type;
+    std::string name;
+    bool hidden;
+    int layer;
+    Transform transform;
+    std::vector<int> children;      ///< Filhos (transformação: um; grupo: vários)
+    std::vector<int> models;        ///< Modelos de um nó de forma
+};
+
+struct Instance {
+    int model;
+    Transform transform;
+    std::string name;
+};
+
+/**
+ * @brief Posição no espaço do MagicaVoxel de uma célula de modelo instanciada
+ *
+ * A célula v ocupa [v, v+1]; o modelo gira em torno do seu centro (size / 2).
+ * 2p = R(2v + 1 - size) + 2t, e a célula é floor(p).
+ */
+glm::ivec3 placeVoxel(const Transform& transform, const glm::ivec3& size, const glm::ivec3& v) {
+    glm::ivec3 doubled = transform.rotation.apply(v * 2 + glm::ivec3(1) - size) + transform.translation * 2;
+    return glm::ivec3(floorDiv(doubled.x, 2), floorDiv(doubled.y, 2), floorDiv(doubled.z, 2));
+}
+
+/**
+ * @brief MagicaVoxel (Z para cima) -> grid (Y para cima), preservando a orientação
+ */
+glm::ivec3 toGrid(const glm::ivec3& v) {
+    return glm::ivec3(v.x, v.z, -v.y - 1);
+}
+
+/**
+ * @brief Paleta padrão do MagicaVoxel (arquivos sem RGBA): cubo 6x6x6 seguido de rampas
+ *        de vermelho, verde, azul e cinza
+ */
+std::array<Voxel::Color, MagicaVoxelFile::PALETTE_SIZE> defaultPalette() {
+    std::array<Voxel::Color, MagicaVoxelFile::PALETTE_SIZE> colors;
+    colors[0] = Voxel::Color(0, 0, 0, 0);
+
+    const uint8_t cube[6] = {0xFF, 0xCC, 0x99, 0x66, 0x33, 0x00};
+    int index = 1;
+    for (int r = 0; r < 6; r++) {
+        for (int g = 0; g < 6; g++) {
+            for (int b = 0; b < 6 && index < 216; b++) {
+                colors[index++] = Voxel::Color(cube[r], cube[g], cube[b]);
+            }
+        }
+    }
+
+    const uint8_t ramp[10] = {0xEE, 0xDD, 0xBB, 0xAA, 0x88, 0x77, 0x55, 0x44, 0x22, 0x11};
+    for (int i = 0; i < 10; i++) colors[index++] = Voxel::Color(ramp[i], 0, 0);
+    for (int i = 0; i < 10; i++) colors[index++] = Voxel::Color(0, ramp[i], 0);
+    for (int i = 0; i < 10; i++) colors[index++] = Voxel::Color(0, 0, ramp[i]);
+    for (int i = 0; i < 10; i++) colors[index++] = Voxel::Color(ramp[i], ramp[i], ramp[i]);
+    return colors;
+}
+
+/**
+ * @brief Leitura sequencial de um arquivo .vox
+ */
+class VoxReader {
+private:
+    std::ifstream& file;
+
+public:
+    explicit VoxReader(std::ifstream& stream) : file(stream) {}
+
+    bool good() const { return static_cast<bool>(file); }
+
+    int32_t readInt() {
+        int32_t value = 0;
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+
+    std::string readString() {
+        int32_t length = readInt();
+        if (!file || length < 0 || length > (1 << 20)) {
+            file.setstate(std::ios::failbit);
+            return std::string();
+        }
+        std::string value(static_cast<size_t>(length), '\0');
+        file.read(&value[0], length);
+        return value;
+    }
+
+    Dictionary readDictionary() {
+        Dictionary dictionary;
+        int32_t count = readInt();
+        for (int32_t i = 0; file && i < count; i++) {
+            std::string key = readString();
+            dictionary[key] = readString();
+        }
+        return dictionary;
+    }
+
+    bool readBytes(void* data, size_t size) {
+        return static_cast<bool>(file.read(static_cast<char*>(data), static_cast<std::streamsize>(size)));
+    }
+};
+
+/**
+ * @brief Gravação sequencial com correção de tamanhos de chunks já escritos
+ */
+class VoxWriter {
+private:
+    std::ofstream& file;
+
+public:
+    explicit VoxWriter(std::ofstream& stream) : file(stream) {}
+
+    void writeInt(int32_t value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeString(const std::string& value) {
+        writeInt(static_cast<int32_t>(value.size()));
+        file.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    void writeDictionary(const Dictionary& dictionary) {
+        writeInt(static_cast<int32_t>(dictionary.size()));
+        for (const auto& pair : dictionary) {
+            writeString(pair.first);
+            writeString(pair.second);
+        }
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    /**
+     * @brief Escreve o cabeçalho de um chunk com tamanhos provisórios
+     * @return Posição do cabeçalho, para endChunk
+     */
+    std::streampos beginChunk(uint32_t id) {
+        std::streampos start = file.tellp();
+        writeBytes(&id, sizeof(id));
+        writeInt(0);
+        writeInt(0);
+        return start;
+    }
+
+    /**
+     * @brief Corrige os tamanhos do chunk iniciado em start
+     * @param contentEnd Fim do conteúdo (os filhos vão até a posição atual)
+     */
+    void endChunk(std::streampos start, std::streampos contentEnd) {
+        std::streampos end = file.tellp();
+        int32_t contentSize = static_cast<int32_t>(contentEnd - start) - 12;
+        int32_t childrenSize = static_cast<int32_t>(end - contentEnd);
+        file.seekp(start + std::streamoff(4));
+        writeInt(contentSize);
+        writeInt(childrenSize);
+        file.seekp(end);
+    }
+
+    void endChunk(std::streampos start) { endChunk(start, file.tellp()); }
+
+    bool good() const { return static_cast<bool>(file); }
+};
+
+/**
+ * @brief Reduz cores a no máximo maxColors por corte mediano
+ * @return Índice (0..n-1) da cor reduzida para cada cor de entrada, e as cores reduzidas
+ */
+std::vector<int> medianCut(const std::vector<Voxel::Color>& colors, size_t maxColors,
+                           std::vector<Voxel::Color>& reduced) {
+    std::vector<int> assignment(colors.size(), 0);
+    std::vector<std::vector<int>> boxes(1);
+    for (size_t i = 0; i < colors.size(); i++) {
+        boxes[0].push_back(static_cast<int>(i));
+    }
+
+    auto channel = [&](int color, int axis) {
+        const Voxel::Color& c = colors[static_cast<size_t>(color)];
+        return axis == 0 ? c.r : axis == 1 ? c.g : c.b;
+    };
+
+    while (boxes.size() < maxColors) {
+        // Caixa com a maior extensão em algum canal
+        int bestBox = -1;
+        int bestAxis = 0;
+        int bestRange = 0;
+        for (size_t b = 0; b < boxes.size(); b++) {
+            if (boxes[b].size() < 2) continue;
+            for (int axis = 0; axis < 3; axis++) {
+                int lo = 255, hi = 0;
+                for (int color : boxes[b]) {
+                    lo = std::min<int>(lo, channel(color, axis));
+                    hi = std::max<int>(hi, channel(color, axis));
+                }
+                if (hi - lo > bestRange) {
+                    bestRange = hi - lo;
+                    bestBox = static_cast<int>(b);
+                    bestAxis = axis;
+                }
+            }
+        }
+        if (bestBox < 0) break;
+
+        std::vector<int>& box = boxes[static_cast<size_t>(bestBox)];
+        size_t middle = box.size() / 2;
+        std::nth_element(box.begin(), box.begin() + static_cast<std::ptrdiff_t>(middle), box.end(),
+                         [&](int a, int b) { return channel(a, bestAxis) < channel(b, bestAxis); });
+        std::vector<int> upper(box.begin() + static_cast<std::ptrdiff_t>(middle), box.end());
+        box.resize(middle);
+        boxes.push_back(std::move(upper));
+    }
+
+    reduced.clear();
+    for (size_t b = 0; b < boxes.size(); b++) {
+        unsigned sum[4] = {0, 0, 0, 0};
+        for (int color : boxes[b]) {
+            const Voxel::Color& c = colors[static_cast<size_t>(color)];
+            sum[0] += c.r;
+            sum[1] += c.g;
+            sum[2] += c.b;
+            sum[3] += c.a;
+            assignment[static_cast<size_t>(color)] = static_cast<int>(b);
+        }
+        unsigned count = static_cast<unsigned>(std::max<size_t>(1, boxes[b].size()));
+        reduced.emplace_back(static_cast<uint8_t>(sum[0] / count), static_cast<uint8_t>(sum[1] / count),
+                             static_cast<uint8_t>(sum[2] / count), static_cast<uint8_t>(sum[3] / count));
+    }
+    return assignment;
+}
+
+} // namespace
+
+bool MagicaVoxelFile::load(const std::string& path, VoxelGrid& grid) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+    objects.clear();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Erro ao abrir arquivo .vox: " << path << std::endl;
+        return false;
+    }
+    const std::streamoff fileSize = file.tellg();
+    file.seekg(0);
+    stats.bytes = static_cast<uint64_t>(fileSize);
+
+    VoxReader reader(file);
+    uint32_t magic = 0;
+    reader.readBytes(&magic, sizeof(magic));
+    int32_t version = reader.readInt();
+    uint32_t mainId = 0;
+    reader.readBytes(&mainId, sizeof(mainId));
+    int32_t mainContent = reader.readInt();
+    int32_t mainChildren = reader.readInt();
+    if (!reader.good() || magic != ID_VOX || mainId != ID_MAIN || mainContent < 0 || mainChildren < 0) {
+        std::cerr << "Arquivo .vox inválido: " << path << std::endl;
+        return false;
+    }
+    if (version > FILE_VERSION) {
+        std::cerr << "Aviso: versão .vox " << version << " mais nova que a suportada (" << FILE_VERSION << ")" << std::endl;
+    }
+    file.seekg(mainContent, std::ios::cur);
+
+    std::vector<Model> models;
+    std::array<Voxel::Color, PALETTE_SIZE> palette = defaultPalette();
+    std::map<int, Node> nodes;
+    std::map<int, bool> hiddenLayers;
+    glm::ivec3 pendingSize(0);
+
+    // Percorre os filhos de MAIN um chunk por vez
+    const std::streamoff mainEnd = std::min<std::streamoff>(fileSize, file.tellg() + std::streamoff(mainChildren));
+    while (reader.good() && file.tellg() + std::streamoff(12) <= mainEnd) {
+        uint32_t id = 0;
+        reader.readBytes(&id, sizeof(id));
+        int32_t contentSize = reader.readInt();
+        int32_t childrenSize = reader.readInt();
+        const std::streamoff contentStart = file.tellg();
+        if (!reader.good() || contentSize < 0 || childrenSize < 0 || contentStart + contentSize > mainEnd) {
+            std::cerr << "Chunk truncado em " << path << std::endl;
+            return false;
+        }
+
+        if (id == ID_SIZE) {
+            pendingSize.x = reader.readInt();
+            pendingSize.y = reader.readInt();
+            pendingSize.z = reader.readInt();
+        } else if (id == ID_XYZI) {
+            Model model;
+            model.size = glm::clamp(pendingSize, glm::ivec3(0), glm::ivec3(MAX_MODEL_SIZE));
+            int64_t count = reader.readInt();
+            count = std::max<int64_t>(0, std::min<int64_t>(count, (contentSize - 4) / 4));
+            model.voxels.resize(static_cast<size_t>(count));
+            for (size_t offset = 0; offset < model.voxels.size(); offset += READ_BATCH) {
+                size_t batch = std::min(READ_BATCH, model.voxels.size() - offset);
+                reader.readBytes(&model.voxels[offset], batch * sizeof(uint32_t));
+            }
+            models.push_back(std::move(model));
+        } else if (id == ID_RGBA) {
+            // A entrada i do arquivo é o índice de cor i + 1
+            uint8_t rgba[PALETTE_SIZE * 4];
+            if (contentSize >= static_cast<int32_t>(sizeof(rgba)) && reader.readBytes(rgba, sizeof(rgba))) {
+                for (int i = 0; i + 1 < PALETTE_SIZE; i++) {
+                    palette[i + 1] = Voxel::Color(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2], rgba[i * 4 + 3]);
+                }
+            }
+        } else if (id == ID_TRANSFORM) {
+            Node node;
+            node.type = NodeType::TRANSFORM;
+            int id = reader.readInt();
+            Dictionary attributes = reader.readDictionary();
+            node.name = attributes["_name"];
+            node.hidden = attributes["_hidden"] == "1";
+            node.children.push_back(reader.readInt());
+            reader.readInt();   // Reservado
+            node.layer = reader.readInt();
+            node.transform = Transform::identity();
+            int32_t frames = reader.readInt();
+            for (int32_t f = 0; reader.good() && f < frames; f++) {
+                Dictionary frame = reader.readDictionary();
+                if (f > 0) continue;
+                if (frame.count("_r")) {
+                    node.transform.rotation = Rotation::decode(std::atoi(frame["_r"].c_str()));
+                }
+                if (frame.count("_t")) {
+                    std::istringstream values(frame["_t"]);
+                    values >> node.transform.translation.x >> node.transform.translation.y >> node.transform.translation.z;
+                }
+            }
+            nodes[id] = node;
+        } else if (id == ID_GROUP) {
+            Node node;
+            node.type = NodeType::GROUP;
+            node.hidden = false;
+            node.layer = -1;
+            node.transform = Transform::identity();
+            int id = reader.readInt();
+            Dictionary attributes = reader.readDictionary();
+            node.hidden = attributes["_hidden"] == "1";
+            int32_t children = reader.readInt();
+            for (int32_t c = 0; reader.good() && c < children; c++) {
+                node.children.push_back(reader.readInt());
+            }
+            nodes[id] = node;
+        } else if (id == ID_SHAPE) {
+            Node node;
+            node.type = NodeType::SHAPE;
+            node.hidden = false;
+            node.layer = -1;
+            node.transform = Transform::identity();
+            int id = reader.readInt();
+            reader.readDictionary();
+            int32_t count = reader.readInt();
+            for (int32_t m = 0; reader.good() && m < count; m++) {
+                node.models.push_back(reader.readInt());
+                reader.readDictionary();
+            }
+            nodes[id] = node;
+        } else if (id == ID_LAYER) {
+            int layer = reader.readInt();
+            Dictionary attributes = reader.readDictionary();
+            hiddenLayers[layer] = attributes["_hidden"] == "1";
+        }
+
+        // Pula o que não foi lido (chunks desconhecidos, MATL, rOBJ, campos novos...)
+        if (!reader.good()) {
+            std::cerr << "Chunk inválido em " << path << std::endl;
+            return false;
+        }
+        file.seekg(contentStart + contentSize + childrenSize);
+    }
+    stats.models = models.size();
+
+    // Instâncias: grafo de cena a partir do nó 0, ou cada modelo na origem (arquivos antigos)
+    std::vector<Instance> instances;
+    if (!nodes.empty() && nodes.find(0) == nodes.end()) {
+        std::cerr << "Grafo de cena sem nó raiz em " << path << "; modelos importados na origem" << std::endl;
+        nodes.clear();
+    }
+    if (nodes.empty()) {
+        for (size_t m = 0; m < models.size(); m++) {
+            Transform transform = Transform::identity();
+            transform.translation = models[m].size / 2;
+            instances.push_back({static_cast<int>(m), transform, "modelo " + std::to_string(m)});
+        }
+    } else {
+        // Nós no caminho atual: um filho que já está nele fecha um ciclo
+        std::unordered_set<int> onPath;
+        size_t visits = 0;
+        const char* error = nullptr;
+        std::function<void(int, const Transform&, const std::string&, int)> visit =
+            [&](int nodeId, const Transform& parent, const std::string& name, int depth) {
+            auto it = nodes.find(nodeId);
+            if (error || it == nodes.end() || depth > MAX_SCENE_DEPTH) return;
+            if (++visits > MAX_SCENE_VISITS) {
+                error = "nós demais no grafo de cena";
+                return;
+            }
+            const Node& node = it->second;
+
+            if (node.hidden || (node.layer >= 0 && hiddenLayers[node.layer])) {
+                stats.hiddenInstances++;
+                return;
+            }
+            if (!onPath.insert(nodeId).second) {
+                error = "ciclo no grafo de cena";
+                return;
+            }
+
+            switch (node.type) {
+                case NodeType::TRANSFORM:
+                    visit(node.children.front(), parent * node.transform,
+                          node.name.empty() ? name : node.name, depth + 1);
+                    break;
+                case NodeType::GROUP:
+                    for (int child : node.children) {
+                        visit(child, parent, name, depth + 1);
+                    }
+                    break;
+                case NodeType::SHAPE:
+                    for (int model : node.models) {
+                        if (model < 0 || static_cast<size_t>(model) >= models.size()) continue;
+                        if (instances.size() >= MAX_SCENE_INSTANCES) {
+                            error = "instâncias demais no grafo de cena";
+                            break;
+                        }
+                        instances.push_back({model, parent,
+                                             name.empty() ? "modelo " + std::to_string(model) : name});
+                    }
+                    break;
+            }
+            onPath.erase(nodeId);
+        };
+        visit(0, Transform::identity(), std::string(), 0);
+
+        if (error) {
+            std::cerr << "Arquivo MagicaVoxel inválido (" << error << "): " << path << std::endl;
+            return false;
+        }
+    }
+    stats.instances = instances.size();
+
+    // Limites da cena no grid (a caixa de cada modelo vira uma caixa)
+    glm::ivec3 lo(INT32_MAX), hi(INT32_MIN);
+    for (const Instance& instance : instances) {
+        const Model& model = models[static_cast<size_t>(instance.model)];
+        if (model.voxels.empty()) continue;
+        glm::ivec3 a = toGrid(placeVoxel(instance.transform, model.size, glm::ivec3(0)));
+        glm::ivec3 b = toGrid(placeVoxel(instance.transform, model.size, model.size - glm::ivec3(1)));
+        lo = glm::min(lo, glm::min(a, b));
+        hi = glm::max(hi, glm::max(a, b));
+    }
+    if (lo.x > hi.x) {
+        lo = hi = glm::ivec3(0);
+    }
+    const glm::ivec3 shift = -lo;
+
+    // Paleta do grid: uma entrada por índice de cor usado, criada no primeiro uso
+    VoxelPalette gridPalette;
+    std::array<VoxelPalette::Index, PALETTE_SIZE> remap;
+    std::array<bool, PALETTE_SIZE> mapped;
+    remap.fill(VoxelPalette::EMPTY);
+    mapped.fill(false);
+
+    // Escrita direta nos chunks, reaproveitando o último chunk (voxels chegam agrupados)
+    VoxelGrid::ChunkMap chunks;
+    glm::ivec3 cachedCoord(INT32_MIN);
+    VoxelChunk* cachedChunk = nullptr;
+
+    for (const Instance& instance : instances) {
+        const Model& model = models[static_cast<size_t>(instance.model)];
+        VoxelObject object(instance.name);
+        object.setSourceModel(instance.model);
+
+        // A posição é afim no índice do voxel (R é uma permutação com sinais): registra no
+        // objeto a matriz exata índice do modelo -> célula do grid
+        glm::ivec3 offset = toGrid(placeVoxel(instance.transform, model.size, glm::ivec3(0))) + shift;
+        glm::mat4 transform(1.0f);
+        for (int axis = 0; axis < 3; axis++) {
+            glm::ivec3 unit(0);
+            unit[axis] = 1;
+            glm::ivec3 rotated = instance.transform.rotation.apply(unit);
+            transform[axis] = glm::vec4(static_cast<float>(rotated.x), static_cast<float>(rotated.z),
+                                        static_cast<float>(-rotated.y), 0.0f);
+        }
+        transform[3] = glm::vec4(glm::vec3(offset), 1.0f);
+        object.setTransform(transform);
+
+        for (uint32_t packed : model.voxels) {
+            glm::ivec3 v(packed & 0xFF, (packed >> 8) & 0xFF, (packed >> 16) & 0xFF);
+            uint32_t color = packed >> 24;
+            if (color == 0 || v.x >= model.size.x || v.y >= model.size.y || v.z >= model.size.z) {
+                continue;
+            }
+            if (!mapped[color]) {
+                remap[color] = gridPalette.findOrAdd(Voxel(glm::ivec3(0), palette[color]));
+                mapped[color] = true;
+            }
+            VoxelPalette::Index cell = remap[color];
+            if (cell == VoxelPalette::EMPTY) continue;
+
+            glm::ivec3 position = toGrid(placeVoxel(instance.transform, model.size, v)) + shift;
+            glm::ivec3 coord = VoxelGrid::chunkCoordOf(position);
+            if (coord != cachedCoord) {
+                auto& slot = chunks[coord];
+                if (!slot) {
+                    slot = std::make_unique<VoxelChunk>(coord);
+                }
+                cachedCoord = coord;
+                cachedChunk = slot.get();
+            }
+            cachedChunk->set(position - coord * VoxelChunk::SIZE, cell);
+            object.include(position);
+            stats.voxels++;
+        }
+        objects.push_back(object);
+    }
+
+    grid.setDimensions(VoxelGrid::Dimensions(hi.x - lo.x + 1, hi.y - lo.y + 1, hi.z - lo.z + 1));
+    grid.setOrigin(glm::ivec3(0));
+    grid.setPalette(gridPalette);
+    for (auto& pair : chunks) {
+        grid.insertChunk(std::move(pair.second));
+    }
+
+    finishStats(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    return true;
+}
+
+bool MagicaVoxelFile::save(const VoxelGrid& grid, const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+    objects.clear();
+
+    // Cores das entradas ativas da paleta do grid, reduzidas a 255 se preciso
+    const VoxelPalette& gridPalette = grid.getPalette();
+    std::vector<Voxel::Color> colors;
+    std::map<uint32_t, int> uniqueColors;
+    std::vector<int> entryColor(gridPalette.size(), -1);
+    for (size_t i = 1; i < gridPalette.size(); i++) {
+        if (!gridPalette.isSolid(static_cast<VoxelPalette::Index>(i))) continue;
+        const Voxel::Color& c = gridPalette.get(static_cast<VoxelPalette::Index>(i)).getColor();
+        uint32_t key = static_cast<uint32_t>(c.r) | (static_cast<uint32_t>(c.g) << 8) |
+                       (static_cast<uint32_t>(c.b) << 16) | (static_cast<uint32_t>(c.a) << 24);
+        auto inserted = uniqueColors.emplace(key, static_cast<int>(colors.size()));
+        if (inserted.second) {
+            colors.push_back(c);
+        }
+        entryColor[i] = inserted.first->second;
+    }
+
+    std::vector<Voxel::Color> voxColors;
+    std::vector<int> reducedIndex = medianCut(colors, PALETTE_SIZE - 1, voxColors);
+    std::vector<uint8_t> cellColor(gridPalette.size(), 0);
+    for (size_t i = 0; i < entryColor.size(); i++) {
+        if (entryColor[i] >= 0) {
+            cellColor[i] = static_cast<uint8_t>(reducedIndex[static_cast<size_t>(entryColor[i])] + 1);
+        }
+    }
+
+    // Chunks agrupados em blocos de 256³ (um modelo por bloco), em ordem determinística
+    const int chunksPerModel = MAX_MODEL_SIZE / VoxelChunk::SIZE;
+    std::map<std::array<int, 3>, std::vector<const VoxelChunk*>> blocks;
+    for (const auto& pair : grid.getChunks()) {
+        glm::ivec3 coord = pair.first;
+        glm::ivec3 block(floorDiv(coord.x, chunksPerModel), floorDiv(coord.y, chunksPerModel),
+                         floorDiv(coord.z, chunksPerModel));
+        blocks[{block.z, block.y, block.x}].push_back(pair.second.get());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Erro ao criar arquivo .vox: " << path << std::endl;
+        return false;
+    }
+
+    VoxWriter writer(file);
+    writer.writeBytes(&ID_VOX, sizeof(ID_VOX));
+    writer.writeInt(FILE_VERSION);
+    std::streampos mainStart = writer.beginChunk(ID_MAIN);
+    std::streampos mainContentEnd = file.tellp();
+
+    const VoxelGrid::Dimensions& dimensions = grid.getDimensions();
+    const glm::ivec3 gridMax(dimensions.width, dimensions.height, dimensions.depth);
+    std::vector<glm::ivec3> translations;
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME);
+    std::vector<uint32_t> packed;
+
+    for (const auto& block : blocks) {
+        // Extensão do modelo: caixa dos chunks do bloco, limitada ao bloco e ao grid
+        glm::ivec3 blockOrigin = glm::ivec3(block.first[2], block.first[1], block.first[0]) * MAX_MODEL_SIZE;
+        glm::ivec3 lo(INT32_MAX), hi(INT32_MIN);
+        for (const VoxelChunk* chunk : block.second) {
+            lo = glm::min(lo, chunk->getOrigin());
+            hi = glm::max(hi, chunk->getOrigin() + glm::ivec3(VoxelChunk::SIZE));
+        }
+        hi = glm::min(hi, glm::min(blockOrigin + glm::ivec3(MAX_MODEL_SIZE), glm::max(gridMax, lo + glm::ivec3(1))));
+        glm::ivec3 extent = hi - lo;
+
+        // Grid (x, y, z) -> modelo (x, topo - z, y)
+        glm::ivec3 modelSize(extent.x, extent.z, extent.y);
+        std::streampos sizeChunk = writer.beginChunk(ID_SIZE);
+        writer.writeInt(modelSize.x);
+        writer.writeInt(modelSize.y);
+        writer.writeInt(modelSize.z);
+        writer.endChunk(sizeChunk);
+
+        std::streampos xyziChunk = writer.beginChunk(ID_XYZI);
+        std::streampos countPosition = file.tellp();
+        writer.writeInt(0);
+        uint32_t count = 0;
+
+        for (const VoxelChunk* chunk : block.second) {
+            chunk->copyCells(cells.data());
+            glm::ivec3 base = chunk->getOrigin();
+            packed.clear();
+            for (int i = 0; i < VoxelChunk::VOLUME; i++) {
+                uint8_t color = cellColor[cells[static_cast<size_t>(i)]];
+                if (color == 0) continue;
+
+                glm::ivec3 position = base + glm::ivec3(i % VoxelChunk::SIZE,
+                                                        (i / VoxelChunk::SIZE) % VoxelChunk::SIZE,
+                                                        i / VoxelChunk::AREA);
+                glm::ivec3 local = position - lo;
+                if (local.x < 0 || local.y < 0 || local.z < 0 ||
+                    local.x >= extent.x || local.y >= extent.y || local.z >= extent.z) {
+                    continue;
+                }
+                packed.push_back(static_cast<uint32_t>(local.x) |
+                                 (static_cast<uint32_t>(extent.z - 1 - local.z) << 8) |
+                                 (static_cast<uint32_t>(local.y) << 16) |
+                                 (static_cast<uint32_t>(color) << 24));
+            }
+            writer.writeBytes(packed.data(), packed.size() * sizeof(uint32_t));
+            count += static_cast<uint32_t>(packed.size());
+        }
+
+        std::streampos xyziEnd = file.tellp();
+        file.seekp(countPosition);
+        writer.writeInt(static_cast<int32_t>(count));
+        file.seekp(xyziEnd);
+        writer.endChunk(xyziChunk);
+        stats.voxels += count;
+
+        // Canto do modelo no espaço do MagicaVoxel; o nó guarda o centro
+        glm::ivec3 corner(lo.x, -(lo.z + extent.z), lo.y);
+        translations.push_back(corner + modelSize / 2);
+    }
+
+    // Formato exige ao menos um modelo
+    if (translations.empty()) {
+        std::streampos sizeChunk = writer.beginChunk(ID_SIZE);
+        writer.writeInt(1);
+        writer.writeInt(1);
+        writer.writeInt(1);
+        writer.endChunk(sizeChunk);
+        std::streampos xyziChunk = writer.beginChunk(ID_XYZI);
+        writer.writeInt(0);
+        writer.endChunk(xyziChunk);
+        translations.push_back(glm::ivec3(0));
+    }
+    stats.models = translations.size();
+    stats.instances = translations.size();
+
+    // Grafo de cena: raiz -> grupo -> (transformação -> forma) por modelo
+    std::streampos rootChunk = writer.beginChunk(ID_TRANSFORM);
+    writer.writeInt(0);
+    writer.writeDictionary(Dictionary());
+    writer.writeInt(1);
+    writer.writeInt(-1);
+    writer.writeInt(-1);
+    writer.writeInt(1);
+    writer.writeDictionary(Dictionary());
+    writer.endChunk(rootChunk);
+
+    std::streampos groupChunk = writer.beginChunk(ID_GROUP);
+    writer.writeInt(1);
+    writer.writeDictionary(Dictionary());
+    writer.writeInt(static_cast<int32_t>(translations.size()));
+    for (size_t m = 0; m < translations.size(); m++) {
+        writer.writeInt(static_cast<int32_t>(2 + 2 * m));
+    }
+    writer.endChunk(groupChunk);
+
+    for (size_t m = 0; m < translations.size(); m++) {
+        std::streampos transformChunk = writer.beginChunk(ID_TRANSFORM);
+        writer.writeInt(static_cast<int32_t>(2 + 2 * m));
+        writer.writeDictionary({{"_name", "bloco " + std::to_string(m)}});
+        writer.writeInt(static_cast<int32_t>(3 + 2 * m));
+        writer.writeInt(-1);
+        writer.writeInt(0);
+        writer.writeInt(1);
+        const glm::ivec3& t = translations[m];
+        writer.writeDictionary({{"_t", std::to_string(t.x) + " " + std::to_string(t.y) + " " + std::to_string(t.z)}});
+        writer.endChunk(transformChunk);
+
+        std::streampos shapeChunk = writer.beginChunk(ID_SHAPE);
+        writer.writeInt(static_cast<int32_t>(3 + 2 * m));
+        writer.writeDictionary(Dictionary());
+        writer.writeInt(1);
+        writer.writeInt(static_cast<int32_t>(m));
+        writer.writeDictionary(Dictionary());
+        writer.endChunk(shapeChunk);
+    }
+
+    // Paleta: a entrada i do arquivo é o índice de cor i + 1
+    uint8_t rgba[PALETTE_SIZE * 4] = {};
+    for (size_t i = 0; i < voxColors.size() && i + 1 < PALETTE_SIZE; i++) {
+        rgba[i * 4] = voxColors[i].r;
+        rgba[i * 4 + 1] = voxColors[i].g;
+        rgba[i * 4 + 2] = voxColors[i].b;
+        rgba[i * 4 + 3] = voxColors[i].a;
+    }
+    std::streampos paletteChunk = writer.beginChunk(ID_RGBA);
+    writer.writeBytes(rgba, sizeof(rgba));
+    writer.endChunk(paletteChunk);
+
+    writer.endChunk(mainStart, mainContentEnd);
+    stats.bytes = static_cast<uint64_t>(file.tellp());
+    file.close();
+    if (!writer.good() || !file) {
+        std::cerr << "Erro ao gravar arquivo .vox: " << path << std::endl;
+        return false;
+    }
+
+    finishStats(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    return true;
+}
+
+void MagicaVoxelFile::finishStats(double elapsedMs) {
+    stats.elapsedMs = elapsedMs;
+    double seconds = elapsedMs / 1000.0;
+    if (seconds > 0.0) {
+        stats.voxelsPerSecond = static_cast<double>(stats.voxels) / seconds;
+        stats.megabytesPerSecond = static_cast<double>(stats.bytes) / (1024.0 * 1024.0) / seconds;
+    }
+}
+
+} // namespace VoxelMaker
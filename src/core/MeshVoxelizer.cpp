@@ -0,0 +1,580 @@
+#include "core/MeshVoxelizer.hpp"
+#include "utils/FileUtils.hpp"
+#include "utils/MappedFile.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+
+namespace VoxelMaker {
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ---------------------------------------------------------------------------------------
+// Leitura de texto
+// ---------------------------------------------------------------------------------------
+
+bool startsWith(const char* p, const char* end, const char* word) {
+    size_t length = std::strlen(word);
+    return static_cast<size_t>(end - p) >= length && std::memcmp(p, word, length) == 0 &&
+           (static_cast<size_t>(end - p) == length || p[length] == ' ' || p[length] == '\t');
+}
+
+uint8_t toByte(float channel) {
+    return static_cast<uint8_t>(std::lround(std::min(std::max(channel, 0.0f), 1.0f) * 255.0f));
+}
+
+// ---------------------------------------------------------------------------------------
+// Voxelização
+// ---------------------------------------------------------------------------------------
+
+/**
+ * @brief Teste conservador triângulo/voxel (Schwarz e Seidel): o voxel unitário com canto
+ *        mínimo p toca o triângulo se toca o plano e as três projeções do triângulo
+ */
+struct OverlapTest {
+    glm::vec3 normal;
+    float d1, d2;               ///< Plano deslocado para os dois cantos críticos da caixa
+    glm::vec2 edgeXY[3], edgeYZ[3], edgeZX[3];
+    float offsetXY[3], offsetYZ[3], offsetZX[3];
+
+    OverlapTest(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
+        const glm::vec3 v[3] = { v0, v1, v2 };
+        normal = glm::cross(v1 - v0, v2 - v0);
+        glm::vec3 critical(normal.x > 0.0f ? 1.0f : 0.0f, normal.y > 0.0f ? 1.0f : 0.0f,
+                           normal.z > 0.0f ? 1.0f : 0.0f);
+        d1 = glm::dot(normal, critical - v0);
+        d2 = glm::dot(normal, glm::vec3(1.0f) - critical - v0);
+
+        float signZ = normal.z >= 0.0f ? 1.0f : -1.0f;
+        float signX = normal.x >= 0.0f ? 1.0f : -1.0f;
+        float signY = normal.y >= 0.0f ? 1.0f : -1.0f;
+        for (int i = 0; i < 3; i++) {
+            glm::vec3 e = v[(i + 1) % 3] - v[i];
+
+            edgeXY[i] = glm::vec2(-e.y, e.x) * signZ;
+            offsetXY[i] = -glm::dot(edgeXY[i], glm::vec2(v[i].x, v[i].y)) +
+                          std::max(0.0f, edgeXY[i].x) + std::max(0.0f, edgeXY[i].y);
+
+            edgeYZ[i] = glm::vec2(-e.z, e.y) * signX;
+            offsetYZ[i] = -glm::dot(edgeYZ[i], glm::vec2(v[i].y, v[i].z)) +
+                          std::max(0.0f, edgeYZ[i].x) + std::max(0.0f, edgeYZ[i].y);
+
+            edgeZX[i] = glm::vec2(-e.x, e.z) * signY;
+            offsetZX[i] = -glm::dot(edgeZX[i], glm::vec2(v[i].z, v[i].x)) +
+                          std::max(0.0f, edgeZX[i].x) + std::max(0.0f, edgeZX[i].y);
+        }
+    }
+
+    bool overlapsXY(float x, float y) const {
+        for (int i = 0; i < 3; i++) {
+            if (edgeXY[i].x * x + edgeXY[i].y * y + offsetXY[i] < 0.0f) return false;
+        }
+        return true;
+    }
+
+    bool overlapsZ(float x, float y, float z) const {
+        float plane = normal.x * x + normal.y * y + normal.z * z;
+        if ((plane + d1) * (plane + d2) > 0.0f) return false;
+        for (int i = 0; i < 3; i++) {
+            if (edgeYZ[i].x * y + edgeYZ[i].y * z + offsetYZ[i] < 0.0f) return false;
+            if (edgeZX[i].x * z + edgeZX[i].y * x + offsetZX[i] < 0.0f) return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Cruzamento de um raio vertical com a superfície
+ */
+struct Crossing {
+    float y;
+    VoxelPalette::Index cell;
+
+    bool operator<(const Crossing& other) const { return y < other.y; }
+};
+
+/**
+ * @brief Caixa de voxels de um triângulo (inclusiva)
+ */
+struct VoxelRange {
+    int16_t lo[3];
+    int16_t hi[3];
+};
+
+/**
+ * @brief Aresta que inclui os pontos sobre ela (regra topo-esquerda no plano XZ, triângulo
+ *        anti-horário): de duas faces que compartilham a aresta, só uma a inclui
+ */
+bool ownsEdge(double dx, double dz) {
+    return dz > 0.0 || (dz == 0.0 && dx < 0.0);
+}
+
+/**
+ * @brief Distribui os triângulos nas células de uma grade (contagem e preenchimento)
+ */
+struct Bins {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> items;
+
+    template <typename RangeFunction>
+    void build(size_t binCount, size_t triangleCount, RangeFunction forEachBin) {
+        offsets.assign(binCount + 1, 0);
+        for (size_t t = 0; t < triangleCount; t++) {
+            forEachBin(t, [&](size_t bin) { offsets[bin + 1]++; });
+        }
+        for (size_t i = 0; i < binCount; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        items.resize(offsets[binCount]);
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; t++) {
+            forEachBin(t, [&](size_t bin) { items[cursor[bin]++] = static_cast<uint32_t>(t); });
+        }
+    }
+
+    size_t size(size_t bin) const { return offsets[bin + 1] - offsets[bin]; }
+    const uint32_t* begin(size_t bin) const { return items.data() + offsets[bin]; }
+};
+
+} // namespace
+
+bool MeshVoxelizer::isMeshPath(const std::string& path) {
+    return FileUtils::hasExtension(path, ".obj") || FileUtils::hasExtension(path, ".stl");
+}
+
+bool MeshVoxelizer::load(const std::string& path, VoxelGrid& grid) {
+    auto start = std::chrono::steady_clock::now();
+
+    TriangleMesh mesh;
+    bool read = FileUtils::hasExtension(path, ".stl") ? readStl(path, mesh) : readObj(path, mesh);
+    if (!read) {
+        return false;
+    }
+    double parseMs = elapsedMs(start);
+
+    if (!voxelize(mesh, grid)) {
+        return false;
+    }
+    stats.parseMs = parseMs;
+    return true;
+}
+
+bool MeshVoxelizer::readObj(const std::string& path, TriangleMesh& mesh) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Erro ao abrir malha: " << path << std::endl;
+        return false;
+    }
+
+    mesh = TriangleMesh();
+    bool hasColors = false;
+    const char* p = reinterpret_cast<const char*>(file.getData());
+    const char* end = p + file.getSize();
+    std::vector<uint32_t> polygon;
+
+    while (p < end) {
+        const char* line = FileUtils::skipSpaces(p, end);
+        const char* next = FileUtils::nextLine(line, end);
+
+        if (startsWith(line, next, "v")) {
+            const char* cursor = line + 1;
+            glm::vec3 position;
+            if (!FileUtils::parseFloat(cursor, next, position.x) || !FileUtils::parseFloat(cursor, next, position.y) ||
+                !FileUtils::parseFloat(cursor, next, position.z)) {
+                std::cerr << "Vértice inválido em " << path << std::endl;
+                return false;
+            }
+            mesh.positions.push_back(position);
+
+            glm::vec3 rgb;
+            if (FileUtils::parseFloat(cursor, next, rgb.x) && FileUtils::parseFloat(cursor, next, rgb.y) &&
+                FileUtils::parseFloat(cursor, next, rgb.z)) {
+                mesh.colors.push_back(Voxel::Color(toByte(rgb.x), toByte(rgb.y), toByte(rgb.z)));
+                hasColors = true;
+            } else {
+                mesh.colors.push_back(Voxel::Color());
+            }
+        } else if (startsWith(line, next, "f")) {
+            // Índices v, v/vt, v//vn ou v/vt/vn; negativos contam a partir do fim
+            const char* cursor = line + 1;
+            polygon.clear();
+            int64_t index;
+            while (FileUtils::parseInt(cursor, next, index)) {
+                int64_t resolved = index > 0 ? index - 1 : static_cast<int64_t>(mesh.positions.size()) + index;
+                if (index == 0 || resolved < 0 || resolved >= static_cast<int64_t>(mesh.positions.size())) {
+                    std::cerr << "Índice de face inválido em " << path << std::endl;
+                    return false;
+                }
+                polygon.push_back(static_cast<uint32_t>(resolved));
+                while (cursor < next && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') {
+                    cursor++;
+                }
+            }
+            for (size_t i = 2; i < polygon.size(); i++) {
+                mesh.indices.insert(mesh.indices.end(), { polygon[0], polygon[i - 1], polygon[i] });
+            }
+        }
+        p = next;
+    }
+
+    if (!hasColors) {
+        mesh.colors.clear();
+    }
+    return true;
+}
+
+bool MeshVoxelizer::readStl(const std::string& path, TriangleMesh& mesh) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Erro ao abrir malha: " << path << std::endl;
+        return false;
+    }
+
+    mesh = TriangleMesh();
+    const uint8_t* data = file.getData();
+    size_t size = file.getSize();
+
+    // Binário: cabeçalho de 80 bytes, contagem e 50 bytes por triângulo (mesmo começando
+    // com "solid", como alguns exportadores fazem)
+    uint32_t count = 0;
+    if (size >= 84) {
+        std::memcpy(&count, data + 80, sizeof(count));
+    }
+    if (size >= 84 && 84 + static_cast<uint64_t>(count) * 50 == size) {
+        mesh.positions.resize(static_cast<size_t>(count) * 3);
+        for (uint32_t t = 0; t < count; t++) {
+            float values[9];
+            std::memcpy(values, data + 84 + static_cast<size_t>(t) * 50 + 12, sizeof(values));
+            for (int k = 0; k < 3; k++) {
+                mesh.positions[t * 3 + k] = glm::vec3(values[k * 3], values[k * 3 + 2], -values[k * 3 + 1]);
+            }
+        }
+    } else {
+        const char* p = reinterpret_cast<const char*>(data);
+        const char* end = p + size;
+        if (!startsWith(FileUtils::skipSpaces(p, end), end, "solid")) {
+            std::cerr << "STL inválido: " << path << std::endl;
+            return false;
+        }
+        while (p < end) {
+            const char* line = FileUtils::skipSpaces(p, end);
+            const char* next = FileUtils::nextLine(line, end);
+            if (startsWith(line, next, "vertex")) {
+                const char* cursor = line + 6;
+                glm::vec3 v;
+                if (!FileUtils::parseFloat(cursor, next, v.x) || !FileUtils::parseFloat(cursor, next, v.y) || !FileUtils::parseFloat(cursor, next, v.z)) {
+                    std::cerr << "Vértice inválido em " << path << std::endl;
+                    return false;
+                }
+                mesh.positions.push_back(glm::vec3(v.x, v.z, -v.y));
+            }
+            p = next;
+        }
+        mesh.positions.resize(mesh.positions.size() / 3 * 3);
+    }
+
+    mesh.indices.resize(mesh.positions.size());
+    for (size_t i = 0; i < mesh.indices.size(); i++) {
+        mesh.indices[i] = static_cast<uint32_t>(i);
+    }
+    return true;
+}
+
+bool MeshVoxelizer::voxelize(const TriangleMesh& mesh, VoxelGrid& grid) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+    stats.vertices = mesh.positions.size();
+    stats.triangles = mesh.indices.size() / 3;
+
+    if (stats.triangles == 0) {
+        std::cerr << "Malha sem triângulos" << std::endl;
+        return false;
+    }
+
+    // Escala: o maior eixo ocupa a resolução pedida
+    glm::vec3 lo(INFINITY), hi(-INFINITY);
+    for (const glm::vec3& position : mesh.positions) {
+        lo = glm::min(lo, position);
+        hi = glm::max(hi, position);
+    }
+    glm::vec3 extent = hi - lo;
+    float longest = std::max(extent.x, std::max(extent.y, extent.z));
+    int resolution = std::min(std::max(settings.resolution, 1), MAX_RESOLUTION);
+    float scale = settings.voxelSize > 0.0f ? 1.0f / settings.voxelSize
+                : (longest > 0.0f ? static_cast<float>(resolution) / longest : 1.0f);
+    glm::ivec3 dims;
+    for (int axis = 0; axis < 3; axis++) {
+        double cells = std::ceil(static_cast<double>(extent[axis]) * scale);
+        if (!(cells <= MAX_RESOLUTION)) {
+            std::cerr << "Malha grande demais para o tamanho de voxel (máximo " << MAX_RESOLUTION
+                      << " voxels por eixo)" << std::endl;
+            return false;
+        }
+        dims[axis] = std::max(1, static_cast<int>(cells));
+    }
+
+    std::vector<glm::vec3> vertices(mesh.positions.size());
+    ThreadPool& pool = ThreadPool::getInstance();
+    const size_t VERTEX_BLOCK = 65536;
+    pool.parallelFor((vertices.size() + VERTEX_BLOCK - 1) / VERTEX_BLOCK, [&](size_t block) {
+        size_t last = std::min(vertices.size(), (block + 1) * VERTEX_BLOCK);
+        for (size_t i = block * VERTEX_BLOCK; i < last; i++) {
+            vertices[i] = (mesh.positions[i] - lo) * scale;
+        }
+    });
+
+    // Paleta: cor média do triângulo quantizada em 5 bits por canal
+    VoxelPalette palette;
+    std::vector<VoxelPalette::Index> triangleCell(stats.triangles);
+    if (mesh.colors.size() == mesh.positions.size()) {
+        std::unordered_map<uint32_t, VoxelPalette::Index> lookup;
+        for (size_t t = 0; t < stats.triangles; t++) {
+            uint32_t key = 0;
+            for (int channel = 0; channel < 3; channel++) {
+                int sum = 0;
+                for (int k = 0; k < 3; k++) {
+                    const Voxel::Color& c = mesh.colors[mesh.indices[t * 3 + k]];
+                    sum += channel == 0 ? c.r : channel == 1 ? c.g : c.b;
+                }
+                key |= static_cast<uint32_t>((sum / 3) >> 3) << (channel * 5);
+            }
+            auto found = lookup.find(key);
+            if (found == lookup.end()) {
+                auto expand = [](uint32_t q) { return static_cast<uint8_t>((q << 3) | (q >> 2)); };
+                Voxel::Color color(expand(key & 31), expand((key >> 5) & 31), expand((key >> 10) & 31));
+                found = lookup.emplace(key, palette.findOrAdd(Voxel(glm::ivec3(0), color))).first;
+            }
+            triangleCell[t] = found->second;
+        }
+    } else {
+        std::fill(triangleCell.begin(), triangleCell.end(), palette.findOrAdd(Voxel(glm::ivec3(0), settings.color)));
+    }
+
+    auto corner = [&](size_t t, int k) -> const glm::vec3& { return vertices[mesh.indices[t * 3 + k]]; };
+
+    // Caixa de voxels de cada triângulo (coordenadas não negativas: truncar é arredondar para baixo)
+    auto binStart = std::chrono::steady_clock::now();
+    std::vector<VoxelRange> ranges(stats.triangles);
+    const size_t TRIANGLE_BLOCK = 16384;
+    pool.parallelFor((ranges.size() + TRIANGLE_BLOCK - 1) / TRIANGLE_BLOCK, [&](size_t block) {
+        size_t last = std::min(ranges.size(), (block + 1) * TRIANGLE_BLOCK);
+        for (size_t t = block * TRIANGLE_BLOCK; t < last; t++) {
+            const glm::vec3& a = corner(t, 0);
+            const glm::vec3& b = corner(t, 1);
+            const glm::vec3& c = corner(t, 2);
+            glm::vec3 minCorner = glm::min(a, glm::min(b, c));
+            glm::vec3 maxCorner = glm::max(a, glm::max(b, c));
+            for (int axis = 0; axis < 3; axis++) {
+                ranges[t].lo[axis] = static_cast<int16_t>(std::min(static_cast<int>(minCorner[axis]), dims[axis] - 1));
+                ranges[t].hi[axis] = static_cast<int16_t>(std::min(static_cast<int>(maxCorner[axis]), dims[axis] - 1));
+            }
+        }
+    });
+
+    // Triângulos por chunk (um triângulo grande entra em todos os chunks que toca)
+    const glm::ivec3 chunkDims = (dims + VoxelChunk::SIZE - 1) / VoxelChunk::SIZE;
+    const size_t chunkCount = static_cast<size_t>(chunkDims.x) * chunkDims.y * chunkDims.z;
+    auto chunkIndex = [&](int x, int y, int z) {
+        return static_cast<size_t>(x) + static_cast<size_t>(chunkDims.x) * (y + static_cast<size_t>(chunkDims.y) * z);
+    };
+    Bins chunkBins;
+    chunkBins.build(chunkCount, stats.triangles, [&](size_t t, auto&& emit) {
+        const VoxelRange& range = ranges[t];
+        for (int z = range.lo[2] / VoxelChunk::SIZE; z <= range.hi[2] / VoxelChunk::SIZE; z++) {
+            for (int y = range.lo[1] / VoxelChunk::SIZE; y <= range.hi[1] / VoxelChunk::SIZE; y++) {
+                for (int x = range.lo[0] / VoxelChunk::SIZE; x <= range.hi[0] / VoxelChunk::SIZE; x++) {
+                    emit(chunkIndex(x, y, z));
+                }
+            }
+        }
+    });
+    std::vector<size_t> occupied;
+    for (size_t i = 0; i < chunkCount; i++) {
+        if (chunkBins.size(i) > 0) occupied.push_back(i);
+    }
+    stats.binMs = elapsedMs(binStart);
+
+    // Superfície: cada chunk testa só os seus triângulos, limitados à sua caixa, e escreve
+    // nas próprias células densas
+    auto surfaceStart = std::chrono::steady_clock::now();
+    std::vector<std::vector<VoxelChunk::Cell>> cells(chunkCount);
+    pool.parallelFor(occupied.size(), [&](size_t o) {
+        size_t index = occupied[o];
+        glm::ivec3 origin = glm::ivec3(static_cast<int>(index % chunkDims.x),
+                                       static_cast<int>(index / chunkDims.x % chunkDims.y),
+                                       static_cast<int>(index / chunkDims.x / chunkDims.y)) * VoxelChunk::SIZE;
+        glm::ivec3 limit = glm::min(origin + VoxelChunk::SIZE, dims) - 1;
+        std::vector<VoxelChunk::Cell>& chunkCells = cells[index];
+        chunkCells.assign(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+
+        const uint32_t* triangles = chunkBins.begin(index);
+        for (size_t i = 0; i < chunkBins.size(index); i++) {
+            size_t t = triangles[i];
+            glm::ivec3 minVoxel = glm::max(glm::ivec3(ranges[t].lo[0], ranges[t].lo[1], ranges[t].lo[2]), origin);
+            glm::ivec3 maxVoxel = glm::min(glm::ivec3(ranges[t].hi[0], ranges[t].hi[1], ranges[t].hi[2]), limit);
+
+            OverlapTest test(corner(t, 0), corner(t, 1), corner(t, 2));
+            VoxelPalette::Index cell = triangleCell[t];
+            for (int x = minVoxel.x; x <= maxVoxel.x; x++) {
+                for (int y = minVoxel.y; y <= maxVoxel.y; y++) {
+                    float fx = static_cast<float>(x), fy = static_cast<float>(y);
+                    if (!test.overlapsXY(fx, fy)) continue;
+                    for (int z = minVoxel.z; z <= maxVoxel.z; z++) {
+                        if (test.overlapsZ(fx, fy, static_cast<float>(z))) {
+                            chunkCells[VoxelChunk::index(x - origin.x, y - origin.y, z - origin.z)] = cell;
+                        }
+                    }
+                }
+            }
+        }
+    });
+    stats.surfaceMs = elapsedMs(surfaceStart);
+
+    if (settings.solid) {
+        // Triângulos por coluna de chunks, pelos centros de coluna de voxels que cobrem em XZ
+        auto fillStart = std::chrono::steady_clock::now();
+        auto columnRange = [&](size_t t, glm::ivec2& minColumn, glm::ivec2& maxColumn) {
+            const glm::vec3& a = corner(t, 0);
+            const glm::vec3& b = corner(t, 1);
+            const glm::vec3& c = corner(t, 2);
+            glm::vec3 minCorner = glm::min(a, glm::min(b, c));
+            glm::vec3 maxCorner = glm::max(a, glm::max(b, c));
+            minColumn = glm::ivec2(std::max(0, static_cast<int>(std::ceil(minCorner.x - 0.5f))),
+                                   std::max(0, static_cast<int>(std::ceil(minCorner.z - 0.5f))));
+            maxColumn = glm::ivec2(std::min(dims.x - 1, static_cast<int>(std::floor(maxCorner.x - 0.5f))),
+                                   std::min(dims.z - 1, static_cast<int>(std::floor(maxCorner.z - 0.5f))));
+            return minColumn.x <= maxColumn.x && minColumn.y <= maxColumn.y;
+        };
+
+        const size_t columnCount = static_cast<size_t>(chunkDims.x) * chunkDims.z;
+        Bins columnBins;
+        columnBins.build(columnCount, stats.triangles, [&](size_t t, auto&& emit) {
+            const VoxelRange& range = ranges[t];
+            for (int z = range.lo[2] / VoxelChunk::SIZE; z <= range.hi[2] / VoxelChunk::SIZE; z++) {
+                for (int x = range.lo[0] / VoxelChunk::SIZE; x <= range.hi[0] / VoxelChunk::SIZE; x++) {
+                    emit(static_cast<size_t>(x) + static_cast<size_t>(chunkDims.x) * z);
+                }
+            }
+        });
+
+        std::vector<uint64_t> columnFilled(columnCount, 0);
+        pool.parallelFor(columnCount, [&](size_t column) {
+            if (columnBins.size(column) == 0) return;
+            glm::ivec2 chunkColumn(static_cast<int>(column % chunkDims.x), static_cast<int>(column / chunkDims.x));
+            glm::ivec2 origin = chunkColumn * VoxelChunk::SIZE;
+            std::vector<std::vector<Crossing>> crossings(VoxelChunk::AREA);
+
+            const uint32_t* triangles = columnBins.begin(column);
+            for (size_t i = 0; i < columnBins.size(column); i++) {
+                size_t t = triangles[i];
+                glm::ivec2 minColumn, maxColumn;
+                if (!columnRange(t, minColumn, maxColumn)) continue;
+                minColumn = glm::max(minColumn, origin);
+                maxColumn = glm::min(maxColumn, origin + VoxelChunk::SIZE - 1);
+                if (minColumn.x > maxColumn.x || minColumn.y > maxColumn.y) continue;
+
+                // Projeção em XZ, anti-horária
+                glm::vec3 v[3] = { corner(t, 0), corner(t, 1), corner(t, 2) };
+                double area = (static_cast<double>(v[1].x) - v[0].x) * (static_cast<double>(v[2].z) - v[0].z) -
+                              (static_cast<double>(v[1].z) - v[0].z) * (static_cast<double>(v[2].x) - v[0].x);
+                if (area == 0.0) continue;
+                if (area < 0.0) {
+                    std::swap(v[1], v[2]);
+                    area = -area;
+                }
+
+                for (int z = minColumn.y; z <= maxColumn.y; z++) {
+                    for (int x = minColumn.x; x <= maxColumn.x; x++) {
+                        double px = x + 0.5, pz = z + 0.5;
+                        double weights[3];
+                        bool inside = true;
+                        for (int e = 0; e < 3 && inside; e++) {
+                            const glm::vec3& a = v[(e + 1) % 3];
+                            const glm::vec3& b = v[(e + 2) % 3];
+                            double dx = static_cast<double>(b.x) - a.x;
+                            double dz = static_cast<double>(b.z) - a.z;
+                            double edge = dx * (pz - a.z) - dz * (px - a.x);
+                            inside = edge > 0.0 || (edge == 0.0 && ownsEdge(dx, dz));
+                            weights[e] = edge;
+                        }
+                        if (!inside) continue;
+
+                        float y = static_cast<float>((weights[0] * v[0].y + weights[1] * v[1].y + weights[2] * v[2].y) / area);
+                        crossings[static_cast<size_t>(z - origin.y) * VoxelChunk::SIZE + (x - origin.x)]
+                            .push_back({ y, triangleCell[t] });
+                    }
+                }
+            }
+
+            // Entre um cruzamento de entrada e o de saída seguinte, os voxels são interiores
+            // (só esta tarefa escreve nos chunks da coluna)
+            for (int lz = 0; lz < VoxelChunk::SIZE; lz++) {
+                for (int lx = 0; lx < VoxelChunk::SIZE; lx++) {
+                    std::vector<Crossing>& list = crossings[static_cast<size_t>(lz) * VoxelChunk::SIZE + lx];
+                    std::sort(list.begin(), list.end());
+                    for (size_t k = 0; k + 1 < list.size(); k += 2) {
+                        int first = std::max(0, static_cast<int>(std::ceil(list[k].y - 0.5f)));
+                        int last = std::min(dims.y - 1, static_cast<int>(std::floor(list[k + 1].y - 0.5f)));
+                        for (int y = first; y <= last; y++) {
+                            std::vector<VoxelChunk::Cell>& chunkCells =
+                                cells[chunkIndex(chunkColumn.x, y / VoxelChunk::SIZE, chunkColumn.y)];
+                            if (chunkCells.empty()) {
+                                chunkCells.assign(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+                            }
+                            VoxelChunk::Cell& slot = chunkCells[VoxelChunk::index(lx, y % VoxelChunk::SIZE, lz)];
+                            if (slot == VoxelPalette::EMPTY) {
+                                slot = list[k].cell;
+                                columnFilled[column]++;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+        for (uint64_t filled : columnFilled) {
+            stats.filledVoxels += filled;
+        }
+        stats.fillMs = elapsedMs(fillStart);
+    }
+
+    // Chunks montados em paralelo a partir das células; o grid os recebe de uma vez
+    std::vector<std::unique_ptr<VoxelChunk>> chunks(chunkCount);
+    pool.parallelFor(chunkCount, [&](size_t index) {
+        if (cells[index].empty()) return;
+        glm::ivec3 coord(static_cast<int>(index % chunkDims.x), static_cast<int>(index / chunkDims.x % chunkDims.y),
+                         static_cast<int>(index / chunkDims.x / chunkDims.y));
+        chunks[index] = std::make_unique<VoxelChunk>(coord, std::move(cells[index]));
+    });
+
+    grid.setDimensions(VoxelGrid::Dimensions(dims.x, dims.y, dims.z));
+    grid.setOrigin(glm::ivec3(0));
+    grid.setPalette(palette);
+    uint64_t voxels = 0;
+    for (auto& chunk : chunks) {
+        if (chunk && !chunk->isEmpty()) {
+            voxels += static_cast<uint64_t>(chunk->getCellCount());
+            grid.insertChunk(std::move(chunk));
+            stats.chunks++;
+        }
+    }
+    stats.surfaceVoxels = voxels - stats.filledVoxels;
+
+    stats.voxelizeMs = elapsedMs(start);
+    double seconds = stats.voxelizeMs / 1000.0;
+    if (seconds > 0.0) {
+        stats.trianglesPerSecond = stats.triangles / seconds;
+        stats.voxelsPerSecond = voxels / seconds;
+    }
+    return true;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,1196 @@
+#include "core/PointCloudImporter.hpp"
+#include "utils/FileUtils.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+
+namespace VoxelMaker {
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int floorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((divisor - 1 - value) / divisor);
+}
+
+// Chunk e posição local por deslocamento (arredonda para baixo também em negativos, sem desvios)
+constexpr int CHUNK_SHIFT = 5;
+static_assert((1 << CHUNK_SHIFT) == VoxelChunk::SIZE, "CHUNK_SHIFT deve corresponder a VoxelChunk::SIZE");
+
+uint8_t toByte(double channel) {
+    return static_cast<uint8_t>(std::lround(std::min(std::max(channel, 0.0), 255.0)));
+}
+
+uint32_t packColor(uint8_t r, uint8_t g, uint8_t b) {
+    return static_cast<uint32_t>(r) | static_cast<uint32_t>(g) << 8 | static_cast<uint32_t>(b) << 16;
+}
+
+/**
+ * @brief Cor quantizada em 5 bits por canal (15 bits)
+ */
+uint32_t colorKey(uint32_t r, uint32_t g, uint32_t b) {
+    return (r >> 3) | (g >> 3) << 5 | (b >> 3) << 10;
+}
+
+Voxel::Color keyColor(uint32_t key) {
+    auto expand = [](uint32_t q) { return static_cast<uint8_t>((q << 3) | (q >> 2)); };
+    return Voxel::Color(expand(key & 31), expand((key >> 5) & 31), expand((key >> 10) & 31));
+}
+
+/**
+ * @brief Índices da paleta das cores quantizadas, criados na primeira ocorrência
+ */
+class KeyPalette {
+private:
+    VoxelPalette& palette;
+    std::vector<VoxelPalette::Index> indices;
+
+public:
+    explicit KeyPalette(VoxelPalette& target) : palette(target), indices(1 << 15, VoxelPalette::EMPTY) {}
+
+    VoxelPalette::Index get(uint32_t key) {
+        VoxelPalette::Index& index = indices[key];
+        if (index == VoxelPalette::EMPTY) {
+            index = palette.findOrAdd(Voxel(glm::ivec3(0), keyColor(key)));
+        }
+        return index;
+    }
+};
+
+// ---------------------------------------------------------------------------------------
+// Leitura em blocos
+// ---------------------------------------------------------------------------------------
+
+/**
+ * @brief Buffer de tamanho fixo que avança pelo arquivo; o resto não consumido de um bloco
+ *        vai para o início do seguinte
+ */
+struct BlockReader {
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t begin;           ///< Início do que ainda não foi consumido
+    size_t end;             ///< Fim dos dados válidos
+    bool eof;
+    uint64_t bytesRead;
+
+    BlockReader() : file(nullptr), buffer(), begin(0), end(0), eof(false), bytesRead(0) {}
+    ~BlockReader() { if (file) std::fclose(file); }
+
+    bool open(const std::string& path, size_t capacity) {
+        file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            std::cerr << "Não foi possível abrir: " << path << std::endl;
+            return false;
+        }
+        buffer.resize(capacity);
+        return refill();
+    }
+
+    size_t available() const { return end - begin; }
+    const char* data() const { return buffer.data() + begin; }
+    void consume(size_t bytes) { begin += bytes; }
+
+    bool refill() {
+        if (begin > 0) {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        while (end < buffer.size() && !eof) {
+            size_t count = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+            if (count == 0) {
+                eof = true;
+                if (std::ferror(file)) {
+                    std::cerr << "Erro de leitura" << std::endl;
+                    return false;
+                }
+            }
+            end += count;
+            bytesRead += count;
+        }
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------------------
+// Formato dos pontos
+// ---------------------------------------------------------------------------------------
+
+enum class Scalar : uint8_t { INT8, UINT8, INT16, UINT16, INT32, UINT32, FLOAT32, FLOAT64 };
+
+bool parseScalar(const std::string& name, Scalar& scalar) {
+    static const struct { const char* name; Scalar scalar; } NAMES[] = {
+        { "char", Scalar::INT8 }, { "int8", Scalar::INT8 }, { "uchar", Scalar::UINT8 }, { "uint8", Scalar::UINT8 },
+        { "short", Scalar::INT16 }, { "int16", Scalar::INT16 }, { "ushort", Scalar::UINT16 }, { "uint16", Scalar::UINT16 },
+        { "int", Scalar::INT32 }, { "int32", Scalar::INT32 }, { "uint", Scalar::UINT32 }, { "uint32", Scalar::UINT32 },
+        { "float", Scalar::FLOAT32 }, { "float32", Scalar::FLOAT32 }, { "double", Scalar::FLOAT64 }, { "float64", Scalar::FLOAT64 }
+    };
+    for (const auto& entry : NAMES) {
+        if (name == entry.name) {
+            scalar = entry.scalar;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t scalarSize(Scalar scalar) {
+    switch (scalar) {
+        case Scalar::INT8: case Scalar::UINT8: return 1;
+        case Scalar::INT16: case Scalar::UINT16: return 2;
+        case Scalar::INT32: case Scalar::UINT32: case Scalar::FLOAT32: return 4;
+        default: return 8;
+    }
+}
+
+double readScalar(const char* p, Scalar scalar, bool swap) {
+    char bytes[8];
+    size_t size = scalarSize(scalar);
+    if (swap) {
+        for (size_t i = 0; i < size; i++) bytes[i] = p[size - 1 - i];
+    } else {
+        std::memcpy(bytes, p, size);
+    }
+    switch (scalar) {
+        case Scalar::INT8: { int8_t v; std::memcpy(&v, bytes, 1); return v; }
+        case Scalar::UINT8: { uint8_t v; std::memcpy(&v, bytes, 1); return v; }
+        case Scalar::INT16: { int16_t v; std::memcpy(&v, bytes, 2); return v; }
+        case Scalar::UINT16: { uint16_t v; std::memcpy(&v, bytes, 2); return v; }
+        case Scalar::INT32: { int32_t v; std::memcpy(&v, bytes, 4); return v; }
+        case Scalar::UINT32: { uint32_t v; std::memcpy(&v, bytes, 4); return v; }
+        case Scalar::FLOAT32: { float v; std::memcpy(&v, bytes, 4); return v; }
+        default: { double v; std::memcpy(&v, bytes, 8); return v; }
+    }
+}
+
+/**
+ * @brief Como os pontos estão dispostos no arquivo
+ */
+struct PointFormat {
+    enum Kind { TEXT, PLY_ASCII, PLY_BINARY };
+
+    static constexpr int MAX_COLUMNS = 32;
+
+    Kind kind;
+    bool swap;                  ///< Binário big-endian
+    size_t headerBytes;         ///< Início dos pontos
+    uint64_t vertexCount;       ///< PLY: pontos antes dos demais elementos
+    int columns;                ///< PLY: propriedades por ponto
+    size_t stride;              ///< PLY binário: bytes por ponto
+    int position[3];            ///< Propriedades x, y, z
+    int color[3];               ///< Propriedades red, green, blue (-1 = sem cor)
+    double colorScale;          ///< Fator para 0..255
+    size_t offsets[MAX_COLUMNS];
+    Scalar types[MAX_COLUMNS];
+
+    PointFormat()
+        : kind(TEXT)
+        , swap(false)
+        , headerBytes(0)
+        , vertexCount(0)
+        , columns(0)
+        , stride(0)
+        , position{ -1, -1, -1 }
+        , color{ -1, -1, -1 }
+        , colorScale(1.0)
+        , offsets()
+        , types() {}
+};
+
+/**
+ * @brief Lê o cabeçalho PLY do início do arquivo
+ */
+bool parsePlyHeader(const char* text, size_t size, PointFormat& format, const std::string& path) {
+    const char* end = text + size;
+    const char* p = text;
+    bool inVertex = false;
+    bool sawElement = false;
+    while (p < end) {
+        const char* next = FileUtils::nextLine(p, end);
+        if (next == end && (next == p || next[-1] != '\n')) {
+            break;
+        }
+        std::string line(p, next - p);
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        p = next;
+
+        std::vector<std::string> words;
+        size_t position = 0;
+        while (position < line.size()) {
+            size_t first = line.find_first_not_of(" \t", position);
+            if (first == std::string::npos) break;
+            size_t last = line.find_first_of(" \t", first);
+            words.push_back(line.substr(first, last == std::string::npos ? std::string::npos : last - first));
+            position = last == std::string::npos ? line.size() : last;
+        }
+        if (words.empty()) continue;
+
+        if (words[0] == "format" && words.size() >= 2) {
+            if (words[1] == "ascii") {
+                format.kind = PointFormat::PLY_ASCII;
+            } else if (words[1] == "binary_little_endian" || words[1] == "binary_big_endian") {
+                format.kind = PointFormat::PLY_BINARY;
+                format.swap = words[1] == "binary_big_endian";
+            } else {
+                std::cerr << "Formato PLY não suportado em " << path << ": " << words[1] << std::endl;
+                return false;
+            }
+        } else if (words[0] == "element" && words.size() >= 3) {
+            inVertex = words[1] == "vertex";
+            if (inVertex && sawElement) {
+                std::cerr << "O elemento vertex precisa ser o primeiro em " << path << std::endl;
+                return false;
+            }
+            sawElement = true;
+            if (inVertex) {
+                format.vertexCount = std::strtoull(words[2].c_str(), nullptr, 10);
+            }
+        } else if (words[0] == "property" && inVertex) {
+            Scalar scalar;
+            if (words.size() < 3 || words[1] == "list" || !parseScalar(words[1], scalar)) {
+                std::cerr << "Propriedade de vértice não suportada em " << path << ": " << line << std::endl;
+                return false;
+            }
+            if (format.columns == PointFormat::MAX_COLUMNS) {
+                std::cerr << "Propriedades de vértice demais em " << path << std::endl;
+                return false;
+            }
+            const std::string& name = words[2];
+            int column = format.columns++;
+            format.types[column] = scalar;
+            format.offsets[column] = format.stride;
+            format.stride += scalarSize(scalar);
+            if (name == "x" || name == "y" || name == "z") {
+                format.position[name[0] - 'x'] = column;
+            } else if (name == "red" || name == "green" || name == "blue" ||
+                       name == "r" || name == "g" || name == "b" ||
+                       name == "diffuse_red" || name == "diffuse_green" || name == "diffuse_blue") {
+                char channel = name.find("red") != std::string::npos || name == "r" ? 0
+                             : name.find("green") != std::string::npos || name == "g" ? 1 : 2;
+                format.color[static_cast<int>(channel)] = column;
+                format.colorScale = scalar == Scalar::FLOAT32 || scalar == Scalar::FLOAT64 ? 255.0
+                                  : scalar == Scalar::UINT16 || scalar == Scalar::INT16 ? 1.0 / 257.0 : 1.0;
+            }
+        } else if (words[0] == "end_header") {
+            format.headerBytes = static_cast<size_t>(p - text);
+            if (format.position[0] < 0 || format.position[1] < 0 || format.position[2] < 0) {
+                std::cerr << "PLY sem coordenadas x, y, z: " << path << std::endl;
+                return false;
+            }
+            if (format.kind == PointFormat::TEXT) {
+                std::cerr << "PLY sem linha de formato: " << path << std::endl;
+                return false;
+            }
+            if (format.color[0] < 0 || format.color[1] < 0 || format.color[2] < 0) {
+                format.color[0] = format.color[1] = format.color[2] = -1;
+            }
+            return true;
+        }
+    }
+    std::cerr << "Cabeçalho PLY inválido ou longo demais: " << path << std::endl;
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------
+// Pontos
+// ---------------------------------------------------------------------------------------
+
+/**
+ * @brief Ponto já no seu chunk: célula (ordem por tijolos de 8³) e cor
+ */
+struct BinnedPoint {
+    uint32_t cell;
+    uint32_t rgb;
+};
+
+/**
+ * @brief Pontos de uma fatia que caem no mesmo chunk
+ */
+struct Run {
+    glm::ivec3 chunk;
+    uint32_t first;
+    uint32_t last;
+};
+
+/**
+ * @brief Chunks tocados por uma fatia (endereçamento aberto), para agrupar seus pontos
+ */
+class SliceChunks {
+private:
+    std::vector<glm::ivec3> keys;
+    std::vector<uint32_t> ids;          ///< UINT32_MAX = posição livre
+    std::vector<glm::ivec3> chunks;     ///< Por id, na ordem de chegada
+    glm::ivec3 lastChunk;
+    uint32_t lastId;
+
+    static size_t hash(const glm::ivec3& c) {
+        return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(c.x)) * 0x9E3779B97F4A7C15ULL) ^
+                                   (static_cast<uint64_t>(static_cast<uint32_t>(c.y)) * 0xC2B2AE3D27D4EB4FULL) ^
+                                   (static_cast<uint64_t>(static_cast<uint32_t>(c.z)) * 0x165667B19E3779F9ULL)) >> 20;
+    }
+
+    void grow() {
+        std::vector<glm::ivec3> oldKeys;
+        std::vector<uint32_t> oldIds;
+        oldKeys.swap(keys);
+        oldIds.swap(ids);
+        keys.assign(std::max<size_t>(64, oldKeys.size() * 2), glm::ivec3(0));
+        ids.assign(keys.size(), UINT32_MAX);
+        for (size_t i = 0; i < oldIds.size(); i++) {
+            if (oldIds[i] != UINT32_MAX) place(oldKeys[i], oldIds[i]);
+        }
+    }
+
+    void place(const glm::ivec3& chunk, uint32_t id) {
+        size_t mask = keys.size() - 1;
+        size_t slot = hash(chunk) & mask;
+        while (ids[slot] != UINT32_MAX) slot = (slot + 1) & mask;
+        keys[slot] = chunk;
+        ids[slot] = id;
+    }
+
+public:
+    SliceChunks() : keys(), ids(), chunks(), lastChunk(0), lastId(UINT32_MAX) {}
+
+    const std::vector<glm::ivec3>& getChunks() const { return chunks; }
+
+    void clear() {
+        if (!chunks.empty()) std::fill(ids.begin(), ids.end(), UINT32_MAX);
+        chunks.clear();
+        lastId = UINT32_MAX;
+    }
+
+    /**
+     * @brief Id do chunk na fatia (pontos seguidos costumam repetir o chunk anterior)
+     */
+    uint32_t find(const glm::ivec3& chunk) {
+        if (lastId != UINT32_MAX && chunk == lastChunk) {
+            return lastId;
+        }
+        if ((chunks.size() + 1) * 2 > keys.size()) {
+            grow();
+        }
+        size_t mask = keys.size() - 1;
+        size_t slot = hash(chunk) & mask;
+        while (ids[slot] != UINT32_MAX && keys[slot] != chunk) slot = (slot + 1) & mask;
+        if (ids[slot] == UINT32_MAX) {
+            keys[slot] = chunk;
+            ids[slot] = static_cast<uint32_t>(chunks.size());
+            chunks.push_back(chunk);
+        }
+        lastChunk = chunk;
+        lastId = ids[slot];
+        return lastId;
+    }
+};
+
+/**
+ * @brief Parte de um bloco lida por uma tarefa, com seus pontos agrupados por chunk
+ */
+struct Slice {
+    const char* begin;
+    const char* end;
+    std::vector<BinnedPoint> points;    ///< Em ordem de chunk
+    std::vector<Run> runs;              ///< Um trecho por chunk tocado
+    std::vector<BinnedPoint> arrival;   ///< Pontos na ordem do arquivo
+    std::vector<uint32_t> arrivalChunk;
+    SliceChunks chunks;
+    int minVoxel[3];
+    int maxVoxel[3];
+    double minPosition[3];
+    double maxPosition[3];
+    uint64_t skipped;
+};
+
+/**
+ * @brief Percorre registros PLY binários nativos (coordenadas do tipo Position, cores uchar)
+ */
+template <typename Position, typename Visitor>
+uint64_t visitRecords(const Slice& slice, const PointFormat& format, bool byteColors, uint32_t defaultColor, Visitor& visit) {
+    const size_t position[3] = { format.offsets[format.position[0]], format.offsets[format.position[1]],
+                                 format.offsets[format.position[2]] };
+    const size_t color[3] = { byteColors ? format.offsets[format.color[0]] : 0, byteColors ? format.offsets[format.color[1]] : 0,
+                              byteColors ? format.offsets[format.color[2]] : 0 };
+    uint64_t skipped = 0;
+    for (const char* record = slice.begin; record + format.stride <= slice.end; record += format.stride) {
+        Position x, y, z;
+        std::memcpy(&x, record + position[0], sizeof(Position));
+        std::memcpy(&y, record + position[1], sizeof(Position));
+        std::memcpy(&z, record + position[2], sizeof(Position));
+        uint32_t rgb = defaultColor;
+        if (byteColors) {
+            rgb = packColor(static_cast<uint8_t>(record[color[0]]), static_cast<uint8_t>(record[color[1]]),
+                            static_cast<uint8_t>(record[color[2]]));
+        }
+        if (!visit(x, y, z, rgb)) skipped++;
+    }
+    return skipped;
+}
+
+/**
+ * @brief Percorre os pontos de uma fatia; visit(x, y, z, rgb) recebe as coordenadas do arquivo
+ * @return Linhas ignoradas
+ */
+template <typename Visitor>
+uint64_t visitPoints(const Slice& slice, const PointFormat& format, uint32_t defaultColor, Visitor&& visit) {
+    uint64_t skipped = 0;
+    if (format.kind == PointFormat::PLY_BINARY) {
+        const int* pos = format.position;
+        const int* col = format.color;
+        // Casos comuns (x, y, z float ou double e red, green, blue uchar, little-endian) sem
+        // conversões genéricas
+        Scalar positionType = format.types[pos[0]];
+        bool nativePositions = !format.swap && (positionType == Scalar::FLOAT32 || positionType == Scalar::FLOAT64) &&
+                               format.types[pos[1]] == positionType && format.types[pos[2]] == positionType;
+        bool byteColors = col[0] >= 0 && format.types[col[0]] == Scalar::UINT8 &&
+                          format.types[col[1]] == Scalar::UINT8 && format.types[col[2]] == Scalar::UINT8;
+        if (nativePositions && (byteColors || col[0] < 0)) {
+            if (positionType == Scalar::FLOAT32) {
+                return visitRecords<float>(slice, format, byteColors, defaultColor, visit);
+            }
+            return visitRecords<double>(slice, format, byteColors, defaultColor, visit);
+        }
+        for (const char* record = slice.begin; record + format.stride <= slice.end; record += format.stride) {
+            double x = readScalar(record + format.offsets[pos[0]], format.types[pos[0]], format.swap);
+            double y = readScalar(record + format.offsets[pos[1]], format.types[pos[1]], format.swap);
+            double z = readScalar(record + format.offsets[pos[2]], format.types[pos[2]], format.swap);
+            uint32_t rgb = defaultColor;
+            if (col[0] >= 0) {
+                rgb = packColor(toByte(readScalar(record + format.offsets[col[0]], format.types[col[0]], format.swap) * format.colorScale),
+                                toByte(readScalar(record + format.offsets[col[1]], format.types[col[1]], format.swap) * format.colorScale),
+                                toByte(readScalar(record + format.offsets[col[2]], format.types[col[2]], format.swap) * format.colorScale));
+            }
+            if (!visit(x, y, z, rgb)) skipped++;
+        }
+        return skipped;
+    }
+
+    double values[PointFormat::MAX_COLUMNS];
+    for (const char* line = slice.begin; line < slice.end;) {
+        const char* next = FileUtils::nextLine(line, slice.end);
+        const char* cursor = line;
+        const char* content = FileUtils::skipSpaces(line, next);
+        bool blank = content == next || *content == '\n';     // Não conta como ignorada
+        int count = 0;
+        while (count < PointFormat::MAX_COLUMNS && FileUtils::parseDouble(cursor, next, values[count])) {
+            count++;
+            cursor = FileUtils::skipSpaces(cursor, next);
+            if (cursor < next && *cursor == ',') cursor++;
+        }
+        line = next;
+
+        double x, y, z;
+        uint32_t rgb = defaultColor;
+        if (format.kind == PointFormat::PLY_ASCII) {
+            if (count < format.columns) {
+                skipped++;
+                continue;
+            }
+            x = values[format.position[0]];
+            y = values[format.position[1]];
+            z = values[format.position[2]];
+            if (format.color[0] >= 0) {
+                rgb = packColor(toByte(values[format.color[0]] * format.colorScale),
+                                toByte(values[format.color[1]] * format.colorScale),
+                                toByte(values[format.color[2]] * format.colorScale));
+            }
+        } else {
+            if (count < 3) {
+                if (!blank) skipped++;
+                continue;
+            }
+            x = values[0];
+            y = values[1];
+            z = values[2];
+            if (count >= 6) {
+                int first = count >= 7 ? 4 : 3;
+                rgb = packColor(toByte(values[first]), toByte(values[first + 1]), toByte(values[first + 2]));
+            }
+        }
+        if (!visit(x, y, z, rgb)) skipped++;
+    }
+    return skipped;
+}
+
+/**
+ * @brief Coordenadas do arquivo (Z para cima) para voxels do grid (Y para cima)
+ */
+struct Quantizer {
+    static constexpr double LIMIT = 1 << 30;
+
+    double offset[3];
+    double scale;
+    bool clamp;
+    int limit[3];       ///< Maior voxel (com clamp)
+
+    bool toVoxel(double x, double y, double z, int voxel[3]) const {
+        const double position[3] = { x, z, -y };
+        for (int axis = 0; axis < 3; axis++) {
+            double v = (position[axis] - offset[axis]) * scale;
+            if (!(v > -LIMIT && v < LIMIT)) {
+                return false;
+            }
+            int cell = static_cast<int>(v);
+            cell -= v < cell;       // Arredonda para baixo sem std::floor (chamada de biblioteca sem SSE4.1)
+            voxel[axis] = clamp ? std::min(std::max(cell, 0), limit[axis]) : cell;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Soma das cores dos pontos de cada voxel de um chunk, em tijolos de 8³ alocados
+ *        quando tocados
+ *
+ * Cada voxel usa 64 bits: 18 por canal e 10 para a contagem. Na contagem máxima as somas e a
+ * contagem caem pela metade, o que preserva a média.
+ */
+struct ChunkAccumulator {
+    static constexpr int BRICK = 8;
+    static constexpr int BRICKS_PER_AXIS = VoxelChunk::SIZE / BRICK;
+    static constexpr int BRICK_COUNT = BRICKS_PER_AXIS * BRICKS_PER_AXIS * BRICKS_PER_AXIS;
+    static constexpr int BRICK_VOLUME = BRICK * BRICK * BRICK;
+    static constexpr uint64_t CHANNEL_MASK = (1u << 18) - 1;
+    static constexpr uint64_t MAX_COUNT = 1023;
+
+    std::unique_ptr<uint64_t[]> bricks[BRICK_COUNT];
+    size_t stamp;       ///< Último bloco que distribuiu pontos para este chunk (+1)
+    size_t bin;         ///< Posição na distribuição desse bloco
+
+    ChunkAccumulator() : bricks(), stamp(0), bin(0) {}
+
+    static uint32_t cellOf(int x, int y, int z) {
+        int brick = x / BRICK + BRICKS_PER_AXIS * (y / BRICK + BRICKS_PER_AXIS * (z / BRICK));
+        int local = x % BRICK + BRICK * (y % BRICK + BRICK * (z % BRICK));
+        return static_cast<uint32_t>(brick * BRICK_VOLUME + local);
+    }
+
+    void add(uint32_t cell, uint32_t rgb) {
+        std::unique_ptr<uint64_t[]>& brick = bricks[cell / BRICK_VOLUME];
+        if (!brick) {
+            brick.reset(new uint64_t[BRICK_VOLUME]());
+        }
+        uint64_t& slot = brick[cell % BRICK_VOLUME];
+        if ((slot >> 54) == MAX_COUNT) {
+            slot = ((slot & CHANNEL_MASK) >> 1) | (((slot >> 18) & CHANNEL_MASK) >> 1) << 18 |
+                   (((slot >> 36) & CHANNEL_MASK) >> 1) << 36 | (MAX_COUNT >> 1) << 54;
+        }
+        slot += static_cast<uint64_t>(rgb & 0xFF) | static_cast<uint64_t>((rgb >> 8) & 0xFF) << 18 |
+                static_cast<uint64_t>((rgb >> 16) & 0xFF) << 36 | uint64_t(1) << 54;
+    }
+
+    /**
+     * @brief Escreve a cor média de cada voxel (chave de 15 bits + 1) e libera os tijolos
+     */
+    void resolve(std::vector<VoxelChunk::Cell>& cells, std::vector<std::atomic<uint8_t>>& usedKeys) {
+        cells.assign(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+        for (int b = 0; b < BRICK_COUNT; b++) {
+            if (!bricks[b]) continue;
+            int bx = b % BRICKS_PER_AXIS * BRICK;
+            int by = b / BRICKS_PER_AXIS % BRICKS_PER_AXIS * BRICK;
+            int bz = b / (BRICKS_PER_AXIS * BRICKS_PER_AXIS) * BRICK;
+            for (int i = 0; i < BRICK_VOLUME; i++) {
+                uint64_t slot = bricks[b][i];
+                uint64_t count = slot >> 54;
+                if (count == 0) continue;
+                uint32_t key = colorKey(static_cast<uint32_t>((slot & CHANNEL_MASK) / count),
+                                        static_cast<uint32_t>(((slot >> 18) & CHANNEL_MASK) / count),
+                                        static_cast<uint32_t>(((slot >> 36) & CHANNEL_MASK) / count));
+                cells[VoxelChunk::index(bx + i % BRICK, by + i / BRICK % BRICK, bz + i / (BRICK * BRICK))] =
+                    static_cast<VoxelChunk::Cell>(key + 1);
+                usedKeys[key].store(1, std::memory_order_relaxed);
+            }
+            bricks[b].reset();
+        }
+    }
+};
+
+/**
+ * @brief Divide o início do buffer em fatias de pontos inteiros
+ * @param remaining PLY: pontos ainda não lidos (descontados os desta divisão)
+ * @return Bytes consumidos
+ */
+size_t splitBlock(const BlockReader& reader, const PointFormat& format, uint64_t& remaining, std::vector<Slice>& slices) {
+    const char* data = reader.data();
+    size_t size = reader.available();
+    const char* end = data + size;
+
+    // Só pontos inteiros: até a última quebra de linha (ou o fim do arquivo) ou registro
+    if (format.kind == PointFormat::PLY_BINARY) {
+        uint64_t records = std::min<uint64_t>(size / format.stride, remaining);
+        end = data + records * format.stride;
+        remaining -= records;
+    } else {
+        if (!reader.eof) {
+            const char* last = end;
+            while (last > data && last[-1] != '\n') last--;
+            end = last;
+        }
+        if (format.kind == PointFormat::PLY_ASCII) {
+            const char* p = data;
+            uint64_t lines = 0;
+            while (p < end && lines < remaining) {
+                p = FileUtils::nextLine(p, end);
+                lines++;
+            }
+            end = p;
+            remaining -= lines;
+        }
+    }
+
+    size_t bytes = static_cast<size_t>(end - data);
+    size_t maxSlices = std::max<size_t>(1, ThreadPool::getInstance().getThreadCount() * 4);
+    size_t count = std::max<size_t>(1, std::min(maxSlices, bytes / PointCloudImporter::SLICE_BYTES));
+    slices.resize(count);
+    const char* begin = data;
+    for (size_t i = 0; i < count; i++) {
+        const char* sliceEnd = i + 1 == count ? end : data + bytes * (i + 1) / count;
+        if (format.kind == PointFormat::PLY_BINARY) {
+            sliceEnd = begin + (std::max(sliceEnd, begin) - begin) / format.stride * format.stride;
+        } else if (sliceEnd < end) {
+            sliceEnd = FileUtils::nextLine(std::max(sliceEnd, begin), end);
+        }
+        slices[i].begin = begin;
+        slices[i].end = sliceEnd;
+        begin = sliceEnd;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Lê o arquivo em blocos, dividindo cada um em fatias para processBlock
+ */
+bool forEachBlock(const std::string& path, const PointFormat& format, PointCloudImporter::Stats& stats,
+                  const std::function<bool(std::vector<Slice>&)>& processBlock) {
+    BlockReader reader;
+    auto readStart = std::chrono::steady_clock::now();
+    if (!reader.open(path, PointCloudImporter::BLOCK_BYTES)) {
+        return false;
+    }
+    reader.consume(format.headerBytes);
+    uint64_t remaining = format.kind == PointFormat::TEXT ? UINT64_MAX : format.vertexCount;
+    stats.readMs += elapsedMs(readStart);
+
+    std::vector<Slice> slices;
+    while (reader.available() > 0 && remaining > 0) {
+        size_t bytes = splitBlock(reader, format, remaining, slices);
+        if (bytes == 0) {
+            if (reader.eof || reader.available() == reader.buffer.size()) {
+                if (!reader.eof) {
+                    std::cerr << "Linha longa demais em " << path << std::endl;
+                    return false;
+                }
+                break;      // Registro incompleto no fim do arquivo
+            }
+        } else {
+            if (!processBlock(slices)) {
+                return false;
+            }
+            stats.blocks++;
+            reader.consume(bytes);
+        }
+
+        readStart = std::chrono::steady_clock::now();
+        if (!reader.refill()) {
+            return false;
+        }
+        stats.readMs += elapsedMs(readStart);
+    }
+    stats.bytesRead = reader.bytesRead;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------
+// Heightmap
+// ---------------------------------------------------------------------------------------
+
+/**
+ * @brief Lê o próximo campo numérico do cabeçalho PNM (pulando comentários)
+ */
+bool readPnmField(const char*& p, const char* end, int& value) {
+    while (p < end) {
+        if (*p == '#') {
+            p = FileUtils::nextLine(p, end);
+        } else if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            p++;
+        } else {
+            break;
+        }
+    }
+    int64_t parsed;
+    if (!FileUtils::parseInt(p, end, parsed) || parsed <= 0) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+} // namespace
+
+bool PointCloudImporter::isPointCloudPath(const std::string& path) {
+    return FileUtils::hasExtension(path, ".xyz") || FileUtils::hasExtension(path, ".txt") ||
+           FileUtils::hasExtension(path, ".pts") || FileUtils::hasExtension(path, ".csv") ||
+           FileUtils::hasExtension(path, ".ply");
+}
+
+bool PointCloudImporter::isHeightmapPath(const std::string& path) {
+    return FileUtils::hasExtension(path, ".pgm") || FileUtils::hasExtension(path, ".ppm");
+}
+
+bool PointCloudImporter::load(const std::string& path, VoxelGrid& grid) {
+    if (isHeightmapPath(path)) {
+        return loadHeightmap(path, grid);
+    }
+    return loadPointCloud(path, grid);
+}
+
+bool PointCloudImporter::loadPointCloud(const std::string& path, VoxelGrid& grid) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+    ThreadPool& pool = ThreadPool::getInstance();
+
+    PointFormat format;
+    if (FileUtils::hasExtension(path, ".ply")) {
+        BlockReader header;
+        if (!header.open(path, 64 * 1024)) {
+            return false;
+        }
+        if (header.available() < 4 || std::memcmp(header.data(), "ply", 3) != 0) {
+            std::cerr << "Arquivo PLY inválido: " << path << std::endl;
+            return false;
+        }
+        if (!parsePlyHeader(header.data(), header.available(), format, path)) {
+            return false;
+        }
+    }
+    const uint32_t defaultColor = packColor(settings.color.r, settings.color.g, settings.color.b);
+
+    // Escala: pelo tamanho do voxel (uma passada) ou pela resolução (limites antes)
+    Quantizer quantizer;
+    quantizer.offset[0] = quantizer.offset[1] = quantizer.offset[2] = 0.0;
+    quantizer.clamp = false;
+    quantizer.limit[0] = quantizer.limit[1] = quantizer.limit[2] = 0;
+    if (settings.voxelSize > 0.0) {
+        quantizer.scale = 1.0 / settings.voxelSize;
+    } else {
+        auto boundsStart = std::chrono::steady_clock::now();
+        double lo[3] = { INFINITY, INFINITY, INFINITY };
+        double hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+        bool read = forEachBlock(path, format, stats, [&](std::vector<Slice>& slices) {
+            pool.parallelFor(slices.size(), [&](size_t i) {
+                Slice& slice = slices[i];
+                for (int axis = 0; axis < 3; axis++) {
+                    slice.minPosition[axis] = INFINITY;
+                    slice.maxPosition[axis] = -INFINITY;
+                }
+                visitPoints(slice, format, defaultColor, [&](double x, double y, double z, uint32_t) {
+                    const double position[3] = { x, z, -y };
+                    if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) return false;
+                    for (int axis = 0; axis < 3; axis++) {
+                        slice.minPosition[axis] = std::min(slice.minPosition[axis], position[axis]);
+                        slice.maxPosition[axis] = std::max(slice.maxPosition[axis], position[axis]);
+                    }
+                    return true;
+                });
+            });
+            for (const Slice& slice : slices) {
+                for (int axis = 0; axis < 3; axis++) {
+                    lo[axis] = std::min(lo[axis], slice.minPosition[axis]);
+                    hi[axis] = std::max(hi[axis], slice.maxPosition[axis]);
+                }
+            }
+            return true;
+        });
+        if (!read) {
+            return false;
+        }
+        if (!(lo[0] <= hi[0])) {
+            std::cerr << "Nenhum ponto válido em " << path << std::endl;
+            return false;
+        }
+
+        double longest = std::max(hi[0] - lo[0], std::max(hi[1] - lo[1], hi[2] - lo[2]));
+        int resolution = std::min(std::max(settings.resolution, 1), MAX_RESOLUTION);
+        quantizer.scale = longest > 0.0 ? resolution / longest : 1.0;
+        quantizer.clamp = true;
+        for (int axis = 0; axis < 3; axis++) {
+            quantizer.offset[axis] = lo[axis];
+            quantizer.limit[axis] = std::min(resolution, static_cast<int>(std::ceil((hi[axis] - lo[axis]) * quantizer.scale))) - 1;
+            quantizer.limit[axis] = std::max(quantizer.limit[axis], 0);
+        }
+        stats.boundsMs = elapsedMs(boundsStart);
+        stats.blocks = 0;
+        stats.readMs = 0.0;
+    }
+
+    // Passada principal: fatias quantizam em paralelo, trechos são distribuídos por chunk e
+    // cada chunk soma as cores dos seus pontos em paralelo
+    std::unordered_map<glm::ivec3, std::unique_ptr<ChunkAccumulator>, Vec3Hash> accumulators;
+    std::vector<ChunkAccumulator*> binChunks;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> binRuns;    // (fatia, trecho)
+    glm::ivec3 minVoxel(INT32_MAX), maxVoxel(INT32_MIN);
+    size_t blockNumber = 0;
+    bool tooLarge = false;
+
+    bool read = forEachBlock(path, format, stats, [&](std::vector<Slice>& slices) {
+        auto parseStart = std::chrono::steady_clock::now();
+        pool.parallelFor(slices.size(), [&](size_t i) {
+            Slice& slice = slices[i];
+            slice.arrival.clear();
+            slice.arrivalChunk.clear();
+            slice.chunks.clear();
+            for (int axis = 0; axis < 3; axis++) {
+                slice.minVoxel[axis] = INT32_MAX;
+                slice.maxVoxel[axis] = INT32_MIN;
+            }
+            slice.skipped = visitPoints(slice, format, defaultColor, [&](double x, double y, double z, uint32_t rgb) {
+                int voxel[3], chunk[3], local[3];
+                if (!quantizer.toVoxel(x, y, z, voxel)) return false;
+                for (int axis = 0; axis < 3; axis++) {
+                    chunk[axis] = voxel[axis] >> CHUNK_SHIFT;
+                    local[axis] = voxel[axis] & (VoxelChunk::SIZE - 1);
+                    slice.minVoxel[axis] = std::min(slice.minVoxel[axis], voxel[axis]);
+                    slice.maxVoxel[axis] = std::max(slice.maxVoxel[axis], voxel[axis]);
+                }
+                slice.arrival.push_back({ ChunkAccumulator::cellOf(local[0], local[1], local[2]), rgb });
+                slice.arrivalChunk.push_back(slice.chunks.find(glm::ivec3(chunk[0], chunk[1], chunk[2])));
+                return true;
+            });
+
+            // Um trecho por chunk: contagem e espalhamento na ordem dos chunks
+            const std::vector<glm::ivec3>& touched = slice.chunks.getChunks();
+            slice.runs.resize(touched.size());
+            for (size_t c = 0; c < touched.size(); c++) {
+                slice.runs[c] = { touched[c], 0, 0 };
+            }
+            for (uint32_t id : slice.arrivalChunk) {
+                slice.runs[id].last++;
+            }
+            uint32_t offset = 0;
+            for (Run& run : slice.runs) {
+                run.first = offset;
+                offset += run.last;
+                run.last = run.first;
+            }
+            slice.points.resize(slice.arrival.size());
+            for (size_t p = 0; p < slice.arrival.size(); p++) {
+                slice.points[slice.runs[slice.arrivalChunk[p]].last++] = slice.arrival[p];
+            }
+        });
+        stats.parseMs += elapsedMs(parseStart);
+
+        auto binStart = std::chrono::steady_clock::now();
+        blockNumber++;
+        binChunks.clear();
+        ChunkAccumulator* current = nullptr;
+        glm::ivec3 currentChunk(0);
+        for (uint32_t s = 0; s < slices.size(); s++) {
+            const Slice& slice = slices[s];
+            stats.points += slice.points.size();
+            stats.skippedPoints += slice.skipped;
+            if (slice.points.empty()) continue;
+            for (int axis = 0; axis < 3; axis++) {
+                minVoxel[axis] = std::min(minVoxel[axis], slice.minVoxel[axis]);
+                maxVoxel[axis] = std::max(maxVoxel[axis], slice.maxVoxel[axis]);
+            }
+
+            for (uint32_t r = 0; r < slice.runs.size(); r++) {
+                const glm::ivec3& chunk = slice.runs[r].chunk;
+                if (!current || chunk != currentChunk) {
+                    std::unique_ptr<ChunkAccumulator>& accumulator = accumulators[chunk];
+                    if (!accumulator) {
+                        accumulator = std::make_unique<ChunkAccumulator>();
+                    }
+                    current = accumulator.get();
+                    currentChunk = chunk;
+                }
+                if (current->stamp != blockNumber) {
+                    current->stamp = blockNumber;
+                    current->bin = binChunks.size();
+                    binChunks.push_back(current);
+                    if (binRuns.size() < binChunks.size()) binRuns.emplace_back();
+                    binRuns[current->bin].clear();
+                }
+                binRuns[current->bin].emplace_back(s, r);
+            }
+        }
+
+        // A extensão só cresce: passar do limite já é erro, sem esperar o fim do arquivo
+        if (stats.points > 0) {
+            for (int axis = 0; axis < 3; axis++) {
+                int extent = maxVoxel[axis] - floorDiv(minVoxel[axis], VoxelChunk::SIZE) * VoxelChunk::SIZE + 1;
+                if (extent > MAX_RESOLUTION) {
+                    tooLarge = true;
+                    return false;
+                }
+            }
+        }
+
+        pool.parallelFor(binChunks.size(), [&](size_t bin) {
+            ChunkAccumulator& accumulator = *binChunks[bin];
+            for (const auto& ref : binRuns[bin]) {
+                const Slice& slice = slices[ref.first];
+                const Run& run = slice.runs[ref.second];
+                for (uint32_t i = run.first; i < run.last; i++) {
+                    accumulator.add(slice.points[i].cell, slice.points[i].rgb);
+                }
+            }
+        });
+        stats.binMs += elapsedMs(binStart);
+        return true;
+    });
+    if (tooLarge) {
+        std::cerr << "Nuvem grande demais para o tamanho de voxel (máximo " << MAX_RESOLUTION
+                  << " voxels por eixo): " << path << std::endl;
+        return false;
+    }
+    if (!read) {
+        return false;
+    }
+    if (stats.points == 0) {
+        std::cerr << "Nenhum ponto válido em " << path << std::endl;
+        return false;
+    }
+
+    // Cores médias, paleta pelas cores quantizadas usadas e chunks montados em paralelo
+    auto finishStart = std::chrono::steady_clock::now();
+    std::vector<std::pair<glm::ivec3, ChunkAccumulator*>> list;
+    list.reserve(accumulators.size());
+    for (auto& entry : accumulators) {
+        list.emplace_back(entry.first, entry.second.get());
+    }
+    std::vector<std::vector<VoxelChunk::Cell>> cells(list.size());
+    std::vector<std::atomic<uint8_t>> usedKeys(1 << 15);
+    pool.parallelFor(list.size(), [&](size_t i) {
+        list[i].second->resolve(cells[i], usedKeys);
+    });
+    accumulators.clear();
+
+    VoxelPalette palette;
+    std::vector<VoxelChunk::Cell> remap(1 << 15, VoxelPalette::EMPTY);
+    for (uint32_t key = 0; key < usedKeys.size(); key++) {
+        if (usedKeys[key].load(std::memory_order_relaxed)) {
+            remap[key] = palette.findOrAdd(Voxel(glm::ivec3(0), keyColor(key)));
+        }
+    }
+
+    glm::ivec3 shift(floorDiv(minVoxel.x, VoxelChunk::SIZE), floorDiv(minVoxel.y, VoxelChunk::SIZE),
+                     floorDiv(minVoxel.z, VoxelChunk::SIZE));
+    std::vector<std::unique_ptr<VoxelChunk>> chunks(list.size());
+    pool.parallelFor(list.size(), [&](size_t i) {
+        for (VoxelChunk::Cell& cell : cells[i]) {
+            if (cell != VoxelPalette::EMPTY) cell = remap[cell - 1];
+        }
+        chunks[i] = std::make_unique<VoxelChunk>(list[i].first - shift, std::move(cells[i]));
+    });
+
+    glm::ivec3 dims = maxVoxel - shift * VoxelChunk::SIZE + 1;
+    grid.setDimensions(VoxelGrid::Dimensions(dims.x, dims.y, dims.z));
+    grid.setOrigin(shift * VoxelChunk::SIZE);
+    grid.setPalette(palette);
+    for (auto& chunk : chunks) {
+        if (!chunk->isEmpty()) {
+            stats.voxels += static_cast<uint64_t>(chunk->getCellCount());
+            grid.insertChunk(std::move(chunk));
+            stats.chunks++;
+        }
+    }
+    stats.finishMs = elapsedMs(finishStart);
+
+    stats.elapsedMs = elapsedMs(start);
+    double seconds = (stats.elapsedMs - stats.boundsMs) / 1000.0;
+    if (seconds > 0.0) {
+        stats.pointsPerSecond = stats.points / seconds;
+        stats.megabytesPerSecond = stats.bytesRead / (1024.0 * 1024.0) / seconds;
+    }
+    return true;
+}
+
+bool PointCloudImporter::loadHeightmap(const std::string& path, VoxelGrid& grid) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+    ThreadPool& pool = ThreadPool::getInstance();
+
+    BlockReader reader;
+    if (!reader.open(path, BLOCK_BYTES)) {
+        return false;
+    }
+    const char* header = reader.data();
+    const char* headerEnd = header + reader.available();
+    int width = 0, height = 0, maxValue = 0;
+    if (reader.available() < 3 || header[0] != 'P' || (header[1] != '5' && header[1] != '6')) {
+        std::cerr << "Heightmap deve ser PGM (P5) ou PPM (P6) binário: " << path << std::endl;
+        return false;
+    }
+    const bool rgb = header[1] == '6';
+    const char* p = header + 2;
+    if (!readPnmField(p, headerEnd, width) || !readPnmField(p, headerEnd, height) ||
+        !readPnmField(p, headerEnd, maxValue) || p >= headerEnd || maxValue > 65535) {
+        std::cerr << "Cabeçalho PNM inválido: " << path << std::endl;
+        return false;
+    }
+    if (width > MAX_RESOLUTION || height > MAX_RESOLUTION) {
+        std::cerr << "Heightmap grande demais (máximo " << MAX_RESOLUTION << " pixels por eixo): " << path << std::endl;
+        return false;
+    }
+    reader.consume(static_cast<size_t>(p - header) + 1);    // Um espaço separa o cabeçalho dos dados
+
+    const int channels = rgb ? 3 : 1;
+    const int sampleBytes = maxValue > 255 ? 2 : 1;
+    const size_t rowBytes = static_cast<size_t>(width) * channels * sampleBytes;
+    const int levels = std::min(std::max(settings.heightmapHeight, 1), MAX_RESOLUTION);
+    const int chunkColumns = (width + VoxelChunk::SIZE - 1) / VoxelChunk::SIZE;
+    const int chunkLayers = (levels + VoxelChunk::SIZE - 1) / VoxelChunk::SIZE;
+
+    VoxelPalette palette;
+    KeyPalette keyPalette(palette);
+
+    // Faixa de SIZE linhas com uma linha vizinha de cada lado (para o fundo das colunas)
+    std::vector<int> heights(static_cast<size_t>(VoxelChunk::SIZE + 2) * width);
+    std::vector<VoxelPalette::Index> colors(static_cast<size_t>(VoxelChunk::SIZE) * width);
+    std::vector<int> nextRow(width);
+    std::vector<VoxelPalette::Index> nextColors(width);
+    std::vector<std::unique_ptr<VoxelChunk>> chunks;
+    std::vector<std::vector<VoxelChunk::Cell>> bandCells(static_cast<size_t>(chunkColumns) * chunkLayers);
+
+    auto readRow = [&](std::vector<int>& rowHeights, std::vector<VoxelPalette::Index>& rowColors) {
+        auto readStart = std::chrono::steady_clock::now();
+        if (reader.available() < rowBytes) {
+            if (!reader.refill() || reader.available() < rowBytes) {
+                std::cerr << "Heightmap truncado: " << path << std::endl;
+                return false;
+            }
+        }
+        stats.readMs += elapsedMs(readStart);
+
+        auto parseStart = std::chrono::steady_clock::now();
+        const uint8_t* row = reinterpret_cast<const uint8_t*>(reader.data());
+        for (int x = 0; x < width; x++) {
+            int sample[3];
+            for (int c = 0; c < channels; c++) {
+                const uint8_t* s = row + (static_cast<size_t>(x) * channels + c) * sampleBytes;
+                sample[c] = sampleBytes == 2 ? (s[0] << 8 | s[1]) : s[0];
+            }
+            int value = rgb ? (299 * sample[0] + 587 * sample[1] + 114 * sample[2]) / 1000 : sample[0];
+            int level = static_cast<int>((static_cast<int64_t>(std::min(value, maxValue)) * (levels - 1) + maxValue / 2) / maxValue);
+            rowHeights[x] = level;
+            uint32_t key;
+            if (rgb) {
+                key = colorKey(static_cast<uint32_t>(sample[0] * 255 / maxValue), static_cast<uint32_t>(sample[1] * 255 / maxValue),
+                               static_cast<uint32_t>(sample[2] * 255 / maxValue));
+            } else {
+                // Tons de cinza: cor das configurações, mais escura embaixo
+                int shade = 128 + 127 * level / std::max(levels - 1, 1);
+                key = colorKey(settings.color.r * shade / 255, settings.color.g * shade / 255, settings.color.b * shade / 255);
+            }
+            rowColors[x] = keyPalette.get(key);
+        }
+        reader.consume(rowBytes);
+        stats.points += static_cast<uint64_t>(width);
+        stats.parseMs += elapsedMs(parseStart);
+        return true;
+    };
+
+    // A primeira linha é lida antes; cada faixa lê a linha seguinte à sua última
+    if (!readRow(nextRow, nextColors)) {
+        return false;
+    }
+    std::copy(nextRow.begin(), nextRow.end(), heights.begin());
+    std::vector<int> rowHeights(width);
+    for (int band = 0; band * VoxelChunk::SIZE < height; band++) {
+        int rows = std::min(VoxelChunk::SIZE, height - band * VoxelChunk::SIZE);
+        if (band > 0) {
+            // Vizinha de cima: última linha da faixa anterior
+            std::copy(heights.begin() + static_cast<size_t>(VoxelChunk::SIZE) * width,
+                      heights.begin() + static_cast<size_t>(VoxelChunk::SIZE + 1) * width, heights.begin());
+        }
+        for (int r = 0; r < rows; r++) {
+            std::copy(nextRow.begin(), nextRow.end(), heights.begin() + static_cast<size_t>(r + 1) * width);
+            std::copy(nextColors.begin(), nextColors.end(), colors.begin() + static_cast<size_t>(r) * width);
+            int z = band * VoxelChunk::SIZE + r;
+            if (z + 1 < height) {
+                if (!readRow(nextRow, nextColors)) {
+                    return false;
+                }
+            }
+        }
+        // Vizinha de baixo: primeira linha da próxima faixa (ou a última repetida)
+        std::copy(nextRow.begin(), nextRow.end(), heights.begin() + static_cast<size_t>(rows + 1) * width);
+        if (band == 0) {
+            std::copy(heights.begin() + width, heights.begin() + 2 * static_cast<size_t>(width), heights.begin());
+        }
+
+        auto binStart = std::chrono::steady_clock::now();
+        pool.parallelFor(static_cast<size_t>(chunkColumns), [&](size_t column) {
+            int x0 = static_cast<int>(column) * VoxelChunk::SIZE;
+            int x1 = std::min(width, x0 + VoxelChunk::SIZE);
+            for (int r = 0; r < rows; r++) {
+                const int* above = heights.data() + static_cast<size_t>(r) * width;
+                const int* row = above + width;
+                const int* below = row + width;
+                for (int x = x0; x < x1; x++) {
+                    int top = row[x];
+                    int bottom = 0;
+                    if (!settings.solid) {
+                        int lowest = std::min(std::min(above[x], below[x]),
+                                              std::min(row[std::max(x - 1, 0)], row[std::min(x + 1, width - 1)]));
+                        bottom = std::min(top, lowest + 1);
+                    }
+                    VoxelPalette::Index color = colors[static_cast<size_t>(r) * width + x];
+                    for (int y = bottom; y <= top; y++) {
+                        std::vector<VoxelChunk::Cell>& cells = bandCells[column * chunkLayers + y / VoxelChunk::SIZE];
+                        if (cells.empty()) {
+                            cells.assign(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+                        }
+                        cells[VoxelChunk::index(x - x0, y % VoxelChunk::SIZE, r)] = color;
+                    }
+                }
+            }
+        });
+
+        size_t first = chunks.size();
+        chunks.resize(first + bandCells.size());
+        pool.parallelFor(bandCells.size(), [&](size_t i) {
+            if (bandCells[i].empty()) return;
+            glm::ivec3 coord(static_cast<int>(i) / chunkLayers, static_cast<int>(i) % chunkLayers, band);
+            chunks[first + i] = std::make_unique<VoxelChunk>(coord, std::move(bandCells[i]));
+            bandCells[i].clear();
+        });
+        stats.binMs += elapsedMs(binStart);
+        stats.blocks++;
+    }
+    stats.bytesRead = reader.bytesRead;
+
+    auto finishStart = std::chrono::steady_clock::now();
+    grid.setDimensions(VoxelGrid::Dimensions(width, levels, height));
+    grid.setOrigin(glm::ivec3(0));
+    grid.setPalette(palette);
+    for (auto& chunk : chunks) {
+        if (chunk) {
+            stats.voxels += static_cast<uint64_t>(chunk->getCellCount());
+            grid.insertChunk(std::move(chunk));
+            stats.chunks++;
+        }
+    }
+    stats.finishMs = elapsedMs(finishStart);
+
+    stats.elapsedMs = elapsedMs(start);
+    if (stats.elapsedMs > 0.0) {
+        stats.pointsPerSecond = stats.points / (stats.elapsedMs / 1000.0);
+        stats.megabytesPerSecond = stats.bytesRead / (1024.0 * 1024.0) / (stats.elapsedMs / 1000.0);
+    }
+    return true;
+}
+
+} // namespace VoxelMaker
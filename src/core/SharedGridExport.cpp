@@ -0,0 +1,512 @@
+#include "core/SharedGridExport.hpp"
+#include "utils/ThreadPool.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VOXELMAKER_HAS_SHM 1
+#endif
+
+namespace VoxelMaker {
+
+// O layout é lido por outros processos (e outras linguagens): nada de preenchimento
+// implícito nem atomics com trava
+static_assert(sizeof(SharedGridHeader) == 112, "layout do cabeçalho compartilhado mudou");
+static_assert(sizeof(SharedGridSlot) == 32, "layout do slot compartilhado mudou");
+static_assert(offsetof(SharedGridHeader, sequence) == 56, "layout do cabeçalho compartilhado mudou");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock exige atomics sem trava");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "seqlock exige atomics sem trava");
+
+namespace {
+
+constexpr size_t SLOT_CELL_BYTES = VoxelChunk::VOLUME * sizeof(VoxelChunk::Cell);
+constexpr int MAX_READ_ATTEMPTS = 1000;     ///< Leituras interrompidas antes de desistir
+
+size_t alignToPage(size_t bytes) {
+    return (bytes + SharedGridExport::PAGE_BYTES - 1) / SharedGridExport::PAGE_BYTES * SharedGridExport::PAGE_BYTES;
+}
+
+/**
+ * @brief Abre uma escrita protegida por seqlock (sequência fica ímpar)
+ */
+template <typename T>
+T beginWrite(std::atomic<T>& sequence) {
+    T value = sequence.load(std::memory_order_relaxed);
+    sequence.store(value + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return value + 2;
+}
+
+/**
+ * @brief Fecha a escrita (sequência volta a ser par, com os dados visíveis antes dela)
+ */
+template <typename T>
+void endWrite(std::atomic<T>& sequence, T value) {
+    sequence.store(value, std::memory_order_release);
+}
+
+/**
+ * @brief Lê dados protegidos por seqlock, repetindo enquanto o editor escreve
+ * @param read Cópia dos dados (pode ler valores rasgados; o resultado só vale se retornar true)
+ * @param observed Sequência par em que a leitura foi feita
+ * @return false se todas as tentativas foram interrompidas por escritas
+ */
+template <typename T, typename Read>
+bool readConsistent(const std::atomic<T>& sequence, Read read, T& observed) {
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+        T before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            read();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                observed = before;
+                return true;
+            }
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+} // namespace
+
+SharedGridExport::SharedGridExport()
+    : name()
+    , region(nullptr)
+    , regionSize(0)
+    , descriptor(-1)
+    , maxChunks(DEFAULT_MAX_CHUNKS)
+    , slots()
+    , freeSlots()
+    , publishedPalette()
+    , publishedRevision(0)
+    , generation(0)
+    , published(false)
+    , stats() {
+}
+
+SharedGridExport::~SharedGridExport() {
+    close();
+}
+
+std::string SharedGridExport::regionNameFor(const std::string& regionName) {
+    size_t start = regionName.find_first_not_of('/');
+    if (start == std::string::npos || regionName.find('/', start) != std::string::npos) {
+        return std::string();
+    }
+    // NAME_MAX inclui a barra
+    if (regionName.size() - start > 250) {
+        return std::string();
+    }
+    return "/" + regionName.substr(start);
+}
+
+size_t SharedGridExport::regionSizeFor(size_t slotCount) {
+    return PAGE_BYTES + alignToPage(slotCount * sizeof(SharedGridSlot)) +
+           alignToPage(PALETTE_CAPACITY * sizeof(uint32_t)) + slotCount * SLOT_CELL_BYTES;
+}
+
+SharedGridSlot& SharedGridExport::slotAt(uint32_t slot) const {
+    return reinterpret_cast<SharedGridSlot*>(region + header().tableOffset)[slot];
+}
+
+VoxelChunk::Cell* SharedGridExport::cellsAt(uint32_t slot) const {
+    return reinterpret_cast<VoxelChunk::Cell*>(region + header().cellsOffset + slot * SLOT_CELL_BYTES);
+}
+
+bool SharedGridExport::open(const std::string& regionName) {
+    close();
+
+    std::string normalized = regionNameFor(regionName);
+    if (normalized.empty()) {
+        std::cerr << "Nome de memória compartilhada inválido: " << regionName << std::endl;
+        return false;
+    }
+    if (maxChunks == 0 || maxChunks > UINT32_MAX) {
+        std::cerr << "Número de slots inválido para memória compartilhada: " << maxChunks << std::endl;
+        return false;
+    }
+
+#ifdef VOXELMAKER_HAS_SHM
+    // Região deixada por uma execução interrompida: leitores antigos continuam com a deles
+    shm_unlink(normalized.c_str());
+    descriptor = shm_open(normalized.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor < 0) {
+        std::cerr << "Erro ao criar memória compartilhada: " << normalized << std::endl;
+        return false;
+    }
+
+    // ftruncate não reserva páginas: slots nunca usados não ocupam memória
+    size_t size = regionSizeFor(maxChunks);
+    if (ftruncate(descriptor, static_cast<off_t>(size)) != 0) {
+        std::cerr << "Erro ao dimensionar memória compartilhada: " << normalized << std::endl;
+        ::close(descriptor);
+        descriptor = -1;
+        shm_unlink(normalized.c_str());
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Erro ao mapear memória compartilhada: " << normalized << std::endl;
+        ::close(descriptor);
+        descriptor = -1;
+        shm_unlink(normalized.c_str());
+        return false;
+    }
+
+    name = normalized;
+    region = static_cast<uint8_t*>(mapping);
+    regionSize = size;
+
+    SharedGridHeader* created = new (region) SharedGridHeader();
+    created->version = SHARED_VERSION;
+    created->headerSize = static_cast<uint32_t>(sizeof(SharedGridHeader));
+    created->chunkSize = static_cast<uint32_t>(VoxelChunk::SIZE);
+    created->regionSize = size;
+    created->maxChunks = static_cast<uint32_t>(maxChunks);
+    created->paletteCapacity = static_cast<uint32_t>(PALETTE_CAPACITY);
+    created->tableOffset = PAGE_BYTES;
+    created->paletteOffset = created->tableOffset + alignToPage(maxChunks * sizeof(SharedGridSlot));
+    created->cellsOffset = created->paletteOffset + alignToPage(PALETTE_CAPACITY * sizeof(uint32_t));
+    created->writerPid = static_cast<uint32_t>(getpid());
+    for (size_t i = 0; i < maxChunks; i++) {
+        new (&slotAt(static_cast<uint32_t>(i))) SharedGridSlot();
+    }
+    // A assinatura vem por último: quem abrir durante a criação vê uma região inválida
+    std::atomic_thread_fence(std::memory_order_release);
+    created->magic = SHARED_MAGIC;
+
+    // Pilha: os primeiros slots saem primeiro e a região cresce do início
+    freeSlots.resize(maxChunks);
+    for (size_t i = 0; i < maxChunks; i++) {
+        freeSlots[i] = static_cast<uint32_t>(maxChunks - 1 - i);
+    }
+    stats = Stats();
+    return true;
+#else
+    std::cerr << "Memória compartilhada não suportada nesta plataforma: " << normalized << std::endl;
+    return false;
+#endif
+}
+
+void SharedGridExport::close() {
+#ifdef VOXELMAKER_HAS_SHM
+    if (region) {
+        SharedGridHeader& shared = header();
+        uint64_t sequence = beginWrite(shared.sequence);
+        shared.flags |= FLAG_CLOSED;
+        endWrite(shared.sequence, sequence);
+
+        munmap(region, regionSize);
+        shm_unlink(name.c_str());
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+#endif
+    region = nullptr;
+    regionSize = 0;
+    descriptor = -1;
+    slots.clear();
+    freeSlots.clear();
+    publishedPalette.clear();
+    publishedRevision = 0;
+    published = false;
+}
+
+void SharedGridExport::encodePalette(const VoxelPalette& palette, std::vector<uint32_t>& rgba) {
+    rgba.resize(palette.size());
+    for (size_t i = 0; i < palette.size(); i++) {
+        const Voxel::Color& color = palette.get(static_cast<VoxelPalette::Index>(i)).getColor();
+        uint8_t bytes[4] = { color.r, color.g, color.b, color.a };
+        std::memcpy(&rgba[i], bytes, sizeof(bytes));
+    }
+}
+
+bool SharedGridExport::update(const VoxelGrid& grid) {
+    if (!region || (published && grid.getRevision() == publishedRevision)) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SharedGridHeader& shared = header();
+    uint64_t sequence = beginWrite(shared.sequence);
+    const VoxelGrid::ChunkMap& chunks = grid.getChunks();
+
+    // Uma passada pelo grid marca os chunks vistos e separa os de revisão nova
+    generation++;
+    std::vector<std::pair<const VoxelChunk*, SlotRef*>> pending;
+    std::vector<const VoxelChunk*> added;
+    size_t seen = 0;
+    for (const auto& pair : chunks) {
+        const VoxelChunk* chunk = pair.second.get();
+        auto found = slots.find(pair.first);
+        if (found == slots.end()) {
+            added.push_back(chunk);
+            continue;
+        }
+        found->second.generation = generation;
+        seen++;
+        if (found->second.revision != chunk->getRevision()) {
+            found->second.revision = chunk->getRevision();
+            pending.emplace_back(chunk, &found->second);
+        }
+    }
+
+    // Chunks removidos liberam o slot antes que os novos peçam um
+    if (seen < slots.size()) {
+        for (auto it = slots.begin(); it != slots.end();) {
+            if (it->second.generation == generation) {
+                ++it;
+                continue;
+            }
+            SharedGridSlot& entry = slotAt(it->second.slot);
+            uint32_t slotSequence = beginWrite(entry.sequence);
+            entry.used = 0;
+            endWrite(entry.sequence, slotSequence);
+            freeSlots.push_back(it->second.slot);
+            stats.chunksRemoved++;
+            it = slots.erase(it);
+        }
+    }
+
+    // Os que não couberem tentam de novo na próxima edição
+    size_t reused = pending.size();
+    size_t dropped = 0;
+    for (const VoxelChunk* chunk : added) {
+        if (freeSlots.empty()) {
+            dropped++;
+            continue;
+        }
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        auto inserted = slots.emplace(chunk->getCoord(), SlotRef{ slot, chunk->getRevision(), 0, generation });
+        pending.emplace_back(chunk, &inserted.first->second);
+    }
+
+    // Cada tarefa escreve só o seu slot; leitores daquele slot veem a sequência ímpar. Editar
+    // um chunk também muda a revisão dos vizinhos: os que têm o mesmo hash de conteúdo (mantido
+    // pelo chunk a cada edição) não são reescritos, para que leitores não releiam slots iguais
+    std::vector<uint8_t> written(pending.size(), 1);
+    ThreadPool::getInstance().parallelFor(pending.size(), [&](size_t i) {
+        const VoxelChunk* chunk = pending[i].first;
+        SlotRef& ref = *pending[i].second;
+        uint64_t contentHash = chunk->getContentHash();
+        if (i < reused && contentHash == ref.contentHash) {
+            written[i] = 0;
+            return;
+        }
+        ref.contentHash = contentHash;
+
+        SharedGridSlot& entry = slotAt(ref.slot);
+        uint32_t slotSequence = beginWrite(entry.sequence);
+        chunk->copyCells(cellsAt(ref.slot));
+        entry.x = chunk->getCoord().x;
+        entry.y = chunk->getCoord().y;
+        entry.z = chunk->getCoord().z;
+        entry.solidCells = static_cast<uint32_t>(chunk->getCellCount());
+        entry.revision = chunk->getRevision();
+        entry.used = 1;
+        endWrite(entry.sequence, slotSequence);
+    });
+    for (uint8_t flag : written) {
+        stats.chunksCopied += flag;
+        stats.chunksUnchanged += 1 - flag;
+    }
+
+    // A paleta só é reescrita a partir da primeira entrada diferente
+    std::vector<uint32_t> palette;
+    encodePalette(grid.getPalette(), palette);
+    size_t firstChanged = 0;
+    while (firstChanged < palette.size() && firstChanged < publishedPalette.size() &&
+           palette[firstChanged] == publishedPalette[firstChanged]) {
+        firstChanged++;
+    }
+    if (firstChanged < palette.size() || palette.size() != publishedPalette.size()) {
+        uint32_t* sharedPalette = reinterpret_cast<uint32_t*>(region + shared.paletteOffset);
+        std::memcpy(sharedPalette + firstChanged, palette.data() + firstChanged,
+                    (palette.size() - firstChanged) * sizeof(uint32_t));
+        publishedPalette.swap(palette);
+        stats.paletteUpdates++;
+    }
+
+    const VoxelGrid::Dimensions& dimensions = grid.getDimensions();
+    const glm::ivec3& origin = grid.getOrigin();
+    shared.revision = grid.getRevision();
+    shared.dimensions[0] = dimensions.width;
+    shared.dimensions[1] = dimensions.height;
+    shared.dimensions[2] = dimensions.depth;
+    shared.origin[0] = origin.x;
+    shared.origin[1] = origin.y;
+    shared.origin[2] = origin.z;
+    shared.chunkCount = static_cast<uint32_t>(slots.size());
+    shared.paletteCount = static_cast<uint32_t>(publishedPalette.size());
+    shared.flags = dropped > 0 ? (shared.flags | FLAG_TRUNCATED) : (shared.flags & ~FLAG_TRUNCATED);
+    endWrite(shared.sequence, sequence);
+
+    if (dropped > 0 && stats.chunksDropped == 0) {
+        std::cerr << "Memória compartilhada cheia: " << dropped << " chunks ficaram de fora de " << name
+                  << " (" << maxChunks << " slots)" << std::endl;
+    }
+
+    publishedRevision = grid.getRevision();
+    published = true;
+    stats.publishes++;
+    stats.chunksPublished = slots.size();
+    stats.chunksDropped = dropped;
+    stats.lastPublishMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+SharedGridView::SharedGridView()
+    : name()
+    , region(nullptr)
+    , regionSize(0)
+    , descriptor(-1) {
+}
+
+SharedGridView::~SharedGridView() {
+    close();
+}
+
+bool SharedGridView::open(const std::string& regionName) {
+    close();
+
+    std::string normalized = SharedGridExport::regionNameFor(regionName);
+    if (normalized.empty()) {
+        std::cerr << "Nome de memória compartilhada inválido: " << regionName << std::endl;
+        return false;
+    }
+
+#ifdef VOXELMAKER_HAS_SHM
+    descriptor = shm_open(normalized.c_str(), O_RDONLY, 0);
+    if (descriptor < 0) {
+        std::cerr << "Memória compartilhada não encontrada: " << normalized << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || static_cast<size_t>(info.st_size) < SharedGridExport::PAGE_BYTES) {
+        std::cerr << "Memória compartilhada inválida: " << normalized << std::endl;
+        close();
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Erro ao mapear memória compartilhada: " << normalized << std::endl;
+        close();
+        return false;
+    }
+    name = normalized;
+    region = static_cast<const uint8_t*>(mapping);
+    regionSize = size;
+
+    // Os campos fixos não mudam depois da assinatura
+    const SharedGridHeader& shared = getHeader();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t cellsEnd = shared.cellsOffset + static_cast<uint64_t>(shared.maxChunks) * SLOT_CELL_BYTES;
+    bool valid = shared.magic == SharedGridExport::SHARED_MAGIC &&
+                 shared.version == SharedGridExport::SHARED_VERSION &&
+                 shared.headerSize >= sizeof(SharedGridHeader) &&
+                 shared.chunkSize == static_cast<uint32_t>(VoxelChunk::SIZE) &&
+                 shared.regionSize <= size &&
+                 shared.tableOffset + static_cast<uint64_t>(shared.maxChunks) * sizeof(SharedGridSlot) <= shared.paletteOffset &&
+                 shared.paletteOffset + static_cast<uint64_t>(shared.paletteCapacity) * sizeof(uint32_t) <= shared.cellsOffset &&
+                 cellsEnd <= shared.regionSize;
+    if (!valid) {
+        std::cerr << "Layout de memória compartilhada desconhecido: " << normalized << std::endl;
+        close();
+        return false;
+    }
+    return true;
+#else
+    std::cerr << "Memória compartilhada não suportada nesta plataforma: " << normalized << std::endl;
+    return false;
+#endif
+}
+
+void SharedGridView::close() {
+#ifdef VOXELMAKER_HAS_SHM
+    if (region) {
+        munmap(const_cast<uint8_t*>(region), regionSize);
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+#endif
+    region = nullptr;
+    regionSize = 0;
+    descriptor = -1;
+}
+
+bool SharedGridView::readSnapshot(Snapshot& out) const {
+    if (!region) {
+        return false;
+    }
+    const SharedGridHeader& shared = getHeader();
+    uint64_t sequence = 0;
+    bool consistent = readConsistent(shared.sequence, [&]() {
+        out.revision = shared.revision;
+        std::memcpy(out.dimensions, shared.dimensions, sizeof(out.dimensions));
+        std::memcpy(out.origin, shared.origin, sizeof(out.origin));
+        out.chunkCount = shared.chunkCount;
+        out.paletteCount = shared.paletteCount;
+        out.writerPid = shared.writerPid;
+        out.flags = shared.flags;
+    }, sequence);
+    if (!consistent) {
+        return false;
+    }
+    out.sequence = sequence;
+    return true;
+}
+
+const SharedGridSlot& SharedGridView::getSlot(uint32_t slot) const {
+    return reinterpret_cast<const SharedGridSlot*>(region + getHeader().tableOffset)[slot];
+}
+
+const VoxelChunk::Cell* SharedGridView::getCells(uint32_t slot) const {
+    return reinterpret_cast<const VoxelChunk::Cell*>(region + getHeader().cellsOffset + slot * SLOT_CELL_BYTES);
+}
+
+const uint32_t* SharedGridView::getPalette() const {
+    return reinterpret_cast<const uint32_t*>(region + getHeader().paletteOffset);
+}
+
+bool SharedGridView::readSlot(uint32_t slot, SharedGridSlot& entry, VoxelChunk::Cell* cells) const {
+    if (!region || slot >= getMaxChunks()) {
+        return false;
+    }
+    const SharedGridSlot& shared = getSlot(slot);
+    uint32_t used = 0;
+    uint32_t sequence = 0;
+    bool consistent = readConsistent(shared.sequence, [&]() {
+        used = shared.used;
+        entry.x = shared.x;
+        entry.y = shared.y;
+        entry.z = shared.z;
+        entry.solidCells = shared.solidCells;
+        entry.revision = shared.revision;
+        if (used && cells) {
+            std::memcpy(cells, getCells(slot), SLOT_CELL_BYTES);
+        }
+    }, sequence);
+    if (!consistent || !used) {
+        return false;
+    }
+    entry.used = used;
+    entry.sequence.store(sequence, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,160 @@
+#include "core/VoxelChunk.hpp"
+#include "core/ChunkCodec.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace VoxelMaker {
+
+VoxelChunk::VoxelChunk(const glm::ivec3& chunkCoord)
+    : coord(chunkCoord)
+    , cells(VOLUME, VoxelPalette::EMPTY)
+    , cellCount(0)
+    , revision(0)
+    , source()
+    , sourceEntry(0)
+    , resident(true)
+    , loadMutex()
+    , contentHash(0)
+    , hashValid(true) {
+}
+
+VoxelChunk::VoxelChunk(const glm::ivec3& chunkCoord, std::shared_ptr<const Source> chunkSource, size_t entry, int count)
+    : coord(chunkCoord)
+    , cells()
+    , cellCount(count)
+    , revision(0)
+    , source(std::move(chunkSource))
+    , sourceEntry(entry)
+    , resident(source == nullptr)
+    , loadMutex()
+    , contentHash(0)
+    , hashValid(source == nullptr) {
+    if (!source) {
+        cells.assign(VOLUME, VoxelPalette::EMPTY);
+        cellCount = 0;
+    }
+}
+
+VoxelChunk::VoxelChunk(const glm::ivec3& chunkCoord, std::shared_ptr<const Source> chunkSource, size_t entry, int count,
+                       uint64_t hash)
+    : VoxelChunk(chunkCoord, std::move(chunkSource), entry, count) {
+    contentHash = source ? hash : 0;
+    hashValid = true;
+}
+
+VoxelChunk::VoxelChunk(const glm::ivec3& chunkCoord, std::vector<Cell> chunkCells)
+    : coord(chunkCoord)
+    , cells(std::move(chunkCells))
+    , cellCount(0)
+    , revision(0)
+    , source()
+    , sourceEntry(0)
+    , resident(true)
+    , loadMutex()
+    , contentHash(0)
+    , hashValid(false) {
+    cells.resize(VOLUME, VoxelPalette::EMPTY);
+    cellCount = static_cast<int>(VOLUME - std::count(cells.begin(), cells.end(), VoxelPalette::EMPTY));
+}
+
+VoxelChunk::Cell VoxelChunk::set(const glm::ivec3& local, Cell cell) {
+    ensureResident();
+    source.reset();     // Editado: a fonte não representa mais o conteúdo
+
+    int cellIndex = index(local.x, local.y, local.z);
+    Cell& slot = cells[cellIndex];
+    Cell previous = slot;
+
+    if (previous == VoxelPalette::EMPTY && cell != VoxelPalette::EMPTY) {
+        cellCount++;
+    } else if (previous != VoxelPalette::EMPTY && cell == VoxelPalette::EMPTY) {
+        cellCount--;
+    }
+
+    slot = cell;
+    if (hashValid) {
+        contentHash += hashCell(cellIndex, cell) - hashCell(cellIndex, previous);
+    }
+    return previous;
+}
+
+uint64_t VoxelChunk::getContentHash() const {
+    if (hashValid) {
+        return contentHash;
+    }
+
+    std::vector<Cell> decoded;
+    const Cell* data = nullptr;
+    if (isResident()) {
+        data = cells.data();
+    } else {
+        // Chunks preguiçosos continuam fora da memória
+        decoded.resize(VOLUME);
+        copyCells(decoded.data());
+        data = decoded.data();
+    }
+
+    uint64_t hash = hashCells(data);
+    contentHash = hash;
+    hashValid = true;
+    return hash;
+}
+
+bool VoxelChunk::copyCells(Cell* out) const {
+    // Não residente implica fonte presente (edições tornam o chunk residente)
+    if (!isResident()) {
+        if (source->decodeChunk(sourceEntry, out)) {
+            return true;
+        }
+        std::fill(out, out + VOLUME, VoxelPalette::EMPTY);
+        return false;
+    }
+
+    std::copy(cells.begin(), cells.end(), out);
+    return true;
+}
+
+bool VoxelChunk::release() {
+    if (!source || !isResident()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(loadMutex);
+    resident.store(false, std::memory_order_release);
+    std::vector<Cell>().swap(cells);
+    return true;
+}
+
+bool VoxelChunk::compress() {
+    if (!isResident()) {
+        return false;
+    }
+    if (!source) {
+        std::vector<uint8_t> block;
+        ChunkCodec::Codec codec = ChunkCodec::encodeBest(cells.data(), block);
+        block.shrink_to_fit();
+        source = std::make_shared<ChunkCodec::MemorySource>(codec, std::move(block));
+        sourceEntry = 0;
+    }
+    return release();
+}
+
+void VoxelChunk::load() const {
+    std::lock_guard<std::mutex> lock(loadMutex);
+    if (resident.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    cells.assign(VOLUME, VoxelPalette::EMPTY);
+    if (!source->decodeChunk(sourceEntry, cells.data())) {
+        std::cerr << "Chunk (" << coord.x << ", " << coord.y << ", " << coord.z
+                  << ") corrompido; carregado vazio" << std::endl;
+        std::fill(cells.begin(), cells.end(), VoxelPalette::EMPTY);
+        cellCount = 0;
+        contentHash = 0;        // Um hash vindo da fonte descreveria as células perdidas
+        hashValid = true;
+    }
+    resident.store(true, std::memory_order_release);
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,379 @@
+#include "core/VoxelFile.hpp"
+#include "utils/FileUtils.hpp"
+#include "utils/MappedFile.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace VoxelMaker {
+
+namespace {
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t dimensions[3];
+    int32_t origin[3];
+    uint32_t paletteCount;      ///< Entradas gravadas (sem a entrada vazia)
+    uint32_t chunkCount;
+    uint64_t paletteOffset;
+    uint64_t paletteSize;
+    uint64_t directoryOffset;
+    uint64_t voxelCount;
+    uint32_t paletteChecksum;
+    uint32_t directoryChecksum;
+    uint32_t headerChecksum;    ///< CRC-32 dos campos anteriores
+    uint32_t reserved;
+};
+static_assert(sizeof(FileHeader) == 88, "Cabeçalho do arquivo mudou de tamanho");
+
+struct DirectoryEntry {
+    int32_t coord[3];
+    uint32_t cellCount;
+    uint64_t offset;
+    uint32_t size;
+    uint32_t checksum;
+    uint8_t encoding;           ///< ChunkCodec::Codec
+    uint8_t reserved[7];
+    uint64_t contentHash;       ///< VoxelChunk::hashCells das células gravadas (versão 3)
+};
+static_assert(sizeof(DirectoryEntry) == 48, "Entrada do diretório mudou de tamanho");
+
+constexpr size_t HEADER_CHECKSUM_BYTES = offsetof(FileHeader, headerChecksum);
+constexpr size_t LEGACY_ENTRY_BYTES = offsetof(DirectoryEntry, contentHash);    ///< Entradas das versões 1 e 2
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool readValue(const uint8_t*& cursor, const uint8_t* end, T& value) {
+    if (static_cast<size_t>(end - cursor) < sizeof(T)) return false;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+/**
+ * @brief Chunks de um arquivo mapeado, decodificados sob demanda
+ */
+class FileChunkSource : public VoxelChunk::Source {
+private:
+    MappedFile file;
+    std::vector<DirectoryEntry> directory;
+    std::vector<VoxelPalette::Index> remap;
+    bool identity;              ///< Índices gravados coincidem com os da paleta carregada
+
+public:
+    FileChunkSource() : file(), directory(), remap(), identity(true) {}
+
+    MappedFile& getFile() { return file; }
+    std::vector<DirectoryEntry>& getDirectory() { return directory; }
+    bool isIdentity() const { return identity; }
+
+    void setRemap(const std::vector<VoxelPalette::Index>& indices) {
+        remap = indices;
+        identity = true;
+        for (size_t i = 0; i < remap.size(); i++) {
+            identity = identity && remap[i] == i;
+        }
+    }
+
+    bool decodeChunk(size_t entry, VoxelChunk::Cell* cells) const override {
+        if (entry >= directory.size()) return false;
+
+        const DirectoryEntry& info = directory[entry];
+        if (!file.contains(info.offset, info.size)) return false;
+
+        const uint8_t* data = file.getData() + info.offset;
+        if (FileUtils::crc32(data, info.size) != info.checksum) return false;
+
+        if (!ChunkCodec::decode(static_cast<ChunkCodec::Codec>(info.encoding), data, info.size, cells)) {
+            return false;
+        }
+
+        int count = 0;
+        for (int i = 0; i < VoxelChunk::VOLUME; i++) {
+            VoxelChunk::Cell cell = cells[i];
+            if (cell >= remap.size()) return false;
+            if (!identity) cells[i] = remap[cell];
+            count += cell != VoxelPalette::EMPTY ? 1 : 0;
+        }
+        return count == static_cast<int>(info.cellCount);
+    }
+};
+
+} // namespace
+
+std::vector<uint8_t> VoxelFile::encodePalette(const VoxelPalette& palette, size_t first) {
+    std::vector<uint8_t> out;
+    for (size_t i = std::max<size_t>(first, 1); i < palette.size(); i++) {
+        const Voxel& voxel = palette.get(static_cast<VoxelPalette::Index>(i));
+        const Voxel::Color& color = voxel.getColor();
+        const Voxel::Material& material = voxel.getMaterial();
+
+        out.insert(out.end(), {color.r, color.g, color.b, color.a});
+        out.push_back(voxel.isActive() ? 1 : 0);
+        appendValue(out, material.roughness);
+        appendValue(out, material.metallic);
+        appendValue(out, material.transparency);
+        uint16_t nameLength = static_cast<uint16_t>(std::min<size_t>(material.name.size(), UINT16_MAX));
+        appendValue(out, nameLength);
+        out.insert(out.end(), material.name.begin(), material.name.begin() + nameLength);
+    }
+    return out;
+}
+
+bool VoxelFile::decodePalette(const uint8_t* data, size_t size, uint32_t count,
+                              VoxelPalette& palette, std::vector<VoxelPalette::Index>& remap) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+
+    palette.clear();
+    remap.assign(static_cast<size_t>(count) + 1, VoxelPalette::EMPTY);
+    for (uint32_t i = 1; i <= count; i++) {
+        uint8_t rgba[4];
+        uint8_t active;
+        Voxel::Material material;
+        uint16_t nameLength;
+        if (!readValue(cursor, end, rgba) || !readValue(cursor, end, active) ||
+            !readValue(cursor, end, material.roughness) || !readValue(cursor, end, material.metallic) ||
+            !readValue(cursor, end, material.transparency) || !readValue(cursor, end, nameLength) ||
+            static_cast<size_t>(end - cursor) < nameLength) {
+            return false;
+        }
+        material.name.assign(reinterpret_cast<const char*>(cursor), nameLength);
+        cursor += nameLength;
+
+        Voxel voxel(glm::ivec3(0), Voxel::Color(rgba[0], rgba[1], rgba[2], rgba[3]), material);
+        voxel.setActive(active != 0);
+        remap[i] = palette.findOrAdd(voxel);
+        if (remap[i] == VoxelPalette::EMPTY) {
+            return false;
+        }
+    }
+    return cursor == end;
+}
+
+bool VoxelFile::save(const VoxelGrid& grid, const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+
+    std::string temporary = path + ".tmp";
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Erro ao criar arquivo: " << temporary << std::endl;
+        return false;
+    }
+
+    FileHeader header = {};
+    header.magic = FILE_MAGIC;
+    header.version = FILE_VERSION;
+    const VoxelGrid::Dimensions& dimensions = grid.getDimensions();
+    header.dimensions[0] = dimensions.width;
+    header.dimensions[1] = dimensions.height;
+    header.dimensions[2] = dimensions.depth;
+    header.origin[0] = grid.getOrigin().x;
+    header.origin[1] = grid.getOrigin().y;
+    header.origin[2] = grid.getOrigin().z;
+
+    std::vector<uint8_t> palette = encodePalette(grid.getPalette());
+    header.paletteCount = static_cast<uint32_t>(grid.getPalette().size() - 1);
+    header.paletteOffset = sizeof(FileHeader);
+    header.paletteSize = palette.size();
+    header.paletteChecksum = FileUtils::crc32(palette.data(), palette.size());
+
+    // O cabeçalho definitivo é regravado no fim, quando o diretório já é conhecido
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(palette.data()), static_cast<std::streamsize>(palette.size()));
+
+    std::vector<const VoxelChunk*> chunks;
+    chunks.reserve(grid.getChunks().size());
+    for (const auto& pair : grid.getChunks()) {
+        chunks.push_back(pair.second.get());
+    }
+
+    // Lotes codificados em paralelo e gravados em ordem: a memória fica limitada ao lote
+    std::vector<DirectoryEntry> directory(chunks.size());
+    std::vector<std::vector<uint8_t>> payloads(std::min(SAVE_BATCH, chunks.size()));
+    uint64_t offset = sizeof(FileHeader) + palette.size();
+    bool ok = static_cast<bool>(file);
+
+    for (size_t first = 0; ok && first < chunks.size(); first += SAVE_BATCH) {
+        size_t count = std::min(SAVE_BATCH, chunks.size() - first);
+
+        ThreadPool::getInstance().parallelFor(count, [&](size_t i) {
+            const VoxelChunk& chunk = *chunks[first + i];
+            std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME);
+            chunk.copyCells(cells.data());
+
+            DirectoryEntry& entry = directory[first + i];
+            entry = DirectoryEntry();
+            entry.coord[0] = chunk.getCoord().x;
+            entry.coord[1] = chunk.getCoord().y;
+            entry.coord[2] = chunk.getCoord().z;
+            entry.cellCount = static_cast<uint32_t>(std::count_if(cells.begin(), cells.end(),
+                [](VoxelChunk::Cell cell) { return cell != VoxelPalette::EMPTY; }));
+            entry.contentHash = VoxelChunk::hashCells(cells.data());
+            entry.encoding = static_cast<uint8_t>(ChunkCodec::encodeBest(cells.data(), payloads[i]));
+            entry.size = static_cast<uint32_t>(payloads[i].size());
+            entry.checksum = FileUtils::crc32(payloads[i].data(), payloads[i].size());
+        });
+
+        for (size_t i = 0; i < count; i++) {
+            DirectoryEntry& entry = directory[first + i];
+            entry.offset = offset;
+            offset += entry.size;
+            header.voxelCount += entry.cellCount;
+            ok = ok && file.write(reinterpret_cast<const char*>(payloads[i].data()), entry.size);
+        }
+    }
+
+    header.chunkCount = static_cast<uint32_t>(directory.size());
+    header.directoryOffset = offset;
+    header.directoryChecksum = FileUtils::crc32(directory.data(), directory.size() * sizeof(DirectoryEntry));
+    header.headerChecksum = FileUtils::crc32(&header, HEADER_CHECKSUM_BYTES);
+
+    ok = ok && file.write(reinterpret_cast<const char*>(directory.data()),
+                          static_cast<std::streamsize>(directory.size() * sizeof(DirectoryEntry)));
+    ok = ok && file.seekp(0) && file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    if (!ok || !file) {
+        std::cerr << "Erro ao gravar arquivo: " << temporary << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    if (!FileUtils::replaceFile(temporary, path)) {
+        return false;
+    }
+
+    stats.chunks = directory.size();
+    stats.fileBytes = offset + directory.size() * sizeof(DirectoryEntry);
+    stats.rawBytes = static_cast<uint64_t>(directory.size()) * VoxelChunk::VOLUME * sizeof(VoxelChunk::Cell);
+    stats.elapsedMs = elapsedMs(start);
+    return true;
+}
+
+bool VoxelFile::load(const std::string& path, VoxelGrid& grid) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Stats();
+
+    auto source = std::make_shared<FileChunkSource>();
+    MappedFile& file = source->getFile();
+    if (!file.open(path)) {
+        return false;
+    }
+
+    FileHeader header;
+    if (!file.contains(0, sizeof(header))) {
+        std::cerr << "Arquivo de projeto inválido: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (header.magic != FILE_MAGIC || header.headerChecksum != FileUtils::crc32(&header, HEADER_CHECKSUM_BYTES)) {
+        std::cerr << "Arquivo de projeto inválido: " << path << std::endl;
+        return false;
+    }
+    if (header.version == 0 || header.version > FILE_VERSION) {
+        std::cerr << "Versão de arquivo não suportada (" << header.version << "): " << path << std::endl;
+        return false;
+    }
+
+    const size_t entryBytes = header.version >= 3 ? sizeof(DirectoryEntry) : LEGACY_ENTRY_BYTES;
+    uint64_t directoryBytes = static_cast<uint64_t>(header.chunkCount) * entryBytes;
+    if (!file.contains(header.paletteOffset, header.paletteSize) ||
+        !file.contains(header.directoryOffset, directoryBytes) ||
+        FileUtils::crc32(file.getData() + header.paletteOffset, header.paletteSize) != header.paletteChecksum ||
+        FileUtils::crc32(file.getData() + header.directoryOffset, directoryBytes) != header.directoryChecksum) {
+        std::cerr << "Paleta ou diretório corrompidos: " << path << std::endl;
+        return false;
+    }
+
+    VoxelPalette palette;
+    std::vector<VoxelPalette::Index> remap;
+    if (!decodePalette(file.getData() + header.paletteOffset, header.paletteSize,
+                       header.paletteCount, palette, remap)) {
+        std::cerr << "Paleta inválida: " << path << std::endl;
+        return false;
+    }
+    source->setRemap(remap);
+
+    std::vector<DirectoryEntry>& directory = source->getDirectory();
+    directory.resize(header.chunkCount);
+    if (entryBytes == sizeof(DirectoryEntry)) {
+        std::memcpy(directory.data(), file.getData() + header.directoryOffset, directoryBytes);
+    } else {
+        for (size_t i = 0; i < directory.size(); i++) {
+            directory[i] = DirectoryEntry();
+            std::memcpy(&directory[i], file.getData() + header.directoryOffset + i * entryBytes, entryBytes);
+        }
+    }
+
+    // O hash gravado vale para os índices do arquivo: se a paleta foi remapeada, ou o
+    // arquivo é anterior à versão 3, o chunk o calcula quando for pedido
+    const bool knownHashes = header.version >= 3 && source->isIdentity();
+
+    grid.setDimensions(VoxelGrid::Dimensions(header.dimensions[0], header.dimensions[1], header.dimensions[2]));
+    grid.setOrigin(glm::ivec3(header.origin[0], header.origin[1], header.origin[2]));
+    grid.setPalette(palette);
+
+    for (size_t i = 0; i < directory.size(); i++) {
+        const DirectoryEntry& entry = directory[i];
+        glm::ivec3 coord(entry.coord[0], entry.coord[1], entry.coord[2]);
+        int cellCount = static_cast<int>(std::min<uint32_t>(entry.cellCount, VoxelChunk::VOLUME));
+        if (knownHashes) {
+            grid.insertChunk(std::make_unique<VoxelChunk>(coord, source, i, cellCount, entry.contentHash));
+        } else {
+            grid.insertChunk(std::make_unique<VoxelChunk>(coord, source, i, cellCount));
+        }
+    }
+
+    stats.chunks = directory.size();
+    stats.fileBytes = file.getSize();
+    stats.rawBytes = static_cast<uint64_t>(directory.size()) * VoxelChunk::VOLUME * sizeof(VoxelChunk::Cell);
+    stats.elapsedMs = elapsedMs(start);
+    return true;
+}
+
+bool VoxelFile::verify(const std::string& path) {
+    VoxelGrid grid;
+    if (!load(path, grid)) {
+        return false;
+    }
+    Stats loaded = stats;
+
+    std::vector<const VoxelChunk*> chunks;
+    for (const auto& pair : grid.getChunks()) {
+        chunks.push_back(pair.second.get());
+    }
+
+    std::vector<uint8_t> corrupt(chunks.size(), 0);
+    ThreadPool::getInstance().parallelFor(chunks.size(), [&](size_t i) {
+        std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME);
+        // O hash do diretório também precisa descrever as células decodificadas
+        bool valid = chunks[i]->copyCells(cells.data()) &&
+                     VoxelChunk::hashCells(cells.data()) == chunks[i]->getContentHash();
+        corrupt[i] = valid ? 0 : 1;
+    });
+
+    stats = loaded;
+    stats.corruptChunks = static_cast<size_t>(std::count(corrupt.begin(), corrupt.end(), 1));
+    if (stats.corruptChunks > 0) {
+        std::cerr << stats.corruptChunks << " chunks corrompidos em " << path << std::endl;
+    }
+    return stats.corruptChunks == 0;
+}
+
+} // namespace VoxelMaker
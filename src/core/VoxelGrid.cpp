@@ -1,55 +1,91 @@
 #include "core/VoxelGrid.hpp"
+#include "utils/ThreadPool.hpp"
 #include <algorithm>
 
 namespace VoxelMaker {
 
-VoxelGrid::VoxelGrid() 
+namespace {
+
+int floorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+        quotient--;
+    }
+    return quotient;
+}
+
+} // namespace
+
+VoxelGrid::VoxelGrid()
     : dimensions()
-    , voxels()
-    , origin(0, 0, 0) {
+    , chunks()
+    , palette()
+    , origin(0, 0, 0)
+    , voxelCount(0)
+    , revision(0)
+    , hashTree()
+    , hashPending()
+    , lastHashPending(0, 0, 0)
+    , hashMutex() {
 }
 
 VoxelGrid::VoxelGrid(const Dimensions& dim)
     : dimensions(dim)
-    , voxels()
-    , origin(0, 0, 0) {
+    , chunks()
+    , palette()
+    , origin(0, 0, 0)
+    , voxelCount(0)
+    , revision(0)
+    , hashTree()
+    , hashPending()
+    , lastHashPending(0, 0, 0)
+    , hashMutex() {
 }
 
 VoxelGrid::VoxelGrid(const Dimensions& dim, const glm::ivec3& orig)
     : dimensions(dim)
-    , voxels()
-    , origin(orig) {
+    , chunks()
+    , palette()
+    , origin(orig)
+    , voxelCount(0)
+    , revision(0)
+    , hashTree()
+    , hashPending()
+    , lastHashPending(0, 0, 0)
+    , hashMutex() {
 }
 
 bool VoxelGrid::addVoxel(const Voxel& voxel) {
     if (!isWithinBounds(voxel.getPosition())) {
         return false;
     }
-    
-    auto voxelPtr = std::make_shared<Voxel>(voxel);
-    voxels[voxel.getPosition()] = voxelPtr;
+
+    VoxelPalette::Index cell = palette.findOrAdd(voxel);
+    if (cell == VoxelPalette::EMPTY) {
+        return false;  // Paleta cheia
+    }
+
+    writeCell(voxel.getPosition(), cell);
     return true;
 }
 
 bool VoxelGrid::removeVoxel(const glm::ivec3& position) {
-    auto it = voxels.find(position);
-    if (it != voxels.end()) {
-        voxels.erase(it);
-        return true;
-    }
-    return false;
+    return writeCell(position, VoxelPalette::EMPTY);
 }
 
 std::shared_ptr<Voxel> VoxelGrid::getVoxel(const glm::ivec3& position) const {
-    auto it = voxels.find(position);
-    if (it != voxels.end()) {
-        return it->second;
+    VoxelPalette::Index cell = getCell(position);
+    if (cell == VoxelPalette::EMPTY) {
+        return nullptr;
     }
-    return nullptr;
+
+    auto voxel = std::make_shared<Voxel>(palette.get(cell));
+    voxel->setPosition(position);
+    return voxel;
 }
 
 bool VoxelGrid::hasVoxel(const glm::ivec3& position) const {
-    return voxels.find(position) != voxels.end();
+    return getCell(position) != VoxelPalette::EMPTY;
 }
 
 bool VoxelGrid::isWithinBounds(const glm::ivec3& position) const {
@@ -59,57 +95,111 @@ bool VoxelGrid::isWithinBounds(const glm::ivec3& position) const {
 }
 
 void VoxelGrid::clear() {
-    voxels.clear();
+    chunks.clear();
+    palette.clear();
+    voxelCount = 0;
+    revision++;
+    hashTree.clear();
+    hashPending.clear();
 }
 
 std::vector<std::shared_ptr<Voxel>> VoxelGrid::getAllVoxels() const {
     std::vector<std::shared_ptr<Voxel>> result;
-    result.reserve(voxels.size());
-    
-    for (const auto& pair : voxels) {
-        if (pair.second->isActive()) {
-            result.push_back(pair.second);
+    result.reserve(voxelCount);
+
+    for (const auto& pair : chunks) {
+        const VoxelChunk& chunk = *pair.second;
+        glm::ivec3 base = chunk.getOrigin();
+        const VoxelChunk::Cell* cells = chunk.getCells();
+
+        for (int i = 0; i < VoxelChunk::VOLUME; i++) {
+            if (!palette.isSolid(cells[i])) continue;
+
+            glm::ivec3 local(i % VoxelChunk::SIZE,
+                             (i / VoxelChunk::SIZE) % VoxelChunk::SIZE,
+                             i / VoxelChunk::AREA);
+            auto voxel = std::make_shared<Voxel>(palette.get(cells[i]));
+            voxel->setPosition(base + local);
+            result.push_back(voxel);
         }
     }
-    
+
     return result;
 }
 
 std::vector<std::shared_ptr<Voxel>> VoxelGrid::getVoxelsInRegion(
-    const glm::ivec3& minPos, 
+    const glm::ivec3& minPos,
     const glm::ivec3& maxPos
 ) const {
     std::vector<std::shared_ptr<Voxel>> result;
-    
-    for (const auto& pair : voxels) {
-        const auto& pos = pair.first;
-        if (pos.x >= minPos.x && pos.x <= maxPos.x &&
-            pos.y >= minPos.y && pos.y <= maxPos.y &&
-            pos.z >= minPos.z && pos.z <= maxPos.z &&
-            pair.second->isActive()) {
-            result.push_back(pair.second);
+
+    glm::ivec3 minChunk = chunkCoordOf(minPos);
+    glm::ivec3 maxChunk = chunkCoordOf(maxPos);
+
+    for (const auto& pair : chunks) {
+        const glm::ivec3& coord = pair.first;
+        if (coord.x < minChunk.x || coord.x > maxChunk.x ||
+            coord.y < minChunk.y || coord.y > maxChunk.y ||
+            coord.z < minChunk.z || coord.z > maxChunk.z) {
+            continue;
+        }
+
+        const VoxelChunk& chunk = *pair.second;
+        glm::ivec3 base = chunk.getOrigin();
+        glm::ivec3 lo = glm::max(minPos - base, glm::ivec3(0));
+        glm::ivec3 hi = glm::min(maxPos - base, glm::ivec3(VoxelChunk::SIZE - 1));
+
+        for (int z = lo.z; z <= hi.z; z++) {
+            for (int y = lo.y; y <= hi.y; y++) {
+                for (int x = lo.x; x <= hi.x; x++) {
+                    VoxelChunk::Cell cell = chunk.get(glm::ivec3(x, y, z));
+                    if (!palette.isSolid(cell)) continue;
+
+                    auto voxel = std::make_shared<Voxel>(palette.get(cell));
+                    voxel->setPosition(base + glm::ivec3(x, y, z));
+                    result.push_back(voxel);
+                }
+            }
         }
     }
-    
+
     return result;
 }
 
 void VoxelGrid::resize(const Dimensions& newDimensions, bool preserveExisting) {
+    dimensions = newDimensions;
+
     if (!preserveExisting) {
         clear();
-    } else {
-        // Remove voxels que estão fora dos novos limites
-        auto it = voxels.begin();
-        while (it != voxels.end()) {
-            if (!isWithinBounds(it->first)) {
-                it = voxels.erase(it);
-            } else {
-                ++it;
+        return;
+    }
+
+    // Remove voxels que estão fora dos novos limites
+    std::vector<glm::ivec3> outside;
+    for (const auto& pair : chunks) {
+        const VoxelChunk& chunk = *pair.second;
+        glm::ivec3 base = chunk.getOrigin();
+        glm::ivec3 top = base + glm::ivec3(VoxelChunk::SIZE - 1);
+        if (isWithinBounds(base) && isWithinBounds(top)) {
+            continue;
+        }
+
+        const VoxelChunk::Cell* cells = chunk.getCells();
+        for (int i = 0; i < VoxelChunk::VOLUME; i++) {
+            if (cells[i] == VoxelPalette::EMPTY) continue;
+
+            glm::ivec3 position = base + glm::ivec3(i % VoxelChunk::SIZE,
+                                                    (i / VoxelChunk::SIZE) % VoxelChunk::SIZE,
+                                                    i / VoxelChunk::AREA);
+            if (!isWithinBounds(position)) {
+                outside.push_back(position);
             }
         }
     }
-    
-    dimensions = newDimensions;
+
+    for (const auto& position : outside) {
+        writeCell(position, VoxelPalette::EMPTY);
+    }
 }
 
 void VoxelGrid::applyTransform(const glm::mat4& transform) {
@@ -122,4 +212,226 @@ void VoxelGrid::applyTransform(const glm::mat4& transform) {
     // 4. Lidar com colisões e sobreposições
 }
 
-} // namespace VoxelMaker 
\ No newline at end of file
+void VoxelGrid::setPalette(const VoxelPalette& newPalette) {
+    chunks.clear();
+    palette = newPalette;
+    voxelCount = 0;
+    revision++;
+    hashTree.clear();
+    hashPending.clear();
+}
+
+void VoxelGrid::insertChunk(std::unique_ptr<VoxelChunk> chunk) {
+    if (!chunk) return;
+
+    glm::ivec3 coord = chunk->getCoord();
+    markHashPending(coord);
+    auto it = chunks.find(coord);
+    if (it != chunks.end()) {
+        voxelCount -= static_cast<size_t>(it->second->getCellCount());
+        chunks.erase(it);
+    }
+    if (chunk->isEmpty()) {
+        revision++;
+        return;
+    }
+
+    voxelCount += static_cast<size_t>(chunk->getCellCount());
+    chunk->setRevision(++revision);
+    chunks.emplace(coord, std::move(chunk));
+
+    // Vizinhos enxergam o novo conteúdo pela borda
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                auto neighbor = chunks.find(coord + glm::ivec3(dx, dy, dz));
+                if (neighbor != chunks.end()) {
+                    neighbor->second->setRevision(revision);
+                }
+            }
+        }
+    }
+}
+
+size_t VoxelGrid::releaseChunksOutside(const glm::ivec3& minPos, const glm::ivec3& maxPos) {
+    glm::ivec3 minChunk = chunkCoordOf(minPos);
+    glm::ivec3 maxChunk = chunkCoordOf(maxPos);
+
+    size_t released = 0;
+    for (auto& pair : chunks) {
+        const glm::ivec3& coord = pair.first;
+        if (coord.x >= minChunk.x && coord.x <= maxChunk.x &&
+            coord.y >= minChunk.y && coord.y <= maxChunk.y &&
+            coord.z >= minChunk.z && coord.z <= maxChunk.z) {
+            continue;
+        }
+        if (pair.second->release()) {
+            released++;
+        }
+    }
+    return released;
+}
+
+size_t VoxelGrid::compressChunksOutside(const glm::ivec3& minPos, const glm::ivec3& maxPos) {
+    glm::ivec3 minChunk = chunkCoordOf(minPos);
+    glm::ivec3 maxChunk = chunkCoordOf(maxPos);
+
+    std::vector<VoxelChunk*> cold;
+    for (auto& pair : chunks) {
+        const glm::ivec3& coord = pair.first;
+        if (coord.x >= minChunk.x && coord.x <= maxChunk.x &&
+            coord.y >= minChunk.y && coord.y <= maxChunk.y &&
+            coord.z >= minChunk.z && coord.z <= maxChunk.z) {
+            continue;
+        }
+        if (pair.second->isResident()) {
+            cold.push_back(pair.second.get());
+        }
+    }
+
+    // Cada chunk é comprimido de forma independente
+    std::vector<uint8_t> compressed(cold.size(), 0);
+    ThreadPool::getInstance().parallelFor(cold.size(), [&](size_t i) {
+        compressed[i] = cold[i]->compress() ? 1 : 0;
+    });
+    return static_cast<size_t>(std::count(compressed.begin(), compressed.end(), 1));
+}
+
+const ChunkHashTree& VoxelGrid::getHashTree() const {
+    std::lock_guard<std::mutex> lock(hashMutex);
+    if (hashPending.empty()) {
+        return hashTree;
+    }
+
+    std::vector<glm::ivec3> coords(hashPending.begin(), hashPending.end());
+    hashPending.clear();
+
+    // Chunks com hash já mantido por set() custam O(1); os novos percorrem as células
+    std::vector<uint64_t> hashes(coords.size(), 0);
+    std::vector<uint8_t> present(coords.size(), 0);
+    ThreadPool::getInstance().parallelFor(coords.size(), [&](size_t i) {
+        const VoxelChunk* chunk = getChunk(coords[i]);
+        if (chunk) {
+            hashes[i] = chunk->getContentHash();
+            present[i] = 1;
+        }
+    });
+
+    for (size_t i = 0; i < coords.size(); i++) {
+        if (present[i]) {
+            hashTree.set(coords[i], hashes[i]);
+        } else {
+            hashTree.remove(coords[i]);
+        }
+    }
+    return hashTree;
+}
+
+void VoxelGrid::markHashPending(const glm::ivec3& chunkCoord) {
+    if (hashPending.empty() || chunkCoord != lastHashPending) {
+        hashPending.insert(chunkCoord);
+        lastHashPending = chunkCoord;
+    }
+}
+
+size_t VoxelGrid::getChunkMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& pair : chunks) {
+        bytes += pair.second->getMemoryUsage();
+    }
+    return bytes;
+}
+
+size_t VoxelGrid::getResidentChunkCount() const {
+    size_t count = 0;
+    for (const auto& pair : chunks) {
+        if (pair.second->isResident()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+VoxelPalette::Index VoxelGrid::getCell(const glm::ivec3& position) const {
+    const VoxelChunk* chunk = getChunk(chunkCoordOf(position));
+    if (!chunk) {
+        return VoxelPalette::EMPTY;
+    }
+    return chunk->get(localCoordOf(position));
+}
+
+const VoxelChunk* VoxelGrid::getChunk(const glm::ivec3& chunkCoord) const {
+    auto it = chunks.find(chunkCoord);
+    if (it != chunks.end()) {
+        return it->second.get();
+    }
+    return nullptr;
+}
+
+glm::ivec3 VoxelGrid::chunkCoordOf(const glm::ivec3& position) {
+    return glm::ivec3(floorDiv(position.x, VoxelChunk::SIZE),
+                      floorDiv(position.y, VoxelChunk::SIZE),
+                      floorDiv(position.z, VoxelChunk::SIZE));
+}
+
+glm::ivec3 VoxelGrid::localCoordOf(const glm::ivec3& position) {
+    return position - chunkCoordOf(position) * VoxelChunk::SIZE;
+}
+
+bool VoxelGrid::writeCell(const glm::ivec3& position, VoxelPalette::Index cell) {
+    glm::ivec3 coord = chunkCoordOf(position);
+    auto it = chunks.find(coord);
+
+    if (it == chunks.end()) {
+        if (cell == VoxelPalette::EMPTY) {
+            return false;
+        }
+        it = chunks.emplace(coord, std::make_unique<VoxelChunk>(coord)).first;
+    }
+
+    VoxelChunk& chunk = *it->second;
+    VoxelPalette::Index previous = chunk.set(localCoordOf(position), cell);
+    if (previous == cell) {
+        return false;
+    }
+
+    if (previous == VoxelPalette::EMPTY) {
+        voxelCount++;
+    } else if (cell == VoxelPalette::EMPTY) {
+        voxelCount--;
+    }
+
+    if (chunk.isEmpty()) {
+        chunks.erase(it);
+    }
+
+    markHashPending(coord);
+    touch(position);
+    return true;
+}
+
+void VoxelGrid::touch(const glm::ivec3& position) {
+    revision++;
+
+    // Vizinhos que tocam a célula pela face, aresta ou canto também precisam ser
+    // reprocessados (culling de faces e oclusão ambiente dependem da borda)
+    glm::ivec3 coord = chunkCoordOf(position);
+    glm::ivec3 local = position - coord * VoxelChunk::SIZE;
+    glm::ivec3 lo(local.x == 0 ? -1 : 0, local.y == 0 ? -1 : 0, local.z == 0 ? -1 : 0);
+    glm::ivec3 hi(local.x == VoxelChunk::SIZE - 1 ? 1 : 0,
+                  local.y == VoxelChunk::SIZE - 1 ? 1 : 0,
+                  local.z == VoxelChunk::SIZE - 1 ? 1 : 0);
+
+    for (int dz = lo.z; dz <= hi.z; dz++) {
+        for (int dy = lo.y; dy <= hi.y; dy++) {
+            for (int dx = lo.x; dx <= hi.x; dx++) {
+                auto it = chunks.find(coord + glm::ivec3(dx, dy, dz));
+                if (it != chunks.end()) {
+                    it->second->setRevision(revision);
+                }
+            }
+        }
+    }
+}
+
+} // namespace VoxelMaker
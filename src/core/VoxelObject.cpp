@@ -2,6 +2,36 @@
 
 namespace VoxelMaker {
 
-// TODO: Implementar VoxelObject
+VoxelObject::VoxelObject()
+    : VoxelObject("objeto") {
+}
 
-} // namespace VoxelMaker 
\ No newline at end of file
+VoxelObject::VoxelObject(const std::string& objectName)
+    : name(objectName)
+    , minBound(0, 0, 0)
+    , maxBound(-1, -1, -1)
+    , transform(1.0f)
+    , sourceModel(-1)
+    , voxelCount(0)
+    , visible(true) {
+}
+
+void VoxelObject::include(const glm::ivec3& position) {
+    if (voxelCount == 0) {
+        minBound = position;
+        maxBound = position;
+    } else {
+        minBound = glm::min(minBound, position);
+        maxBound = glm::max(maxBound, position);
+    }
+    voxelCount++;
+}
+
+bool VoxelObject::contains(const glm::ivec3& position) const {
+    return voxelCount > 0 &&
+           position.x >= minBound.x && position.x <= maxBound.x &&
+           position.y >= minBound.y && position.y <= maxBound.y &&
+           position.z >= minBound.z && position.z <= maxBound.z;
+}
+
+} // namespace VoxelMaker
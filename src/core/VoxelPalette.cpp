@@ -0,0 +1,86 @@
+#include "core/VoxelPalette.hpp"
+#include <cstring>
+#include <functional>
+
+namespace VoxelMaker {
+
+namespace {
+
+size_t hashCombine(size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+size_t hashFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return std::hash<uint32_t>{}(bits);
+}
+
+} // namespace
+
+VoxelPalette::VoxelPalette()
+    : entries()
+    , solid()
+    , lookup() {
+    clear();
+}
+
+VoxelPalette::Index VoxelPalette::findOrAdd(const Voxel& voxel) {
+    size_t hash = hashAppearance(voxel);
+
+    auto& bucket = lookup[hash];
+    for (Index index : bucket) {
+        if (sameAppearance(entries[index], voxel)) {
+            return index;
+        }
+    }
+
+    if (entries.size() >= MAX_ENTRIES) {
+        return EMPTY;
+    }
+
+    Voxel prototype(voxel);
+    prototype.setPosition(glm::ivec3(0, 0, 0));
+
+    Index index = static_cast<Index>(entries.size());
+    entries.push_back(prototype);
+    solid.push_back(prototype.isActive() ? 1 : 0);
+    bucket.push_back(index);
+    return index;
+}
+
+void VoxelPalette::clear() {
+    entries.clear();
+    solid.clear();
+    lookup.clear();
+
+    // Índice 0 = vazio
+    Voxel empty;
+    empty.setActive(false);
+    entries.push_back(empty);
+    solid.push_back(0);
+}
+
+size_t VoxelPalette::hashAppearance(const Voxel& voxel) {
+    const auto& color = voxel.getColor();
+    const auto& material = voxel.getMaterial();
+
+    size_t seed = (static_cast<size_t>(color.r) << 24) |
+                  (static_cast<size_t>(color.g) << 16) |
+                  (static_cast<size_t>(color.b) << 8) |
+                  static_cast<size_t>(color.a);
+    seed = hashCombine(seed, std::hash<std::string>{}(material.name));
+    seed = hashCombine(seed, hashFloat(material.roughness));
+    seed = hashCombine(seed, hashFloat(material.metallic));
+    seed = hashCombine(seed, hashFloat(material.transparency));
+    seed = hashCombine(seed, voxel.isActive() ? 1 : 0);
+    return seed;
+}
+
+bool VoxelPalette::sameAppearance(const Voxel& a, const Voxel& b) {
+    Voxel moved(b);
+    moved.setPosition(a.getPosition());
+    return a == moved;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,133 @@
+#include "graphics/BufferAllocator.hpp"
+#include <iterator>
+
+namespace VoxelMaker {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+BufferAllocator::BufferAllocator(size_t capacity, size_t alignment)
+    : capacity(0)
+    , alignment(1)
+    , usedBytes(0)
+    , freeByOffset()
+    , freeBySize()
+    , allocations() {
+    reset(capacity, alignment);
+}
+
+void BufferAllocator::reset(size_t newCapacity, size_t newAlignment) {
+    alignment = newAlignment > 0 ? newAlignment : 1;
+    capacity = newCapacity / alignment * alignment;
+    usedBytes = 0;
+    freeByOffset.clear();
+    freeBySize.clear();
+    allocations.clear();
+
+    if (capacity > 0) {
+        insertFree(0, capacity);
+    }
+}
+
+size_t BufferAllocator::allocate(size_t size) {
+    if (size == 0) {
+        return INVALID_OFFSET;
+    }
+
+    size_t rounded = alignUp(size, alignment);
+    auto best = freeBySize.lower_bound(rounded);
+    if (best == freeBySize.end()) {
+        return INVALID_OFFSET;
+    }
+
+    size_t blockSize = best->first;
+    size_t offset = best->second;
+    eraseFree(freeByOffset.find(offset));
+
+    if (blockSize > rounded) {
+        insertFree(offset + rounded, blockSize - rounded);
+    }
+
+    allocations[offset] = rounded;
+    usedBytes += rounded;
+    return offset;
+}
+
+void BufferAllocator::free(size_t offset) {
+    auto it = allocations.find(offset);
+    if (it == allocations.end()) {
+        return;
+    }
+
+    size_t size = it->second;
+    allocations.erase(it);
+    usedBytes -= size;
+    insertFree(offset, size);
+}
+
+size_t BufferAllocator::getAllocationSize(size_t offset) const {
+    auto it = allocations.find(offset);
+    return it != allocations.end() ? it->second : 0;
+}
+
+void BufferAllocator::grow(size_t newCapacity) {
+    newCapacity = newCapacity / alignment * alignment;
+    if (newCapacity <= capacity) {
+        return;
+    }
+
+    size_t oldCapacity = capacity;
+    capacity = newCapacity;
+    insertFree(oldCapacity, newCapacity - oldCapacity);
+}
+
+BufferAllocator::Stats BufferAllocator::getStats() const {
+    Stats stats;
+    stats.capacity = capacity;
+    stats.usedBytes = usedBytes;
+    stats.allocationCount = allocations.size();
+    stats.freeBlockCount = freeByOffset.size();
+    stats.largestFreeBlock = freeBySize.empty() ? 0 : freeBySize.rbegin()->first;
+    return stats;
+}
+
+void BufferAllocator::insertFree(size_t offset, size_t size) {
+    // Fundir com o bloco seguinte
+    auto next = freeByOffset.find(offset + size);
+    if (next != freeByOffset.end()) {
+        size += next->second;
+        eraseFree(next);
+    }
+
+    // Fundir com o bloco anterior
+    auto after = freeByOffset.lower_bound(offset);
+    if (after != freeByOffset.begin()) {
+        auto previous = std::prev(after);
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            eraseFree(previous);
+        }
+    }
+
+    freeByOffset[offset] = size;
+    freeBySize.emplace(size, offset);
+}
+
+void BufferAllocator::eraseFree(std::map<size_t, size_t>::iterator it) {
+    auto range = freeBySize.equal_range(it->second);
+    for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt) {
+        if (sizeIt->second == it->first) {
+            freeBySize.erase(sizeIt);
+            break;
+        }
+    }
+    freeByOffset.erase(it);
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,415 @@
+#include "graphics/ChunkMeshManager.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace VoxelMaker {
+
+namespace {
+
+uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t combine(uint64_t seed, uint64_t value) {
+    return mix(seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)));
+}
+
+uint64_t packCoord(const glm::ivec3& coord) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) ^
+           static_cast<uint64_t>(static_cast<uint32_t>(coord.y)) << 21 ^
+           static_cast<uint64_t>(static_cast<uint32_t>(coord.z)) << 42;
+}
+
+} // namespace
+
+ChunkMeshManager::ChunkMeshManager()
+    : mesher()
+    , smoothMesher()
+    , borderCache()
+    , meshingMode(MeshingMode::BLOCKY)
+    , lodSettings()
+    , optimizeMeshes(false)
+    , maxChunksPerUpdate(0)
+    , meshes()
+    , sourceGrid(nullptr)
+    , sourceRevision(NOT_MESHED)
+    , meshVersion(0)
+    , meshCache()
+    , paletteHashes()
+    , stats() {
+}
+
+size_t ChunkMeshManager::update(const VoxelGrid& grid) {
+    return updateMeshes(grid, nullptr);
+}
+
+size_t ChunkMeshManager::update(const VoxelGrid& grid, const Camera& camera) {
+    glm::vec3 viewer = camera.getPosition();
+    return updateMeshes(grid, &viewer);
+}
+
+size_t ChunkMeshManager::updateMeshes(const VoxelGrid& grid, const glm::vec3* viewer) {
+    auto start = std::chrono::steady_clock::now();
+
+    stats.chunksMeshed = 0;
+    stats.chunksLoaded = 0;
+    stats.chunksRemoved = 0;
+
+    if (sourceGrid != &grid) {
+        meshes.clear();
+        sourceGrid = &grid;
+        sourceRevision = NOT_MESHED;
+    }
+
+    bool useLod = viewer && lodSettings.enabled && meshingMode == MeshingMode::BLOCKY;
+    bool lodInUse = stats.chunksPerLevel[0] != stats.meshCount;
+    if (grid.getRevision() == sourceRevision && !useLod && !lodInUse && stats.chunksDeferred == 0) {
+        stats.lastUpdateMs = 0.0;
+        return 0;
+    }
+
+    // Descartar malhas de chunks que não existem mais
+    if (grid.getRevision() != sourceRevision) {
+        for (auto it = meshes.begin(); it != meshes.end();) {
+            if (!grid.getChunk(it->first)) {
+                it = meshes.erase(it);
+                stats.chunksRemoved++;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Associar chunks às entradas (a inserção no mapa não é thread-safe)
+    std::vector<std::pair<const VoxelChunk*, ChunkMesh*>> entries;
+    entries.reserve(grid.getChunks().size());
+    for (const auto& pair : grid.getChunks()) {
+        entries.emplace_back(pair.second.get(), &meshes[pair.first]);
+    }
+
+    std::vector<int> levels(entries.size(), 0);
+    stats.lodBias = 1.0f;
+    if (useLod) {
+        selectLevels(entries, *viewer, levels);
+    }
+
+    // Chunks novos, alterados ou que mudaram de nível
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const ChunkMesh& entry = *entries[i].second;
+        if (entry.revision != entries[i].first->getRevision() || entry.lod != levels[i]) {
+            pending.push_back(i);
+        }
+    }
+
+    // Malhas lidas do cache não contam no limite por atualização
+    std::vector<size_t> loaded;
+    if (meshCache.isOpen() && !pending.empty()) {
+        loaded = loadCachedMeshes(grid, entries, levels, pending);
+    }
+
+    // Acima do limite, os chunks mais próximos da câmera são refeitos primeiro
+    stats.chunksDeferred = 0;
+    if (maxChunksPerUpdate > 0 && pending.size() > maxChunksPerUpdate) {
+        glm::vec3 center = viewer ? *viewer - glm::vec3(grid.getOrigin()) : glm::vec3(0.0f);
+        std::vector<float> distances(entries.size(), 0.0f);
+        for (size_t index : pending) {
+            glm::vec3 chunkCenter = glm::vec3(entries[index].first->getOrigin()) + glm::vec3(VoxelChunk::SIZE * 0.5f);
+            glm::vec3 offset = chunkCenter - center;
+            distances[index] = glm::dot(offset, offset);
+        }
+        std::partial_sort(pending.begin(), pending.begin() + maxChunksPerUpdate, pending.end(),
+                          [&distances](size_t a, size_t b) { return distances[a] < distances[b]; });
+        stats.chunksDeferred = pending.size() - maxChunksPerUpdate;
+        pending.resize(maxChunksPerUpdate);
+    }
+
+    // Superfícies suaves extrapolam o chunk em meia célula
+    float margin = meshingMode == MeshingMode::SMOOTH ? 1.0f : 0.0f;
+    glm::vec3 gridOrigin(grid.getOrigin());
+    borderCache.clear();
+    std::vector<Mesh::OptimizeStats> optimizeStats(optimizeMeshes ? pending.size() : 0);
+    uint32_t paletteCount = static_cast<uint32_t>(grid.getPalette().size());
+
+    ThreadPool::getInstance().parallelFor(pending.size(), [&](size_t i) {
+        size_t index = pending[i];
+        const VoxelChunk& chunk = *entries[index].first;
+        ChunkMesh& entry = *entries[index].second;
+
+        // A malha anterior ainda pode estar sendo lida pela thread de renderização:
+        // nesse caso a nova é gerada em outra instância em vez de sobrescrevê-la
+        if (entry.mesh.use_count() > 1) {
+            entry.mesh = std::make_shared<Mesh>();
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+
+        if (meshingMode == MeshingMode::SMOOTH) {
+            smoothMesher.meshChunk(grid, chunk.getCoord(), *entry.mesh, &borderCache);
+        } else {
+            mesher.meshChunkLod(grid, chunk.getCoord(), levels[index], *entry.mesh);
+        }
+
+        if (optimizeMeshes) {
+            optimizeStats[i] = entry.mesh->optimize();
+        }
+
+        entry.revision = chunk.getRevision();
+        entry.lod = levels[index];
+        entry.paletteCount = paletteCount;
+        entry.cached = false;
+        entry.boundsMin = gridOrigin + glm::vec3(chunk.getOrigin()) - glm::vec3(margin);
+        entry.boundsMax = gridOrigin + glm::vec3(chunk.getOrigin() + glm::ivec3(VoxelChunk::SIZE)) + glm::vec3(margin);
+    });
+
+    borderCache.clear();
+    stats.chunksMeshed = pending.size();
+    stats.chunksLoaded = loaded.size();
+    for (size_t index : pending) {
+        entries[index].second->version = ++meshVersion;
+    }
+    for (size_t index : loaded) {
+        entries[index].second->version = ++meshVersion;
+    }
+
+    // Média ponderada pelo número de triângulos
+    double weightedBefore = 0.0, weightedAfter = 0.0, triangles = 0.0;
+    for (size_t i = 0; i < optimizeStats.size(); i++) {
+        double count = static_cast<double>(entries[pending[i]].second->mesh->getTriangleCount());
+        weightedBefore += optimizeStats[i].acmrBefore * count;
+        weightedAfter += optimizeStats[i].acmrAfter * count;
+        triangles += count;
+    }
+    stats.acmrBefore = triangles > 0.0 ? static_cast<float>(weightedBefore / triangles) : 0.0f;
+    stats.acmrAfter = triangles > 0.0 ? static_cast<float>(weightedAfter / triangles) : 0.0f;
+
+    sourceRevision = grid.getRevision();
+
+    stats.meshCount = meshes.size();
+    stats.triangleCount = 0;
+    for (auto& count : stats.chunksPerLevel) {
+        count = 0;
+    }
+    for (const auto& pair : meshes) {
+        stats.triangleCount += pair.second.mesh->getTriangleCount();
+        stats.chunksPerLevel[pair.second.lod]++;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    stats.lastUpdateMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return stats.chunksMeshed + stats.chunksLoaded;
+}
+
+std::vector<size_t> ChunkMeshManager::loadCachedMeshes(const VoxelGrid& grid,
+                                                       const std::vector<std::pair<const VoxelChunk*, ChunkMesh*>>& entries,
+                                                       const std::vector<int>& levels,
+                                                       std::vector<size_t>& pending) {
+    // Atualiza os hashes dos chunks editados desde a última consulta (em paralelo)
+    const ChunkHashTree& tree = grid.getHashTree();
+    MeshCache::hashPalette(grid.getPalette(), paletteHashes);
+    float margin = meshingMode == MeshingMode::SMOOTH ? 1.0f : 0.0f;
+    glm::vec3 gridOrigin(grid.getOrigin());
+
+    std::vector<uint8_t> hits(pending.size(), 0);
+    ThreadPool::getInstance().parallelFor(pending.size(), [&](size_t i) {
+        size_t index = pending[i];
+        const VoxelChunk& chunk = *entries[index].first;
+        ChunkMesh& entry = *entries[index].second;
+
+        // Lida à parte: uma falta mantém a malha anterior até o chunk ser refeito
+        thread_local Mesh mesh;
+        uint64_t key = cacheKey(tree, grid.getOrigin(), chunk.getCoord(), levels[index]);
+        if (!meshCache.load(key, paletteHashes, mesh)) {
+            return;
+        }
+        if (entry.mesh.use_count() > 1) {
+            entry.mesh = std::make_shared<Mesh>();
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        std::swap(*entry.mesh, mesh);
+
+        entry.revision = chunk.getRevision();
+        entry.lod = levels[index];
+        entry.paletteCount = static_cast<uint32_t>(paletteHashes.size() - 1);
+        entry.cached = true;
+        entry.boundsMin = gridOrigin + glm::vec3(chunk.getOrigin()) - glm::vec3(margin);
+        entry.boundsMax = gridOrigin + glm::vec3(chunk.getOrigin() + glm::ivec3(VoxelChunk::SIZE)) + glm::vec3(margin);
+        hits[i] = 1;
+    });
+
+    std::vector<size_t> loaded;
+    size_t remaining = 0;
+    for (size_t i = 0; i < pending.size(); i++) {
+        if (hits[i]) {
+            loaded.push_back(pending[i]);
+        } else {
+            pending[remaining++] = pending[i];
+        }
+    }
+    pending.resize(remaining);
+    return loaded;
+}
+
+size_t ChunkMeshManager::storeMeshes() {
+    if (!meshCache.isOpen() || !sourceGrid) {
+        return 0;
+    }
+
+    // O lote cabe em 3/4 do limite; o espaço é aberto de uma vez antes de gravar
+    const VoxelGrid& grid = *sourceGrid;
+    std::vector<ChunkMeshMap::value_type*> batch;
+    uint64_t batchBytes = 0;
+    uint64_t maxBatchBytes = meshCache.getMaxBytes() - meshCache.getMaxBytes() / 4;
+    for (auto& pair : meshes) {
+        ChunkMesh& entry = pair.second;
+        const VoxelChunk* chunk = grid.getChunk(pair.first);
+        if (entry.cached || !chunk || entry.revision != chunk->getRevision()) {
+            continue;
+        }
+        uint64_t bytes = MeshCache::recordBytes(*entry.mesh);
+        if (batchBytes + bytes <= maxBatchBytes) {
+            batch.push_back(&pair);
+            batchBytes += bytes;
+        }
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+    meshCache.reserve(batchBytes);
+
+    // A paleta só cresce: as entradas usadas por cada malha continuam com o mesmo hash
+    const ChunkHashTree& tree = grid.getHashTree();
+    MeshCache::hashPalette(grid.getPalette(), paletteHashes);
+    size_t stored = 0;
+    for (ChunkMeshMap::value_type* pair : batch) {
+        ChunkMesh& entry = pair->second;
+        uint64_t key = cacheKey(tree, grid.getOrigin(), pair->first, entry.lod);
+        if (meshCache.store(key, entry.paletteCount, paletteHashes, *entry.mesh)) {
+            entry.cached = true;
+            stored++;
+        }
+    }
+    return stored;
+}
+
+uint64_t ChunkMeshManager::cacheKey(const ChunkHashTree& tree, const glm::ivec3& gridOrigin,
+                                    const glm::ivec3& chunkCoord, int level) const {
+    const ChunkMesher::Settings& settings = mesher.getSettings();
+    uint32_t strength;
+    std::memcpy(&strength, &settings.aoStrength, sizeof(strength));
+    uint64_t key = combine(MeshCache::CACHE_VERSION, static_cast<uint64_t>(meshingMode) |
+                           static_cast<uint64_t>(settings.ambientOcclusion ? 1 : 0) << 8 |
+                           static_cast<uint64_t>(optimizeMeshes ? 1 : 0) << 16 |
+                           static_cast<uint64_t>(level) << 24 | static_cast<uint64_t>(strength) << 32);
+    key = combine(key, packCoord(gridOrigin));
+    key = combine(key, packCoord(chunkCoord));
+
+    // O culling e a oclusão leem uma célula de borda de cada vizinho
+    for (int z = -1; z <= 1; z++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int x = -1; x <= 1; x++) {
+                uint64_t hash = 0;
+                tree.findLeaf(chunkCoord + glm::ivec3(x, y, z), hash);
+                key = combine(key, hash);
+            }
+        }
+    }
+    return key;
+}
+
+int ChunkMeshManager::levelForDistance(float distance) const {
+    if (distance < lodSettings.baseDistance || lodSettings.baseDistance <= 0.0f) {
+        return 0;
+    }
+
+    int level = 1 + static_cast<int>(std::floor(std::log2(distance / lodSettings.baseDistance)));
+    return std::min(level, std::min(lodSettings.maxLevel, ChunkMesher::MAX_LOD_LEVEL));
+}
+
+void ChunkMeshManager::selectLevels(const std::vector<std::pair<const VoxelChunk*, ChunkMesh*>>& entries,
+                                    const glm::vec3& viewer,
+                                    std::vector<int>& levels) {
+    // Distância até a caixa do chunk (0 se a câmera estiver dentro)
+    std::vector<float> distances(entries.size());
+    glm::vec3 gridOrigin = sourceGrid ? glm::vec3(sourceGrid->getOrigin()) : glm::vec3(0.0f);
+    for (size_t i = 0; i < entries.size(); i++) {
+        glm::vec3 boxMin = gridOrigin + glm::vec3(entries[i].first->getOrigin());
+        glm::vec3 boxMax = boxMin + glm::vec3(static_cast<float>(VoxelChunk::SIZE));
+        glm::vec3 closest = glm::clamp(viewer, boxMin, boxMax);
+        distances[i] = glm::length(viewer - closest);
+    }
+
+    // Estimativa de triângulos por nível: cada nível divide por 4 a área de faces
+    auto estimate = [](const ChunkMesh& entry, int level) {
+        if (entry.revision == NOT_MESHED) {
+            double cells = static_cast<double>(VoxelChunk::SIZE >> level);
+            return 4.0 * cells * cells;
+        }
+        return static_cast<double>(entry.mesh->getTriangleCount()) * std::pow(4.0, entry.lod - level);
+    };
+
+    const int MAX_ITERATIONS = 16;
+    float bias = 1.0f;
+    for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+        double total = 0.0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            levels[i] = levelForDistance(distances[i] * bias);
+            total += estimate(*entries[i].second, levels[i]);
+        }
+
+        if (lodSettings.triangleBudget == 0 || total <= static_cast<double>(lodSettings.triangleBudget)) {
+            break;
+        }
+        bias *= 1.25f;
+    }
+
+    stats.lodBias = bias;
+}
+
+const Mesh* ChunkMeshManager::getMesh(const glm::ivec3& chunkCoord) const {
+    auto it = meshes.find(chunkCoord);
+    if (it != meshes.end()) {
+        return it->second.mesh.get();
+    }
+    return nullptr;
+}
+
+void ChunkMeshManager::setMesherSettings(const ChunkMesher::Settings& settings) {
+    mesher.setSettings(settings);
+    invalidate();
+}
+
+void ChunkMeshManager::setMeshingMode(MeshingMode mode) {
+    if (mode != meshingMode) {
+        meshingMode = mode;
+        invalidate();
+    }
+}
+
+void ChunkMeshManager::invalidate() {
+    for (auto& pair : meshes) {
+        pair.second.revision = NOT_MESHED;
+    }
+    sourceRevision = NOT_MESHED;
+}
+
+void ChunkMeshManager::clear() {
+    meshes.clear();
+    sourceGrid = nullptr;
+    sourceRevision = NOT_MESHED;
+    stats = Stats();
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,328 @@
+#include "graphics/ChunkMesher.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace VoxelMaker {
+
+namespace {
+
+/**
+ * @brief Descrição de uma face do cubo: eixo da normal, sentido e eixos tangentes
+ *
+ * Os eixos u e v satisfazem cross(u, v) = normal, então os cantos (0,0), (1,0), (1,1),
+ * (0,1) ficam em sentido anti-horário quando vistos de fora.
+ */
+struct FaceInfo {
+    int axis;
+    int sign;
+    int u;
+    int v;
+};
+
+const FaceInfo FACES[6] = {
+    {0, +1, 1, 2},
+    {0, -1, 2, 1},
+    {1, +1, 2, 0},
+    {1, -1, 0, 2},
+    {2, +1, 0, 1},
+    {2, -1, 1, 0},
+};
+
+const int CORNERS[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+/**
+ * @brief Nível de oclusão de um canto indexado por (lado1 | lado2 << 1 | canto << 2)
+ *
+ * Dois lados ocupados ocluem totalmente o canto, independentemente da diagonal.
+ */
+const int AO_LEVELS[8] = {3, 2, 2, 0, 2, 1, 1, 0};
+
+/**
+ * @brief Faixa de cópia de um vizinho ao longo de um eixo
+ * @param offset Posição do vizinho (-1, 0, 1)
+ * @param size Células por eixo no interior
+ * @param src Primeira célula de origem no vizinho
+ * @param dst Primeira célula de destino na vizinhança
+ * @param count Número de células
+ */
+void neighbourRange(int offset, int size, int& src, int& dst, int& count) {
+    if (offset < 0) {
+        src = size - 1;
+        dst = 0;
+        count = 1;
+    } else if (offset > 0) {
+        src = 0;
+        dst = size + 1;
+        count = 1;
+    } else {
+        src = 0;
+        dst = 1;
+        count = size;
+    }
+}
+
+/**
+ * @brief Reduz um bloco de voxels a uma célula
+ * @param chunk Chunk de origem
+ * @param palette Paleta do grid
+ * @param base Primeiro voxel do bloco (coordenada local)
+ * @param factor Lado do bloco em voxels
+ * @param full Saída: true se todos os voxels do bloco são sólidos
+ * @return Índice de paleta mais frequente entre os voxels sólidos (EMPTY se nenhum)
+ */
+VoxelChunk::Cell reduceBlock(const VoxelChunk& chunk,
+                             const VoxelPalette& palette,
+                             const glm::ivec3& base,
+                             int factor,
+                             bool& full) {
+    const int MAX_CANDIDATES = 8;
+    VoxelChunk::Cell candidates[MAX_CANDIDATES];
+    int counts[MAX_CANDIDATES];
+    int candidateCount = 0;
+    int solidCount = 0;
+
+    const VoxelChunk::Cell* cells = chunk.getCells();
+    for (int z = 0; z < factor; z++) {
+        for (int y = 0; y < factor; y++) {
+            const VoxelChunk::Cell* row = cells + VoxelChunk::index(base.x, base.y + y, base.z + z);
+            for (int x = 0; x < factor; x++) {
+                VoxelChunk::Cell cell = row[x];
+                if (!palette.isSolid(cell)) continue;
+                solidCount++;
+
+                int slot = 0;
+                while (slot < candidateCount && candidates[slot] != cell) {
+                    slot++;
+                }
+                if (slot < candidateCount) {
+                    counts[slot]++;
+                } else if (candidateCount < MAX_CANDIDATES) {
+                    candidates[candidateCount] = cell;
+                    counts[candidateCount] = 1;
+                    candidateCount++;
+                }
+            }
+        }
+    }
+
+    full = solidCount == factor * factor * factor;
+    if (candidateCount == 0) {
+        return VoxelPalette::EMPTY;
+    }
+
+    int best = 0;
+    for (int i = 1; i < candidateCount; i++) {
+        if (counts[i] > counts[best]) {
+            best = i;
+        }
+    }
+    return candidates[best];
+}
+
+} // namespace
+
+ChunkMesher::ChunkMesher()
+    : settings() {
+}
+
+ChunkMesher::ChunkMesher(const Settings& settings)
+    : settings(settings) {
+}
+
+void ChunkMesher::meshChunk(const VoxelGrid& grid, const glm::ivec3& chunkCoord, Mesh& out) const {
+    std::vector<VoxelChunk::Cell> padded;
+    gatherNeighbourhood(grid, chunkCoord, padded);
+
+    glm::vec3 offset = glm::vec3(grid.getOrigin() + chunkCoord * VoxelChunk::SIZE);
+    meshNeighbourhood(padded, grid.getPalette(), offset, out);
+}
+
+void ChunkMesher::meshChunkLod(const VoxelGrid& grid, const glm::ivec3& chunkCoord, int level, Mesh& out) const {
+    level = std::max(0, std::min(level, MAX_LOD_LEVEL));
+    if (level == 0) {
+        meshChunk(grid, chunkCoord, out);
+        return;
+    }
+
+    std::vector<VoxelChunk::Cell> padded;
+    std::vector<uint8_t> full;
+    gatherDownsampled(grid, chunkCoord, level, padded, full);
+
+    glm::vec3 offset = glm::vec3(grid.getOrigin() + chunkCoord * VoxelChunk::SIZE);
+    meshCells(padded.data(), full.data(), VoxelChunk::SIZE >> level,
+              static_cast<float>(1 << level), grid.getPalette(), offset, out);
+}
+
+void ChunkMesher::gatherNeighbourhood(const VoxelGrid& grid,
+                                      const glm::ivec3& chunkCoord,
+                                      std::vector<VoxelChunk::Cell>& padded) {
+    padded.assign(PADDED_VOLUME, VoxelPalette::EMPTY);
+
+    for (int nz = -1; nz <= 1; nz++) {
+        for (int ny = -1; ny <= 1; ny++) {
+            for (int nx = -1; nx <= 1; nx++) {
+                const VoxelChunk* chunk = grid.getChunk(chunkCoord + glm::ivec3(nx, ny, nz));
+                if (!chunk) continue;
+
+                int sx, dx, cx, sy, dy, cy, sz, dz, cz;
+                neighbourRange(nx, VoxelChunk::SIZE, sx, dx, cx);
+                neighbourRange(ny, VoxelChunk::SIZE, sy, dy, cy);
+                neighbourRange(nz, VoxelChunk::SIZE, sz, dz, cz);
+
+                const VoxelChunk::Cell* cells = chunk->getCells();
+                for (int z = 0; z < cz; z++) {
+                    for (int y = 0; y < cy; y++) {
+                        const VoxelChunk::Cell* src = cells + VoxelChunk::index(sx, sy + y, sz + z);
+                        VoxelChunk::Cell* dst = padded.data() + dx + PADDED_SIZE * ((dy + y) + PADDED_SIZE * (dz + z));
+                        std::memcpy(dst, src, cx * sizeof(VoxelChunk::Cell));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::gatherDownsampled(const VoxelGrid& grid,
+                                    const glm::ivec3& chunkCoord,
+                                    int level,
+                                    std::vector<VoxelChunk::Cell>& padded,
+                                    std::vector<uint8_t>& full) {
+    const int factor = 1 << level;
+    const int size = VoxelChunk::SIZE >> level;
+    const int paddedSize = size + 2;
+    const VoxelPalette& palette = grid.getPalette();
+
+    padded.assign(paddedSize * paddedSize * paddedSize, VoxelPalette::EMPTY);
+    full.assign(padded.size(), 0);
+
+    for (int nz = -1; nz <= 1; nz++) {
+        for (int ny = -1; ny <= 1; ny++) {
+            for (int nx = -1; nx <= 1; nx++) {
+                const VoxelChunk* chunk = grid.getChunk(chunkCoord + glm::ivec3(nx, ny, nz));
+                if (!chunk) continue;
+
+                // Blocos de borda caem inteiros dentro de um único vizinho
+                int sx, dx, cx, sy, dy, cy, sz, dz, cz;
+                neighbourRange(nx, size, sx, dx, cx);
+                neighbourRange(ny, size, sy, dy, cy);
+                neighbourRange(nz, size, sz, dz, cz);
+
+                for (int z = 0; z < cz; z++) {
+                    for (int y = 0; y < cy; y++) {
+                        for (int x = 0; x < cx; x++) {
+                            glm::ivec3 base = glm::ivec3(sx + x, sy + y, sz + z) * factor;
+                            bool isFull = false;
+                            int dst = (dx + x) + paddedSize * ((dy + y) + paddedSize * (dz + z));
+                            padded[dst] = reduceBlock(*chunk, palette, base, factor, isFull);
+                            full[dst] = isFull ? 1 : 0;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::meshNeighbourhood(const std::vector<VoxelChunk::Cell>& padded,
+                                    const VoxelPalette& palette,
+                                    const glm::vec3& offset,
+                                    Mesh& out) const {
+    meshCells(padded.data(), nullptr, VoxelChunk::SIZE, 1.0f, palette, offset, out);
+}
+
+void ChunkMesher::meshCells(const VoxelChunk::Cell* padded,
+                            const uint8_t* full,
+                            int size,
+                            float scale,
+                            const VoxelPalette& palette,
+                            const glm::vec3& offset,
+                            Mesh& out) const {
+    out.clear();
+
+    const int paddedSize = size + 2;
+    const int paddedVolume = paddedSize * paddedSize * paddedSize;
+    const int strides[3] = {1, paddedSize, paddedSize * paddedSize};
+
+    // Ocupação em bytes: o laço interno consulta vizinhos muitas vezes
+    std::vector<uint8_t> solid(paddedVolume);
+    for (int i = 0; i < paddedVolume; i++) {
+        solid[i] = palette.isSolid(padded[i]) ? 1 : 0;
+    }
+
+    // Tabela de intensidade por nível de oclusão (0 = três vizinhos, 3 = nenhum)
+    float aoCurve[4];
+    for (int level = 0; level < 4; level++) {
+        float occlusion = settings.ambientOcclusion ? (3 - level) / 3.0f : 0.0f;
+        aoCurve[level] = 1.0f - settings.aoStrength * occlusion;
+    }
+
+    // Deslocamentos (lado 1, lado 2, canto) da camada de ar para cada canto de cada face
+    int aoOffsets[6][4][3];
+    for (int f = 0; f < 6; f++) {
+        for (int c = 0; c < 4; c++) {
+            int du = CORNERS[c][0] ? strides[FACES[f].u] : -strides[FACES[f].u];
+            int dv = CORNERS[c][1] ? strides[FACES[f].v] : -strides[FACES[f].v];
+            aoOffsets[f][c][0] = du;
+            aoOffsets[f][c][1] = dv;
+            aoOffsets[f][c][2] = du + dv;
+        }
+    }
+
+    for (int z = 0; z < size; z++) {
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                int idx = (x + 1) + paddedSize * ((y + 1) + paddedSize * (z + 1));
+                if (!solid[idx]) continue;
+
+                const Voxel::Color& color = palette.get(padded[idx]).getColor();
+                glm::ivec3 cell(x, y, z);
+                glm::vec3 cellPos = offset + glm::vec3(cell) * scale;
+
+                for (int f = 0; f < 6; f++) {
+                    const FaceInfo& face = FACES[f];
+                    int airIdx = idx + face.sign * strides[face.axis];
+                    if (solid[airIdx]) {
+                        // Saia: face na fronteira do chunk voltada para um bloco que pode
+                        // estar parcialmente vazio em um vizinho de nível mais fino
+                        bool boundary = face.sign > 0 ? cell[face.axis] == size - 1 : cell[face.axis] == 0;
+                        if (!full || !boundary || full[airIdx]) continue;
+                    }
+
+                    glm::vec3 normal(0.0f);
+                    normal[face.axis] = static_cast<float>(face.sign);
+
+                    glm::vec3 base = cellPos;
+                    if (face.sign > 0) {
+                        base[face.axis] += scale;
+                    }
+
+                    int levels[4] = {3, 3, 3, 3};
+                    if (settings.ambientOcclusion) {
+                        const uint8_t* air = solid.data() + airIdx;
+                        for (int c = 0; c < 4; c++) {
+                            int side1 = air[aoOffsets[f][c][0]];
+                            int side2 = air[aoOffsets[f][c][1]];
+                            int corner = air[aoOffsets[f][c][2]];
+                            levels[c] = AO_LEVELS[side1 | (side2 << 1) | (corner << 2)];
+                        }
+                    }
+
+                    Mesh::Vertex quad[4];
+                    for (int c = 0; c < 4; c++) {
+                        glm::vec3 position = base;
+                        position[face.u] += scale * static_cast<float>(CORNERS[c][0]);
+                        position[face.v] += scale * static_cast<float>(CORNERS[c][1]);
+                        quad[c] = Mesh::Vertex(position, normal, color, aoCurve[levels[c]]);
+                    }
+
+                    // Divide o quad pela diagonal mais clara para evitar artefatos
+                    // anisotrópicos na interpolação da oclusão
+                    bool flip = levels[1] + levels[3] > levels[0] + levels[2];
+                    out.addQuad(quad, flip);
+                }
+            }
+        }
+    }
+}
+
+} // namespace VoxelMaker
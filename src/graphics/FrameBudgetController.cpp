@@ -0,0 +1,207 @@
+#include "graphics/FrameBudgetController.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace VoxelMaker {
+
+namespace {
+
+const char* ACTION_NAMES[] = {"none", "degrade", "improve"};
+
+double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+} // namespace
+
+FrameBudgetController::FrameBudgetController()
+    : FrameBudgetController(Settings()) {
+}
+
+FrameBudgetController::FrameBudgetController(const Settings& settings)
+    : settings(settings)
+    , quality(settings.maxQuality)
+    , frameStart()
+    , phaseStart()
+    , currentPhase(Phase::EVENTS)
+    , inFrame(false)
+    , framePhaseMs()
+    , averagePhaseMs()
+    , averageFrameMs(0.0)
+    , frameCount(0)
+    , framesSinceDecision(0)
+    , history()
+    , metricsFile() {
+}
+
+void FrameBudgetController::setQuality(const Quality& newQuality) {
+    quality.lodDistance = std::clamp(newQuality.lodDistance,
+                                     settings.minQuality.lodDistance, settings.maxQuality.lodDistance);
+    quality.meshJobsPerFrame = std::clamp(newQuality.meshJobsPerFrame,
+                                          settings.minQuality.meshJobsPerFrame, settings.maxQuality.meshJobsPerFrame);
+    quality.uploadBytesPerFrame = std::clamp(newQuality.uploadBytesPerFrame,
+                                             settings.minQuality.uploadBytesPerFrame, settings.maxQuality.uploadBytesPerFrame);
+}
+
+bool FrameBudgetController::openMetricsFile(const std::string& path) {
+    metricsFile.close();
+    metricsFile.open(path, std::ios::trunc);
+    if (!metricsFile) {
+        std::cerr << "Erro ao criar arquivo de métricas: " << path << std::endl;
+        return false;
+    }
+
+    metricsFile << "frame,frame_ms";
+    for (size_t i = 0; i < PHASE_COUNT; i++) {
+        metricsFile << "," << getPhaseName(static_cast<Phase>(i)) << "_ms";
+    }
+    metricsFile << ",dominant,action,lod_distance,mesh_jobs,upload_bytes\n";
+    return true;
+}
+
+void FrameBudgetController::beginFrame() {
+    frameStart = Clock::now();
+    phaseStart = frameStart;
+    currentPhase = Phase::EVENTS;
+    std::fill(std::begin(framePhaseMs), std::end(framePhaseMs), 0.0);
+    inFrame = true;
+}
+
+void FrameBudgetController::beginPhase(Phase phase) {
+    if (!inFrame) return;
+
+    Clock::time_point now = Clock::now();
+    framePhaseMs[static_cast<size_t>(currentPhase)] += elapsedMs(phaseStart, now);
+    currentPhase = phase;
+    phaseStart = now;
+}
+
+bool FrameBudgetController::endFrame() {
+    if (!inFrame) return false;
+    inFrame = false;
+
+    Clock::time_point now = Clock::now();
+    framePhaseMs[static_cast<size_t>(currentPhase)] += elapsedMs(phaseStart, now);
+    double frameMs = elapsedMs(frameStart, now);
+
+    // Média móvel exponencial (o primeiro quadro inicializa as médias)
+    double weight = frameCount == 0 ? 1.0 : std::clamp(settings.smoothing, 0.0, 1.0);
+    averageFrameMs += (frameMs - averageFrameMs) * weight;
+    for (size_t i = 0; i < PHASE_COUNT; i++) {
+        averagePhaseMs[i] += (framePhaseMs[i] - averagePhaseMs[i]) * weight;
+    }
+    frameCount++;
+
+    if (++framesSinceDecision < std::max(1, settings.adjustInterval)) {
+        return false;
+    }
+    framesSinceDecision = 0;
+
+    size_t dominant = static_cast<size_t>(std::max_element(averagePhaseMs, averagePhaseMs + PHASE_COUNT) - averagePhaseMs);
+
+    Decision decision;
+    decision.frame = frameCount;
+    decision.frameMs = averageFrameMs;
+    std::copy(averagePhaseMs, averagePhaseMs + PHASE_COUNT, decision.phaseMs);
+    decision.dominantPhase = static_cast<Phase>(dominant);
+    decision.action = Action::NONE;
+
+    if (averageFrameMs > settings.targetFrameMs * (1.0 + settings.tolerance)) {
+        if (degrade(decision.dominantPhase)) {
+            decision.action = Action::DEGRADE;
+        }
+    } else if (averageFrameMs < settings.targetFrameMs * settings.headroom) {
+        if (improve()) {
+            decision.action = Action::IMPROVE;
+        }
+    }
+
+    decision.quality = quality;
+    record(decision);
+    return decision.action != Action::NONE;
+}
+
+const char* FrameBudgetController::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::EVENTS: return "events";
+        case Phase::UPDATE: return "update";
+        case Phase::RECORD: return "record";
+        case Phase::SUBMIT: return "submit";
+    }
+    return "unknown";
+}
+
+bool FrameBudgetController::degrade(Phase dominant) {
+    const Quality& minimum = settings.minQuality;
+
+    auto reduceJobs = [&]() {
+        if (quality.meshJobsPerFrame <= minimum.meshJobsPerFrame) return false;
+        quality.meshJobsPerFrame = std::max(minimum.meshJobsPerFrame, quality.meshJobsPerFrame / 2);
+        return true;
+    };
+    auto reduceUploads = [&]() {
+        if (quality.uploadBytesPerFrame <= minimum.uploadBytesPerFrame) return false;
+        quality.uploadBytesPerFrame = std::max(minimum.uploadBytesPerFrame, quality.uploadBytesPerFrame / 2);
+        return true;
+    };
+    auto reduceLod = [&]() {
+        if (quality.lodDistance <= minimum.lodDistance) return false;
+        quality.lodDistance = std::max(minimum.lodDistance, quality.lodDistance * 0.8f);
+        return true;
+    };
+
+    // Gravação lenta = malhas demais por quadro; espera longa = envio e triângulos demais
+    if (dominant == Phase::RECORD && reduceJobs()) return true;
+    if (dominant == Phase::SUBMIT && reduceUploads()) return true;
+    return reduceLod() || reduceJobs() || reduceUploads();
+}
+
+bool FrameBudgetController::improve() {
+    const Quality& maximum = settings.maxQuality;
+
+    if (quality.uploadBytesPerFrame < maximum.uploadBytesPerFrame) {
+        quality.uploadBytesPerFrame = std::min(maximum.uploadBytesPerFrame,
+                                               quality.uploadBytesPerFrame + quality.uploadBytesPerFrame / 4);
+        return true;
+    }
+    if (quality.meshJobsPerFrame < maximum.meshJobsPerFrame) {
+        quality.meshJobsPerFrame = std::min(maximum.meshJobsPerFrame,
+                                            quality.meshJobsPerFrame + std::max<size_t>(1, quality.meshJobsPerFrame / 4));
+        return true;
+    }
+    if (quality.lodDistance < maximum.lodDistance) {
+        quality.lodDistance = std::min(maximum.lodDistance, quality.lodDistance * 1.1f);
+        return true;
+    }
+    return false;
+}
+
+void FrameBudgetController::record(const Decision& decision) {
+    history.push_back(decision);
+    if (history.size() > HISTORY_SIZE) {
+        history.pop_front();
+    }
+
+    if (metricsFile) {
+        metricsFile << decision.frame << "," << decision.frameMs;
+        for (double phaseMs : decision.phaseMs) {
+            metricsFile << "," << phaseMs;
+        }
+        metricsFile << "," << getPhaseName(decision.dominantPhase)
+                    << "," << ACTION_NAMES[static_cast<size_t>(decision.action)]
+                    << "," << decision.quality.lodDistance
+                    << "," << decision.quality.meshJobsPerFrame
+                    << "," << decision.quality.uploadBytesPerFrame << "\n";
+    }
+
+    if (decision.action != Action::NONE) {
+        std::cout << "Orçamento de quadro: " << decision.frameMs << " ms (alvo " << settings.targetFrameMs
+                  << ", fase " << getPhaseName(decision.dominantPhase) << ") -> "
+                  << (decision.action == Action::DEGRADE ? "reduz" : "aumenta")
+                  << " qualidade: LOD " << decision.quality.lodDistance
+                  << ", malhas/quadro " << decision.quality.meshJobsPerFrame
+                  << ", envio/quadro " << decision.quality.uploadBytesPerFrame << " bytes" << std::endl;
+    }
+}
+
+} // namespace VoxelMaker
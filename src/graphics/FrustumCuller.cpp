@@ -0,0 +1,190 @@
+#include "graphics/FrustumCuller.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOXELMAKER_CULL_SSE 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define VOXELMAKER_CULL_AVX 1
+#include <immintrin.h>
+#endif
+
+namespace VoxelMaker {
+
+FrustumCuller::FrustumCuller()
+    : minX(), minY(), minZ()
+    , maxX(), maxY(), maxZ()
+    , visible()
+    , candidates()
+    , stats() {
+    // Planos degenerados (normal nula, d = 1) não rejeitam nenhuma caixa
+    for (auto& plane : planes) {
+        plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+
+void FrustumCuller::setViewProjection(const glm::mat4& viewProjection) {
+    // glm é column-major: a linha i é (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&viewProjection](int i) {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i],
+                         viewProjection[2][i], viewProjection[3][i]);
+    };
+
+    glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+    planes[0] = r3 + r0;    // Esquerda
+    planes[1] = r3 - r0;    // Direita
+    planes[2] = r3 + r1;    // Baixo
+    planes[3] = r3 - r1;    // Cima
+    planes[4] = r3 + r2;    // Perto
+    planes[5] = r3 - r2;    // Longe
+
+    for (auto& plane : planes) {
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+}
+
+bool FrustumCuller::testBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const {
+    for (const auto& plane : planes) {
+        // Vértice positivo: o canto mais à frente na direção da normal
+        float px = plane.x >= 0.0f ? boxMax.x : boxMin.x;
+        float py = plane.y >= 0.0f ? boxMax.y : boxMin.y;
+        float pz = plane.z >= 0.0f ? boxMax.z : boxMin.z;
+        if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t FrustumCuller::testBoxes(const float* boxMinX, const float* boxMinY, const float* boxMinZ,
+                                const float* boxMaxX, const float* boxMaxY, const float* boxMaxZ,
+                                size_t count, uint8_t* result) const {
+    // O vértice positivo depende só do sinal da normal, então a escolha min/max é feita
+    // uma vez por plano e o laço interno não tem desvios
+    const float* px[PLANE_COUNT];
+    const float* py[PLANE_COUNT];
+    const float* pz[PLANE_COUNT];
+    for (int p = 0; p < PLANE_COUNT; p++) {
+        px[p] = planes[p].x >= 0.0f ? boxMaxX : boxMinX;
+        py[p] = planes[p].y >= 0.0f ? boxMaxY : boxMinY;
+        pz[p] = planes[p].z >= 0.0f ? boxMaxZ : boxMinZ;
+    }
+
+    size_t visibleCount = 0;
+    size_t i = 0;
+
+#if VOXELMAKER_CULL_AVX
+    for (; i + 8 <= count; i += 8) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            __m256 distance = _mm256_set1_ps(planes[p].w);
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes[p].x), _mm256_loadu_ps(px[p] + i)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes[p].y), _mm256_loadu_ps(py[p] + i)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes[p].z), _mm256_loadu_ps(pz[p] + i)));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(inside);
+        for (int k = 0; k < 8; k++) {
+            result[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+            visibleCount += result[i + k];
+        }
+    }
+#endif
+
+#if VOXELMAKER_CULL_SSE
+    for (; i + 4 <= count; i += 4) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            __m128 distance = _mm_set1_ps(planes[p].w);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p].x), _mm_loadu_ps(px[p] + i)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p].y), _mm_loadu_ps(py[p] + i)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p].z), _mm_loadu_ps(pz[p] + i)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; k++) {
+            result[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+            visibleCount += result[i + k];
+        }
+    }
+#endif
+
+    // Restante (ou tudo, sem SIMD)
+    for (; i < count; i++) {
+        bool inside = true;
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            float distance = planes[p].x * px[p][i] + planes[p].y * py[p][i] + planes[p].z * pz[p][i] + planes[p].w;
+            inside = inside && distance >= 0.0f;
+        }
+        result[i] = inside ? 1 : 0;
+        visibleCount += result[i];
+    }
+
+    return visibleCount;
+}
+
+void FrustumCuller::cullChunks(const ChunkMeshManager::ChunkMeshMap& meshes,
+                               const glm::vec3& viewer,
+                               std::vector<VisibleChunk>& out) {
+    out.clear();
+
+    // Chunks sem triângulos (totalmente internos ou vazios) não precisam de teste
+    candidates.clear();
+    for (const auto& pair : meshes) {
+        if (!pair.second.mesh->isEmpty()) {
+            candidates.push_back(&pair);
+        }
+    }
+
+    size_t count = candidates.size();
+    minX.resize(count); minY.resize(count); minZ.resize(count);
+    maxX.resize(count); maxY.resize(count); maxZ.resize(count);
+    visible.resize(count);
+
+    for (size_t i = 0; i < count; i++) {
+        const auto& entry = candidates[i]->second;
+        minX[i] = entry.boundsMin.x;
+        minY[i] = entry.boundsMin.y;
+        minZ[i] = entry.boundsMin.z;
+        maxX[i] = entry.boundsMax.x;
+        maxY[i] = entry.boundsMax.y;
+        maxZ[i] = entry.boundsMax.z;
+    }
+
+    size_t visibleCount = testBoxes(minX.data(), minY.data(), minZ.data(),
+                                    maxX.data(), maxY.data(), maxZ.data(),
+                                    count, visible.data());
+
+    out.reserve(visibleCount);
+    for (size_t i = 0; i < count; i++) {
+        if (!visible[i]) continue;
+
+        const auto& entry = candidates[i]->second;
+        glm::vec3 closest = glm::clamp(viewer, entry.boundsMin, entry.boundsMax);
+
+        VisibleChunk chunk;
+        chunk.coord = candidates[i]->first;
+        chunk.mesh = &entry;
+        chunk.distance = glm::length(viewer - closest);
+        out.push_back(chunk);
+    }
+
+    // Da frente para trás para aproveitar o early-z
+    std::sort(out.begin(), out.end(), [](const VisibleChunk& a, const VisibleChunk& b) {
+        return a.distance < b.distance;
+    });
+
+    stats.chunksTested = count;
+    stats.chunksVisible = visibleCount;
+    stats.chunksCulled = count - visibleCount;
+}
+
+} // namespace VoxelMaker
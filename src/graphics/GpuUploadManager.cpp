@@ -0,0 +1,232 @@
+#include "graphics/GpuUploadManager.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+#ifdef VOXELMAKER_HAS_GLAD
+#include <glad/glad.h>
+#endif
+
+namespace VoxelMaker {
+
+namespace {
+
+constexpr size_t RING_ALIGNMENT = 16;
+
+} // namespace
+
+GpuUploadManager::GpuUploadManager()
+    : settings()
+    , ring()
+    , vertexAllocator()
+    , indexAllocator()
+    , vertexBuffer(0), indexBuffer(0)
+    , vertexArray(0)
+    , stats()
+    , initialized(false) {
+}
+
+GpuUploadManager::~GpuUploadManager() {
+    cleanup();
+}
+
+bool GpuUploadManager::initialize(const Settings& newSettings) {
+    cleanup();
+    settings = newSettings;
+
+    if (!ring.initialize(settings.ringCapacity, settings.allowPersistentMapping)) {
+        std::cerr << "Erro ao criar o anel de envio" << std::endl;
+        return false;
+    }
+
+    // Faixas de vértices alinhadas ao tamanho do vértice para derivar o vértice base
+    vertexAllocator.reset(settings.vertexCapacity, sizeof(Mesh::Vertex));
+    indexAllocator.reset(settings.indexCapacity, sizeof(uint32_t));
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glGenBuffers(1, &vertexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(vertexAllocator.getCapacity()), nullptr, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(indexAllocator.getCapacity()), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glGenVertexArrays(1, &vertexArray);
+    setupVertexArray();
+#endif
+
+    stats = Stats();
+    initialized = true;
+    return true;
+}
+
+void GpuUploadManager::cleanup() {
+#ifdef VOXELMAKER_HAS_GLAD
+    if (initialized) {
+        glDeleteVertexArrays(1, &vertexArray);
+        glDeleteBuffers(1, &vertexBuffer);
+        glDeleteBuffers(1, &indexBuffer);
+    }
+#endif
+    vertexArray = vertexBuffer = indexBuffer = 0;
+    ring.cleanup();
+    vertexAllocator.reset(0, sizeof(Mesh::Vertex));
+    indexAllocator.reset(0, sizeof(uint32_t));
+    initialized = false;
+}
+
+bool GpuUploadManager::upload(const Mesh& mesh, Allocation& allocation) {
+    if (!initialized) return false;
+
+    size_t vertexBytes = mesh.getVertexCount() * sizeof(Mesh::Vertex);
+    size_t indexBytes = mesh.getIndexCount() * sizeof(uint32_t);
+    if (vertexBytes == 0 || indexBytes == 0) {
+        release(allocation);
+        return true;
+    }
+
+    // Reaproveitar as faixas do chunk se a nova malha couber nelas
+    if (allocation.isValid() &&
+        (vertexAllocator.getAllocationSize(allocation.vertexOffset) < vertexBytes ||
+         indexAllocator.getAllocationSize(allocation.indexOffset) < indexBytes)) {
+        release(allocation);
+    }
+
+    if (!allocation.isValid()) {
+        allocation.vertexOffset = allocateRange(vertexAllocator, vertexBuffer, vertexBytes);
+        allocation.indexOffset = allocateRange(indexAllocator, indexBuffer, indexBytes);
+        if (allocation.vertexOffset == BufferAllocator::INVALID_OFFSET ||
+            allocation.indexOffset == BufferAllocator::INVALID_OFFSET) {
+            std::cerr << "Erro ao reservar faixas para a malha do chunk" << std::endl;
+            release(allocation);
+            return false;
+        }
+    }
+
+    // A CPU lê direto dos vetores do mesher; a cópia para a faixa final é feita pela GPU
+    writeRange(vertexBuffer, allocation.vertexOffset, mesh.getVertices().data(), vertexBytes, RING_ALIGNMENT);
+    writeRange(indexBuffer, allocation.indexOffset, mesh.getIndices().data(), indexBytes, RING_ALIGNMENT);
+
+    allocation.indexCount = mesh.getIndexCount();
+    allocation.baseVertex = static_cast<int32_t>(allocation.vertexOffset / sizeof(Mesh::Vertex));
+    stats.meshesUploaded++;
+    return true;
+}
+
+void GpuUploadManager::release(Allocation& allocation) {
+    if (allocation.vertexOffset != BufferAllocator::INVALID_OFFSET) {
+        vertexAllocator.free(allocation.vertexOffset);
+    }
+    if (allocation.indexOffset != BufferAllocator::INVALID_OFFSET) {
+        indexAllocator.free(allocation.indexOffset);
+    }
+    allocation = Allocation();
+}
+
+void GpuUploadManager::draw(const Allocation& allocation) const {
+    if (!allocation.isValid() || allocation.indexCount == 0) return;
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(allocation.indexCount), GL_UNSIGNED_INT,
+                             reinterpret_cast<void*>(allocation.indexOffset), allocation.baseVertex);
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+#endif
+}
+
+void GpuUploadManager::endFrame() {
+    ring.fence();
+}
+
+GpuUploadManager::Stats GpuUploadManager::getStats() const {
+    Stats current = stats;
+    current.vertexBuffer = vertexAllocator.getStats();
+    current.indexBuffer = indexAllocator.getStats();
+    return current;
+}
+
+size_t GpuUploadManager::allocateRange(BufferAllocator& allocator, unsigned int& buffer, size_t size) {
+    size_t offset = allocator.allocate(size);
+    while (offset == BufferAllocator::INVALID_OFFSET) {
+        size_t oldCapacity = allocator.getCapacity();
+        size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + size);
+
+#ifdef VOXELMAKER_HAS_GLAD
+        // Dobrar o buffer preservando as faixas existentes (cópia feita pela GPU)
+        unsigned int grown = 0;
+        glGenBuffers(1, &grown);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newCapacity), nullptr, GL_STATIC_DRAW);
+        if (oldCapacity > 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(oldCapacity));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glDeleteBuffers(1, &buffer);
+        buffer = grown;
+        setupVertexArray();
+#endif
+
+        allocator.grow(newCapacity);
+        stats.bufferGrowths++;
+        offset = allocator.allocate(size);
+    }
+    return offset;
+}
+
+void GpuUploadManager::writeRange(unsigned int buffer, size_t offset, const void* data, size_t size, size_t alignment) {
+    size_t ringOffset = ring.write(data, size, alignment);
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (ringOffset == UploadRing::INVALID_OFFSET) {
+        // Maior que o anel: envio direto
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    } else {
+        glBindBuffer(GL_COPY_READ_BUFFER, ring.getBuffer());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(ringOffset),
+                            static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+    (void)buffer;
+    (void)offset;
+#endif
+
+    if (ringOffset == UploadRing::INVALID_OFFSET) {
+        stats.directUploads++;
+    }
+    stats.bytesUploaded += size;
+}
+
+void GpuUploadManager::setupVertexArray() {
+#ifdef VOXELMAKER_HAS_GLAD
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+    const GLsizei stride = sizeof(Mesh::Vertex);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void*>(offsetof(Mesh::Vertex, position)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void*>(offsetof(Mesh::Vertex, normal)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                          reinterpret_cast<void*>(offsetof(Mesh::Vertex, color)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void*>(offsetof(Mesh::Vertex, ao)));
+    glEnableVertexAttribArray(3);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,122 @@
+#include "graphics/Image.hpp"
+#include "utils/FileUtils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+
+namespace VoxelMaker {
+
+namespace {
+
+constexpr size_t MAX_STORED_BLOCK = 65535;
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void appendChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data) {
+    appendBigEndian(out, static_cast<uint32_t>(data.size()));
+    size_t typeStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    appendBigEndian(out, FileUtils::crc32(&out[typeStart], out.size() - typeStart));
+}
+
+} // namespace
+
+Image::Image()
+    : width(0)
+    , height(0)
+    , pixels() {
+}
+
+Image::Image(int w, int h)
+    : width(0)
+    , height(0)
+    , pixels() {
+    resize(w, h);
+}
+
+void Image::resize(int w, int h) {
+    width = std::max(0, w);
+    height = std::max(0, h);
+    pixels.assign(static_cast<size_t>(width) * height * 3, 0);
+}
+
+bool Image::save(const std::string& path) const {
+    std::string extension = path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".png" ? savePNG(path) : savePPM(path);
+}
+
+bool Image::savePPM(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Erro ao criar imagem: " << path << std::endl;
+        return false;
+    }
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+    return static_cast<bool>(file);
+}
+
+bool Image::savePNG(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Erro ao criar imagem: " << path << std::endl;
+        return false;
+    }
+
+    // Dados brutos: um byte de filtro (0 = nenhum) antes de cada linha
+    const size_t rowBytes = static_cast<size_t>(width) * 3;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        const uint8_t* row = getRow(y);
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // Fluxo zlib com blocos deflate armazenados
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    size_t blockCount = std::max<size_t>(1, (raw.size() + MAX_STORED_BLOCK - 1) / MAX_STORED_BLOCK);
+    zlib.reserve(raw.size() + blockCount * 5 + 6);
+    for (size_t offset = 0, block = 0; block < blockCount; block++) {
+        size_t length = std::min(MAX_STORED_BLOCK, raw.size() - offset);
+        zlib.push_back(block + 1 == blockCount ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(length));
+        zlib.push_back(static_cast<uint8_t>(length >> 8));
+        zlib.push_back(static_cast<uint8_t>(~length));
+        zlib.push_back(static_cast<uint8_t>(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        offset += length;
+    }
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t value : raw) {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    appendBigEndian(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header.insert(header.end(), {8, 2, 0, 0, 0});   // 8 bits, RGB, deflate, filtro 0, sem entrelaçamento
+
+    std::vector<uint8_t> out = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    appendChunk(out, "IHDR", header);
+    appendChunk(out, "IDAT", zlib);
+    appendChunk(out, "IEND", std::vector<uint8_t>());
+
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace VoxelMaker
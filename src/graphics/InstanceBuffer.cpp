@@ -0,0 +1,159 @@
+#include "graphics/InstanceBuffer.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace VoxelMaker {
+
+static_assert(sizeof(InstanceBuffer::Instance) == 8, "Instância deve ocupar 8 bytes");
+
+namespace {
+
+const glm::ivec3 NEIGHBOURS[6] = {
+    glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0),
+    glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0),
+    glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)
+};
+
+/**
+ * @brief Verifica se um voxel tem alguma face livre (vizinho vazio ou inativo, como no ChunkMesher)
+ */
+bool isExposed(const VoxelGrid& grid, const VoxelPalette& palette, const VoxelChunk& chunk, const glm::ivec3& local) {
+    const int last = VoxelChunk::SIZE - 1;
+    bool interior = local.x > 0 && local.y > 0 && local.z > 0 &&
+                    local.x < last && local.y < last && local.z < last;
+
+    for (const auto& offset : NEIGHBOURS) {
+        glm::ivec3 neighbour = local + offset;
+        VoxelChunk::Cell cell = interior
+            ? chunk.get(neighbour)
+            : grid.getCell(chunk.getOrigin() + neighbour);
+        if (!palette.isSolid(cell)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+InstanceBuffer::InstanceBuffer()
+    : instances()
+    , paletteColors()
+    , chunkCoords()
+    , chunkOffsets()
+    , sourceGrid(nullptr)
+    , sourceRevision(0)
+    , exposedOnly(true)
+    , sourceExposedOnly(true) {
+}
+
+bool InstanceBuffer::update(const VoxelGrid& grid) {
+    if (sourceGrid == &grid && sourceRevision == grid.getRevision() && sourceExposedOnly == exposedOnly) {
+        return false;
+    }
+
+    build(grid);
+    return true;
+}
+
+void InstanceBuffer::build(const VoxelGrid& grid) {
+    // Ordem estável entre execuções: chunks ordenados por coordenada
+    std::vector<const VoxelChunk*> chunks;
+    chunks.reserve(grid.getChunks().size());
+    for (const auto& pair : grid.getChunks()) {
+        // Posições fora de 0..MAX_COORDINATE dariam a volta na conversão para 16 bits do pack
+        const glm::ivec3& origin = pair.second->getOrigin();
+        glm::ivec3 farCorner = origin + glm::ivec3(VoxelChunk::SIZE - 1);
+        if (origin.x < 0 || origin.y < 0 || origin.z < 0 ||
+            farCorner.x > MAX_COORDINATE || farCorner.y > MAX_COORDINATE || farCorner.z > MAX_COORDINATE) {
+            continue;
+        }
+        chunks.push_back(pair.second.get());
+    }
+    std::sort(chunks.begin(), chunks.end(), [](const VoxelChunk* a, const VoxelChunk* b) {
+        const glm::ivec3& ca = a->getCoord();
+        const glm::ivec3& cb = b->getCoord();
+        if (ca.z != cb.z) return ca.z < cb.z;
+        if (ca.y != cb.y) return ca.y < cb.y;
+        return ca.x < cb.x;
+    });
+
+    // 1ª passada: instâncias de cada chunk em separado
+    std::vector<std::vector<Instance>> perChunk(chunks.size());
+    const VoxelPalette& palette = grid.getPalette();
+    bool onlyExposed = exposedOnly;
+    ThreadPool::getInstance().parallelFor(chunks.size(), [&](size_t i) {
+        const VoxelChunk& chunk = *chunks[i];
+        std::vector<Instance>& local = perChunk[i];
+        local.reserve(static_cast<size_t>(chunk.getCellCount()));
+
+        const VoxelChunk::Cell* cells = chunk.getCells();
+        glm::ivec3 origin = chunk.getOrigin();
+        for (int index = 0; index < VoxelChunk::VOLUME; index++) {
+            if (!palette.isSolid(cells[index])) continue;
+
+            glm::ivec3 position(index % VoxelChunk::SIZE,
+                                (index / VoxelChunk::SIZE) % VoxelChunk::SIZE,
+                                index / VoxelChunk::AREA);
+            if (onlyExposed && !isExposed(grid, palette, chunk, position)) continue;
+
+            local.push_back(pack(origin + position, cells[index]));
+        }
+    });
+
+    // 2ª passada: copia cada bloco para sua faixa no buffer final (soma de prefixos)
+    chunkCoords.resize(chunks.size());
+    chunkOffsets.assign(chunks.size() + 1, 0);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        chunkCoords[i] = chunks[i]->getCoord();
+        chunkOffsets[i + 1] = chunkOffsets[i] + perChunk[i].size();
+    }
+
+    instances.resize(chunkOffsets.back());
+    ThreadPool::getInstance().parallelFor(chunks.size(), [&](size_t i) {
+        if (!perChunk[i].empty()) {
+            std::memcpy(instances.data() + chunkOffsets[i], perChunk[i].data(), perChunk[i].size() * sizeof(Instance));
+        }
+    });
+
+    paletteColors.resize(palette.size());
+    for (size_t i = 0; i < palette.size(); i++) {
+        paletteColors[i] = packColor(palette.get(static_cast<VoxelPalette::Index>(i)).getColor());
+    }
+
+    sourceGrid = &grid;
+    sourceRevision = grid.getRevision();
+    sourceExposedOnly = exposedOnly;
+}
+
+void InstanceBuffer::clear() {
+    instances.clear();
+    paletteColors.clear();
+    chunkCoords.clear();
+    chunkOffsets.clear();
+    sourceGrid = nullptr;
+    sourceRevision = 0;
+}
+
+InstanceBuffer::Instance InstanceBuffer::pack(const glm::ivec3& position, VoxelPalette::Index paletteIndex) {
+    Instance instance;
+    instance.x = static_cast<uint16_t>(position.x);
+    instance.y = static_cast<uint16_t>(position.y);
+    instance.z = static_cast<uint16_t>(position.z);
+    instance.paletteIndex = paletteIndex;
+    return instance;
+}
+
+glm::ivec3 InstanceBuffer::unpackPosition(const Instance& instance) {
+    return glm::ivec3(instance.x, instance.y, instance.z);
+}
+
+uint32_t InstanceBuffer::packColor(const Voxel::Color& color) {
+    return static_cast<uint32_t>(color.r) |
+           (static_cast<uint32_t>(color.g) << 8) |
+           (static_cast<uint32_t>(color.b) << 16) |
+           (static_cast<uint32_t>(color.a) << 24);
+}
+
+} // namespace VoxelMaker
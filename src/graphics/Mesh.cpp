@@ -1,7 +1,342 @@
 #include "graphics/Mesh.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 namespace VoxelMaker {
 
-// TODO: Implementar Mesh
+namespace {
 
-} // namespace VoxelMaker 
\ No newline at end of file
+static_assert(sizeof(Mesh::Vertex) == 32, "Mesh::Vertex não deve ter preenchimento");
+
+/**
+ * @brief Hash e igualdade bit a bit de vértices
+ */
+struct VertexBytesHash {
+    size_t operator()(const Mesh::Vertex* vertex) const {
+        // FNV-1a sobre os bytes do vértice
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(vertex);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < sizeof(Mesh::Vertex); i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct VertexBytesEqual {
+    bool operator()(const Mesh::Vertex* a, const Mesh::Vertex* b) const {
+        return std::memcmp(a, b, sizeof(Mesh::Vertex)) == 0;
+    }
+};
+
+} // namespace
+
+void Mesh::clear() {
+    vertices.clear();
+    indices.clear();
+}
+
+void Mesh::assign(const Vertex* vertexData, size_t vertexCount, const uint32_t* indexData, size_t indexCount) {
+    vertices.assign(vertexData, vertexData + vertexCount);
+    indices.assign(indexData, indexData + indexCount);
+}
+
+void Mesh::reserveQuads(size_t quadCount) {
+    vertices.reserve(vertices.size() + quadCount * 4);
+    indices.reserve(indices.size() + quadCount * 6);
+}
+
+uint32_t Mesh::addVertex(const Vertex& vertex) {
+    vertices.push_back(vertex);
+    return static_cast<uint32_t>(vertices.size() - 1);
+}
+
+void Mesh::addTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    indices.push_back(a);
+    indices.push_back(b);
+    indices.push_back(c);
+}
+
+void Mesh::addQuad(const Vertex quad[4], bool flipDiagonal) {
+    uint32_t base = static_cast<uint32_t>(vertices.size());
+    vertices.insert(vertices.end(), quad, quad + 4);
+
+    if (flipDiagonal) {
+        addTriangle(base + 1, base + 2, base + 3);
+        addTriangle(base + 1, base + 3, base + 0);
+    } else {
+        addTriangle(base + 0, base + 1, base + 2);
+        addTriangle(base + 0, base + 2, base + 3);
+    }
+}
+
+void Mesh::append(const Mesh& other) {
+    uint32_t offset = static_cast<uint32_t>(vertices.size());
+    vertices.insert(vertices.end(), other.vertices.begin(), other.vertices.end());
+
+    indices.reserve(indices.size() + other.indices.size());
+    for (uint32_t index : other.indices) {
+        indices.push_back(index + offset);
+    }
+}
+
+bool Mesh::computeBounds(glm::vec3& minPos, glm::vec3& maxPos) const {
+    if (vertices.empty()) {
+        return false;
+    }
+
+    minPos = vertices[0].position;
+    maxPos = vertices[0].position;
+    for (const auto& vertex : vertices) {
+        minPos = glm::min(minPos, vertex.position);
+        maxPos = glm::max(maxPos, vertex.position);
+    }
+    return true;
+}
+
+Mesh::OptimizeStats Mesh::optimize(size_t cacheSize) {
+    OptimizeStats result;
+    result.verticesBefore = vertices.size();
+    result.acmrBefore = computeACMR(cacheSize);
+
+    deduplicateVertices();
+
+    std::vector<size_t> clusters;
+    optimizeVertexCache(cacheSize, &clusters);
+    optimizeOverdraw(clusters);
+    optimizeVertexFetch();
+
+    result.verticesAfter = vertices.size();
+    result.clusterCount = clusters.size();
+    result.acmrAfter = computeACMR(cacheSize);
+    return result;
+}
+
+size_t Mesh::deduplicateVertices() {
+    // As chaves apontam para "unique", reservado de antemão para não realocar
+    std::vector<Vertex> unique;
+    unique.reserve(vertices.size());
+    std::unordered_map<const Vertex*, uint32_t, VertexBytesHash, VertexBytesEqual> lookup;
+    lookup.reserve(vertices.size());
+
+    std::vector<uint32_t> remap(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        auto it = lookup.find(&vertices[i]);
+        if (it != lookup.end()) {
+            remap[i] = it->second;
+            continue;
+        }
+
+        remap[i] = static_cast<uint32_t>(unique.size());
+        unique.push_back(vertices[i]);
+        lookup.emplace(&unique.back(), remap[i]);
+    }
+
+    for (auto& index : indices) {
+        index = remap[index];
+    }
+
+    size_t removed = vertices.size() - unique.size();
+    vertices.swap(unique);
+    return removed;
+}
+
+void Mesh::optimizeVertexCache(size_t cacheSize, std::vector<size_t>* clusters) {
+    if (clusters) {
+        clusters->clear();
+    }
+
+    size_t triangleCount = indices.size() / 3;
+    size_t vertexCount = vertices.size();
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Adjacência vértice -> triângulos (formato CSR)
+    std::vector<uint32_t> live(vertexCount, 0);
+    for (uint32_t index : indices) {
+        live[index]++;
+    }
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) {
+        adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    const uint32_t size = static_cast<uint32_t>(cacheSize);
+    uint32_t timeStamp = size + 1;
+    size_t cursor = 0;
+    int64_t fan = 0;
+    bool newCluster = true;
+
+    while (fan >= 0) {
+        if (newCluster && clusters) {
+            clusters->push_back(output.size() / 3);
+        }
+
+        // Emite todos os triângulos ainda pendentes em volta do vértice atual
+        candidates.clear();
+        for (uint32_t a = offsets[fan]; a < offsets[fan + 1]; a++) {
+            uint32_t triangle = adjacency[a];
+            if (emitted[triangle]) continue;
+            emitted[triangle] = 1;
+
+            for (int k = 0; k < 3; k++) {
+                uint32_t v = indices[triangle * 3 + k];
+                output.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+                if (timeStamp - cacheTime[v] > size) {
+                    cacheTime[v] = timeStamp++;
+                }
+            }
+        }
+
+        // Próximo vértice: o mais antigo que ainda estará no cache ao terminar seu leque
+        int64_t best = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (live[v] == 0) continue;
+            int64_t priority = 0;
+            if (timeStamp - cacheTime[v] + 2 * live[v] <= size) {
+                priority = timeStamp - cacheTime[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+
+        newCluster = best < 0;
+        if (best < 0) {
+            // Beco sem saída: volta pelos vértices recentes e depois varre a malha
+            while (!deadEnd.empty() && best < 0) {
+                uint32_t v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0) {
+                    best = v;
+                }
+            }
+            while (best < 0 && cursor < vertexCount) {
+                if (live[cursor] > 0) {
+                    best = static_cast<int64_t>(cursor);
+                }
+                cursor++;
+            }
+        }
+        fan = best;
+    }
+
+    indices.swap(output);
+}
+
+void Mesh::optimizeOverdraw(const std::vector<size_t>& clusters) {
+    size_t triangleCount = indices.size() / 3;
+    if (clusters.size() < 2 || triangleCount == 0) {
+        return;
+    }
+
+    glm::vec3 meshCenter(0.0f);
+    for (uint32_t index : indices) {
+        meshCenter += vertices[index].position;
+    }
+    meshCenter /= static_cast<float>(indices.size());
+
+    struct Cluster {
+        size_t first;
+        size_t last;
+        float sortKey;
+    };
+
+    std::vector<Cluster> sorted(clusters.size());
+    for (size_t c = 0; c < clusters.size(); c++) {
+        Cluster& cluster = sorted[c];
+        cluster.first = clusters[c];
+        cluster.last = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+
+        // Normal ponderada pela área e centróide ponderado pela área
+        glm::vec3 normal(0.0f);
+        glm::vec3 centroid(0.0f);
+        float area = 0.0f;
+        for (size_t t = cluster.first; t < cluster.last; t++) {
+            const glm::vec3& a = vertices[indices[t * 3 + 0]].position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& c2 = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 cross = glm::cross(b - a, c2 - a);
+            float triangleArea = glm::length(cross);
+            normal += cross;
+            centroid += (a + b + c2) * (triangleArea / 3.0f);
+            area += triangleArea;
+        }
+
+        if (area > 0.0f) {
+            centroid /= area;
+        }
+        float length = glm::length(normal);
+        cluster.sortKey = length > 0.0f ? glm::dot(centroid - meshCenter, normal / length) : 0.0f;
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (const auto& cluster : sorted) {
+        output.insert(output.end(), indices.begin() + cluster.first * 3, indices.begin() + cluster.last * 3);
+    }
+    indices.swap(output);
+}
+
+void Mesh::optimizeVertexFetch() {
+    const uint32_t UNUSED = 0xFFFFFFFFu;
+    std::vector<uint32_t> remap(vertices.size(), UNUSED);
+    std::vector<Vertex> output;
+    output.reserve(vertices.size());
+
+    for (auto& index : indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = static_cast<uint32_t>(output.size());
+            output.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    // Vértices não referenciados são descartados
+    vertices.swap(output);
+}
+
+float Mesh::computeACMR(size_t cacheSize) const {
+    if (indices.empty()) {
+        return 0.0f;
+    }
+
+    // Cache FIFO: um vértice é acerto se entrou há menos de cacheSize misses
+    std::vector<size_t> insertedAt(vertices.size(), 0);
+    size_t misses = 0;
+    for (uint32_t index : indices) {
+        if (insertedAt[index] == 0 || misses - insertedAt[index] >= cacheSize) {
+            misses++;
+            insertedAt[index] = misses;
+        }
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(getTriangleCount());
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,499 @@
+#include "graphics/MeshCache.hpp"
+#include "utils/FileUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace VoxelMaker {
+
+namespace {
+
+enum RecordType : uint32_t {
+    RECORD_MESH = 1,        ///< MeshRecord + vértices + índices
+    RECORD_TOUCH = 2        ///< Chaves usadas, da menos para a mais recente
+};
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+static_assert(sizeof(CacheHeader) == 8, "Cabeçalho do cache de malhas mudou de tamanho");
+
+struct RecordHeader {
+    uint32_t type;
+    uint32_t size;          ///< Bytes de conteúdo após o cabeçalho
+    uint32_t checksum;      ///< CRC-32 do conteúdo
+};
+static_assert(sizeof(RecordHeader) == 12, "Cabeçalho de registro mudou de tamanho");
+
+struct MeshRecord {
+    uint64_t key;
+    uint64_t paletteHash;   ///< Hash das primeiras paletteCount entradas da paleta
+    uint32_t paletteCount;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t reserved;
+};
+static_assert(sizeof(MeshRecord) == 32, "Registro de malha mudou de tamanho");
+
+uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t meshRecordBytes(size_t vertexCount, size_t indexCount) {
+    return sizeof(RecordHeader) + sizeof(MeshRecord) + vertexCount * sizeof(Mesh::Vertex) + indexCount * sizeof(uint32_t);
+}
+
+bool writeHeader(std::FILE* file) {
+    CacheHeader header = { MeshCache::CACHE_MAGIC, MeshCache::CACHE_VERSION };
+    return std::fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+} // namespace
+
+MeshCache::MeshCache()
+    : path()
+    , file(nullptr)
+    , fileBytes(0)
+    , liveBytes(0)
+    , maxBytes(DEFAULT_MAX_BYTES)
+    , useClock(0)
+    , entries()
+    , mutex()
+    , stats() {
+}
+
+MeshCache::~MeshCache() {
+    close();
+}
+
+MeshCache::Stats MeshCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats current = stats;
+    current.fileBytes = fileBytes;
+    current.liveBytes = liveBytes;
+    current.entries = entries.size();
+    return current;
+}
+
+bool MeshCache::open(const std::string& cachePath, uint64_t limit) {
+    close();
+    std::lock_guard<std::mutex> lock(mutex);
+    path = cachePath;
+    maxBytes = std::max<uint64_t>(limit, MIN_COMPACT_BYTES);
+    stats = Stats();
+
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+        if (error) {
+            std::cerr << "Erro ao criar diretório do cache de malhas: " << parent.string() << " (" << error.message() << ")" << std::endl;
+            return false;
+        }
+    }
+
+    file = std::fopen(path.c_str(), "r+b");
+    if (!file || !scan()) {
+        // Ausente, de outra versão ou ilegível: é só um cache, recomeça vazio
+        if (file) {
+            std::fclose(file);
+        }
+        entries.clear();
+        liveBytes = 0;
+        file = std::fopen(path.c_str(), "w+b");
+        if (!file || !writeHeader(file)) {
+            std::cerr << "Erro ao criar cache de malhas: " << path << std::endl;
+            if (file) {
+                std::fclose(file);
+                file = nullptr;
+            }
+            return false;
+        }
+        fileBytes = sizeof(CacheHeader);
+    }
+
+    // Limite reduzido desde a última execução, ou arquivo cheio de registros substituídos
+    if (fileBytes > maxBytes || (fileBytes >= MIN_COMPACT_BYTES && fileBytes > COMPACT_RATIO * liveBytes)) {
+        compact(fileBytes > maxBytes ? maxBytes - maxBytes / 4 : maxBytes);
+    }
+    return file != nullptr;
+}
+
+void MeshCache::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) {
+        return;
+    }
+    appendTouches();
+    if (fileBytes >= MIN_COMPACT_BYTES && fileBytes > COMPACT_RATIO * liveBytes) {
+        compact(maxBytes);
+    }
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    entries.clear();
+    fileBytes = 0;
+    liveBytes = 0;
+}
+
+bool MeshCache::scan() {
+    CacheHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != CACHE_MAGIC ||
+        header.version != CACHE_VERSION) {
+        return false;
+    }
+
+    std::fseek(file, 0, SEEK_END);
+    uint64_t size = static_cast<uint64_t>(std::ftell(file));
+    uint64_t cursor = sizeof(header);
+    std::vector<uint64_t> keys;
+    while (cursor + sizeof(RecordHeader) <= size) {
+        RecordHeader record;
+        if (std::fseek(file, static_cast<long>(cursor), SEEK_SET) != 0 ||
+            std::fread(&record, sizeof(record), 1, file) != 1 ||
+            cursor + sizeof(record) + record.size > size) {
+            break;
+        }
+
+        if (record.type == RECORD_MESH && record.size >= sizeof(MeshRecord)) {
+            // O conteúdo só é conferido (CRC-32) quando a malha é lida
+            MeshRecord mesh;
+            if (std::fread(&mesh, sizeof(mesh), 1, file) != 1 ||
+                meshRecordBytes(mesh.vertexCount, mesh.indexCount) != sizeof(record) + record.size) {
+                break;
+            }
+            auto previous = entries.find(mesh.key);
+            if (previous != entries.end()) {
+                liveBytes -= previous->second.size;
+            }
+            Entry& entry = entries[mesh.key];
+            entry.offset = cursor;
+            entry.size = static_cast<uint32_t>(sizeof(record) + record.size);
+            entry.paletteCount = mesh.paletteCount;
+            entry.paletteHash = mesh.paletteHash;
+            entry.lastUse = ++useClock;
+            entry.touched = false;
+            liveBytes += entry.size;
+        } else if (record.type == RECORD_TOUCH && record.size % sizeof(uint64_t) == 0) {
+            keys.resize(record.size / sizeof(uint64_t));
+            if (!keys.empty() && std::fread(keys.data(), record.size, 1, file) != 1) {
+                break;
+            }
+            if (FileUtils::crc32(keys.data(), record.size) != record.checksum) {
+                break;
+            }
+            for (uint64_t key : keys) {
+                auto it = entries.find(key);
+                if (it != entries.end()) {
+                    it->second.lastUse = ++useClock;
+                }
+            }
+        } else {
+            break;
+        }
+        cursor += sizeof(record) + record.size;
+    }
+
+    // Descarta a cauda de uma gravação interrompida
+    if (cursor < size) {
+        std::error_code error;
+        std::fflush(file);
+        std::filesystem::resize_file(path, cursor, error);
+        if (error) {
+            return false;
+        }
+    }
+    fileBytes = cursor;
+    return std::fseek(file, 0, SEEK_END) == 0;
+}
+
+bool MeshCache::load(uint64_t key, const std::vector<uint64_t>& paletteHashes, Mesh& out) {
+    auto start = std::chrono::steady_clock::now();
+    thread_local std::vector<uint8_t> buffer;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = file ? entries.find(key) : entries.end();
+    if (it == entries.end()) {
+        stats.misses++;
+        return false;
+    }
+    Entry& entry = it->second;
+    if (entry.paletteCount >= paletteHashes.size() || paletteHashes[entry.paletteCount] != entry.paletteHash) {
+        stats.stale++;
+        stats.misses++;
+        return false;
+    }
+    uint64_t offset = entry.offset;
+    buffer.resize(entry.size);
+    bool read = std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0 &&
+                std::fread(buffer.data(), buffer.size(), 1, file) == 1;
+    std::fseek(file, 0, SEEK_END);
+    entry.lastUse = ++useClock;
+    entry.touched = true;
+    lock.unlock();
+
+    // Conferência e cópia fora do mutex: outras threads continuam lendo
+    RecordHeader record;
+    MeshRecord mesh;
+    bool valid = read && buffer.size() >= sizeof(record) + sizeof(mesh);
+    if (valid) {
+        std::memcpy(&record, buffer.data(), sizeof(record));
+        std::memcpy(&mesh, buffer.data() + sizeof(record), sizeof(mesh));
+        valid = record.type == RECORD_MESH && mesh.key == key &&
+                meshRecordBytes(mesh.vertexCount, mesh.indexCount) == buffer.size() &&
+                FileUtils::crc32(buffer.data() + sizeof(record), record.size) == record.checksum;
+    }
+    if (valid) {
+        const uint8_t* data = buffer.data() + sizeof(record) + sizeof(mesh);
+        const uint32_t* indices = reinterpret_cast<const uint32_t*>(data + mesh.vertexCount * sizeof(Mesh::Vertex));
+        for (uint32_t i = 0; i < mesh.indexCount && valid; i++) {
+            valid = indices[i] < mesh.vertexCount;
+        }
+        if (valid) {
+            out.assign(reinterpret_cast<const Mesh::Vertex*>(data), mesh.vertexCount, indices, mesh.indexCount);
+        }
+    }
+
+    lock.lock();
+    if (!valid) {
+        auto current = entries.find(key);
+        if (current != entries.end() && current->second.offset == offset) {
+            liveBytes -= current->second.size;
+            entries.erase(current);
+        }
+        stats.invalidated++;
+        stats.misses++;
+        return false;
+    }
+    stats.hits++;
+    stats.bytesRead += buffer.size();
+    stats.loadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool MeshCache::store(uint64_t key, uint32_t paletteCount, const std::vector<uint64_t>& paletteHashes, const Mesh& mesh) {
+    uint64_t bytes = recordBytes(mesh);
+    if (paletteCount >= paletteHashes.size() || bytes > maxBytes / 4) {
+        return false;
+    }
+
+    MeshRecord head = {};
+    head.key = key;
+    head.paletteHash = paletteHashes[paletteCount];
+    head.paletteCount = paletteCount;
+    head.vertexCount = static_cast<uint32_t>(mesh.getVertexCount());
+    head.indexCount = static_cast<uint32_t>(mesh.getIndexCount());
+    size_t vertexBytes = mesh.getVertexCount() * sizeof(Mesh::Vertex);
+    size_t indexBytes = mesh.getIndexCount() * sizeof(uint32_t);
+
+    RecordHeader record;
+    record.type = RECORD_MESH;
+    record.size = static_cast<uint32_t>(bytes - sizeof(record));
+    record.checksum = FileUtils::crc32(&head, sizeof(head));
+    record.checksum = FileUtils::crc32(mesh.getVertices().data(), vertexBytes, record.checksum);
+    record.checksum = FileUtils::crc32(mesh.getIndices().data(), indexBytes, record.checksum);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) {
+        return false;
+    }
+    if (fileBytes + bytes > maxBytes && !compact(maxBytes - maxBytes / 4)) {
+        return false;
+    }
+    if (!file || std::fseek(file, 0, SEEK_END) != 0) {
+        return false;
+    }
+    bool written = std::fwrite(&record, sizeof(record), 1, file) == 1 &&
+                   std::fwrite(&head, sizeof(head), 1, file) == 1 &&
+                   (vertexBytes == 0 || std::fwrite(mesh.getVertices().data(), vertexBytes, 1, file) == 1) &&
+                   (indexBytes == 0 || std::fwrite(mesh.getIndices().data(), indexBytes, 1, file) == 1);
+    if (!written) {
+        // Um registro pela metade esconderia os seguintes na próxima abertura
+        std::error_code error;
+        std::fflush(file);
+        std::filesystem::resize_file(path, fileBytes, error);
+        std::fseek(file, 0, SEEK_END);
+        std::cerr << "Erro ao gravar cache de malhas: " << path << std::endl;
+        return false;
+    }
+
+    auto previous = entries.find(key);
+    if (previous != entries.end()) {
+        liveBytes -= previous->second.size;
+    }
+    Entry& entry = entries[key];
+    entry.offset = fileBytes;
+    entry.size = static_cast<uint32_t>(bytes);
+    entry.paletteCount = paletteCount;
+    entry.paletteHash = head.paletteHash;
+    entry.lastUse = ++useClock;
+    entry.touched = false;
+    fileBytes += bytes;
+    liveBytes += bytes;
+    stats.stored++;
+    stats.bytesWritten += bytes;
+    return true;
+}
+
+void MeshCache::reserve(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file && fileBytes + bytes > maxBytes) {
+        compact(bytes < maxBytes - maxBytes / 4 ? maxBytes - bytes : maxBytes / 4);
+    }
+}
+
+void MeshCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) {
+        return;
+    }
+    std::fclose(file);
+    entries.clear();
+    liveBytes = 0;
+    file = std::fopen(path.c_str(), "w+b");
+    if (!file || !writeHeader(file)) {
+        std::cerr << "Erro ao recriar cache de malhas: " << path << std::endl;
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        fileBytes = 0;
+        return;
+    }
+    fileBytes = sizeof(CacheHeader);
+}
+
+uint64_t MeshCache::recordBytes(const Mesh& mesh) {
+    return meshRecordBytes(mesh.getVertexCount(), mesh.getIndexCount());
+}
+
+void MeshCache::hashPalette(const VoxelPalette& palette, std::vector<uint64_t>& prefixes) {
+    prefixes.resize(palette.size() + 1);
+    prefixes[0] = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < palette.size(); i++) {
+        VoxelPalette::Index index = static_cast<VoxelPalette::Index>(i);
+        const Voxel::Color& color = palette.get(index).getColor();
+        uint64_t value = static_cast<uint64_t>(color.r) | static_cast<uint64_t>(color.g) << 8 |
+                         static_cast<uint64_t>(color.b) << 16 | static_cast<uint64_t>(color.a) << 24 |
+                         static_cast<uint64_t>(palette.isSolid(index) ? 1 : 0) << 32;
+        prefixes[i + 1] = mix(prefixes[i] ^ mix(value + i));
+    }
+}
+
+bool MeshCache::compact(uint64_t target) {
+    // Mais recentes primeiro até encher o alvo; o arquivo novo fica em ordem de uso
+    std::vector<std::pair<uint64_t, Entry*>> order;
+    order.reserve(entries.size());
+    for (auto& pair : entries) {
+        order.emplace_back(pair.first, &pair.second);
+    }
+    std::sort(order.begin(), order.end(), [](const std::pair<uint64_t, Entry*>& a, const std::pair<uint64_t, Entry*>& b) {
+        return a.second->lastUse > b.second->lastUse;
+    });
+    uint64_t kept = sizeof(CacheHeader);
+    size_t keep = 0;
+    while (keep < order.size() && kept + order[keep].second->size <= target) {
+        kept += order[keep].second->size;
+        keep++;
+    }
+
+    std::string temporary = path + ".tmp";
+    std::FILE* output = std::fopen(temporary.c_str(), "wb");
+    bool ok = output && writeHeader(output);
+    std::vector<uint8_t> buffer;
+    std::vector<uint64_t> offsets(keep);
+    uint64_t cursor = sizeof(CacheHeader);
+    for (size_t i = keep; ok && i-- > 0;) {
+        Entry& entry = *order[i].second;
+        buffer.resize(entry.size);
+        ok = std::fseek(file, static_cast<long>(entry.offset), SEEK_SET) == 0 &&
+             std::fread(buffer.data(), buffer.size(), 1, file) == 1 &&
+             std::fwrite(buffer.data(), buffer.size(), 1, output) == 1;
+        offsets[i] = cursor;
+        cursor += entry.size;
+    }
+    if (output) {
+        ok = std::fclose(output) == 0 && ok;
+    }
+    std::fseek(file, 0, SEEK_END);
+    if (!ok) {
+        std::remove(temporary.c_str());
+        std::cerr << "Erro ao compactar cache de malhas: " << path << std::endl;
+        return false;
+    }
+
+    std::fclose(file);
+    file = nullptr;
+    bool replaced = FileUtils::replaceFile(temporary, path);
+    file = std::fopen(path.c_str(), "r+b");
+    if (!file || std::fseek(file, 0, SEEK_END) != 0) {
+        std::cerr << "Erro ao reabrir cache de malhas: " << path << std::endl;
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        entries.clear();
+        return false;
+    }
+    if (!replaced) {
+        return false;
+    }
+
+    for (size_t i = 0; i < keep; i++) {
+        order[i].second->offset = offsets[i];
+        order[i].second->touched = false;
+    }
+    for (size_t i = keep; i < order.size(); i++) {
+        entries.erase(order[i].first);
+    }
+    stats.evicted += order.size() - keep;
+    stats.compactions++;
+    fileBytes = cursor;
+    liveBytes = cursor - sizeof(CacheHeader);
+    return true;
+}
+
+void MeshCache::appendTouches() {
+    std::vector<std::pair<uint64_t, uint64_t>> used;
+    for (auto& pair : entries) {
+        if (pair.second.touched) {
+            used.emplace_back(pair.second.lastUse, pair.first);
+            pair.second.touched = false;
+        }
+    }
+    if (used.empty()) {
+        return;
+    }
+    std::sort(used.begin(), used.end());
+    std::vector<uint64_t> keys;
+    keys.reserve(used.size());
+    for (const auto& pair : used) {
+        keys.push_back(pair.second);
+    }
+
+    RecordHeader record;
+    record.type = RECORD_TOUCH;
+    record.size = static_cast<uint32_t>(keys.size() * sizeof(uint64_t));
+    record.checksum = FileUtils::crc32(keys.data(), record.size);
+    if (std::fseek(file, 0, SEEK_END) != 0 ||
+        std::fwrite(&record, sizeof(record), 1, file) != 1 ||
+        std::fwrite(keys.data(), record.size, 1, file) != 1) {
+        std::error_code error;
+        std::fflush(file);
+        std::filesystem::resize_file(path, fileBytes, error);
+        std::fseek(file, 0, SEEK_END);
+        return;
+    }
+    fileBytes += sizeof(record) + record.size;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,650 @@
+#include "graphics/MeshExporter.hpp"
+#include "graphics/ChunkMesher.hpp"
+#include "graphics/SurfaceNetsMesher.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define VOXELMAKER_HAS_WRITEV 1
+#endif
+
+namespace VoxelMaker {
+
+namespace {
+
+constexpr size_t MAX_IO_VECTORS = 1024;             ///< Limite portátil de IOV_MAX
+constexpr size_t COPY_BLOCK = 1 << 20;              ///< Bloco ao anexar o arquivo temporário
+constexpr size_t OBJ_VERTEX_BYTES = 320;            ///< Pior caso de "v ..." + "vn ..."
+constexpr size_t OBJ_TRIANGLE_BYTES = 140;          ///< Pior caso de "f a//a b//b c//c"
+constexpr size_t PLY_VERTEX_BYTES = 27;             ///< 6 floats + 3 bytes de cor
+constexpr size_t PLY_TRIANGLE_BYTES = 13;           ///< Contagem (1 byte) + 3 índices
+constexpr size_t GLTF_VERTEX_STRIDE = 28;           ///< Posição, normal e cor RGBA8
+constexpr int PLY_COUNT_WIDTH = 10;                 ///< Contagens do cabeçalho com largura fixa
+
+/**
+ * @brief Buffer de saída reaproveitado entre lotes (a capacidade só cresce)
+ */
+struct OutputBuffer {
+    std::vector<char> bytes;
+    size_t used = 0;
+
+    void clear() { used = 0; }
+
+    /**
+     * @brief Garante espaço para mais n bytes
+     * @return Ponteiro para o fim do conteúdo
+     */
+    char* reserve(size_t n) {
+        if (bytes.size() < used + n) {
+            bytes.resize(std::max(used + n, bytes.size() * 2));
+        }
+        return bytes.data() + used;
+    }
+
+    void commit(const char* end) { used = static_cast<size_t>(end - bytes.data()); }
+};
+
+/**
+ * @brief Arquivo de saída com escrita vetorizada (writev) e correção no lugar
+ */
+class OutputFile {
+private:
+#ifdef VOXELMAKER_HAS_WRITEV
+    int descriptor = -1;
+#else
+    std::FILE* file = nullptr;
+#endif
+    uint64_t written = 0;
+    bool failed = false;
+
+public:
+    OutputFile() = default;
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+    ~OutputFile() { close(); }
+
+    bool open(const std::string& path) {
+#ifdef VOXELMAKER_HAS_WRITEV
+        descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        failed = descriptor < 0;
+#else
+        file = std::fopen(path.c_str(), "wb");
+        failed = file == nullptr;
+#endif
+        written = 0;
+        return !failed;
+    }
+
+    /**
+     * @brief Grava os buffers em ordem (uma chamada writev para até MAX_IO_VECTORS buffers)
+     */
+    void write(const std::vector<OutputBuffer>& buffers, size_t count) {
+        if (failed) return;
+#ifdef VOXELMAKER_HAS_WRITEV
+        std::vector<iovec> vectors;
+        vectors.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            if (buffers[i].used > 0) {
+                vectors.push_back({const_cast<char*>(buffers[i].bytes.data()), buffers[i].used});
+            }
+        }
+
+        size_t first = 0;
+        while (first < vectors.size()) {
+            int vectorCount = static_cast<int>(std::min(vectors.size() - first, MAX_IO_VECTORS));
+            ssize_t result = ::writev(descriptor, &vectors[first], vectorCount);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                failed = true;
+                return;
+            }
+            written += static_cast<uint64_t>(result);
+
+            // Escrita parcial: avança pelos vetores já gravados
+            size_t remaining = static_cast<size_t>(result);
+            while (first < vectors.size() && remaining >= vectors[first].iov_len) {
+                remaining -= vectors[first].iov_len;
+                first++;
+            }
+            if (remaining > 0) {
+                vectors[first].iov_base = static_cast<char*>(vectors[first].iov_base) + remaining;
+                vectors[first].iov_len -= remaining;
+            }
+        }
+#else
+        for (size_t i = 0; i < count; i++) {
+            write(buffers[i].bytes.data(), buffers[i].used);
+        }
+#endif
+    }
+
+    void write(const void* data, size_t size) {
+        if (failed || size == 0) return;
+#ifdef VOXELMAKER_HAS_WRITEV
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t result = ::write(descriptor, bytes, size);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                failed = true;
+                return;
+            }
+            bytes += result;
+            size -= static_cast<size_t>(result);
+            written += static_cast<uint64_t>(result);
+        }
+#else
+        failed = std::fwrite(data, 1, size, file) != size;
+        written += size;
+#endif
+    }
+
+    /**
+     * @brief Sobrescreve bytes já gravados sem mover a posição de escrita
+     */
+    void writeAt(uint64_t offset, const void* data, size_t size) {
+        if (failed) return;
+#ifdef VOXELMAKER_HAS_WRITEV
+        failed = ::pwrite(descriptor, data, size, static_cast<off_t>(offset)) != static_cast<ssize_t>(size);
+#else
+        long end = std::ftell(file);
+        failed = std::fseek(file, static_cast<long>(offset), SEEK_SET) != 0 ||
+                 std::fwrite(data, 1, size, file) != size ||
+                 std::fseek(file, end, SEEK_SET) != 0;
+#endif
+    }
+
+    bool close() {
+#ifdef VOXELMAKER_HAS_WRITEV
+        if (descriptor >= 0) {
+            failed = (::close(descriptor) != 0) || failed;
+            descriptor = -1;
+        }
+#else
+        if (file) {
+            failed = (std::fclose(file) != 0) || failed;
+            file = nullptr;
+        }
+#endif
+        return !failed;
+    }
+
+    uint64_t getWritten() const { return written; }
+    bool good() const { return !failed; }
+};
+
+char* appendUnsigned(char* out, uint64_t value) {
+    char digits[20];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (length > 0) {
+        *out++ = digits[--length];
+    }
+    return out;
+}
+
+/**
+ * @brief Formata um número em ponto fixo, sem zeros à direita
+ * @param scale 10^decimals
+ */
+char* appendFixed(char* out, float value, int decimals, uint64_t scale) {
+    double magnitude = std::fabs(static_cast<double>(value));
+    if (!(magnitude < 1.0e9)) {
+        magnitude = 0.0;    // NaN/infinito não devem aparecer; evita saída inválida
+    }
+    uint64_t scaled = static_cast<uint64_t>(magnitude * static_cast<double>(scale) + 0.5);
+    if (scaled != 0 && value < 0.0f) {
+        *out++ = '-';
+    }
+    out = appendUnsigned(out, scaled / scale);
+
+    uint64_t fraction = scaled % scale;
+    if (fraction != 0) {
+        char digits[20];
+        for (int i = decimals - 1; i >= 0; i--) {
+            digits[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        int length = decimals;
+        while (length > 0 && digits[length - 1] == '0') {
+            length--;
+        }
+        *out++ = '.';
+        std::memcpy(out, digits, static_cast<size_t>(length));
+        out += length;
+    }
+    return out;
+}
+
+char* appendText(char* out, const char* text, size_t length) {
+    std::memcpy(out, text, length);
+    return out + length;
+}
+
+template <typename T>
+char* appendBinary(char* out, const T& value) {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+Voxel::Color shadedColor(const Mesh::Vertex& vertex, bool bakeAmbientOcclusion) {
+    if (!bakeAmbientOcclusion) {
+        return vertex.color;
+    }
+    float ao = std::min(1.0f, std::max(0.0f, vertex.ao));
+    return Voxel::Color(static_cast<uint8_t>(vertex.color.r * ao + 0.5f),
+                        static_cast<uint8_t>(vertex.color.g * ao + 0.5f),
+                        static_cast<uint8_t>(vertex.color.b * ao + 0.5f),
+                        vertex.color.a);
+}
+
+bool isLittleEndian() {
+    const uint16_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+std::string plyHeader(uint64_t vertices, uint64_t triangles) {
+    char counts[2][32];
+    std::snprintf(counts[0], sizeof(counts[0]), "%0*llu", PLY_COUNT_WIDTH, static_cast<unsigned long long>(vertices));
+    std::snprintf(counts[1], sizeof(counts[1]), "%0*llu", PLY_COUNT_WIDTH, static_cast<unsigned long long>(triangles));
+
+    std::string header = "ply\n";
+    header += isLittleEndian() ? "format binary_little_endian 1.0\n" : "format binary_big_endian 1.0\n";
+    header += "comment VoxelMaker\n";
+    header += "element vertex " + std::string(counts[0]) + "\n";
+    header += "property float x\nproperty float y\nproperty float z\n";
+    header += "property float nx\nproperty float ny\nproperty float nz\n";
+    header += "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    header += "element face " + std::string(counts[1]) + "\n";
+    header += "property list uchar uint vertex_indices\n";
+    header += "end_header\n";
+    return header;
+}
+
+std::string fileName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+bool hasExtension(const std::string& path, const char* extension) {
+    size_t length = std::strlen(extension);
+    if (path.size() <= length) return false;
+    for (size_t i = 0; i < length; i++) {
+        char c = path[path.size() - length + i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != extension[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Anexa um arquivo temporário à saída em blocos e o remove
+ */
+bool appendAndRemove(OutputFile& output, const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    std::vector<char> block(COPY_BLOCK);
+    while (input) {
+        input.read(block.data(), static_cast<std::streamsize>(block.size()));
+        output.write(block.data(), static_cast<size_t>(input.gcount()));
+    }
+    bool ok = input.eof() && output.good();
+    input.close();
+    std::remove(path.c_str());
+    return ok;
+}
+
+} // namespace
+
+MeshExporter::MeshExporter(const Settings& settings)
+    : settings(settings)
+    , stats() {
+}
+
+bool MeshExporter::formatFromPath(const std::string& path, Format& format) {
+    if (hasExtension(path, ".obj")) {
+        format = Format::OBJ;
+    } else if (hasExtension(path, ".ply")) {
+        format = Format::PLY;
+    } else if (hasExtension(path, ".gltf")) {
+        format = Format::GLTF;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool MeshExporter::exportGrid(VoxelGrid& grid, const std::string& path) {
+    Format format;
+    if (!formatFromPath(path, format)) {
+        std::cerr << "Formato de exportação desconhecido: " << path << std::endl;
+        return false;
+    }
+    return exportGrid(grid, path, format);
+}
+
+bool MeshExporter::exportGrid(VoxelGrid& grid, const std::string& path, Format format) {
+    using Clock = std::chrono::steady_clock;
+    auto elapsedSince = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+    auto start = Clock::now();
+    stats = Stats();
+
+    // Vértices vão para o arquivo principal; triângulos, quando o formato os quer no
+    // fim, para um temporário anexado depois
+    std::string mainPath = path;
+    if (format == Format::GLTF) {
+        mainPath = (hasExtension(path, ".gltf") ? path.substr(0, path.size() - 5) : path) + ".bin";
+    }
+    const std::string sidePath = mainPath + ".tmp";
+    const bool useSideFile = format != Format::OBJ;
+
+    OutputFile output;
+    OutputFile side;
+    if (!output.open(mainPath) || (useSideFile && !side.open(sidePath))) {
+        std::cerr << "Erro ao criar arquivo de exportação: " << mainPath << std::endl;
+        return false;
+    }
+
+    const std::string header = format == Format::PLY ? plyHeader(0, 0)
+                             : format == Format::OBJ ? std::string("# VoxelMaker\n")
+                             : std::string();
+    output.write(header.data(), header.size());
+
+    // Chunks com conteúdo, em ordem determinística
+    std::vector<glm::ivec3> coords;
+    for (const auto& pair : grid.getChunks()) {
+        if (!pair.second->isEmpty()) {
+            coords.push_back(pair.first);
+        }
+    }
+    std::sort(coords.begin(), coords.end(), [](const glm::ivec3& a, const glm::ivec3& b) {
+        if (a.z != b.z) return a.z < b.z;
+        if (a.y != b.y) return a.y < b.y;
+        return a.x < b.x;
+    });
+    stats.chunks = coords.size();
+
+    // Chunks preguiçosos que a exportação vai decodificar, por z: um chunk só é lido pelas
+    // malhas dele e dos vizinhos, então é liberado assim que o lote passa da camada seguinte
+    std::vector<VoxelChunk*> lazyChunks;
+    for (const auto& pair : grid.getChunks()) {
+        if (pair.second->hasSource() && !pair.second->isResident()) {
+            lazyChunks.push_back(pair.second.get());
+        }
+    }
+    std::sort(lazyChunks.begin(), lazyChunks.end(), [](const VoxelChunk* a, const VoxelChunk* b) {
+        return a->getCoord().z < b->getCoord().z;
+    });
+    size_t lazyReleased = 0;
+    auto releaseLazyBelow = [&](int z) {
+        for (; lazyReleased < lazyChunks.size() && lazyChunks[lazyReleased]->getCoord().z < z; lazyReleased++) {
+            if (lazyChunks[lazyReleased]->release()) {
+                stats.releasedChunks++;
+            }
+        }
+    };
+
+    const int decimals = std::min(9, std::max(0, settings.decimals));
+    uint64_t scale = 1;
+    for (int i = 0; i < decimals; i++) scale *= 10;
+
+    ChunkMesher mesher;
+    SurfaceNetsMesher smoothMesher;
+    SurfaceNetsMesher::BorderCache borderCache;
+
+    std::vector<Mesh> meshes(BATCH_CHUNKS);
+    std::vector<OutputBuffer> mainBuffers(BATCH_CHUNKS);
+    std::vector<OutputBuffer> sideBuffers(BATCH_CHUNKS);
+    std::vector<uint64_t> vertexBase(BATCH_CHUNKS);
+    std::vector<std::array<glm::vec3, 2>> bounds(BATCH_CHUNKS);
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+    uint64_t vertexCount = 0;
+    uint64_t triangleCount = 0;
+
+    for (size_t first = 0; first < coords.size(); first += BATCH_CHUNKS) {
+        const size_t count = std::min(BATCH_CHUNKS, coords.size() - first);
+        ThreadPool& pool = ThreadPool::getInstance();
+
+        // 1. Malhas do lote em paralelo
+        auto phase = Clock::now();
+        pool.parallelFor(count, [&](size_t i) {
+            Mesh& mesh = meshes[i];
+            if (settings.meshingMode == ChunkMeshManager::MeshingMode::SMOOTH) {
+                smoothMesher.meshChunk(grid, coords[first + i], mesh, &borderCache);
+            } else {
+                mesher.meshChunk(grid, coords[first + i], mesh);
+            }
+            if (settings.weldVertices) {
+                mesh.deduplicateVertices();
+            }
+        });
+        borderCache.clear();
+        stats.meshingMs += elapsedSince(phase);
+
+        // 2. Deslocamentos globais de índices (soma de prefixos)
+        for (size_t i = 0; i < count; i++) {
+            vertexBase[i] = vertexCount;
+            vertexCount += meshes[i].getVertexCount();
+            triangleCount += meshes[i].getTriangleCount();
+        }
+        if (format != Format::OBJ && vertexCount > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "Malha grande demais para índices de 32 bits: " << path << std::endl;
+            output.close();
+            side.close();
+            std::remove(sidePath.c_str());
+            releaseLazyBelow(std::numeric_limits<int>::max());
+            return false;
+        }
+
+        // 3. Formatação de cada chunk no seu buffer, em paralelo
+        phase = Clock::now();
+        pool.parallelFor(count, [&](size_t i) {
+            const Mesh& mesh = meshes[i];
+            const std::vector<Mesh::Vertex>& vertices = mesh.getVertices();
+            const std::vector<uint32_t>& indices = mesh.getIndices();
+            OutputBuffer& main = mainBuffers[i];
+            OutputBuffer& tail = sideBuffers[i];
+            main.clear();
+            tail.clear();
+            bounds[i][0] = glm::vec3(std::numeric_limits<float>::max());
+            bounds[i][1] = glm::vec3(-std::numeric_limits<float>::max());
+
+            switch (format) {
+                case Format::OBJ: {
+                    // Reserva por linha: o pior caso do texto é bem maior que o típico
+                    for (const Mesh::Vertex& vertex : vertices) {
+                        char* out = main.reserve(OBJ_VERTEX_BYTES);
+                        Voxel::Color color = shadedColor(vertex, settings.bakeAmbientOcclusion);
+                        out = appendText(out, "v ", 2);
+                        out = appendFixed(out, vertex.position.x, decimals, scale);
+                        *out++ = ' ';
+                        out = appendFixed(out, vertex.position.y, decimals, scale);
+                        *out++ = ' ';
+                        out = appendFixed(out, vertex.position.z, decimals, scale);
+                        *out++ = ' ';
+                        out = appendFixed(out, color.r / 255.0f, 3, 1000);
+                        *out++ = ' ';
+                        out = appendFixed(out, color.g / 255.0f, 3, 1000);
+                        *out++ = ' ';
+                        out = appendFixed(out, color.b / 255.0f, 3, 1000);
+                        out = appendText(out, "\nvn ", 4);
+                        out = appendFixed(out, vertex.normal.x, decimals, scale);
+                        *out++ = ' ';
+                        out = appendFixed(out, vertex.normal.y, decimals, scale);
+                        *out++ = ' ';
+                        out = appendFixed(out, vertex.normal.z, decimals, scale);
+                        *out++ = '\n';
+                        main.commit(out);
+                    }
+                    // Índices do OBJ são globais e começam em 1
+                    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+                        char* out = main.reserve(OBJ_TRIANGLE_BYTES);
+                        *out++ = 'f';
+                        for (int k = 0; k < 3; k++) {
+                            uint64_t index = vertexBase[i] + indices[t + static_cast<size_t>(k)] + 1;
+                            *out++ = ' ';
+                            out = appendUnsigned(out, index);
+                            out = appendText(out, "//", 2);
+                            out = appendUnsigned(out, index);
+                        }
+                        *out++ = '\n';
+                        main.commit(out);
+                    }
+                    break;
+                }
+                case Format::PLY: {
+                    char* out = main.reserve(vertices.size() * PLY_VERTEX_BYTES);
+                    for (const Mesh::Vertex& vertex : vertices) {
+                        Voxel::Color color = shadedColor(vertex, settings.bakeAmbientOcclusion);
+                        out = appendBinary(out, vertex.position);
+                        out = appendBinary(out, vertex.normal);
+                        *out++ = static_cast<char>(color.r);
+                        *out++ = static_cast<char>(color.g);
+                        *out++ = static_cast<char>(color.b);
+                    }
+                    main.commit(out);
+
+                    out = tail.reserve(indices.size() / 3 * PLY_TRIANGLE_BYTES);
+                    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+                        *out++ = 3;
+                        for (int k = 0; k < 3; k++) {
+                            out = appendBinary(out, static_cast<uint32_t>(vertexBase[i] + indices[t + static_cast<size_t>(k)]));
+                        }
+                    }
+                    tail.commit(out);
+                    break;
+                }
+                case Format::GLTF: {
+                    char* out = main.reserve(vertices.size() * GLTF_VERTEX_STRIDE);
+                    for (const Mesh::Vertex& vertex : vertices) {
+                        Voxel::Color color = shadedColor(vertex, settings.bakeAmbientOcclusion);
+                        out = appendBinary(out, vertex.position);
+                        out = appendBinary(out, vertex.normal);
+                        *out++ = static_cast<char>(color.r);
+                        *out++ = static_cast<char>(color.g);
+                        *out++ = static_cast<char>(color.b);
+                        *out++ = static_cast<char>(color.a);
+                        bounds[i][0] = glm::min(bounds[i][0], vertex.position);
+                        bounds[i][1] = glm::max(bounds[i][1], vertex.position);
+                    }
+                    main.commit(out);
+
+                    out = tail.reserve(indices.size() * sizeof(uint32_t));
+                    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+                        for (int k = 0; k < 3; k++) {
+                            out = appendBinary(out, static_cast<uint32_t>(vertexBase[i] + indices[t + static_cast<size_t>(k)]));
+                        }
+                    }
+                    tail.commit(out);
+                    break;
+                }
+            }
+        });
+        stats.formattingMs += elapsedSince(phase);
+
+        // 4. Gravação em ordem, uma escrita vetorizada por arquivo
+        phase = Clock::now();
+        size_t batchBytes = 0;
+        for (size_t i = 0; i < count; i++) {
+            batchBytes += mainBuffers[i].used + sideBuffers[i].used;
+            boundsMin = glm::min(boundsMin, bounds[i][0]);
+            boundsMax = glm::max(boundsMax, bounds[i][1]);
+        }
+        output.write(mainBuffers, count);
+        if (useSideFile) {
+            side.write(sideBuffers, count);
+        }
+        stats.writingMs += elapsedSince(phase);
+        stats.peakBatchBytes = std::max(stats.peakBatchBytes, batchBytes);
+        stats.batches++;
+
+        // Os próximos lotes começam em z >= o último deste e leem no máximo uma camada abaixo
+        releaseLazyBelow(coords[first + count - 1].z - 1);
+    }
+    releaseLazyBelow(std::numeric_limits<int>::max());
+
+    // Fechamento: triângulos no fim, cabeçalho com as contagens finais, JSON do glTF
+    auto phase = Clock::now();
+    const uint64_t vertexBytes = output.getWritten() - header.size();
+    bool ok = side.close();
+    if (useSideFile) {
+        ok = appendAndRemove(output, sidePath) && ok;
+    }
+    if (format == Format::PLY) {
+        std::string finalHeader = plyHeader(vertexCount, triangleCount);
+        output.writeAt(0, finalHeader.data(), finalHeader.size());
+    }
+    stats.bytes = output.getWritten();
+    ok = output.close() && ok;
+
+    if (ok && format == Format::GLTF) {
+        const uint64_t indexBytes = triangleCount * 3 * sizeof(uint32_t);
+        char number[64];
+        auto vec3Text = [&](const glm::vec3& v) {
+            std::snprintf(number, sizeof(number), "[%.9g,%.9g,%.9g]", v.x, v.y, v.z);
+            return std::string(number);
+        };
+
+        std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"VoxelMaker\"},\"scene\":0,";
+        if (vertexCount == 0 || triangleCount == 0) {
+            json += "\"scenes\":[{\"nodes\":[]}]}\n";
+        } else {
+            json += "\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],";
+            json += "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"COLOR_0\":2},"
+                    "\"indices\":3,\"mode\":4}]}],";
+            json += "\"buffers\":[{\"uri\":\"" + fileName(mainPath) + "\",\"byteLength\":" +
+                    std::to_string(vertexBytes + indexBytes) + "}],";
+            json += "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" + std::to_string(vertexBytes) +
+                    ",\"byteStride\":" + std::to_string(GLTF_VERTEX_STRIDE) + ",\"target\":34962},";
+            json += "{\"buffer\":0,\"byteOffset\":" + std::to_string(vertexBytes) + ",\"byteLength\":" +
+                    std::to_string(indexBytes) + ",\"target\":34963}],";
+            const std::string vertices = std::to_string(vertexCount);
+            json += "\"accessors\":[{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":" + vertices +
+                    ",\"type\":\"VEC3\",\"min\":" + vec3Text(boundsMin) + ",\"max\":" + vec3Text(boundsMax) + "},";
+            json += "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":" + vertices +
+                    ",\"type\":\"VEC3\"},";
+            json += "{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5121,\"normalized\":true,\"count\":" +
+                    vertices + ",\"type\":\"VEC4\"},";
+            json += "{\"bufferView\":1,\"byteOffset\":0,\"componentType\":5125,\"count\":" +
+                    std::to_string(triangleCount * 3) + ",\"type\":\"SCALAR\"}]}\n";
+        }
+
+        OutputFile document;
+        ok = document.open(path);
+        document.write(json.data(), json.size());
+        ok = document.close() && ok;
+        stats.bytes += json.size();
+    }
+    stats.writingMs += elapsedSince(phase);
+
+    if (!ok) {
+        std::cerr << "Erro ao gravar exportação: " << path << std::endl;
+        return false;
+    }
+
+    stats.vertices = vertexCount;
+    stats.triangles = triangleCount;
+    stats.elapsedMs = elapsedSince(start);
+    return true;
+}
+
+} // namespace VoxelMaker
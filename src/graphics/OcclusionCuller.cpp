@@ -0,0 +1,440 @@
+#include "graphics/OcclusionCuller.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOXELMAKER_OCCLUSION_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace VoxelMaker {
+
+namespace {
+
+constexpr float MIN_CLIP_W = 1e-5f;
+
+/**
+ * @brief Retângulo em um plano de corte do chunk
+ */
+struct PlaneRect {
+    int plane = 0;
+    int u0 = 0, v0 = 0;
+    int du = 0, dv = 0;
+    int area() const { return du * dv; }
+};
+
+/**
+ * @brief Maior retângulo encontrado por varredura gulosa de uma máscara S x S
+ */
+PlaneRect largestRect(std::vector<uint8_t>& mask) {
+    const int size = VoxelChunk::SIZE;
+    PlaneRect best;
+
+    for (int v = 0; v < size; v++) {
+        for (int u = 0; u < size; u++) {
+            if (!mask[u + v * size]) continue;
+
+            int du = 1;
+            while (u + du < size && mask[u + du + v * size]) {
+                du++;
+            }
+
+            int dv = 1;
+            bool rowFull = true;
+            while (v + dv < size && rowFull) {
+                for (int k = 0; k < du; k++) {
+                    if (!mask[u + k + (v + dv) * size]) {
+                        rowFull = false;
+                        break;
+                    }
+                }
+                if (rowFull) {
+                    dv++;
+                }
+            }
+
+            // Consome o retângulo para que a varredura siga adiante
+            for (int j = 0; j < dv; j++) {
+                for (int k = 0; k < du; k++) {
+                    mask[u + k + (v + j) * size] = 0;
+                }
+            }
+
+            if (du * dv > best.area()) {
+                best.u0 = u;
+                best.v0 = v;
+                best.du = du;
+                best.dv = dv;
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller()
+    : OcclusionCuller(Settings()) {
+}
+
+OcclusionCuller::OcclusionCuller(const Settings& settings)
+    : settings(settings)
+    , viewProjection(1.0f)
+    , levels()
+    , levelWidths()
+    , levelHeights()
+    , occluderCache()
+    , stats() {
+    allocateLevels();
+}
+
+void OcclusionCuller::setSettings(const Settings& newSettings) {
+    settings = newSettings;
+    allocateLevels();
+}
+
+void OcclusionCuller::allocateLevels() {
+    // Largura múltipla de 4 para o laço SIMD nunca sair da linha
+    int width = std::max(4, (settings.width + 3) & ~3);
+    int height = std::max(1, settings.height);
+
+    levels.clear();
+    levelWidths.clear();
+    levelHeights.clear();
+
+    while (true) {
+        levels.emplace_back(static_cast<size_t>(width) * height, 1.0f);
+        levelWidths.push_back(width);
+        levelHeights.push_back(height);
+        if (width == 1 && height == 1) {
+            break;
+        }
+        width = std::max(1, (width + 1) / 2);
+        height = std::max(1, (height + 1) / 2);
+    }
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjectionMatrix) {
+    viewProjection = viewProjectionMatrix;
+    std::fill(levels[0].begin(), levels[0].end(), 1.0f);
+}
+
+bool OcclusionCuller::rasterizeOccluder(const Occluder& occluder, const glm::vec3& offset) {
+    const float width = static_cast<float>(levelWidths[0]);
+    const float height = static_cast<float>(levelHeights[0]);
+
+    glm::vec2 screen[4];
+    float maxDepth = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        glm::vec4 clip = viewProjection * glm::vec4(occluder.corners[i] + offset, 1.0f);
+
+        // Quads que cruzam o plano próximo são ignorados (ignorar um oclusor é seguro)
+        if (clip.w < MIN_CLIP_W || clip.z < -clip.w) {
+            return false;
+        }
+
+        float invW = 1.0f / clip.w;
+        screen[i] = glm::vec2((clip.x * invW * 0.5f + 0.5f) * width,
+                              (clip.y * invW * 0.5f + 0.5f) * height);
+        maxDepth = std::max(maxDepth, clip.z * invW * 0.5f + 0.5f);
+    }
+
+    if (maxDepth > 1.0f) {
+        return false;
+    }
+
+    rasterizeQuad(screen, maxDepth);
+    return true;
+}
+
+void OcclusionCuller::rasterizeQuad(const glm::vec2 (&corners)[4], float depth) {
+    const int width = levelWidths[0];
+    const int height = levelHeights[0];
+
+    // A projeção de um retângulo à frente da câmera é um quadrilátero convexo; rasterizá-lo
+    // inteiro (e não como dois triângulos) evita a fresta que o recuo de meio pixel de cada
+    // triângulo deixaria na diagonal
+    float area = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        const glm::vec2& p = corners[i];
+        const glm::vec2& q = corners[(i + 1) % 4];
+        area += p.x * q.y - q.x * p.y;
+    }
+    if (std::fabs(area) < 1e-6f) {
+        return;
+    }
+
+    // Orienta de modo que o interior tenha funções de aresta positivas
+    glm::vec2 v[4] = {corners[0], corners[1], corners[2], corners[3]};
+    if (area < 0.0f) {
+        std::swap(v[1], v[3]);
+    }
+
+    float minX = std::min({v[0].x, v[1].x, v[2].x, v[3].x});
+    float maxX = std::max({v[0].x, v[1].x, v[2].x, v[3].x});
+    float minY = std::min({v[0].y, v[1].y, v[2].y, v[3].y});
+    float maxY = std::max({v[0].y, v[1].y, v[2].y, v[3].y});
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    int x1 = std::min(width - 1, static_cast<int>(std::ceil(maxX)) - 1);
+    int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    int y1 = std::min(height - 1, static_cast<int>(std::ceil(maxY)) - 1);
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    // E(x, y) = A*x + B*y + C, avaliada no centro do pixel e recuada meio pixel em cada
+    // eixo: só pixels inteiramente cobertos passam (rasterização conservadora interna)
+    float edgeA[4], edgeB[4], edgeC[4];
+    for (int e = 0; e < 4; e++) {
+        const glm::vec2& from = v[e];
+        const glm::vec2& to = v[(e + 1) % 4];
+        edgeA[e] = -(to.y - from.y);
+        edgeB[e] = to.x - from.x;
+        edgeC[e] = -edgeA[e] * from.x - edgeB[e] * from.y
+                   - 0.5f * (std::fabs(edgeA[e]) + std::fabs(edgeB[e]));
+    }
+
+    std::vector<float>& buffer = levels[0];
+    int startX = x0 & ~3;
+
+    for (int y = y0; y <= y1; y++) {
+        float* row = buffer.data() + static_cast<size_t>(y) * width;
+        float py = static_cast<float>(y) + 0.5f;
+        float rowBase[4];
+        for (int e = 0; e < 4; e++) {
+            rowBase[e] = edgeB[e] * py + edgeC[e];
+        }
+
+#if VOXELMAKER_OCCLUSION_SSE
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 depthValue = _mm_set1_ps(depth);
+        const __m128 zero = _mm_setzero_ps();
+        for (int x = startX; x <= x1; x += 4) {
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+            __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[0]), px), _mm_set1_ps(rowBase[0])), zero);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[1]), px), _mm_set1_ps(rowBase[1])), zero));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[2]), px), _mm_set1_ps(rowBase[2])), zero));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[3]), px), _mm_set1_ps(rowBase[3])), zero));
+            if (_mm_movemask_ps(inside) == 0) continue;
+
+            __m128 current = _mm_loadu_ps(row + x);
+            __m128 nearer = _mm_min_ps(current, depthValue);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+        }
+#else
+        for (int x = startX; x <= x1; x++) {
+            float px = static_cast<float>(x) + 0.5f;
+            if (edgeA[0] * px + rowBase[0] >= 0.0f &&
+                edgeA[1] * px + rowBase[1] >= 0.0f &&
+                edgeA[2] * px + rowBase[2] >= 0.0f &&
+                edgeA[3] * px + rowBase[3] >= 0.0f) {
+                row[x] = std::min(row[x], depth);
+            }
+        }
+#endif
+    }
+}
+
+void OcclusionCuller::buildHierarchy() {
+    for (size_t level = 1; level < levels.size(); level++) {
+        const std::vector<float>& source = levels[level - 1];
+        std::vector<float>& target = levels[level];
+        int sourceWidth = levelWidths[level - 1];
+        int sourceHeight = levelHeights[level - 1];
+        int targetWidth = levelWidths[level];
+        int targetHeight = levelHeights[level];
+
+        // Cada texel guarda a profundidade mais distante dos 4 filhos
+        for (int y = 0; y < targetHeight; y++) {
+            int sy0 = std::min(y * 2, sourceHeight - 1);
+            int sy1 = std::min(y * 2 + 1, sourceHeight - 1);
+            for (int x = 0; x < targetWidth; x++) {
+                int sx0 = std::min(x * 2, sourceWidth - 1);
+                int sx1 = std::min(x * 2 + 1, sourceWidth - 1);
+                target[x + y * targetWidth] = std::max(
+                    std::max(source[sx0 + sy0 * sourceWidth], source[sx1 + sy0 * sourceWidth]),
+                    std::max(source[sx0 + sy1 * sourceWidth], source[sx1 + sy1 * sourceWidth]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::testBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const {
+    const int width = levelWidths[0];
+    const int height = levelHeights[0];
+
+    glm::vec2 screenMin(1e30f), screenMax(-1e30f);
+    float minDepth = 1.0f;
+    for (int i = 0; i < 8; i++) {
+        glm::vec3 corner((i & 1) ? boxMax.x : boxMin.x,
+                         (i & 2) ? boxMax.y : boxMin.y,
+                         (i & 4) ? boxMax.z : boxMin.z);
+        glm::vec4 clip = viewProjection * glm::vec4(corner, 1.0f);
+
+        // Caixa cruzando o plano próximo: considerada visível
+        if (clip.w < MIN_CLIP_W || clip.z < -clip.w) {
+            return true;
+        }
+
+        float invW = 1.0f / clip.w;
+        glm::vec2 screen((clip.x * invW * 0.5f + 0.5f) * width,
+                         (clip.y * invW * 0.5f + 0.5f) * height);
+        screenMin = glm::min(screenMin, screen);
+        screenMax = glm::max(screenMax, screen);
+        minDepth = std::min(minDepth, clip.z * invW * 0.5f + 0.5f);
+    }
+
+    // Fora da tela é responsabilidade do descarte por frustum
+    if (screenMax.x < 0.0f || screenMax.y < 0.0f ||
+        screenMin.x >= static_cast<float>(width) || screenMin.y >= static_cast<float>(height)) {
+        return true;
+    }
+
+    int x0 = std::max(0, static_cast<int>(std::floor(screenMin.x)));
+    int x1 = std::min(width - 1, static_cast<int>(std::floor(screenMax.x)));
+    int y0 = std::max(0, static_cast<int>(std::floor(screenMin.y)));
+    int y1 = std::min(height - 1, static_cast<int>(std::floor(screenMax.y)));
+
+    // Nível em que a caixa cobre no máximo 4x4 texels
+    size_t level = 0;
+    while (level + 1 < levels.size() &&
+           ((x1 >> level) - (x0 >> level) > 3 || (y1 >> level) - (y0 >> level) > 3)) {
+        level++;
+    }
+
+    const std::vector<float>& depth = levels[level];
+    int levelWidth = levelWidths[level];
+    for (int y = y0 >> level; y <= (y1 >> level); y++) {
+        for (int x = x0 >> level; x <= (x1 >> level); x++) {
+            if (depth[x + y * levelWidth] >= minDepth) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void OcclusionCuller::cullChunks(const VoxelGrid& grid,
+                                 const glm::mat4& viewProjectionMatrix,
+                                 std::vector<FrustumCuller::VisibleChunk>& chunks) {
+    auto start = std::chrono::steady_clock::now();
+
+    beginFrame(viewProjectionMatrix);
+
+    // Oclusores dos chunks mais próximos (a lista chega ordenada da frente para trás)
+    glm::vec3 gridOrigin(grid.getOrigin());
+    size_t occluderChunks = std::min(settings.maxOccluderChunks, chunks.size());
+    stats.occludersRasterized = 0;
+    for (size_t i = 0; i < occluderChunks; i++) {
+        const VoxelChunk* chunk = grid.getChunk(chunks[i].coord);
+        if (!chunk) continue;
+
+        auto inserted = occluderCache.emplace(chunks[i].coord, CachedOccluders());
+        CachedOccluders& cached = inserted.first->second;
+        if (inserted.second || cached.revision != chunk->getRevision()) {
+            extractOccluders(*chunk, grid.getPalette(), settings.minOccluderArea, cached.occluders);
+            cached.revision = chunk->getRevision();
+        }
+
+        glm::vec3 offset = gridOrigin + glm::vec3(chunk->getOrigin());
+        for (const auto& occluder : cached.occluders) {
+            if (rasterizeOccluder(occluder, offset)) {
+                stats.occludersRasterized++;
+            }
+        }
+    }
+
+    buildHierarchy();
+
+    size_t tested = chunks.size();
+    chunks.erase(std::remove_if(chunks.begin(), chunks.end(),
+                                [this](const FrustumCuller::VisibleChunk& chunk) {
+                                    return !testBox(chunk.mesh->boundsMin, chunk.mesh->boundsMax);
+                                }),
+                 chunks.end());
+
+    stats.chunksTested = tested;
+    stats.chunksCulled = tested - chunks.size();
+
+    // Chunks removidos do grid deixam entradas órfãs; recalcular é barato
+    if (occluderCache.size() > 2 * grid.getChunks().size() + settings.maxOccluderChunks) {
+        occluderCache.clear();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    stats.lastCullMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void OcclusionCuller::extractOccluders(const VoxelChunk& chunk,
+                                       const VoxelPalette& palette,
+                                       int minArea,
+                                       std::vector<Occluder>& out) {
+    out.clear();
+
+    const int size = VoxelChunk::SIZE;
+    const VoxelChunk::Cell* cells = chunk.getCells();
+    std::vector<uint8_t> mask(VoxelChunk::AREA);
+
+    for (int axis = 0; axis < 3; axis++) {
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+
+        PlaneRect lowest, highest;
+        for (int plane = 0; plane <= size; plane++) {
+            int count = 0;
+            glm::ivec3 p;
+            for (p[v] = 0; p[v] < size; p[v]++) {
+                for (p[u] = 0; p[u] < size; p[u]++) {
+                    // O plano é opaco onde algum dos voxels adjacentes é sólido (entradas inativas da
+                    // paleta não geram faces no ChunkMesher, logo não ocluem)
+                    bool solid = false;
+                    if (plane > 0) {
+                        p[axis] = plane - 1;
+                        solid = palette.isSolid(cells[VoxelChunk::index(p.x, p.y, p.z)]);
+                    }
+                    if (!solid && plane < size) {
+                        p[axis] = plane;
+                        solid = palette.isSolid(cells[VoxelChunk::index(p.x, p.y, p.z)]);
+                    }
+                    mask[p[u] + p[v] * size] = solid ? 1 : 0;
+                    count += solid ? 1 : 0;
+                }
+            }
+            if (count < minArea) continue;
+
+            PlaneRect rect = largestRect(mask);
+            rect.plane = plane;
+            if (rect.area() < minArea) continue;
+
+            // Primeiro e último plano com a maior área
+            if (rect.area() > lowest.area()) {
+                lowest = rect;
+            }
+            if (rect.area() >= highest.area()) {
+                highest = rect;
+            }
+        }
+
+        auto emit = [&](const PlaneRect& rect) {
+            Occluder occluder;
+            for (int corner = 0; corner < 4; corner++) {
+                glm::vec3 position(0.0f);
+                position[axis] = static_cast<float>(rect.plane);
+                position[u] = static_cast<float>(rect.u0 + ((corner == 1 || corner == 2) ? rect.du : 0));
+                position[v] = static_cast<float>(rect.v0 + ((corner >= 2) ? rect.dv : 0));
+                occluder.corners[corner] = position;
+            }
+            out.push_back(occluder);
+        };
+
+        if (lowest.area() > 0) {
+            emit(lowest);
+            if (highest.plane != lowest.plane) {
+                emit(highest);
+            }
+        }
+    }
+}
+
+} // namespace VoxelMaker
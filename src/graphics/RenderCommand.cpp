@@ -0,0 +1,64 @@
+#include "graphics/RenderCommand.hpp"
+#include <algorithm>
+
+namespace VoxelMaker {
+
+RenderCommandList::RenderCommandList()
+    : frameState()
+    , commands()
+    , sorted(true) {
+}
+
+void RenderCommandList::clear() {
+    commands.clear();
+    sorted = true;
+}
+
+void RenderCommandList::push(const RenderCommand& command) {
+    if (!commands.empty() && command.sortKey < commands.back().sortKey) {
+        sorted = false;
+    }
+    commands.push_back(command);
+}
+
+void RenderCommandList::sort() {
+    if (sorted) {
+        return;
+    }
+
+    std::stable_sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+        return a.sortKey < b.sortKey;
+    });
+    sorted = true;
+}
+
+size_t RenderCommandList::countStateChanges() const {
+    size_t changes = 0;
+    uint64_t current = ~static_cast<uint64_t>(0);
+    for (const auto& command : commands) {
+        // Shader e material ocupam os bits 36..59
+        uint64_t state = (command.sortKey >> 36) & 0xFFFFFFu;
+        if (state != current) {
+            changes++;
+            current = state;
+        }
+    }
+    return changes;
+}
+
+uint64_t RenderCommandList::makeSortKey(uint8_t layer, uint8_t shader, uint16_t material,
+                                        float depth, bool backToFront) {
+    const uint32_t maxDepth = (1u << DEPTH_BITS) - 1;
+    float clamped = std::min(std::max(depth, 0.0f), 1.0f);
+    uint32_t quantized = static_cast<uint32_t>(clamped * static_cast<float>(maxDepth));
+    if (backToFront) {
+        quantized = maxDepth - quantized;
+    }
+
+    return (static_cast<uint64_t>(layer & 0xF) << 60) |
+           (static_cast<uint64_t>(shader) << 52) |
+           (static_cast<uint64_t>(material) << 36) |
+           (static_cast<uint64_t>(quantized) << 12);
+}
+
+} // namespace VoxelMaker
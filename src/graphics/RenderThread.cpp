@@ -0,0 +1,139 @@
+#include "graphics/RenderThread.hpp"
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+namespace VoxelMaker {
+
+RenderThread::RenderThread()
+    : thread()
+    , mutex()
+    , condition()
+    , pending()
+    , executing()
+    , hasPending(false)
+    , busy(false)
+    , stopping(false)
+    , running(false)
+    , stats() {
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+bool RenderThread::start(ContextFunction onStart, ExecuteFunction execute, ContextFunction onStop) {
+    if (running) {
+        return true;
+    }
+    if (!execute) {
+        std::cerr << "RenderThread: função de execução não definida" << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        hasPending = false;
+        busy = false;
+        stopping = false;
+        stats = Stats();
+    }
+
+    thread = std::thread(&RenderThread::renderLoop, this, std::move(onStart), std::move(execute), std::move(onStop));
+    running = true;
+    return true;
+}
+
+void RenderThread::submit(RenderCommandList& list) {
+    if (!running) {
+        list.clear();
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        // Só espera se o quadro anterior ainda não foi retirado da vaga pendente
+        condition.wait(lock, [this]() { return !hasPending; });
+        std::swap(pending, list);
+        hasPending = true;
+        stats.framesSubmitted++;
+        stats.lastSubmitWaitMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+    condition.notify_all();
+    list.clear();
+}
+
+void RenderThread::waitIdle() {
+    if (!running) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this]() { return !hasPending && !busy; });
+}
+
+void RenderThread::stop() {
+    if (!running) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+    running = false;
+}
+
+RenderThread::Stats RenderThread::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void RenderThread::renderLoop(ContextFunction onStart, ExecuteFunction execute, ContextFunction onStop) {
+    if (onStart) {
+        onStart();
+    }
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return hasPending || stopping; });
+            if (!hasPending) {
+                break;
+            }
+
+            // Libera a vaga pendente antes de executar para a thread principal seguir gravando
+            std::swap(executing, pending);
+            hasPending = false;
+            busy = true;
+        }
+        condition.notify_all();
+
+        auto start = std::chrono::steady_clock::now();
+        execute(executing);
+        double elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        executing.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+            stats.framesExecuted++;
+            stats.lastExecuteMs = elapsed;
+        }
+        condition.notify_all();
+    }
+
+    if (onStop) {
+        onStop();
+    }
+}
+
+} // namespace VoxelMaker
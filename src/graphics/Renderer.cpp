@@ -1,17 +1,226 @@
 #include "graphics/Renderer.hpp"
 #include <iostream>
+#include <vector>
+
+#ifdef VOXELMAKER_HAS_GLAD
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#endif
 
 namespace VoxelMaker {
 
+namespace {
+
+const glm::vec3 LIGHT_DIRECTION(-0.4f, -1.0f, -0.3f);
+
+constexpr unsigned int FRAME_UNIFORM_BINDING = 0;
+constexpr UniformId U_PALETTE("uPalette");
+
+constexpr int GRID_HALF_LINES = 64;         ///< Linhas do grid de referência de cada lado da origem
+constexpr int GRID_VERTEX_COUNT = (2 * GRID_HALF_LINES + 1) * 4;
+constexpr float AXES_LENGTH = 16.0f;        ///< Comprimento dos eixos em voxels
+constexpr int AXES_VERTEX_COUNT = 6;
+
+/**
+ * @brief Bloco FrameData dos shaders (layout std140), enviado uma vez por quadro
+ */
+struct FrameUniforms {
+    glm::mat4 viewProjection;
+    glm::vec4 cameraPosition;
+    glm::vec4 lightDirection;
+    glm::vec4 gridOrigin;
+    int32_t flags[4];           ///< [0] = iluminação
+};
+
+static_assert(sizeof(FrameUniforms) == 128, "FrameUniforms deve seguir o layout std140");
+
+/**
+ * @brief Malhas por chunk: layout de Mesh::Vertex (posição, normal, cor RGBA8 e AO)
+ * já no espaço mundial
+ */
+const char* CHUNK_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in float aAo;
+
+layout(std140) uniform FrameData {
+    mat4 uViewProjection;
+    vec4 uCameraPosition;
+    vec4 uLightDirection;
+    vec4 uGridOrigin;
+    ivec4 uFlags;
+};
+
+out vec3 vNormal;
+out vec4 vColor;
+out float vAo;
+
+void main() {
+    vNormal = aNormal;
+    vColor = aColor;
+    vAo = aAo;
+    gl_Position = uViewProjection * vec4(aPosition, 1.0);
+}
+)";
+
+const char* CHUNK_FRAGMENT_SHADER = R"(#version 330 core
+in vec3 vNormal;
+in vec4 vColor;
+in float vAo;
+
+layout(std140) uniform FrameData {
+    mat4 uViewProjection;
+    vec4 uCameraPosition;
+    vec4 uLightDirection;
+    vec4 uGridOrigin;
+    ivec4 uFlags;
+};
+
+out vec4 fragColor;
+
+void main() {
+    float diffuse = uFlags.x != 0 ? max(dot(normalize(vNormal), -uLightDirection.xyz), 0.0) : 1.0;
+    float light = (0.35 + 0.65 * diffuse) * mix(0.4, 1.0, vAo);
+    fragColor = vec4(vColor.rgb * light, vColor.a);
+}
+)";
+
+/**
+ * @brief Cubo compartilhado pelas instâncias: cada voxel desloca o cubo unitário
+ * pela posição compactada e busca a cor na paleta (texture buffer)
+ */
+const char* INSTANCE_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in uvec4 aInstance;
+
+layout(std140) uniform FrameData {
+    mat4 uViewProjection;
+    vec4 uCameraPosition;
+    vec4 uLightDirection;
+    vec4 uGridOrigin;
+    ivec4 uFlags;
+};
+
+uniform samplerBuffer uPalette;
+
+out vec3 vNormal;
+out vec4 vColor;
+
+void main() {
+    vec3 world = uGridOrigin.xyz + vec3(aInstance.xyz) + aPosition;
+    vNormal = aNormal;
+    vColor = texelFetch(uPalette, int(aInstance.w));
+    gl_Position = uViewProjection * vec4(world, 1.0);
+}
+)";
+
+const char* INSTANCE_FRAGMENT_SHADER = R"(#version 330 core
+in vec3 vNormal;
+in vec4 vColor;
+
+layout(std140) uniform FrameData {
+    mat4 uViewProjection;
+    vec4 uCameraPosition;
+    vec4 uLightDirection;
+    vec4 uGridOrigin;
+    ivec4 uFlags;
+};
+
+out vec4 fragColor;
+
+void main() {
+    float diffuse = uFlags.x != 0 ? max(dot(normalize(vNormal), -uLightDirection.xyz), 0.0) : 1.0;
+    fragColor = vec4(vColor.rgb * (0.35 + 0.65 * diffuse), vColor.a);
+}
+)";
+
+/**
+ * @brief Linhas do grid de referência e dos eixos: posição e cor por vértice
+ */
+const char* LINE_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec3 aColor;
+
+layout(std140) uniform FrameData {
+    mat4 uViewProjection;
+    vec4 uCameraPosition;
+    vec4 uLightDirection;
+    vec4 uGridOrigin;
+    ivec4 uFlags;
+};
+
+out vec3 vColor;
+
+void main() {
+    vColor = aColor;
+    gl_Position = uViewProjection * vec4(aPosition, 1.0);
+}
+)";
+
+const char* LINE_FRAGMENT_SHADER = R"(#version 330 core
+in vec3 vColor;
+
+out vec4 fragColor;
+
+void main() {
+    fragColor = vec4(vColor, 1.0);
+}
+)";
+
+#ifdef VOXELMAKER_HAS_GLAD
+/**
+ * @brief Cria um VAO de linhas com atributos posição (0) e cor (1), 6 floats por vértice
+ * @param vertices Dados intercalados
+ * @param vao Saída
+ * @param vbo Saída
+ */
+void createLineArray(const std::vector<float>& vertices, unsigned int& vao, unsigned int& vbo) {
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+#endif
+
+} // namespace
+
 Renderer::Renderer()
     : camera(nullptr)
     , voxelShader(nullptr)
     , gridShader(nullptr)
     , axesShader(nullptr)
+    , instanceShader(nullptr)
     , settings()
+    , meshManager()
+    , frustumCuller()
+    , occlusionCuller()
+    , visibleChunks()
+    , instanceBuffer()
+    , submittedVersions()
+    , instanceVersion(0)
+    , immediateList()
+    , recordStats()
+    , uploadManager()
+    , frameUniforms()
+    , gpuMeshes()
+    , gpuInstanceCount(0)
+    , executeStatsMutex()
+    , executeStats()
     , voxelVAO(0), voxelVBO(0), voxelEBO(0)
     , gridVAO(0), gridVBO(0)
     , axesVAO(0), axesVBO(0)
+    , instanceVBO(0)
+    , paletteBuffer(0), paletteTexture(0)
     , initialized(false) {
 }
 
@@ -24,24 +233,327 @@ bool Renderer::initialize() {
         return true;
     }
 
+#ifdef VOXELMAKER_HAS_GLAD
+    // Requer um contexto OpenGL 3.3 core já ativo (Window::initialize)
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+        std::cerr << "Erro ao inicializar GLAD" << std::endl;
+        return false;
+    }
+
+    if (!initializeShaders() || !initializeBuffers()) {
+        return false;
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    std::cout << "Renderer inicializado (OpenGL " << glGetString(GL_VERSION) << ")" << std::endl;
+#else
     // TODO: Inicializar GLAD quando disponível
     // Por enquanto, apenas marcar como inicializado
     std::cout << "Renderer inicializado (modo simplificado)" << std::endl;
+#endif
+
+    if (!uploadManager.initialize() || !frameUniforms.initialize(sizeof(FrameUniforms), FRAME_UNIFORM_BINDING)) {
+        return false;
+    }
     
     initialized = true;
     return true;
 }
 
 void Renderer::cleanup() {
+#ifdef VOXELMAKER_HAS_GLAD
+    if (initialized) {
+        glDeleteVertexArrays(1, &voxelVAO);
+        glDeleteBuffers(1, &voxelVBO);
+        glDeleteBuffers(1, &voxelEBO);
+        glDeleteBuffers(1, &instanceVBO);
+        glDeleteBuffers(1, &paletteBuffer);
+        glDeleteTextures(1, &paletteTexture);
+        glDeleteVertexArrays(1, &gridVAO);
+        glDeleteBuffers(1, &gridVBO);
+        glDeleteVertexArrays(1, &axesVAO);
+        glDeleteBuffers(1, &axesVBO);
+        voxelVAO = voxelVBO = voxelEBO = 0;
+        instanceVBO = paletteBuffer = paletteTexture = 0;
+        gridVAO = gridVBO = axesVAO = axesVBO = 0;
+    }
+#else
     // TODO: Limpar recursos OpenGL quando GLAD estiver disponível
+#endif
+    uploadManager.cleanup();
+    frameUniforms.cleanup();
+    gpuMeshes.clear();
+    gpuInstanceCount = 0;
+    submittedVersions.clear();
+    meshManager.clear();
+    instanceBuffer.clear();
     initialized = false;
 }
 
-void Renderer::renderVoxelGrid(const VoxelGrid& grid) {
+void Renderer::beginFrame(RenderCommandList& list) {
+    list.clear();
+
+    RenderCommandList::FrameState frame;
+    if (camera) {
+        frame.viewProjection = camera->getViewProjectionMatrix();
+        frame.cameraPosition = camera->getPosition();
+        frame.farPlane = camera->getFarPlane();
+    }
+    frame.lighting = settings.enableLighting;
+    frame.wireframe = settings.wireframeMode;
+    list.setFrameState(frame);
+}
+
+void Renderer::recordVoxelGrid(const VoxelGrid& grid, RenderCommandList& list) {
     if (!initialized) return;
     
+    // Refazer apenas as malhas dos chunks alterados desde o último quadro
+    if (camera) {
+        meshManager.update(grid, *camera);
+    } else {
+        meshManager.update(grid);
+    }
+
+    // Descartar chunks fora do campo de visão e escondidos atrás de chunks próximos
+    visibleChunks.clear();
+    if (camera) {
+        glm::mat4 viewProjection = camera->getViewProjectionMatrix();
+        frustumCuller.setViewProjection(viewProjection);
+        frustumCuller.cullChunks(meshManager.getMeshes(), camera->getPosition(), visibleChunks);
+        occlusionCuller.cullChunks(grid, viewProjection, visibleChunks);
+    }
+
+    const auto& meshes = meshManager.getMeshes();
+
+    // Liberar as cópias na GPU de chunks que não existem mais ou cuja malha ficou vazia
+    // (o FrustumCuller descarta malhas vazias, então elas nunca chegariam a um DRAW_CHUNK)
+    for (auto it = submittedVersions.begin(); it != submittedVersions.end();) {
+        auto mesh = meshes.find(it->first);
+        if (mesh == meshes.end() || mesh->second.mesh->isEmpty()) {
+            RenderCommand command;
+            command.sortKey = RenderCommandList::makeSortKey(RenderCommandList::LAYER_SETUP,
+                                                             RenderCommandList::SHADER_NONE, 0, 0.0f);
+            command.type = RenderCommandType::RELEASE_CHUNK;
+            command.chunkCoord = it->first;
+            list.push(command);
+            it = submittedVersions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Um comando por chunk visível; a malha (compartilhada, sem cópia) só segue no comando
+    // se mudou desde o último envio e ainda couber no orçamento do quadro
+    recordStats = RecordStats();
+    float farPlane = list.getFrameState().farPlane;
+    for (const auto& visible : visibleChunks) {
+        RenderCommand command;
+        command.sortKey = RenderCommandList::makeSortKey(RenderCommandList::LAYER_OPAQUE,
+                                                         RenderCommandList::SHADER_CHUNK, 0,
+                                                         visible.distance / farPlane);
+        command.type = RenderCommandType::DRAW_CHUNK;
+        command.chunkCoord = visible.coord;
+        command.version = visible.mesh->version;
+
+        auto sent = submittedVersions.find(visible.coord);
+        if (sent == submittedVersions.end() || sent->second != visible.mesh->version) {
+            const Mesh& mesh = *visible.mesh->mesh;
+            size_t bytes = mesh.getVertexCount() * sizeof(Mesh::Vertex) + mesh.getIndexCount() * sizeof(uint32_t);
+            // Pelo menos uma malha por quadro, para que o envio nunca pare
+            if (settings.uploadBudget > 0 && recordStats.uploadsQueued > 0 &&
+                recordStats.bytesQueued + bytes > settings.uploadBudget) {
+                recordStats.uploadsDeferred++;
+            } else {
+                command.mesh = visible.mesh->mesh;
+                submittedVersions[visible.coord] = visible.mesh->version;
+                recordStats.uploadsQueued++;
+                recordStats.bytesQueued += bytes;
+            }
+        }
+        list.push(command);
+        recordStats.chunksRecorded++;
+    }
+}
+
+void Renderer::recordVoxelGridInstanced(const VoxelGrid& grid, RenderCommandList& list) {
+    if (!initialized) return;
+
+    RenderCommand command;
+    command.sortKey = RenderCommandList::makeSortKey(RenderCommandList::LAYER_OPAQUE,
+                                                     RenderCommandList::SHADER_INSTANCED, 0, 0.0f);
+    command.type = RenderCommandType::DRAW_INSTANCED;
+
+    // Remonta (em paralelo) só quando o grid muda; só então os dados seguem no comando
+    if (instanceBuffer.update(grid)) {
+        auto data = std::make_shared<InstanceUpload>();
+        data->instances = instanceBuffer.getInstances();
+        data->paletteColors = instanceBuffer.getPaletteColors();
+        command.instances = data;
+        instanceVersion++;
+    }
+    command.version = instanceVersion;
+
+    RenderCommandList::FrameState frame = list.getFrameState();
+    frame.gridOrigin = glm::vec3(grid.getOrigin());
+    list.setFrameState(frame);
+    list.push(command);
+}
+
+void Renderer::recordGrid(RenderCommandList& list) {
+    if (!initialized || !settings.showGrid) return;
+
+    // Depois dos eixos: as linhas centrais do grid coincidem com eles e perdem o teste de profundidade
+    RenderCommand command;
+    command.sortKey = RenderCommandList::makeSortKey(RenderCommandList::LAYER_OVERLAY,
+                                                     RenderCommandList::SHADER_LINES, 1, 0.0f);
+    command.type = RenderCommandType::DRAW_GRID;
+    list.push(command);
+}
+
+void Renderer::recordAxes(RenderCommandList& list) {
+    if (!initialized || !settings.showAxes) return;
+
+    RenderCommand command;
+    command.sortKey = RenderCommandList::makeSortKey(RenderCommandList::LAYER_OVERLAY,
+                                                     RenderCommandList::SHADER_LINES, 0, 0.0f);
+    command.type = RenderCommandType::DRAW_AXES;
+    list.push(command);
+}
+
+void Renderer::execute(RenderCommandList& list) {
+    if (!initialized) return;
+
+    list.sort();
+    const auto& frame = list.getFrameState();
+
+    ExecuteStats frameStats;
+    frameStats.commandCount = list.size();
+    frameStats.stateChanges = list.countStateChanges();
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glClearColor(frame.clearColor.x, frame.clearColor.y, frame.clearColor.z, frame.clearColor.w);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glPolygonMode(GL_FRONT_AND_BACK, frame.wireframe ? GL_LINE : GL_FILL);
+#endif
+
+    // Câmera e iluminação seguem em um único envio; os desenhos não definem uniforms
+    FrameUniforms uniforms;
+    uniforms.viewProjection = frame.viewProjection;
+    uniforms.cameraPosition = glm::vec4(frame.cameraPosition, 1.0f);
+    uniforms.lightDirection = glm::vec4(glm::normalize(LIGHT_DIRECTION), 0.0f);
+    uniforms.gridOrigin = glm::vec4(frame.gridOrigin, 1.0f);
+    uniforms.flags[0] = frame.lighting ? 1 : 0;
+    uniforms.flags[1] = uniforms.flags[2] = uniforms.flags[3] = 0;
+    frameUniforms.update(uniforms);
+
+    uint8_t currentShader = RenderCommandList::SHADER_NONE;
+    for (const auto& command : list.getCommands()) {
+        // Comandos ordenados: cada shader é ativado uma única vez por quadro
+        uint8_t shader = RenderCommandList::shaderOf(command.sortKey);
+        if (shader != currentShader && shader != RenderCommandList::SHADER_NONE) {
+            bindShader(shader);
+            currentShader = shader;
+        }
+
+        switch (command.type) {
+            case RenderCommandType::RELEASE_CHUNK:
+                releaseChunkMesh(command.chunkCoord);
+                break;
+
+            case RenderCommandType::DRAW_CHUNK: {
+                GpuUploadManager::Allocation& allocation = gpuMeshes[command.chunkCoord];
+                if (command.mesh) {
+                    uploadManager.upload(*command.mesh, allocation);
+                    frameStats.bytesUploaded += command.mesh->getVertexCount() * sizeof(Mesh::Vertex) +
+                                                command.mesh->getIndexCount() * sizeof(uint32_t);
+                    frameStats.chunksUploaded++;
+                }
+                if (!allocation.isValid()) break;
+
+                uploadManager.draw(allocation);
+                frameStats.chunksDrawn++;
+                frameStats.trianglesDrawn += allocation.indexCount / 3;
+                break;
+            }
+
+            case RenderCommandType::DRAW_INSTANCED:
+                if (command.instances) {
+                    uploadInstances(*command.instances);
+                }
+                if (gpuInstanceCount == 0) break;
+
+#ifdef VOXELMAKER_HAS_GLAD
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_BUFFER, paletteTexture);
+                glBindVertexArray(voxelVAO);
+                glDrawElementsInstanced(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, nullptr,
+                                        static_cast<GLsizei>(gpuInstanceCount));
+#else
+                // TODO: Implementar renderização quando GLAD estiver disponível
+                std::cout << "Renderizando " << gpuInstanceCount
+                          << " voxels instanciados (1 chamada de desenho)" << std::endl;
+#endif
+                break;
+
+            case RenderCommandType::DRAW_GRID:
+#ifdef VOXELMAKER_HAS_GLAD
+                glBindVertexArray(gridVAO);
+                glDrawArrays(GL_LINES, 0, GRID_VERTEX_COUNT);
+#else
+                std::cout << "Renderizando grid de referência" << std::endl;
+#endif
+                break;
+
+            case RenderCommandType::DRAW_AXES:
+#ifdef VOXELMAKER_HAS_GLAD
+                glBindVertexArray(axesVAO);
+                glDrawArrays(GL_LINES, 0, AXES_VERTEX_COUNT);
+#else
+                std::cout << "Renderizando eixos de coordenadas" << std::endl;
+#endif
+                break;
+        }
+    }
+
+    // Protege as escritas deste quadro no anel de envio
+    uploadManager.endFrame();
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glBindVertexArray(0);
+    glUseProgram(0);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+#else
     // TODO: Implementar renderização quando GLAD estiver disponível
-    std::cout << "Renderizando grid com " << grid.getVoxelCount() << " voxels" << std::endl;
+    std::cout << "Executando " << frameStats.commandCount << " comandos ("
+              << frameStats.stateChanges << " trocas de estado, "
+              << frameStats.chunksDrawn << " chunks, "
+              << frameStats.trianglesDrawn << " triângulos, "
+              << frameStats.chunksUploaded << " malhas enviadas)" << std::endl;
+#endif
+
+    std::lock_guard<std::mutex> lock(executeStatsMutex);
+    executeStats = frameStats;
+}
+
+Renderer::ExecuteStats Renderer::getExecuteStats() const {
+    std::lock_guard<std::mutex> lock(executeStatsMutex);
+    return executeStats;
+}
+
+void Renderer::renderVoxelGrid(const VoxelGrid& grid) {
+    if (!initialized) return;
+
+    beginFrame(immediateList);
+    recordVoxelGrid(grid, immediateList);
+    execute(immediateList);
+}
+
+void Renderer::renderVoxelGridInstanced(const VoxelGrid& grid) {
+    if (!initialized) return;
+
+    beginFrame(immediateList);
+    recordVoxelGridInstanced(grid, immediateList);
+    execute(immediateList);
 }
 
 void Renderer::renderVoxel(const Voxel& voxel) {
@@ -54,38 +566,202 @@ void Renderer::renderVoxel(const Voxel& voxel) {
 
 void Renderer::renderGrid() {
     if (!initialized || !settings.showGrid) return;
-    
-    // TODO: Implementar renderização quando GLAD estiver disponível
-    std::cout << "Renderizando grid de referência" << std::endl;
+
+    beginFrame(immediateList);
+    recordGrid(immediateList);
+    execute(immediateList);
 }
 
 void Renderer::renderAxes() {
     if (!initialized || !settings.showAxes) return;
-    
-    // TODO: Implementar renderização quando GLAD estiver disponível
-    std::cout << "Renderizando eixos de coordenadas" << std::endl;
+
+    beginFrame(immediateList);
+    recordAxes(immediateList);
+    execute(immediateList);
 }
 
 bool Renderer::initializeShaders() {
-    // TODO: Implementar quando GLAD estiver disponível
+    voxelShader = std::make_shared<Shader>();
+    if (!voxelShader->compile(CHUNK_VERTEX_SHADER, CHUNK_FRAGMENT_SHADER)) {
+        std::cerr << "Erro ao compilar o shader de chunks" << std::endl;
+        return false;
+    }
+
+    instanceShader = std::make_shared<Shader>();
+    if (!instanceShader->compile(INSTANCE_VERTEX_SHADER, INSTANCE_FRAGMENT_SHADER)) {
+        std::cerr << "Erro ao compilar o shader de instâncias" << std::endl;
+        return false;
+    }
+
+    // Bloco do quadro e sampler fixos: definidos uma única vez por programa
+    voxelShader->bindUniformBlock("FrameData", FRAME_UNIFORM_BINDING);
+    instanceShader->bindUniformBlock("FrameData", FRAME_UNIFORM_BINDING);
+    instanceShader->use();
+    instanceShader->setInt(U_PALETTE, 0);
+    instanceShader->unbind();
+
+    // Grid e eixos são linhas com cor por vértice: um único programa (SHADER_LINES)
+    gridShader = std::make_shared<Shader>();
+    if (!gridShader->compile(LINE_VERTEX_SHADER, LINE_FRAGMENT_SHADER)) {
+        std::cerr << "Erro ao compilar o shader de linhas" << std::endl;
+        return false;
+    }
+    gridShader->bindUniformBlock("FrameData", FRAME_UNIFORM_BINDING);
+    axesShader = gridShader;
     return true;
 }
 
 bool Renderer::initializeBuffers() {
-    // TODO: Implementar quando GLAD estiver disponível
+    createCubeGeometry();
+    createGridGeometry();
+    createAxesGeometry();
     return true;
 }
 
 void Renderer::createCubeGeometry() {
+#ifdef VOXELMAKER_HAS_GLAD
+    // 4 vértices por face (posição + normal) para normais planas
+    const float vertices[] = {
+        // +X
+        1, 0, 0,  1, 0, 0,   1, 1, 0,  1, 0, 0,   1, 1, 1,  1, 0, 0,   1, 0, 1,  1, 0, 0,
+        // -X
+        0, 0, 1, -1, 0, 0,   0, 1, 1, -1, 0, 0,   0, 1, 0, -1, 0, 0,   0, 0, 0, -1, 0, 0,
+        // +Y
+        0, 1, 0,  0, 1, 0,   0, 1, 1,  0, 1, 0,   1, 1, 1,  0, 1, 0,   1, 1, 0,  0, 1, 0,
+        // -Y
+        0, 0, 0,  0,-1, 0,   1, 0, 0,  0,-1, 0,   1, 0, 1,  0,-1, 0,   0, 0, 1,  0,-1, 0,
+        // +Z
+        0, 0, 1,  0, 0, 1,   1, 0, 1,  0, 0, 1,   1, 1, 1,  0, 0, 1,   0, 1, 1,  0, 0, 1,
+        // -Z
+        1, 0, 0,  0, 0,-1,   0, 0, 0,  0, 0,-1,   0, 1, 0,  0, 0,-1,   1, 1, 0,  0, 0,-1,
+    };
+    unsigned short indices[36];
+    for (unsigned short face = 0; face < 6; face++) {
+        unsigned short base = static_cast<unsigned short>(face * 4);
+        const unsigned short quad[6] = {0, 1, 2, 0, 2, 3};
+        for (int i = 0; i < 6; i++) {
+            indices[face * 6 + i] = static_cast<unsigned short>(base + quad[i]);
+        }
+    }
+
+    glGenVertexArrays(1, &voxelVAO);
+    glGenBuffers(1, &voxelVBO);
+    glGenBuffers(1, &voxelEBO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(voxelVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, voxelVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, voxelEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    // Atributo por instância: x, y, z e índice da paleta como inteiros de 16 bits
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribIPointer(2, 4, GL_UNSIGNED_SHORT, sizeof(InstanceBuffer::Instance), nullptr);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glBindVertexArray(0);
+
+    glGenBuffers(1, &paletteBuffer);
+    glGenTextures(1, &paletteTexture);
+#else
     // TODO: Implementar quando GLAD estiver disponível
+#endif
 }
 
 void Renderer::createGridGeometry() {
-    // TODO: Implementar quando GLAD estiver disponível
+#ifdef VOXELMAKER_HAS_GLAD
+    // Plano y = 0, uma linha por voxel; a cada 8 linhas um tom mais claro
+    const float extent = GRID_HALF_LINES * settings.voxelSize;
+    std::vector<float> vertices;
+    vertices.reserve(GRID_VERTEX_COUNT * 6);
+    for (int i = -GRID_HALF_LINES; i <= GRID_HALF_LINES; i++) {
+        float offset = i * settings.voxelSize;
+        float shade = (i % 8 == 0) ? 0.55f : 0.35f;
+        const float lines[4][3] = {
+            {offset, 0.0f, -extent}, {offset, 0.0f, extent},
+            {-extent, 0.0f, offset}, {extent, 0.0f, offset},
+        };
+        for (const auto& point : lines) {
+            vertices.insert(vertices.end(), {point[0], point[1], point[2], shade, shade, shade});
+        }
+    }
+    createLineArray(vertices, gridVAO, gridVBO);
+#endif
 }
 
 void Renderer::createAxesGeometry() {
+#ifdef VOXELMAKER_HAS_GLAD
+    // X vermelho, Y verde, Z azul, a partir da origem
+    const float length = AXES_LENGTH * settings.voxelSize;
+    const std::vector<float> vertices = {
+        0.0f, 0.0f, 0.0f,     1.0f, 0.2f, 0.2f,   length, 0.0f, 0.0f,   1.0f, 0.2f, 0.2f,
+        0.0f, 0.0f, 0.0f,     0.2f, 1.0f, 0.2f,   0.0f, length, 0.0f,   0.2f, 1.0f, 0.2f,
+        0.0f, 0.0f, 0.0f,     0.2f, 0.4f, 1.0f,   0.0f, 0.0f, length,   0.2f, 0.4f, 1.0f,
+    };
+    createLineArray(vertices, axesVAO, axesVBO);
+#endif
+}
+
+void Renderer::uploadInstances(const InstanceUpload& data) {
+#ifdef VOXELMAKER_HAS_GLAD
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, data.instances.size() * sizeof(InstanceBuffer::Instance),
+                 data.instances.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, paletteBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, data.paletteColors.size() * sizeof(uint32_t),
+                 data.paletteColors.data(), GL_DYNAMIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, paletteTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8, paletteBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+#endif
+    gpuInstanceCount = data.instances.size();
+}
+
+void Renderer::releaseChunkMesh(const glm::ivec3& chunkCoord) {
+    auto it = gpuMeshes.find(chunkCoord);
+    if (it == gpuMeshes.end()) return;
+
+    uploadManager.release(it->second);
+    gpuMeshes.erase(it);
+}
+
+void Renderer::bindShader(uint8_t shader) {
+#ifdef VOXELMAKER_HAS_GLAD
+    switch (shader) {
+        case RenderCommandList::SHADER_CHUNK:
+            // Todos os chunks compartilham o VAO dos buffers do gerenciador de envio
+            glBindVertexArray(uploadManager.getVertexArray());
+            voxelShader->use();
+            break;
+
+        case RenderCommandList::SHADER_INSTANCED:
+            instanceShader->use();
+            break;
+
+        case RenderCommandList::SHADER_LINES:
+            // Grid e eixos ligam o próprio VAO no desenho
+            gridShader->use();
+            break;
+
+        default:
+            glUseProgram(0);
+            break;
+    }
+#else
     // TODO: Implementar quando GLAD estiver disponível
+#endif
 }
 
 void Renderer::updateMatrices() {
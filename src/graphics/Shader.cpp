@@ -1,44 +1,200 @@
 #include "graphics/Shader.hpp"
+#include "graphics/ShaderCache.hpp"
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+
+#ifdef VOXELMAKER_HAS_GLAD
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+#endif
 
 namespace VoxelMaker {
 
 Shader::Shader()
     : programID(0)
     , uniformLocations()
+    , hashedLocations()
     , compiled(false) {
 }
 
 Shader::~Shader() {
-    // TODO: Limpar recursos quando GLAD estiver disponível
+#ifdef VOXELMAKER_HAS_GLAD
+    if (programID != 0) {
+        glDeleteProgram(programID);
+    }
+#endif
 }
 
 bool Shader::loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
+#ifdef VOXELMAKER_HAS_GLAD
+    auto readFile = [](const std::string& path, std::string& content) {
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "Erro ao abrir shader: " << path << std::endl;
+            return false;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        content = stream.str();
+        return true;
+    };
+
+    std::string vertexSource, fragmentSource;
+    if (!readFile(vertexPath, vertexSource) || !readFile(fragmentPath, fragmentSource)) {
+        return false;
+    }
+    return compile(vertexSource, fragmentSource);
+#else
     // TODO: Implementar quando GLAD estiver disponível
     std::cout << "Carregando shader de arquivos: " << vertexPath << ", " << fragmentPath << std::endl;
     compiled = true;
     return true;
+#endif
 }
 
 bool Shader::compile(const std::string& vertexSource, const std::string& fragmentSource) {
+#ifdef VOXELMAKER_HAS_GLAD
+    ShaderCache& cache = ShaderCache::getInstance();
+    bool useCache = cache.isEnabled();
+
+    unsigned int program = glCreateProgram();
+    if (useCache && cache.load(program, vertexSource, fragmentSource)) {
+        adoptProgram(program);
+        return true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    unsigned int vertexShader = compileShader(vertexSource, GL_VERTEX_SHADER);
+    unsigned int fragmentShader = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
+    if (vertexShader == 0 || fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        glDeleteProgram(program);
+        return false;
+    }
+
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    if (useCache) {
+        cache.prepareForStore(program);
+    }
+    glLinkProgram(program);
+    glDetachShader(program, vertexShader);
+    glDetachShader(program, fragmentShader);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    if (!checkCompileErrors(program, "PROGRAM")) {
+        glDeleteProgram(program);
+        return false;
+    }
+
+    cache.recordCompile(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    if (useCache) {
+        cache.store(program, vertexSource, fragmentSource);
+    }
+
+    adoptProgram(program);
+    return true;
+#else
     // TODO: Implementar quando GLAD estiver disponível
     std::cout << "Compilando shader (modo simplificado)" << std::endl;
     compiled = true;
     return true;
+#endif
 }
 
 void Shader::use() {
     if (compiled) {
+#ifdef VOXELMAKER_HAS_GLAD
+        glUseProgram(programID);
+#else
         // TODO: Implementar quando GLAD estiver disponível
         std::cout << "Usando shader" << std::endl;
+#endif
     }
 }
 
 void Shader::unbind() {
+#ifdef VOXELMAKER_HAS_GLAD
+    glUseProgram(0);
+#else
     // TODO: Implementar quando GLAD estiver disponível
     std::cout << "Parando de usar shader" << std::endl;
+#endif
 }
 
+#ifdef VOXELMAKER_HAS_GLAD
+
+void Shader::setFloat(const std::string& name, float value) {
+    glUniform1f(getUniformLocation(name), value);
+}
+
+void Shader::setInt(const std::string& name, int value) {
+    glUniform1i(getUniformLocation(name), value);
+}
+
+void Shader::setBool(const std::string& name, bool value) {
+    glUniform1i(getUniformLocation(name), value ? 1 : 0);
+}
+
+void Shader::setVec2(const std::string& name, const glm::vec2& value) {
+    glUniform2fv(getUniformLocation(name), 1, glm::value_ptr(value));
+}
+
+void Shader::setVec3(const std::string& name, const glm::vec3& value) {
+    glUniform3fv(getUniformLocation(name), 1, glm::value_ptr(value));
+}
+
+void Shader::setVec4(const std::string& name, const glm::vec4& value) {
+    glUniform4fv(getUniformLocation(name), 1, glm::value_ptr(value));
+}
+
+void Shader::setMat3(const std::string& name, const glm::mat3& value) {
+    glUniformMatrix3fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::setMat4(const std::string& name, const glm::mat4& value) {
+    glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::setFloat(const UniformId& id, float value) {
+    glUniform1f(getUniformLocation(id), value);
+}
+
+void Shader::setInt(const UniformId& id, int value) {
+    glUniform1i(getUniformLocation(id), value);
+}
+
+void Shader::setBool(const UniformId& id, bool value) {
+    glUniform1i(getUniformLocation(id), value ? 1 : 0);
+}
+
+void Shader::setVec2(const UniformId& id, const glm::vec2& value) {
+    glUniform2fv(getUniformLocation(id), 1, glm::value_ptr(value));
+}
+
+void Shader::setVec3(const UniformId& id, const glm::vec3& value) {
+    glUniform3fv(getUniformLocation(id), 1, glm::value_ptr(value));
+}
+
+void Shader::setVec4(const UniformId& id, const glm::vec4& value) {
+    glUniform4fv(getUniformLocation(id), 1, glm::value_ptr(value));
+}
+
+void Shader::setMat3(const UniformId& id, const glm::mat3& value) {
+    glUniformMatrix3fv(getUniformLocation(id), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::setMat4(const UniformId& id, const glm::mat4& value) {
+    glUniformMatrix4fv(getUniformLocation(id), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+#else
+
 void Shader::setFloat(const std::string& name, float value) {
     // TODO: Implementar quando GLAD estiver disponível
 }
@@ -71,25 +227,140 @@ void Shader::setMat4(const std::string& name, const glm::mat4& value) {
     // TODO: Implementar quando GLAD estiver disponível
 }
 
+void Shader::setFloat(const UniformId& id, float value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+void Shader::setInt(const UniformId& id, int value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+void Shader::setBool(const UniformId& id, bool value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+void Shader::setVec2(const UniformId& id, const glm::vec2& value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+void Shader::setVec3(const UniformId& id, const glm::vec3& value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+void Shader::setVec4(const UniformId& id, const glm::vec4& value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+void Shader::setMat3(const UniformId& id, const glm::mat3& value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+void Shader::setMat4(const UniformId& id, const glm::mat4& value) {
+    // TODO: Implementar quando GLAD estiver disponível
+}
+
+#endif
+
+bool Shader::bindUniformBlock(const char* blockName, unsigned int bindingPoint) {
+#ifdef VOXELMAKER_HAS_GLAD
+    unsigned int blockIndex = glGetUniformBlockIndex(programID, blockName);
+    if (blockIndex == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(programID, blockIndex, bindingPoint);
+    return true;
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+    return true;
+#endif
+}
+
+int Shader::getUniformLocation(const UniformId& id) {
+    // Poucos uniforms por programa: busca linear pelo hash; o nome só é comparado
+    // caractere a caractere quando vem de outra constante com o mesmo hash
+    for (const auto& entry : hashedLocations) {
+        if (entry.hash == id.hash && (entry.name == id.name || std::strcmp(entry.name, id.name) == 0)) {
+            return entry.location;
+        }
+    }
+
+#ifdef VOXELMAKER_HAS_GLAD
+    int location = glGetUniformLocation(programID, id.name);
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+    int location = -1; // Placeholder
+#endif
+    hashedLocations.push_back(HashedLocation{id.hash, id.name, location});
+    return location;
+}
+
 int Shader::getUniformLocation(const std::string& name) {
     if (uniformLocations.find(name) != uniformLocations.end()) {
         return uniformLocations[name];
     }
 
+#ifdef VOXELMAKER_HAS_GLAD
+    int location = glGetUniformLocation(programID, name.c_str());
+#else
     // TODO: Implementar quando GLAD estiver disponível
     int location = -1; // Placeholder
+#endif
     uniformLocations[name] = location;
     return location;
 }
 
+void Shader::adoptProgram(unsigned int program) {
+#ifdef VOXELMAKER_HAS_GLAD
+    if (programID != 0) {
+        glDeleteProgram(programID);
+    }
+#endif
+    programID = program;
+    uniformLocations.clear();
+    hashedLocations.clear();
+    compiled = true;
+}
+
 unsigned int Shader::compileShader(const std::string& source, unsigned int type) {
+#ifdef VOXELMAKER_HAS_GLAD
+    unsigned int shader = glCreateShader(type);
+    const char* code = source.c_str();
+    glShaderSource(shader, 1, &code, nullptr);
+    glCompileShader(shader);
+
+    if (!checkCompileErrors(shader, type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT")) {
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+#else
     // TODO: Implementar quando GLAD estiver disponível
     return 0;
+#endif
 }
 
 bool Shader::checkCompileErrors(unsigned int shader, const std::string& type) {
+#ifdef VOXELMAKER_HAS_GLAD
+    int success = 0;
+    char infoLog[1024];
+    if (type == "PROGRAM") {
+        glGetProgramiv(shader, GL_LINK_STATUS, &success);
+        if (!success) {
+            glGetProgramInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+            std::cerr << "Erro ao linkar shader:\n" << infoLog << std::endl;
+        }
+    } else {
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+            std::cerr << "Erro ao compilar shader " << type << ":\n" << infoLog << std::endl;
+        }
+    }
+    return success != 0;
+#else
     // TODO: Implementar quando GLAD estiver disponível
     return true;
+#endif
 }
 
-} // namespace VoxelMaker 
\ No newline at end of file
+} // namespace VoxelMaker
@@ -0,0 +1,316 @@
+#include "graphics/ShaderCache.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef VOXELMAKER_HAS_GLAD
+#include <glad/glad.h>
+#if defined(GL_VERSION_4_1) || defined(GL_ARB_get_program_binary)
+#define VOXELMAKER_HAS_PROGRAM_BINARY
+#endif
+#endif
+
+namespace VoxelMaker {
+
+#ifdef VOXELMAKER_HAS_PROGRAM_BINARY
+namespace {
+
+/**
+ * @brief Cabeçalho dos arquivos do cache
+ */
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint64_t driverHash;
+    uint64_t checksum;      ///< Hash do binário (detecta arquivos truncados)
+    uint32_t format;
+    uint32_t length;
+};
+
+uint64_t hashSources(const std::string& vertexSource, const std::string& fragmentSource) {
+    // Tamanhos entram no hash para que a divisão entre os fontes não seja ambígua
+    uint64_t vertexSize = vertexSource.size();
+    uint64_t fragmentSize = fragmentSource.size();
+    uint64_t value = ShaderCache::hash(&vertexSize, sizeof(vertexSize));
+    value = ShaderCache::hash(vertexSource.data(), vertexSource.size(), value);
+    value = ShaderCache::hash(&fragmentSize, sizeof(fragmentSize), value);
+    return ShaderCache::hash(fragmentSource.data(), fragmentSource.size(), value);
+}
+
+} // namespace
+#endif
+
+ShaderCache::ShaderCache()
+    : directory()
+    , prunedDriver(0)
+    , mutex()
+    , stats() {
+}
+
+ShaderCache& ShaderCache::getInstance() {
+    static ShaderCache instance;
+    return instance;
+}
+
+bool ShaderCache::setDirectory(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    directory.clear();
+    if (path.empty()) {
+        return true;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(path, error);
+    if (error) {
+        std::cerr << "Erro ao criar diretório do cache de shaders: " << path << " (" << error.message() << ")" << std::endl;
+        return false;
+    }
+
+    directory = path;
+    prunedDriver = 0;
+
+    // Sem contexto o driver é desconhecido: a limpeza fica para a primeira gravação
+    uint64_t driver = driverHash();
+    if (driver != 0) {
+        pruneForeign(driver);
+    }
+    return true;
+}
+
+std::string ShaderCache::getDirectory() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return directory;
+}
+
+bool ShaderCache::isEnabled() const {
+    if (getDirectory().empty()) {
+        return false;
+    }
+
+#ifdef VOXELMAKER_HAS_PROGRAM_BINARY
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+#else
+    return false;
+#endif
+}
+
+bool ShaderCache::load(unsigned int program, const std::string& vertexSource, const std::string& fragmentSource) {
+#ifdef VOXELMAKER_HAS_PROGRAM_BINARY
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sourceHash = hashSources(vertexSource, fragmentSource);
+    uint64_t driver = driverHash();
+    std::string path = pathFor(sourceHash, driver);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.misses++;
+        return false;
+    }
+
+    FileHeader header;
+    std::vector<char> binary;
+    bool valid = static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header))) &&
+                 header.magic == FILE_MAGIC && header.version == FILE_VERSION &&
+                 header.sourceHash == sourceHash && header.driverHash == driver && header.length > 0;
+    if (valid) {
+        binary.resize(header.length);
+        valid = static_cast<bool>(file.read(binary.data(), header.length)) &&
+                hash(binary.data(), binary.size()) == header.checksum;
+    }
+    file.close();
+
+    if (valid) {
+        glProgramBinary(program, static_cast<GLenum>(header.format), binary.data(), static_cast<GLsizei>(header.length));
+        GLint linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        valid = linked != 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!valid) {
+        // Binário recusado (driver diferente, arquivo corrompido): volta ao fonte
+        std::remove(path.c_str());
+        stats.invalidated++;
+        stats.misses++;
+        return false;
+    }
+
+    stats.hits++;
+    stats.loadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+#else
+    (void)program;
+    (void)vertexSource;
+    (void)fragmentSource;
+    return false;
+#endif
+}
+
+void ShaderCache::prepareForStore(unsigned int program) const {
+#ifdef VOXELMAKER_HAS_PROGRAM_BINARY
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#else
+    (void)program;
+#endif
+}
+
+bool ShaderCache::store(unsigned int program, const std::string& vertexSource, const std::string& fragmentSource) {
+#ifdef VOXELMAKER_HAS_PROGRAM_BINARY
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return false;
+    }
+    binary.resize(static_cast<size_t>(written));
+
+    FileHeader header;
+    header.magic = FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.sourceHash = hashSources(vertexSource, fragmentSource);
+    header.driverHash = driverHash();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (prunedDriver != header.driverHash) {
+            pruneForeign(header.driverHash);
+        }
+    }
+    header.checksum = hash(binary.data(), binary.size());
+    header.format = static_cast<uint32_t>(format);
+    header.length = static_cast<uint32_t>(binary.size());
+
+    // Grava em um arquivo temporário e renomeia: leitores nunca veem um arquivo pela metade
+    std::string path = pathFor(header.sourceHash, header.driverHash);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file ||
+            !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+            std::cerr << "Erro ao gravar cache de shader: " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.stored++;
+    return true;
+#else
+    (void)program;
+    (void)vertexSource;
+    (void)fragmentSource;
+    return false;
+#endif
+}
+
+void ShaderCache::recordCompile(double milliseconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.compiles++;
+    stats.compileMs += milliseconds;
+}
+
+void ShaderCache::clear() {
+    std::string path = getDirectory();
+    if (path.empty()) {
+        return;
+    }
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+        if (entry.path().extension() == ".bin") {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+}
+
+ShaderCache::Stats ShaderCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+uint64_t ShaderCache::hash(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t value = seed;
+    for (size_t i = 0; i < size; i++) {
+        value = (value ^ bytes[i]) * 1099511628211ull;
+    }
+    return value;
+}
+
+uint64_t ShaderCache::driverHash() {
+#ifdef VOXELMAKER_HAS_GLAD
+    // Antes do carregamento do GLAD (ou sem contexto) não há driver para identificar
+    if (!glGetString || !glGetString(GL_VERSION)) {
+        return 0;
+    }
+
+    uint64_t value = hash(nullptr, 0);
+    const GLenum names[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for (GLenum name : names) {
+        const char* text = reinterpret_cast<const char*>(glGetString(name));
+        if (text) {
+            value = hash(text, std::char_traits<char>::length(text) + 1, value);
+        }
+    }
+    return value;
+#else
+    return 0;
+#endif
+}
+
+void ShaderCache::pruneForeign(uint64_t driver) {
+    // Chamado com o mutex travado; nomes seguem pathFor: <fonte>_<driver>.bin
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%016llx.bin", static_cast<unsigned long long>(driver));
+    const std::string current = suffix;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        bool binary = entry.path().extension() == ".bin";
+        bool temporary = entry.path().extension() == ".tmp";
+        if (!binary && !temporary) {
+            continue;
+        }
+        if (binary && name.size() >= current.size() &&
+            name.compare(name.size() - current.size(), current.size(), current) == 0) {
+            continue;
+        }
+
+        std::error_code removeError;
+        if (std::filesystem::remove(entry.path(), removeError) && binary) {
+            stats.pruned++;
+        }
+    }
+    prunedDriver = driver;
+}
+
+std::string ShaderCache::pathFor(uint64_t sourceHash, uint64_t driver) const {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%016llx_%016llx.bin",
+                  static_cast<unsigned long long>(sourceHash), static_cast<unsigned long long>(driver));
+    return (std::filesystem::path(getDirectory()) / name).string();
+}
+
+} // namespace VoxelMaker
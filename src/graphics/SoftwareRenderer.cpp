@@ -0,0 +1,372 @@
+#include "graphics/SoftwareRenderer.hpp"
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace VoxelMaker {
+
+namespace {
+
+constexpr float RAY_EPSILON = 1e-4f;
+constexpr float SHADOW_BIAS = 1e-3f;
+constexpr float INFINITE_DISTANCE = std::numeric_limits<float>::infinity();
+
+/**
+ * @brief Contadores de um bloco (somados ao final para evitar contenção)
+ */
+struct Counters {
+    uint64_t rays = 0;
+    uint64_t voxelSteps = 0;
+    uint64_t chunksSkipped = 0;
+};
+
+/**
+ * @brief Resultado de um raio que atingiu um voxel
+ */
+struct Hit {
+    float distance;
+    glm::ivec3 voxel;
+    int axis;                   ///< Eixo da face atingida
+    int sign;                   ///< Sentido da normal da face (+1 ou -1)
+    VoxelPalette::Index cell;
+};
+
+/**
+ * @brief Visão somente leitura do grid para os raios
+ *
+ * Os chunks ficam em um vetor denso sobre a caixa que os contém, evitando consultas ao
+ * mapa de chunks durante o percurso. Coordenadas em espaço do grid (sem a origem).
+ */
+class SceneView {
+private:
+    const VoxelPalette& palette;
+    glm::ivec3 minChunk;
+    glm::ivec3 extent;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+    std::vector<const VoxelChunk*> chunks;
+    std::vector<glm::vec3> colors;
+
+public:
+    explicit SceneView(const VoxelGrid& grid)
+        : palette(grid.getPalette())
+        , minChunk(0)
+        , extent(0)
+        , boundsMin(0.0f)
+        , boundsMax(0.0f)
+        , chunks()
+        , colors() {
+        bool first = true;
+        glm::ivec3 maxChunk(0);
+        for (const auto& pair : grid.getChunks()) {
+            if (pair.second->isEmpty()) continue;
+            minChunk = first ? pair.first : glm::min(minChunk, pair.first);
+            maxChunk = first ? pair.first : glm::max(maxChunk, pair.first);
+            first = false;
+        }
+        if (first) {
+            return;
+        }
+
+        extent = maxChunk - minChunk + glm::ivec3(1);
+        boundsMin = glm::vec3(minChunk * VoxelChunk::SIZE);
+        boundsMax = glm::vec3((maxChunk + glm::ivec3(1)) * VoxelChunk::SIZE);
+        chunks.assign(static_cast<size_t>(extent.x) * extent.y * extent.z, nullptr);
+        for (const auto& pair : grid.getChunks()) {
+            if (pair.second->isEmpty()) continue;
+            glm::ivec3 relative = pair.first - minChunk;
+            chunks[relative.x + extent.x * (relative.y + extent.y * relative.z)] = pair.second.get();
+        }
+
+        colors.resize(palette.size());
+        for (size_t i = 0; i < palette.size(); i++) {
+            const Voxel::Color& color = palette.get(static_cast<VoxelPalette::Index>(i)).getColor();
+            colors[i] = glm::vec3(color.r, color.g, color.b) / 255.0f;
+        }
+    }
+
+    const glm::vec3& colorOf(VoxelPalette::Index cell) const { return colors[cell]; }
+
+    const VoxelChunk* chunkAt(const glm::ivec3& chunkCoord) const {
+        glm::ivec3 relative = chunkCoord - minChunk;
+        if (relative.x < 0 || relative.y < 0 || relative.z < 0 ||
+            relative.x >= extent.x || relative.y >= extent.y || relative.z >= extent.z) {
+            return nullptr;
+        }
+        return chunks[relative.x + extent.x * (relative.y + extent.y * relative.z)];
+    }
+
+    bool isSolid(const glm::ivec3& position) const {
+        const VoxelChunk* chunk = chunkAt(VoxelGrid::chunkCoordOf(position));
+        return chunk && palette.isSolid(chunk->get(VoxelGrid::localCoordOf(position)));
+    }
+
+    /**
+     * @brief Percorre o raio até o primeiro voxel sólido (DDA por chunk e por voxel)
+     * @param origin Origem (espaço do grid)
+     * @param direction Direção normalizada
+     * @param maxDistance Distância máxima
+     * @param hit Voxel atingido
+     * @param counters Contadores do bloco
+     * @return true se algum voxel foi atingido
+     */
+    bool trace(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+               Hit& hit, Counters& counters) const {
+        counters.rays++;
+        if (chunks.empty()) {
+            return false;
+        }
+
+        // Entrada e saída da caixa que contém todos os chunks
+        float tNear = 0.0f;
+        float tFar = maxDistance;
+        int axis = -1;
+        for (int a = 0; a < 3; a++) {
+            if (direction[a] == 0.0f) {
+                if (origin[a] < boundsMin[a] || origin[a] > boundsMax[a]) return false;
+                continue;
+            }
+            float t0 = (boundsMin[a] - origin[a]) / direction[a];
+            float t1 = (boundsMax[a] - origin[a]) / direction[a];
+            if (t0 > t1) std::swap(t0, t1);
+            if (t0 > tNear) {
+                tNear = t0;
+                axis = a;
+            }
+            tFar = std::min(tFar, t1);
+        }
+        if (tNear > tFar) {
+            return false;
+        }
+
+        glm::ivec3 step(0);
+        glm::vec3 tDelta(INFINITE_DISTANCE);
+        for (int a = 0; a < 3; a++) {
+            if (direction[a] != 0.0f) {
+                step[a] = direction[a] > 0.0f ? 1 : -1;
+                tDelta[a] = std::abs(1.0f / direction[a]);
+            }
+        }
+        if (axis < 0) {
+            // Origem dentro da caixa: a face "atingida" é a voltada para o raio
+            glm::vec3 magnitude = glm::abs(direction);
+            axis = magnitude.x > magnitude.y ? (magnitude.x > magnitude.z ? 0 : 2) : (magnitude.y > magnitude.z ? 1 : 2);
+        }
+
+        const glm::ivec3 firstVoxel = glm::ivec3(boundsMin);
+        const glm::ivec3 lastVoxel = glm::ivec3(boundsMax) - glm::ivec3(1);
+        float t = tNear;
+        glm::ivec3 voxel = glm::clamp(glm::ivec3(glm::floor(origin + direction * (t + RAY_EPSILON))), firstVoxel, lastVoxel);
+        while (t < tFar) {
+            if (voxel.x < firstVoxel.x || voxel.y < firstVoxel.y || voxel.z < firstVoxel.z ||
+                voxel.x > lastVoxel.x || voxel.y > lastVoxel.y || voxel.z > lastVoxel.z) {
+                return false;
+            }
+
+            glm::ivec3 chunkCoord = VoxelGrid::chunkCoordOf(voxel);
+            glm::ivec3 chunkMin = chunkCoord * VoxelChunk::SIZE;
+            glm::ivec3 chunkMax = chunkMin + glm::ivec3(VoxelChunk::SIZE);
+
+            const VoxelChunk* chunk = chunkAt(chunkCoord);
+            if (!chunk) {
+                // Chunk vazio: pula direto para a saída da sua caixa
+                counters.chunksSkipped++;
+                float exit = INFINITE_DISTANCE;
+                for (int a = 0; a < 3; a++) {
+                    if (step[a] == 0) continue;
+                    float bound = static_cast<float>(step[a] > 0 ? chunkMax[a] : chunkMin[a]);
+                    float ta = (bound - origin[a]) / direction[a];
+                    if (ta < exit) {
+                        exit = ta;
+                        axis = a;
+                    }
+                }
+                t = std::max(exit, t + RAY_EPSILON);
+                voxel = glm::ivec3(glm::floor(origin + direction * (t + RAY_EPSILON)));
+                voxel[axis] = step[axis] > 0 ? chunkMax[axis] : chunkMin[axis] - 1;
+                continue;
+            }
+
+            glm::vec3 tMax(INFINITE_DISTANCE);
+            for (int a = 0; a < 3; a++) {
+                if (step[a] == 0) continue;
+                float bound = static_cast<float>(voxel[a] + (step[a] > 0 ? 1 : 0));
+                tMax[a] = (bound - origin[a]) / direction[a];
+            }
+
+            const VoxelChunk::Cell* cells = chunk->getCells();
+            while (true) {
+                counters.voxelSteps++;
+                VoxelChunk::Cell cell = cells[VoxelChunk::index(voxel.x - chunkMin.x, voxel.y - chunkMin.y, voxel.z - chunkMin.z)];
+                if (palette.isSolid(cell)) {
+                    hit.distance = t;
+                    hit.voxel = voxel;
+                    hit.axis = axis;
+                    hit.sign = -step[axis] != 0 ? -step[axis] : 1;
+                    hit.cell = cell;
+                    return true;
+                }
+
+                int a = tMax.x < tMax.y ? (tMax.x < tMax.z ? 0 : 2) : (tMax.y < tMax.z ? 1 : 2);
+                t = tMax[a];
+                axis = a;
+                voxel[a] += step[a];
+                tMax[a] += tDelta[a];
+                if (t >= tFar) {
+                    return false;
+                }
+                if (voxel[a] < chunkMin[a] || voxel[a] >= chunkMax[a]) {
+                    break;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Oclusão ambiente na face atingida (mesmo critério das malhas por chunk)
+ *
+ * Cada canto da face olha as duas células laterais e a diagonal na camada em frente à
+ * face; o valor no ponto atingido é a interpolação bilinear dos quatro cantos.
+ */
+float ambientOcclusion(const SceneView& scene, const Hit& hit, const glm::vec3& point) {
+    int u = (hit.axis + 1) % 3;
+    int w = (hit.axis + 2) % 3;
+    glm::ivec3 front = hit.voxel;
+    front[hit.axis] += hit.sign;
+
+    float fu = glm::clamp(point[u] - static_cast<float>(hit.voxel[u]), 0.0f, 1.0f);
+    float fw = glm::clamp(point[w] - static_cast<float>(hit.voxel[w]), 0.0f, 1.0f);
+
+    float corners[2][2];
+    for (int cu = 0; cu < 2; cu++) {
+        for (int cw = 0; cw < 2; cw++) {
+            glm::ivec3 side1 = front;
+            side1[u] += cu ? 1 : -1;
+            glm::ivec3 side2 = front;
+            side2[w] += cw ? 1 : -1;
+            glm::ivec3 corner = side1;
+            corner[w] += cw ? 1 : -1;
+
+            int s1 = scene.isSolid(side1) ? 1 : 0;
+            int s2 = scene.isSolid(side2) ? 1 : 0;
+            int c = scene.isSolid(corner) ? 1 : 0;
+            int level = (s1 && s2) ? 0 : 3 - (s1 + s2 + c);
+            corners[cu][cw] = static_cast<float>(level) / 3.0f;
+        }
+    }
+
+    float low = corners[0][0] + (corners[1][0] - corners[0][0]) * fu;
+    float high = corners[0][1] + (corners[1][1] - corners[0][1]) * fu;
+    return low + (high - low) * fw;
+}
+
+uint8_t toByte(float value) {
+    return static_cast<uint8_t>(glm::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+} // namespace
+
+SoftwareRenderer::SoftwareRenderer()
+    : settings()
+    , stats() {
+}
+
+SoftwareRenderer::SoftwareRenderer(const Settings& settings)
+    : settings(settings)
+    , stats() {
+}
+
+bool SoftwareRenderer::render(const VoxelGrid& grid, const Camera& camera, Image& image) {
+    if (image.isEmpty()) {
+        std::cerr << "SoftwareRenderer: imagem sem tamanho" << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const SceneView scene(grid);
+
+    // Base da câmera (mesmas convenções de Camera::updateViewMatrix/updateProjectionMatrix)
+    const int width = image.getWidth();
+    const int height = image.getHeight();
+    const float aspect = static_cast<float>(width) / static_cast<float>(height);
+    const glm::vec3 gridOrigin = glm::vec3(grid.getOrigin());
+    const glm::vec3 eye = camera.getPosition() - gridOrigin;
+    const glm::vec3 forward = glm::normalize(camera.getTarget() - camera.getPosition());
+    const glm::vec3 right = glm::normalize(glm::cross(forward, camera.getUp()));
+    const glm::vec3 up = glm::cross(right, forward);
+    const bool perspective = camera.getProjectionType() == Camera::ProjectionType::PERSPECTIVE;
+    const float halfHeight = perspective ? std::tan(glm::radians(camera.getFOV()) * 0.5f) : camera.getOrthoSize() * 0.5f;
+    const float halfWidth = halfHeight * aspect;
+    const float farPlane = camera.getFarPlane();
+
+    const glm::vec3 toLight = -glm::normalize(settings.lightDirection);
+    const Settings shading = settings;
+
+    const int tileSize = std::max(1, settings.tileSize);
+    const int tilesX = (width + tileSize - 1) / tileSize;
+    const int tilesY = (height + tileSize - 1) / tileSize;
+    const size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+    std::vector<Counters> tileCounters(tileCount);
+
+    ThreadPool::getInstance().parallelFor(tileCount, [&](size_t tile) {
+        Counters& counters = tileCounters[tile];
+        int x0 = static_cast<int>(tile % tilesX) * tileSize;
+        int y0 = static_cast<int>(tile / tilesX) * tileSize;
+        int x1 = std::min(x0 + tileSize, width);
+        int y1 = std::min(y0 + tileSize, height);
+
+        for (int y = y0; y < y1; y++) {
+            float ndcY = 1.0f - 2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+            for (int x = x0; x < x1; x++) {
+                float ndcX = 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(width) - 1.0f;
+                glm::vec3 offset = right * (ndcX * halfWidth) + up * (ndcY * halfHeight);
+                glm::vec3 origin = perspective ? eye : eye + offset;
+                glm::vec3 direction = perspective ? glm::normalize(forward + offset) : forward;
+
+                glm::vec3 color = shading.backgroundColor;
+                Hit hit;
+                if (scene.trace(origin, direction, farPlane, hit, counters)) {
+                    glm::vec3 normal(0.0f);
+                    normal[hit.axis] = static_cast<float>(hit.sign);
+                    glm::vec3 point = origin + direction * hit.distance;
+
+                    float diffuse = std::max(glm::dot(normal, toLight), 0.0f);
+                    if (diffuse > 0.0f && shading.shadows) {
+                        Hit blocker;
+                        if (scene.trace(point + normal * SHADOW_BIAS, toLight, INFINITE_DISTANCE, blocker, counters)) {
+                            diffuse = 0.0f;
+                        }
+                    }
+                    float occlusion = shading.ambientOcclusion ? ambientOcclusion(scene, hit, point) : 1.0f;
+
+                    // Mesma resposta de luz do shader de chunks do Renderer
+                    float light = (shading.ambient + (1.0f - shading.ambient) * diffuse) * (0.4f + 0.6f * occlusion);
+                    color = scene.colorOf(hit.cell) * light;
+                }
+                image.setPixel(x, y, toByte(color.x), toByte(color.y), toByte(color.z));
+            }
+        }
+    });
+
+    stats = Stats();
+    stats.tiles = tileCount;
+    stats.threads = std::max<size_t>(1, ThreadPool::getInstance().getThreadCount());
+    for (const Counters& counters : tileCounters) {
+        stats.rays += counters.rays;
+        stats.voxelSteps += counters.voxelSteps;
+        stats.chunksSkipped += counters.chunksSkipped;
+    }
+    stats.renderMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.megapixelsPerSecond = stats.renderMs > 0.0
+        ? (static_cast<double>(width) * height / 1.0e6) / (stats.renderMs / 1000.0)
+        : 0.0;
+    return true;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,226 @@
+#include "graphics/SurfaceNetsMesher.hpp"
+#include "graphics/ChunkMesher.hpp"
+#include <cstdint>
+#include <utility>
+
+namespace VoxelMaker {
+
+namespace {
+
+/**
+ * @brief Eixos tangentes (u, v) de cada eixo, com cross(u, v) = eixo
+ */
+const int TANGENTS[3][2] = {{1, 2}, {2, 0}, {0, 1}};
+
+constexpr int P = SurfaceNetsMesher::PADDED_SIZE;
+constexpr int C = SurfaceNetsMesher::CELL_SIZE;
+
+inline int sampleIndex(const glm::ivec3& p) {
+    return (p.x + 1) + P * ((p.y + 1) + P * (p.z + 1));
+}
+
+inline int cellIndex(const glm::ivec3& c) {
+    return (c.x + 1) + C * ((c.y + 1) + C * (c.z + 1));
+}
+
+inline bool isBorderCell(const glm::ivec3& c) {
+    const int last = VoxelChunk::SIZE - 1;
+    return c.x == -1 || c.y == -1 || c.z == -1 ||
+           c.x == last || c.y == last || c.z == last;
+}
+
+/**
+ * @brief Calcula o vértice de uma célula dual
+ * @param solid Ocupação da vizinhança (PADDED_SIZE³)
+ * @param padded Índices de paleta da vizinhança
+ * @param palette Paleta do grid
+ * @param c Célula (coordenada local, -1..SIZE-1)
+ * @param worldBase Posição mundial da amostra local (0, 0, 0)
+ */
+SurfaceNetsMesher::CellVertex computeCellVertex(const std::vector<uint8_t>& solid,
+                                                const std::vector<VoxelChunk::Cell>& padded,
+                                                const VoxelPalette& palette,
+                                                const glm::ivec3& c,
+                                                const glm::vec3& worldBase) {
+    int samples[8];
+    unsigned r = 0, g = 0, b = 0, a = 0, solidCount = 0;
+    for (int i = 0; i < 8; i++) {
+        int idx = sampleIndex(c + glm::ivec3(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+        samples[i] = solid[idx];
+        if (samples[i]) {
+            const Voxel::Color& color = palette.get(padded[idx]).getColor();
+            r += color.r;
+            g += color.g;
+            b += color.b;
+            a += color.a;
+            solidCount++;
+        }
+    }
+
+    // Média dos cruzamentos nas 12 arestas da célula
+    glm::vec3 sum(0.0f);
+    int crossings = 0;
+    for (int i = 0; i < 8; i++) {
+        for (int bit = 1; bit < 8; bit <<= 1) {
+            if (i & bit) continue;
+            int j = i | bit;
+            if (samples[i] == samples[j]) continue;
+
+            glm::vec3 from(static_cast<float>(i & 1),
+                           static_cast<float>((i >> 1) & 1),
+                           static_cast<float>((i >> 2) & 1));
+            glm::vec3 to(static_cast<float>(j & 1),
+                         static_cast<float>((j >> 1) & 1),
+                         static_cast<float>((j >> 2) & 1));
+            sum += (from + to) * 0.5f;
+            crossings++;
+        }
+    }
+
+    // Gradiente da densidade aponta para dentro do sólido
+    glm::vec3 gradient(0.0f);
+    for (int i = 0; i < 8; i++) {
+        float s = static_cast<float>(samples[i]);
+        gradient.x += (i & 1) ? s : -s;
+        gradient.y += ((i >> 1) & 1) ? s : -s;
+        gradient.z += ((i >> 2) & 1) ? s : -s;
+    }
+
+    SurfaceNetsMesher::CellVertex vertex;
+    glm::vec3 local = crossings > 0 ? sum / static_cast<float>(crossings) : glm::vec3(0.5f);
+    // Amostras ficam no centro dos voxels (+0.5)
+    vertex.position = worldBase + glm::vec3(c) + glm::vec3(0.5f) + local;
+    vertex.normal = glm::dot(gradient, gradient) > 0.0f ? -glm::normalize(gradient) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+    if (solidCount > 0) {
+        vertex.color = Voxel::Color(static_cast<uint8_t>(r / solidCount),
+                                    static_cast<uint8_t>(g / solidCount),
+                                    static_cast<uint8_t>(b / solidCount),
+                                    static_cast<uint8_t>(a / solidCount));
+    }
+    return vertex;
+}
+
+} // namespace
+
+bool SurfaceNetsMesher::BorderCache::find(const glm::ivec3& cell, CellVertex& vertex) {
+    Shard& shard = shardFor(cell);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.vertices.find(cell);
+    if (it == shard.vertices.end()) {
+        return false;
+    }
+    vertex = it->second;
+    return true;
+}
+
+void SurfaceNetsMesher::BorderCache::insert(const glm::ivec3& cell, const CellVertex& vertex) {
+    Shard& shard = shardFor(cell);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.vertices.emplace(cell, vertex);
+}
+
+void SurfaceNetsMesher::BorderCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.vertices.clear();
+    }
+}
+
+SurfaceNetsMesher::BorderCache::Shard& SurfaceNetsMesher::BorderCache::shardFor(const glm::ivec3& cell) {
+    return shards[Vec3Hash{}(cell) % SHARD_COUNT];
+}
+
+void SurfaceNetsMesher::meshChunk(const VoxelGrid& grid,
+                                  const glm::ivec3& chunkCoord,
+                                  Mesh& out,
+                                  BorderCache* cache) const {
+    std::vector<VoxelChunk::Cell> padded;
+    ChunkMesher::gatherNeighbourhood(grid, chunkCoord, padded);
+
+    meshNeighbourhood(padded, grid.getPalette(), chunkCoord * VoxelChunk::SIZE,
+                      glm::vec3(grid.getOrigin()), out, cache);
+}
+
+void SurfaceNetsMesher::meshNeighbourhood(const std::vector<VoxelChunk::Cell>& padded,
+                                          const VoxelPalette& palette,
+                                          const glm::ivec3& chunkOrigin,
+                                          const glm::vec3& gridOrigin,
+                                          Mesh& out,
+                                          BorderCache* cache) const {
+    out.clear();
+
+    std::vector<uint8_t> solid(padded.size());
+    for (size_t i = 0; i < padded.size(); i++) {
+        solid[i] = palette.isSolid(padded[i]) ? 1 : 0;
+    }
+
+    glm::vec3 worldBase = gridOrigin + glm::vec3(chunkOrigin);
+    std::vector<int32_t> cellVertices(C * C * C, -1);
+
+    auto vertexFor = [&](const glm::ivec3& c) -> uint32_t {
+        int32_t& slot = cellVertices[cellIndex(c)];
+        if (slot >= 0) {
+            return static_cast<uint32_t>(slot);
+        }
+
+        CellVertex vertex;
+        bool border = cache && isBorderCell(c);
+        if (!border || !cache->find(chunkOrigin + c, vertex)) {
+            vertex = computeCellVertex(solid, padded, palette, c, worldBase);
+            if (border) {
+                cache->insert(chunkOrigin + c, vertex);
+            }
+        }
+
+        slot = static_cast<int32_t>(out.addVertex(Mesh::Vertex(vertex.position, vertex.normal, vertex.color)));
+        return static_cast<uint32_t>(slot);
+    };
+
+    const int size = VoxelChunk::SIZE;
+    for (int axis = 0; axis < 3; axis++) {
+        int u = TANGENTS[axis][0];
+        int v = TANGENTS[axis][1];
+        glm::ivec3 eAxis(0), eU(0), eV(0);
+        eAxis[axis] = 1;
+        eU[u] = 1;
+        eV[v] = 1;
+
+        glm::ivec3 p;
+        for (p[axis] = -1; p[axis] < size; p[axis]++) {
+            for (p[v] = 0; p[v] < size; p[v]++) {
+                for (p[u] = 0; p[u] < size; p[u]++) {
+                    int from = solid[sampleIndex(p)];
+                    int to = solid[sampleIndex(p + eAxis)];
+                    if (from == to) continue;
+
+                    // A aresta pertence ao chunk que contém a amostra ocupada
+                    int solidAlongAxis = from ? p[axis] : p[axis] + 1;
+                    if (solidAlongAxis < 0 || solidAlongAxis >= size) continue;
+
+                    uint32_t q0 = vertexFor(p - eU - eV);
+                    uint32_t q1 = vertexFor(p - eV);
+                    uint32_t q2 = vertexFor(p);
+                    uint32_t q3 = vertexFor(p - eU);
+                    if (!from) {
+                        std::swap(q1, q3);  // Normal aponta para -eixo
+                    }
+
+                    // Divide pela diagonal mais curta
+                    const auto& vertices = out.getVertices();
+                    glm::vec3 d02 = vertices[q2].position - vertices[q0].position;
+                    glm::vec3 d13 = vertices[q3].position - vertices[q1].position;
+                    if (glm::dot(d02, d02) <= glm::dot(d13, d13)) {
+                        out.addTriangle(q0, q1, q2);
+                        out.addTriangle(q0, q2, q3);
+                    } else {
+                        out.addTriangle(q1, q2, q3);
+                        out.addTriangle(q1, q3, q0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,68 @@
+#include "graphics/UniformBuffer.hpp"
+#include <iostream>
+
+#ifdef VOXELMAKER_HAS_GLAD
+#include <glad/glad.h>
+#endif
+
+namespace VoxelMaker {
+
+UniformBuffer::UniformBuffer()
+    : buffer(0)
+    , bindingPoint(0)
+    , size(0) {
+}
+
+UniformBuffer::~UniformBuffer() {
+    cleanup();
+}
+
+bool UniformBuffer::initialize(size_t bufferSize, unsigned int binding) {
+    cleanup();
+    if (bufferSize == 0) {
+        std::cerr << "UniformBuffer: tamanho inválido" << std::endl;
+        return false;
+    }
+
+    size = bufferSize;
+    bindingPoint = binding;
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, buffer);
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+#endif
+    return true;
+}
+
+void UniformBuffer::cleanup() {
+#ifdef VOXELMAKER_HAS_GLAD
+    if (buffer != 0) {
+        glDeleteBuffers(1, &buffer);
+    }
+#endif
+    buffer = 0;
+    size = 0;
+}
+
+void UniformBuffer::update(const void* data, size_t dataSize) {
+    if (dataSize > size) {
+        std::cerr << "UniformBuffer: dados maiores que o bloco" << std::endl;
+        return;
+    }
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(dataSize), data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+    (void)data;
+#endif
+}
+
+} // namespace VoxelMaker
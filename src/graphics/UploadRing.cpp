@@ -0,0 +1,259 @@
+#include "graphics/UploadRing.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifdef VOXELMAKER_HAS_GLAD
+#include <glad/glad.h>
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+#define VOXELMAKER_HAS_BUFFER_STORAGE
+#endif
+#endif
+
+namespace VoxelMaker {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+} // namespace
+
+UploadRing::UploadRing()
+    : buffer(0)
+    , capacity(0)
+    , mapped(nullptr)
+    , persistent(false)
+    , head(0)
+    , usedBytes(0)
+    , pendingBytes(0)
+    , regions()
+    , stats() {
+}
+
+UploadRing::~UploadRing() {
+    cleanup();
+}
+
+bool UploadRing::initialize(size_t ringCapacity, bool allowPersistent) {
+    cleanup();
+    if (ringCapacity == 0) {
+        std::cerr << "UploadRing: capacidade inválida" << std::endl;
+        return false;
+    }
+
+    capacity = ringCapacity;
+    head = 0;
+    usedBytes = 0;
+    pendingBytes = 0;
+    stats = Stats();
+
+#ifdef VOXELMAKER_HAS_GLAD
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+#ifdef VOXELMAKER_HAS_BUFFER_STORAGE
+    if (allowPersistent && supportsPersistentMapping()) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+        mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0,
+                                                        static_cast<GLsizeiptr>(capacity), flags));
+        persistent = mapped != nullptr;
+        if (!persistent) {
+            // Armazenamento imutável não pode ser redefinido: recria o buffer
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        }
+    }
+#else
+    (void)allowPersistent;
+#endif
+
+    if (!persistent) {
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+#else
+    (void)allowPersistent;
+#endif
+
+    return true;
+}
+
+void UploadRing::cleanup() {
+#ifdef VOXELMAKER_HAS_GLAD
+    for (auto& region : regions) {
+        if (region.fence) {
+            glDeleteSync(static_cast<GLsync>(region.fence));
+        }
+    }
+    if (buffer != 0) {
+        if (mapped) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+#endif
+    regions.clear();
+    buffer = 0;
+    capacity = 0;
+    mapped = nullptr;
+    persistent = false;
+    head = 0;
+    usedBytes = 0;
+    pendingBytes = 0;
+}
+
+size_t UploadRing::write(const void* data, size_t size, size_t alignment) {
+    if (capacity == 0 || size == 0 || size > capacity) {
+        return INVALID_OFFSET;
+    }
+
+    size_t offset = 0;
+    size_t padding = 0;
+    while (true) {
+        if (usedBytes == 0) {
+            head = 0;
+        }
+
+        offset = alignUp(head, alignment);
+        if (offset + size > capacity) {
+            // Não cabe até o fim: o restante vira preenchimento e a escrita volta ao início
+            offset = 0;
+            padding = capacity - head;
+        } else {
+            padding = offset - head;
+        }
+
+        if (usedBytes + padding + size <= capacity) {
+            break;
+        }
+
+        // Anel cheio: fecha o lote atual se necessário e libera a região mais antiga
+        if (regions.empty()) {
+            fence();
+        }
+        waitOldest();
+    }
+
+#ifdef VOXELMAKER_HAS_GLAD
+    if (persistent) {
+        std::memcpy(mapped + offset, data, size);
+    } else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        void* pointer = glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset),
+                                         static_cast<GLsizeiptr>(size),
+                                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                         GL_MAP_UNSYNCHRONIZED_BIT);
+        if (!pointer) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            std::cerr << "UploadRing: falha ao mapear faixa do anel" << std::endl;
+            return INVALID_OFFSET;
+        }
+        std::memcpy(pointer, data, size);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+#else
+    // TODO: Implementar quando GLAD estiver disponível
+    (void)data;
+#endif
+
+    head = offset + size;
+    usedBytes += padding + size;
+    pendingBytes += padding + size;
+    stats.bytesWritten += size;
+    stats.writes++;
+    return offset;
+}
+
+void UploadRing::fence() {
+    retireCompleted();
+    if (pendingBytes == 0) {
+        return;
+    }
+
+    Region region;
+    region.size = pendingBytes;
+#ifdef VOXELMAKER_HAS_GLAD
+    region.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+    regions.push_back(region);
+    pendingBytes = 0;
+}
+
+bool UploadRing::supportsPersistentMapping() {
+#ifdef VOXELMAKER_HAS_BUFFER_STORAGE
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 4)) {
+        return true;
+    }
+
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; i++) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (name && std::strcmp(name, "GL_ARB_buffer_storage") == 0) {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+void UploadRing::retireCompleted() {
+    while (!regions.empty()) {
+#ifdef VOXELMAKER_HAS_GLAD
+        GLsync sync = static_cast<GLsync>(regions.front().fence);
+        if (sync) {
+            if (glClientWaitSync(sync, 0, 0) == GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            glDeleteSync(sync);
+        }
+#endif
+        usedBytes -= regions.front().size;
+        regions.pop_front();
+    }
+}
+
+void UploadRing::waitOldest() {
+    if (regions.empty()) {
+        return;
+    }
+
+    Region region = regions.front();
+    regions.pop_front();
+
+#ifdef VOXELMAKER_HAS_GLAD
+    GLsync sync = static_cast<GLsync>(region.fence);
+    if (sync) {
+        GLenum result = glClientWaitSync(sync, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            auto start = std::chrono::steady_clock::now();
+            const GLuint64 timeout = 1000000000;   // 1 s por tentativa
+            do {
+                result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+            } while (result == GL_TIMEOUT_EXPIRED);
+
+            stats.fenceWaits++;
+            stats.waitMs += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+        if (result == GL_WAIT_FAILED) {
+            std::cerr << "UploadRing: falha ao esperar fence" << std::endl;
+        }
+        glDeleteSync(sync);
+    }
+#endif
+
+    usedBytes -= region.size;
+}
+
+} // namespace VoxelMaker
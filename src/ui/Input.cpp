@@ -1,7 +1,262 @@
 #include "ui/Input.hpp"
+#include <cmath>
 
 namespace VoxelMaker {
 
-// TODO: Implementar Input
+Input::Input()
+    : startTime(Clock::now())
+    , pending()
+    , frameEvents()
+    , pendingSamples()
+    , frameSamples()
+    , state()
+    , pendingStats()
+    , stats()
+    , lastSample()
+    , hasLastSample(false)
+    , coalescing(true)
+    , recordSamples(true) {
+}
 
-} // namespace VoxelMaker 
\ No newline at end of file
+void Input::pushKey(int key, int scancode, int action, int mods) {
+    Event event;
+    event.type = EventType::KEY;
+    event.key = key;
+    event.scancode = scancode;
+    event.action = action;
+    event.mods = mods;
+    enqueue(event);
+}
+
+void Input::pushMouseButton(int button, int action, int mods) {
+    Event event;
+    event.type = EventType::MOUSE_BUTTON;
+    event.key = button;
+    event.action = action;
+    event.mods = mods;
+    enqueue(event);
+}
+
+void Input::pushMouseMove(double x, double y) {
+    double time = now();
+
+    if (recordSamples) {
+        if (pendingSamples.size() < MAX_SAMPLES_PER_FRAME) {
+            pendingSamples.emplace_back(x, y, time);
+        } else {
+            // Lotado: a última amostra acompanha o cursor para o traço terminar no lugar certo
+            pendingSamples.back() = MouseSample(x, y, time);
+            pendingStats.samplesDropped++;
+        }
+    }
+
+    // Só agrupa com o evento imediatamente anterior, preservando a ordem com cliques e teclas
+    if (coalescing && !pending.empty() && pending.back().type == EventType::MOUSE_MOVE) {
+        Event& last = pending.back();
+        last.x = x;
+        last.y = y;
+        last.time = time;
+        last.samples++;
+        pendingStats.received++;
+        pendingStats.coalesced++;
+        return;
+    }
+
+    Event event;
+    event.type = EventType::MOUSE_MOVE;
+    event.x = x;
+    event.y = y;
+    event.time = time;
+    enqueue(event);
+}
+
+void Input::pushScroll(double xoffset, double yoffset) {
+    if (coalescing && !pending.empty() && pending.back().type == EventType::SCROLL) {
+        Event& last = pending.back();
+        last.x += xoffset;
+        last.y += yoffset;
+        last.time = now();
+        last.samples++;
+        pendingStats.received++;
+        pendingStats.coalesced++;
+        return;
+    }
+
+    Event event;
+    event.type = EventType::SCROLL;
+    event.x = xoffset;
+    event.y = yoffset;
+    enqueue(event);
+}
+
+void Input::pushResize(int width, int height) {
+    if (coalescing && !pending.empty() && pending.back().type == EventType::RESIZE) {
+        Event& last = pending.back();
+        last.x = width;
+        last.y = height;
+        last.time = now();
+        last.samples++;
+        pendingStats.received++;
+        pendingStats.coalesced++;
+        return;
+    }
+
+    Event event;
+    event.type = EventType::RESIZE;
+    event.x = width;
+    event.y = height;
+    enqueue(event);
+}
+
+void Input::beginFrame() {
+    frameEvents.swap(pending);
+    pending.clear();
+
+    stats = pendingStats;
+    stats.delivered = frameEvents.size();
+    pendingStats = Stats();
+
+    state.keysPressed.reset();
+    state.keysReleased.reset();
+    state.buttonsPressed.reset();
+    state.buttonsReleased.reset();
+    state.mouseDeltaX = 0.0;
+    state.mouseDeltaY = 0.0;
+    state.scrollX = 0.0;
+    state.scrollY = 0.0;
+
+    const double startX = state.mouseX;
+    const double startY = state.mouseY;
+    const bool hadPosition = hasLastSample;
+    bool moved = false;
+    double moveTime = 0.0;
+
+    for (const Event& event : frameEvents) {
+        switch (event.type) {
+            case EventType::KEY:
+                state.mods = event.mods;
+                if (!State::validKey(event.key)) break;
+                if (event.action == ACTION_PRESS) {
+                    state.keysPressed.set(static_cast<size_t>(event.key));
+                    state.keysDown.set(static_cast<size_t>(event.key));
+                } else if (event.action == ACTION_RELEASE) {
+                    state.keysReleased.set(static_cast<size_t>(event.key));
+                    state.keysDown.reset(static_cast<size_t>(event.key));
+                }
+                break;
+
+            case EventType::MOUSE_BUTTON:
+                state.mods = event.mods;
+                if (!State::validButton(event.key)) break;
+                if (event.action == ACTION_PRESS) {
+                    state.buttonsPressed.set(static_cast<size_t>(event.key));
+                    state.buttonsDown.set(static_cast<size_t>(event.key));
+                } else if (event.action == ACTION_RELEASE) {
+                    state.buttonsReleased.set(static_cast<size_t>(event.key));
+                    state.buttonsDown.reset(static_cast<size_t>(event.key));
+                }
+                break;
+
+            case EventType::MOUSE_MOVE:
+                state.mouseX = event.x;
+                state.mouseY = event.y;
+                moveTime = event.time;
+                moved = true;
+                break;
+
+            case EventType::SCROLL:
+                state.scrollX += event.x;
+                state.scrollY += event.y;
+                break;
+
+            case EventType::RESIZE:
+                break;
+        }
+    }
+
+    frameSamples.clear();
+    if (moved) {
+        // O primeiro movimento conhecido não gera deslocamento
+        if (hadPosition) {
+            state.mouseDeltaX = state.mouseX - startX;
+            state.mouseDeltaY = state.mouseY - startY;
+        }
+
+        if (!pendingSamples.empty()) {
+            // Começa na posição do quadro anterior para o traço continuar sem lacunas
+            if (hadPosition) {
+                frameSamples.push_back(lastSample);
+            }
+            frameSamples.insert(frameSamples.end(), pendingSamples.begin(), pendingSamples.end());
+        }
+
+        lastSample = MouseSample(state.mouseX, state.mouseY, moveTime);
+        hasLastSample = true;
+    }
+    pendingSamples.clear();
+}
+
+void Input::reset() {
+    pending.clear();
+    frameEvents.clear();
+    pendingSamples.clear();
+    frameSamples.clear();
+    pendingStats = Stats();
+    stats = Stats();
+
+    // A posição do cursor continua válida; só o estado de teclas e botões é perdido
+    double mouseX = state.mouseX;
+    double mouseY = state.mouseY;
+    state = State();
+    state.mouseX = mouseX;
+    state.mouseY = mouseY;
+}
+
+std::vector<Input::MouseSample> Input::resampleStroke(const std::vector<MouseSample>& samples,
+                                                      double spacing, double& carry) {
+    std::vector<MouseSample> points;
+    if (samples.empty() || spacing <= 0.0) {
+        return points;
+    }
+
+    // Traço novo: o primeiro ponto é a própria amostra inicial
+    if (carry < 0.0) {
+        points.push_back(samples.front());
+        carry = 0.0;
+    }
+
+    for (size_t i = 1; i < samples.size(); i++) {
+        const MouseSample& a = samples[i - 1];
+        const MouseSample& b = samples[i];
+        double dx = b.x - a.x;
+        double dy = b.y - a.y;
+        double length = std::sqrt(dx * dx + dy * dy);
+        if (length <= 0.0) continue;
+
+        // Distância ao longo do segmento até o próximo ponto
+        double distance = spacing - carry;
+        while (distance <= length) {
+            double t = distance / length;
+            points.emplace_back(a.x + dx * t, a.y + dy * t, a.time + (b.time - a.time) * t);
+            distance += spacing;
+        }
+        carry = length - (distance - spacing);
+    }
+
+    return points;
+}
+
+double Input::now() const {
+    return std::chrono::duration<double>(Clock::now() - startTime).count();
+}
+
+void Input::enqueue(const Event& event) {
+    Event queued = event;
+    if (queued.time == 0.0) {
+        queued.time = now();
+    }
+    pending.push_back(queued);
+    pendingStats.received++;
+}
+
+} // namespace VoxelMaker
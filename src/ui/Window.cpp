@@ -89,12 +89,34 @@ void Window::pollEvents() {
     }
 }
 
+void Window::waitEvents(double timeoutSeconds) {
+    if (initialized) {
+        glfwWaitEventsTimeout(timeoutSeconds);
+    }
+}
+
+void Window::postEmptyEvent() {
+    if (initialized) {
+        glfwPostEmptyEvent();
+    }
+}
+
 void Window::swapBuffers() {
     if (windowHandle) {
         glfwSwapBuffers(static_cast<GLFWwindow*>(windowHandle));
     }
 }
 
+void Window::makeContextCurrent() {
+    if (windowHandle) {
+        glfwMakeContextCurrent(static_cast<GLFWwindow*>(windowHandle));
+    }
+}
+
+void Window::detachContext() {
+    glfwMakeContextCurrent(nullptr);
+}
+
 bool Window::shouldClose() const {
     if (windowHandle) {
         return glfwWindowShouldClose(static_cast<GLFWwindow*>(windowHandle));
@@ -228,6 +250,14 @@ void Window::setupCallbacks() {
         }
     });
 
+    // Callback de redesenho (janela exposta ou redimensionada pelo sistema)
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* w) {
+        Window* window = static_cast<Window*>(glfwGetWindowUserPointer(w));
+        if (window && window->callbacks.onRefresh) {
+            window->callbacks.onRefresh();
+        }
+    });
+
     // Definir ponteiro para a janela
     glfwSetWindowUserPointer(window, this);
 }
@@ -1,7 +1,186 @@
 #include "utils/FileUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
 
 namespace VoxelMaker {
 
-// TODO: Implementar FileUtils
+uint32_t FileUtils::crc32(const void* data, size_t size, uint32_t crc) {
+    // Tabela do byte seguido de 7 tabelas derivadas (slicing-by-8): 8 bytes por iteração
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> values(256 * 8);
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            values[n] = c;
+        }
+        for (size_t n = 256; n < values.size(); n++) {
+            uint32_t previous = values[n - 256];
+            values[n] = (previous >> 8) ^ values[previous & 0xFF];
+        }
+        return values;
+    }();
 
-} // namespace VoxelMaker 
\ No newline at end of file
+    const uint32_t* t = table.data();
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint32_t low = crc ^ (static_cast<uint32_t>(bytes[i]) | static_cast<uint32_t>(bytes[i + 1]) << 8 |
+                              static_cast<uint32_t>(bytes[i + 2]) << 16 | static_cast<uint32_t>(bytes[i + 3]) << 24);
+        crc = t[7 * 256 + (low & 0xFF)] ^ t[6 * 256 + ((low >> 8) & 0xFF)] ^
+              t[5 * 256 + ((low >> 16) & 0xFF)] ^ t[4 * 256 + (low >> 24)] ^
+              t[3 * 256 + bytes[i + 4]] ^ t[2 * 256 + bytes[i + 5]] ^
+              t[256 + bytes[i + 6]] ^ t[bytes[i + 7]];
+    }
+    for (; i < size; i++) {
+        crc = t[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool FileUtils::writeFileAtomic(const std::string& path, const std::vector<uint8_t>& data) {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file ||
+            !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            std::cerr << "Erro ao gravar arquivo: " << temporary << std::endl;
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    return replaceFile(temporary, path);
+}
+
+bool FileUtils::replaceFile(const std::string& temporary, const std::string& path) {
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Erro ao substituir arquivo " << path << ": " << error.message() << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool FileUtils::hasExtension(const std::string& path, const char* extension) {
+    size_t length = std::strlen(extension);
+    if (path.size() <= length) return false;
+    for (size_t i = 0; i < length; i++) {
+        char c = path[path.size() - length + i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != extension[i]) return false;
+    }
+    return true;
+}
+
+const char* FileUtils::skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+const char* FileUtils::nextLine(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) + 1 : end;
+}
+
+bool FileUtils::parseDouble(const char*& p, const char* end, double& value) {
+    static const double POWERS[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* s = skipSpaces(p, end);
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = *s == '-';
+        s++;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    for (; s < end && *s >= '0' && *s <= '9'; s++, digits++) {
+        if (mantissa < 100000000000000000ULL) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*s - '0');
+        } else {
+            exponent++;
+        }
+    }
+    if (s < end && *s == '.') {
+        for (s++; s < end && *s >= '0' && *s <= '9'; s++, digits++) {
+            if (mantissa < 100000000000000000ULL) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*s - '0');
+                exponent--;
+            }
+        }
+    }
+    if (digits == 0) {
+        return false;
+    }
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        const char* e = s + 1;
+        bool negativeExponent = false;
+        if (e < end && (*e == '-' || *e == '+')) {
+            negativeExponent = *e == '-';
+            e++;
+        }
+        int power = 0;
+        const char* first = e;
+        for (; e < end && *e >= '0' && *e <= '9'; e++) {
+            power = std::min(power * 10 + (*e - '0'), 1000);
+        }
+        if (e > first) {
+            exponent += negativeExponent ? -power : power;
+            s = e;
+        }
+    }
+
+    double result = static_cast<double>(mantissa);
+    if (exponent != 0) {
+        int magnitude = exponent < 0 ? -exponent : exponent;
+        double scale = magnitude <= 22 ? POWERS[magnitude] : std::pow(10.0, magnitude);
+        result = exponent < 0 ? result / scale : result * scale;
+    }
+    value = negative ? -result : result;
+    p = s;
+    return true;
+}
+
+bool FileUtils::parseFloat(const char*& p, const char* end, float& value) {
+    double result;
+    if (!parseDouble(p, end, result)) {
+        return false;
+    }
+    value = static_cast<float>(result);
+    return true;
+}
+
+bool FileUtils::parseInt(const char*& p, const char* end, int64_t& value) {
+    const char* s = skipSpaces(p, end);
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = *s == '-';
+        s++;
+    }
+    const char* first = s;
+    int64_t result = 0;
+    for (; s < end && *s >= '0' && *s <= '9'; s++) {
+        result = std::min<int64_t>(result * 10 + (*s - '0'), INT32_MAX);
+    }
+    if (s == first) {
+        return false;
+    }
+    value = negative ? -result : result;
+    p = s;
+    return true;
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,96 @@
+#include "utils/MappedFile.hpp"
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VOXELMAKER_HAS_MMAP 1
+#endif
+
+namespace VoxelMaker {
+
+MappedFile::MappedFile()
+    : path()
+    , data(nullptr)
+    , size(0)
+    , descriptor(-1)
+    , opened(false)
+    , fallback() {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& filePath) {
+    close();
+    path = filePath;
+
+#ifdef VOXELMAKER_HAS_MMAP
+    descriptor = ::open(filePath.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        std::cerr << "Erro ao abrir arquivo: " << filePath << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0) {
+        std::cerr << "Erro ao consultar arquivo: " << filePath << std::endl;
+        close();
+        return false;
+    }
+
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "Erro ao mapear arquivo: " << filePath << std::endl;
+            close();
+            return false;
+        }
+        // Acesso esparso: chunks são lidos sob demanda, sem leitura antecipada agressiva
+        madvise(mapping, size, MADV_RANDOM);
+        data = static_cast<const uint8_t*>(mapping);
+    }
+#else
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Erro ao abrir arquivo: " << filePath << std::endl;
+        return false;
+    }
+    fallback.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(fallback.data()), static_cast<std::streamsize>(fallback.size()))) {
+        std::cerr << "Erro ao ler arquivo: " << filePath << std::endl;
+        fallback.clear();
+        return false;
+    }
+    size = fallback.size();
+    data = fallback.empty() ? nullptr : fallback.data();
+#endif
+
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef VOXELMAKER_HAS_MMAP
+    if (data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    descriptor = -1;
+    opened = false;
+    fallback.clear();
+    fallback.shrink_to_fit();
+}
+
+} // namespace VoxelMaker
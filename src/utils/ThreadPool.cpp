@@ -0,0 +1,143 @@
+#include "utils/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace VoxelMaker {
+
+namespace {
+
+/**
+ * @brief Estado compartilhado de uma chamada a parallelFor
+ */
+struct ParallelJob {
+    std::function<void(size_t)> fn;
+    size_t count;
+    std::atomic<size_t> next;
+    std::atomic<size_t> done;
+    std::atomic<bool> failed;
+    std::exception_ptr error;           ///< Primeira exceção lançada por fn (protegida por mutex)
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    ParallelJob(const std::function<void(size_t)>& function, size_t total)
+        : fn(function), count(total), next(0), done(0), failed(false) {}
+
+    void run() {
+        size_t completed = 0;
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            // Depois de uma exceção os índices restantes são só contados, para que a espera
+            // em parallelFor termine sem chamar fn de novo
+            if (!failed.load(std::memory_order_relaxed)) {
+                try {
+                    fn(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            completed++;
+        }
+
+        if (completed > 0 && done.fetch_add(completed) + completed == count) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : workers()
+    , tasks()
+    , mutex()
+    , condition()
+    , stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance;
+    return instance;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    condition.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    if (count == 1 || workers.size() <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            fn(i);
+        }
+        return;
+    }
+
+    auto job = std::make_shared<ParallelJob>(fn, count);
+
+    size_t helpers = std::min(workers.size(), count - 1);
+    for (size_t i = 0; i < helpers; i++) {
+        enqueue([job]() { job->run(); });
+    }
+
+    // A thread chamadora também trabalha; ao final espera apenas pelos índices em andamento
+    job->run();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&job]() { return job->done.load() == job->count; });
+
+    // Só relança depois que nenhuma thread usa mais fn (as capturas dela vivem na pilha de quem chamou)
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace VoxelMaker
@@ -0,0 +1,211 @@
+#include "core/AutosaveJournal.hpp"
+#include "core/VoxelFile.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace VoxelMaker;
+
+namespace {
+
+/**
+ * @brief Estado de um grid comparável entre sessões
+ */
+struct GridState {
+    uint64_t contentHash;
+    size_t voxelCount;
+    size_t chunkCount;
+    size_t paletteSize;
+};
+
+GridState stateOf(const VoxelGrid& grid) {
+    return GridState{ grid.getContentHash(), grid.getVoxelCount(), grid.getChunks().size(), grid.getPalette().size() };
+}
+
+void expectSameState(const GridState& actual, const GridState& expected) {
+    EXPECT_EQ(actual.contentHash, expected.contentHash);
+    EXPECT_EQ(actual.voxelCount, expected.voxelCount);
+    EXPECT_EQ(actual.chunkCount, expected.chunkCount);
+    EXPECT_EQ(actual.paletteSize, expected.paletteSize);
+}
+
+/**
+ * @brief Projeto gravado em disco e o journal ao lado dele, apagados no fim do teste
+ */
+class AutosaveJournalTest : public ::testing::Test {
+protected:
+    std::string projectPath;
+    std::string journalPath;
+
+    void SetUp() override {
+        projectPath = (std::filesystem::temp_directory_path() / "voxelmaker_journal_test.vxm").string();
+        journalPath = AutosaveJournal::journalPathFor(projectPath);
+        std::remove(journalPath.c_str());
+
+        // Uma camada de 4 voxels de altura sobre 2x2 chunks
+        const int extent = 2 * VoxelChunk::SIZE;
+        VoxelGrid grid(VoxelGrid::Dimensions(extent, extent, extent));
+        for (int z = 0; z < extent; z++) {
+            for (int x = 0; x < extent; x++) {
+                for (int y = 0; y < 4; y++) {
+                    grid.addVoxel(Voxel(glm::ivec3(x, y, z), Voxel::Color(40, 120, 40)));
+                }
+            }
+        }
+        VoxelFile file;
+        ASSERT_TRUE(file.save(grid, projectPath));
+    }
+
+    void TearDown() override {
+        std::remove(projectPath.c_str());
+        std::remove(journalPath.c_str());
+    }
+
+    /**
+     * @brief Abre o projeto gravado (sem as alterações do journal)
+     */
+    void loadProject(VoxelGrid& grid) {
+        VoxelFile file;
+        ASSERT_TRUE(file.load(projectPath, grid));
+    }
+
+    /**
+     * @brief Sessão interrompida: dois snapshots (o primeiro com um chunk removido e cores
+     *        novas, o segundo no fechamento) e o projeto nunca é regravado
+     * @param afterFirst Estado registrado pelo primeiro snapshot
+     * @param afterSecond Estado registrado pelo último
+     */
+    void runInterruptedSession(GridState& afterFirst, GridState& afterSecond) {
+        VoxelGrid grid;
+        loadProject(grid);
+        AutosaveJournal journal;
+        ASSERT_TRUE(journal.open(journalPath, grid));
+        EXPECT_EQ(journal.getStats().recoveredChunks, 0u);
+
+        // Esvazia o chunk (1, 0, 0): vira um registro de remoção
+        for (int z = 0; z < VoxelChunk::SIZE; z++) {
+            for (int x = VoxelChunk::SIZE; x < 2 * VoxelChunk::SIZE; x++) {
+                for (int y = 0; y < 4; y++) {
+                    grid.removeVoxel(glm::ivec3(x, y, z));
+                }
+            }
+        }
+        grid.addVoxel(Voxel(glm::ivec3(3, 10, 3), Voxel::Color(250, 10, 10)));
+        grid.addVoxel(Voxel(glm::ivec3(5, VoxelChunk::SIZE + 2, 40), Voxel::Color(10, 10, 250)));
+        ASSERT_EQ(grid.getChunk(glm::ivec3(1, 0, 0)), nullptr);
+        ASSERT_TRUE(journal.snapshot(grid));
+        afterFirst = stateOf(grid);
+
+        grid.addVoxel(Voxel(glm::ivec3(40, 20, 40), Voxel::Color(250, 250, 10)));
+        grid.removeVoxel(glm::ivec3(0, 0, 0));
+        afterSecond = stateOf(grid);
+        journal.close(&grid);
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Sem regravar o projeto, a próxima abertura reaplica o journal até o último commit
+ */
+TEST_F(AutosaveJournalTest, RecoversAfterCrash) {
+    GridState afterFirst;
+    GridState afterSecond;
+    runInterruptedSession(afterFirst, afterSecond);
+    ASSERT_NE(afterSecond.contentHash, afterFirst.contentHash);
+
+    VoxelGrid recovered;
+    loadProject(recovered);
+    AutosaveJournal journal;
+    ASSERT_TRUE(journal.open(journalPath, recovered));
+    EXPECT_GT(journal.getStats().recoveredChunks, 0u);
+    EXPECT_EQ(recovered.getChunk(glm::ivec3(1, 0, 0)), nullptr);
+    expectSameState(stateOf(recovered), afterSecond);
+    journal.close();
+
+    // O journal reescrito na abertura continua levando ao mesmo estado
+    VoxelGrid reopened;
+    loadProject(reopened);
+    ASSERT_TRUE(journal.open(journalPath, reopened));
+    expectSameState(stateOf(reopened), afterSecond);
+    journal.close();
+}
+
+/**
+ * @brief Um último registro cortado descarta só o snapshot dele; o arquivo volta ao último commit
+ */
+TEST_F(AutosaveJournalTest, TruncatedLastRecordIsDiscarded) {
+    GridState afterFirst;
+    GridState afterSecond;
+    runInterruptedSession(afterFirst, afterSecond);
+
+    // Queda no meio da gravação do commit do segundo snapshot
+    uint64_t size = std::filesystem::file_size(journalPath);
+    std::filesystem::resize_file(journalPath, size - 3);
+
+    VoxelGrid recovered;
+    loadProject(recovered);
+    AutosaveJournal journal;
+    ASSERT_TRUE(journal.open(journalPath, recovered));
+    EXPECT_EQ(recovered.getChunk(glm::ivec3(1, 0, 0)), nullptr);
+    expectSameState(stateOf(recovered), afterFirst);
+    journal.close();
+}
+
+/**
+ * @brief Lixo de uma gravação interrompida depois do último commit é ignorado e não volta
+ */
+TEST_F(AutosaveJournalTest, TornTailIsTrimmed) {
+    GridState afterFirst;
+    GridState afterSecond;
+    runInterruptedSession(afterFirst, afterSecond);
+    {
+        std::ofstream tail(journalPath, std::ios::binary | std::ios::app);
+        const char garbage[] = "registro pela metade";
+        tail.write(garbage, sizeof(garbage));
+    }
+
+    VoxelGrid recovered;
+    loadProject(recovered);
+    AutosaveJournal journal;
+    ASSERT_TRUE(journal.open(journalPath, recovered));
+    expectSameState(stateOf(recovered), afterSecond);
+    journal.close();
+
+    VoxelGrid reopened;
+    loadProject(reopened);
+    ASSERT_TRUE(journal.open(journalPath, reopened));
+    expectSameState(stateOf(reopened), afterSecond);
+    journal.close();
+}
+
+/**
+ * @brief Depois de gravar o projeto, o journal recomeça e nada é reaplicado
+ */
+TEST_F(AutosaveJournalTest, SavedProjectStartsEmptyJournal) {
+    GridState afterFirst;
+    GridState afterSecond;
+    runInterruptedSession(afterFirst, afterSecond);
+
+    {
+        VoxelGrid grid;
+        loadProject(grid);
+        AutosaveJournal journal;
+        ASSERT_TRUE(journal.open(journalPath, grid));
+        VoxelFile file;
+        ASSERT_TRUE(file.save(grid, projectPath));
+        journal.markSaved(grid);
+        journal.close();
+    }
+
+    VoxelGrid reopened;
+    loadProject(reopened);
+    expectSameState(stateOf(reopened), afterSecond);
+    AutosaveJournal journal;
+    ASSERT_TRUE(journal.open(journalPath, reopened));
+    EXPECT_EQ(journal.getStats().recoveredChunks, 0u);
+    expectSameState(stateOf(reopened), afterSecond);
+    journal.close();
+}
@@ -0,0 +1,165 @@
+#include "graphics/BufferAllocator.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace VoxelMaker;
+
+/**
+ * @brief Pedidos são arredondados ao alinhamento e os deslocamentos são múltiplos dele
+ */
+TEST(BufferAllocatorTest, RoundsToAlignment) {
+    BufferAllocator allocator(1000, 32);
+    EXPECT_EQ(allocator.getCapacity(), 992u);
+
+    size_t a = allocator.allocate(1);
+    size_t b = allocator.allocate(33);
+    ASSERT_NE(a, BufferAllocator::INVALID_OFFSET);
+    ASSERT_NE(b, BufferAllocator::INVALID_OFFSET);
+    EXPECT_EQ(a % 32, 0u);
+    EXPECT_EQ(b % 32, 0u);
+    EXPECT_EQ(allocator.getAllocationSize(a), 32u);
+    EXPECT_EQ(allocator.getAllocationSize(b), 64u);
+    EXPECT_EQ(allocator.getUsedBytes(), 96u);
+
+    EXPECT_EQ(allocator.allocate(0), BufferAllocator::INVALID_OFFSET);
+    EXPECT_EQ(allocator.allocate(993), BufferAllocator::INVALID_OFFSET);
+    EXPECT_EQ(allocator.getAllocationSize(12345), 0u);
+}
+
+/**
+ * @brief O menor bloco livre que comporta o pedido é o escolhido
+ */
+TEST(BufferAllocatorTest, BestFit) {
+    BufferAllocator allocator(1024, 16);
+    size_t a = allocator.allocate(100);     // [0, 112)
+    size_t b = allocator.allocate(200);     // [112, 320)
+    size_t c = allocator.allocate(50);      // [320, 384)
+    size_t d = allocator.allocate(300);     // [384, 688), sobra [688, 1024)
+    EXPECT_EQ(a, 0u);
+    EXPECT_EQ(b, 112u);
+    EXPECT_EQ(c, 320u);
+    EXPECT_EQ(d, 384u);
+
+    // Livres: 208 bytes em 112 e 336 bytes em 688; 64 bytes cabem melhor no primeiro
+    allocator.free(b);
+    EXPECT_EQ(allocator.allocate(64), 112u);
+
+    // 300 bytes só cabem no bloco do fim
+    EXPECT_EQ(allocator.allocate(300), 688u);
+
+    BufferAllocator::Stats stats = allocator.getStats();
+    EXPECT_EQ(stats.allocationCount, 5u);
+    EXPECT_EQ(stats.freeBlockCount, 2u);
+    EXPECT_EQ(stats.largestFreeBlock, 144u);
+}
+
+/**
+ * @brief Liberar em qualquer ordem funde os vizinhos de volta em um único bloco
+ */
+TEST(BufferAllocatorTest, FreeCoalescesNeighbours) {
+    BufferAllocator allocator(64 * 16, 16);
+    std::vector<size_t> offsets;
+    for (int i = 0; i < 64; i++) {
+        offsets.push_back(allocator.allocate(16));
+    }
+    EXPECT_EQ(allocator.allocate(16), BufferAllocator::INVALID_OFFSET);
+    EXPECT_EQ(allocator.getStats().freeBlockCount, 0u);
+
+    std::mt19937 random(7);
+    std::shuffle(offsets.begin(), offsets.end(), random);
+    for (size_t offset : offsets) {
+        allocator.free(offset);
+        allocator.free(offset);     // Liberar de novo não tem efeito
+    }
+
+    BufferAllocator::Stats stats = allocator.getStats();
+    EXPECT_EQ(stats.usedBytes, 0u);
+    EXPECT_EQ(stats.allocationCount, 0u);
+    EXPECT_EQ(stats.freeBlockCount, 1u);
+    EXPECT_EQ(stats.largestFreeBlock, allocator.getCapacity());
+    EXPECT_EQ(allocator.allocate(allocator.getCapacity()), 0u);
+}
+
+/**
+ * @brief grow preserva as faixas e funde a área nova com o bloco livre do fim
+ */
+TEST(BufferAllocatorTest, GrowKeepsAllocations) {
+    BufferAllocator allocator(256, 16);
+    size_t a = allocator.allocate(128);
+    size_t b = allocator.allocate(96);      // Sobram 32 bytes no fim
+    EXPECT_EQ(allocator.allocate(64), BufferAllocator::INVALID_OFFSET);
+
+    allocator.grow(100);                    // Menor que a capacidade: ignorado
+    EXPECT_EQ(allocator.getCapacity(), 256u);
+
+    allocator.grow(512);
+    EXPECT_EQ(allocator.getCapacity(), 512u);
+    EXPECT_EQ(allocator.getAllocationSize(a), 128u);
+    EXPECT_EQ(allocator.getAllocationSize(b), 96u);
+
+    BufferAllocator::Stats stats = allocator.getStats();
+    EXPECT_EQ(stats.freeBlockCount, 1u);
+    EXPECT_EQ(stats.largestFreeBlock, 288u);
+    EXPECT_EQ(allocator.allocate(288), 224u);
+}
+
+/**
+ * @brief Sequência aleatória comparada com um modelo: faixas nunca se sobrepõem e a contagem bate
+ */
+TEST(BufferAllocatorTest, RandomOperationsMatchModel) {
+    const size_t alignment = 32;
+    BufferAllocator allocator(64 * 1024, alignment);
+    std::map<size_t, size_t> live;          // Deslocamento -> tamanho reservado
+    std::mt19937 random(12345);
+
+    for (int step = 0; step < 20000; step++) {
+        if (live.empty() || random() % 3 != 0) {
+            size_t size = 1 + random() % 2000;
+            size_t offset = allocator.allocate(size);
+            if (offset == BufferAllocator::INVALID_OFFSET) {
+                allocator.grow(allocator.getCapacity() * 2);
+                offset = allocator.allocate(size);
+            }
+            ASSERT_NE(offset, BufferAllocator::INVALID_OFFSET);
+            ASSERT_EQ(offset % alignment, 0u);
+            size_t reserved = allocator.getAllocationSize(offset);
+            ASSERT_GE(reserved, size);
+            ASSERT_LE(offset + reserved, allocator.getCapacity());
+
+            // Vizinhos no modelo não podem sobrepor a faixa nova
+            auto next = live.lower_bound(offset);
+            if (next != live.end()) {
+                ASSERT_LE(offset + reserved, next->first);
+            }
+            if (next != live.begin()) {
+                auto previous = std::prev(next);
+                ASSERT_LE(previous->first + previous->second, offset);
+            }
+            live[offset] = reserved;
+        } else {
+            auto it = live.begin();
+            std::advance(it, random() % live.size());
+            allocator.free(it->first);
+            live.erase(it);
+        }
+
+        if (step % 1000 == 0) {
+            size_t used = 0;
+            for (const auto& pair : live) {
+                used += pair.second;
+            }
+            BufferAllocator::Stats stats = allocator.getStats();
+            ASSERT_EQ(stats.usedBytes, used);
+            ASSERT_EQ(stats.allocationCount, live.size());
+        }
+    }
+
+    for (const auto& pair : live) {
+        allocator.free(pair.first);
+    }
+    EXPECT_EQ(allocator.getStats().freeBlockCount, 1u);
+    EXPECT_EQ(allocator.getUsedBytes(), 0u);
+}
@@ -0,0 +1,193 @@
+#include "core/ChunkCodec.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace VoxelMaker;
+
+namespace {
+
+using Cells = std::vector<VoxelChunk::Cell>;
+
+const ChunkCodec::Codec CODECS[] = {
+    ChunkCodec::Codec::RAW, ChunkCodec::Codec::RLE, ChunkCodec::Codec::PALETTE,
+    ChunkCodec::Codec::MORTON_RLE, ChunkCodec::Codec::PALETTE_LZ
+};
+
+/**
+ * @brief Conteúdos típicos e extremos de um chunk, com um nome para as mensagens
+ */
+std::vector<std::pair<std::string, Cells>> samples() {
+    std::vector<std::pair<std::string, Cells>> result;
+    std::mt19937 random(44);
+
+    result.emplace_back("vazio", Cells(VoxelChunk::VOLUME, VoxelPalette::EMPTY));
+    result.emplace_back("uniforme", Cells(VoxelChunk::VOLUME, 7));
+
+    Cells terrain(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+    for (int z = 0; z < VoxelChunk::SIZE; z++) {
+        for (int y = 0; y < VoxelChunk::SIZE; y++) {
+            for (int x = 0; x < VoxelChunk::SIZE; x++) {
+                if (y < 5 + (x + z) % 8) {
+                    terrain[VoxelChunk::index(x, y, z)] = static_cast<VoxelChunk::Cell>(1 + y / 3);
+                }
+            }
+        }
+    }
+    result.emplace_back("terreno", terrain);
+
+    Cells fewColors(VoxelChunk::VOLUME);
+    for (auto& cell : fewColors) {
+        cell = static_cast<VoxelChunk::Cell>(random() % 3);
+    }
+    result.emplace_back("três cores", fewColors);
+
+    Cells manyColors(VoxelChunk::VOLUME);
+    for (auto& cell : manyColors) {
+        cell = static_cast<VoxelChunk::Cell>(random() % 300);
+    }
+    result.emplace_back("300 cores", manyColors);
+
+    Cells noise(VoxelChunk::VOLUME);
+    for (auto& cell : noise) {
+        cell = static_cast<VoxelChunk::Cell>(random());
+    }
+    result.emplace_back("ruído", noise);
+    return result;
+}
+
+/**
+ * @brief Decodifica para um destino com células de guarda depois de VOLUME, que não podem mudar
+ */
+bool guardedDecode(ChunkCodec::Codec codec, const std::vector<uint8_t>& block, size_t size) {
+    const VoxelChunk::Cell GUARD = 0xA5A5;
+    Cells cells(VoxelChunk::VOLUME + 64, GUARD);
+    bool decoded = ChunkCodec::decode(codec, block.data(), size, cells.data());
+    EXPECT_TRUE(std::all_of(cells.begin() + VoxelChunk::VOLUME, cells.end(),
+                            [&](VoxelChunk::Cell cell) { return cell == GUARD; }));
+    return decoded;
+}
+
+} // namespace
+
+/**
+ * @brief Todo codec devolve exatamente as células codificadas
+ */
+TEST(ChunkCodecTest, RoundTripAllCodecs) {
+    for (const auto& sample : samples()) {
+        for (ChunkCodec::Codec codec : CODECS) {
+            std::vector<uint8_t> block;
+            ChunkCodec::encode(codec, sample.second.data(), block);
+            Cells decoded(VoxelChunk::VOLUME, 0xFFFF);
+            ASSERT_TRUE(ChunkCodec::decode(codec, block.data(), block.size(), decoded.data()))
+                << sample.first << " / " << ChunkCodec::getName(codec);
+            EXPECT_EQ(decoded, sample.second) << sample.first << " / " << ChunkCodec::getName(codec);
+        }
+    }
+}
+
+/**
+ * @brief encodeBest escolhe o menor bloco e ele também volta intacto
+ */
+TEST(ChunkCodecTest, EncodeBestIsSmallestAndRoundTrips) {
+    for (const auto& sample : samples()) {
+        std::vector<uint8_t> best;
+        ChunkCodec::Codec chosen = ChunkCodec::encodeBest(sample.second.data(), best);
+        for (ChunkCodec::Codec codec : CODECS) {
+            std::vector<uint8_t> block;
+            ChunkCodec::encode(codec, sample.second.data(), block);
+            // O LZ só é tentado entre LZ_THRESHOLD e RAW_BYTES
+            if (codec == ChunkCodec::Codec::PALETTE_LZ &&
+                (block.size() < ChunkCodec::LZ_THRESHOLD || chosen == ChunkCodec::Codec::RAW)) continue;
+            EXPECT_LE(best.size(), block.size()) << sample.first << " / " << ChunkCodec::getName(codec);
+        }
+
+        Cells decoded(VoxelChunk::VOLUME);
+        ASSERT_TRUE(ChunkCodec::decode(chosen, best.data(), best.size(), decoded.data())) << sample.first;
+        EXPECT_EQ(decoded, sample.second) << sample.first;
+    }
+}
+
+/**
+ * @brief Qualquer prefixo estrito de um bloco, ou o bloco com bytes a mais, é recusado
+ */
+TEST(ChunkCodecTest, TruncatedOrExtendedBlocksAreRejected) {
+    for (const auto& sample : samples()) {
+        for (ChunkCodec::Codec codec : CODECS) {
+            std::vector<uint8_t> block;
+            ChunkCodec::encode(codec, sample.second.data(), block);
+            // Todos os cortes no início e no fim do bloco; no meio, a cada 97 bytes
+            for (size_t size = 0; size < block.size(); size += (size < 256 || size + 256 > block.size()) ? 1 : 97) {
+                ASSERT_FALSE(guardedDecode(codec, block, size))
+                    << sample.first << " / " << ChunkCodec::getName(codec) << ": " << size << " de " << block.size();
+            }
+
+            block.insert(block.end(), { 1, 0, 1, 0 });
+            EXPECT_FALSE(guardedDecode(codec, block, block.size()))
+                << sample.first << " / " << ChunkCodec::getName(codec);
+        }
+    }
+}
+
+/**
+ * @brief Campos estruturais alterados (contagens, índices, codec) são recusados
+ */
+TEST(ChunkCodecTest, MutatedStructureIsRejected) {
+    Cells cells = samples()[3].second;      // Três cores: 2 bits por índice
+    Cells decoded(VoxelChunk::VOLUME);
+
+    // RLE: uma repetição a mais passa de VOLUME
+    std::vector<uint8_t> block;
+    ChunkCodec::encode(ChunkCodec::Codec::RLE, cells.data(), block);
+    block[0]++;
+    EXPECT_FALSE(ChunkCodec::decode(ChunkCodec::Codec::RLE, block.data(), block.size(), decoded.data()));
+
+    // PALETTE: paleta local maior que a gravada e índice fora da paleta local
+    ChunkCodec::encode(ChunkCodec::Codec::PALETTE, cells.data(), block);
+    std::vector<uint8_t> mutated = block;
+    mutated[0]++;
+    EXPECT_FALSE(ChunkCodec::decode(ChunkCodec::Codec::PALETTE, mutated.data(), mutated.size(), decoded.data()));
+    mutated = block;
+    mutated.back() = 0xFF;
+    EXPECT_FALSE(ChunkCodec::decode(ChunkCodec::Codec::PALETTE, mutated.data(), mutated.size(), decoded.data()));
+
+    // Codec desconhecido
+    EXPECT_FALSE(ChunkCodec::decode(static_cast<ChunkCodec::Codec>(ChunkCodec::CODEC_COUNT),
+                                    block.data(), block.size(), decoded.data()));
+
+    // LZ: tamanho de saída diferente do esperado
+    std::vector<uint8_t> data(5000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i % 7 == 0 ? i : 0);
+    }
+    std::vector<uint8_t> compressed;
+    ChunkCodec::lzCompress(data.data(), data.size(), compressed);
+    std::vector<uint8_t> out(data.size() + 1);
+    ASSERT_TRUE(ChunkCodec::lzDecompress(compressed.data(), compressed.size(), out.data(), data.size()));
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), out.begin()));
+    EXPECT_FALSE(ChunkCodec::lzDecompress(compressed.data(), compressed.size(), out.data(), data.size() + 1));
+    EXPECT_FALSE(ChunkCodec::lzDecompress(compressed.data(), compressed.size(), out.data(), data.size() - 1));
+}
+
+/**
+ * @brief Bytes trocados ao acaso nunca escrevem fora das VOLUME células de destino
+ */
+TEST(ChunkCodecTest, RandomMutationsStayInBounds) {
+    std::mt19937 random(4404);
+    for (const auto& sample : samples()) {
+        for (ChunkCodec::Codec codec : CODECS) {
+            std::vector<uint8_t> block;
+            ChunkCodec::encode(codec, sample.second.data(), block);
+            for (int attempt = 0; attempt < 200; attempt++) {
+                std::vector<uint8_t> mutated = block;
+                for (int flips = 1 + static_cast<int>(random() % 4); flips > 0; flips--) {
+                    mutated[random() % mutated.size()] ^= static_cast<uint8_t>(1 + random() % 255);
+                }
+                guardedDecode(codec, mutated, mutated.size());
+            }
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#include "HeadlessContext.hpp"
+#include "graphics/GpuUploadManager.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace VoxelMaker;
+
+namespace {
+
+/**
+ * @brief Malha com conteúdo aleatório (os valores só precisam ser reconhecíveis na leitura)
+ */
+Mesh randomMesh(std::mt19937& random, size_t vertexCount, size_t indexCount) {
+    std::vector<Mesh::Vertex> vertices(vertexCount);
+    for (auto& vertex : vertices) {
+        vertex.position = glm::vec3(static_cast<float>(random() % 1000), static_cast<float>(random() % 1000),
+                                    static_cast<float>(random() % 1000));
+        vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+        vertex.color = Voxel::Color(random() % 256, random() % 256, random() % 256, 255);
+        vertex.ao = static_cast<float>(random() % 4) / 3.0f;
+    }
+    std::vector<uint32_t> indices(indexCount);
+    for (auto& index : indices) {
+        index = static_cast<uint32_t>(random() % vertexCount);
+    }
+
+    Mesh mesh;
+    mesh.assign(vertices.data(), vertices.size(), indices.data(), indices.size());
+    return mesh;
+}
+
+/**
+ * @brief Lê uma faixa de um buffer OpenGL
+ */
+std::vector<uint8_t> readBack(GLuint buffer, size_t offset, size_t size) {
+    std::vector<uint8_t> data(size);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    return data;
+}
+
+/**
+ * @brief Envia muitas malhas (crescendo os buffers, dando a volta no anel e passando do
+ *        tamanho dele) e confere byte a byte o conteúdo final de cada faixa viva
+ */
+void uploadAndReadBack(bool allowPersistentMapping) {
+    HeadlessContext context;
+    if (!context.isValid()) {
+        GTEST_SKIP() << "Contexto OpenGL sem janela indisponível";
+    }
+
+    GpuUploadManager::Settings settings;
+    settings.ringCapacity = 128 * 1024;
+    settings.vertexCapacity = 64 * 1024;
+    settings.indexCapacity = 16 * 1024;
+    settings.allowPersistentMapping = allowPersistentMapping;
+
+    GpuUploadManager manager;
+    ASSERT_TRUE(manager.initialize(settings));
+
+    const size_t chunkCount = 48;
+    std::vector<Mesh> meshes(chunkCount);
+    std::vector<GpuUploadManager::Allocation> allocations(chunkCount);
+    std::mt19937 random(2024);
+
+    for (int step = 0; step < 400; step++) {
+        size_t chunk = random() % chunkCount;
+        if (random() % 8 == 0) {
+            manager.release(allocations[chunk]);
+            meshes[chunk] = Mesh();
+        } else {
+            // De vez em quando uma malha maior que o anel (envio direto)
+            size_t vertexCount = random() % 16 == 0 ? 6000 : 1 + random() % 800;
+            meshes[chunk] = randomMesh(random, vertexCount, vertexCount * 3 / 2);
+            ASSERT_TRUE(manager.upload(meshes[chunk], allocations[chunk]));
+        }
+        if (step % 10 == 9) {
+            manager.endFrame();
+        }
+    }
+    manager.endFrame();
+    glFinish();
+    ASSERT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+
+    GpuUploadManager::Stats stats = manager.getStats();
+    EXPECT_GT(stats.bufferGrowths, 0u);
+    EXPECT_GT(stats.directUploads, 0u);
+    EXPECT_GT(manager.getRing().getStats().bytesWritten, settings.ringCapacity);
+
+    for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+        const GpuUploadManager::Allocation& allocation = allocations[chunk];
+        if (!allocation.isValid()) continue;
+
+        const Mesh& mesh = meshes[chunk];
+        size_t vertexBytes = mesh.getVertexCount() * sizeof(Mesh::Vertex);
+        size_t indexBytes = mesh.getIndexCount() * sizeof(uint32_t);
+        EXPECT_EQ(allocation.indexCount, mesh.getIndexCount());
+        EXPECT_EQ(static_cast<size_t>(allocation.baseVertex) * sizeof(Mesh::Vertex), allocation.vertexOffset);
+
+        std::vector<uint8_t> vertices = readBack(manager.getVertexBuffer(), allocation.vertexOffset, vertexBytes);
+        std::vector<uint8_t> indices = readBack(manager.getIndexBuffer(), allocation.indexOffset, indexBytes);
+        EXPECT_EQ(std::memcmp(vertices.data(), mesh.getVertices().data(), vertexBytes), 0) << "chunk " << chunk;
+        EXPECT_EQ(std::memcmp(indices.data(), mesh.getIndices().data(), indexBytes), 0) << "chunk " << chunk;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Anel mapeado de forma persistente (GL 4.4 / ARB_buffer_storage), se disponível
+ */
+TEST(GpuUploadManagerGLTest, PersistentRingReadBack) {
+    uploadAndReadBack(true);
+}
+
+/**
+ * @brief Caminho OpenGL 3.3: glMapBufferRange sincronizado por fences a cada escrita
+ */
+TEST(GpuUploadManagerGLTest, MappedRangeRingReadBack) {
+    uploadAndReadBack(false);
+}
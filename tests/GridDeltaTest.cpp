@@ -0,0 +1,138 @@
+#include "core/GridDelta.hpp"
+#include <gtest/gtest.h>
+
+using namespace VoxelMaker;
+
+namespace {
+
+const int EXTENT = 2 * VoxelChunk::SIZE;
+
+/**
+ * @brief Camada de 4 voxels de altura sobre 2x2 chunks, na cor dada
+ */
+void fillGround(VoxelGrid& grid, const Voxel::Color& color) {
+    grid.setDimensions(VoxelGrid::Dimensions(EXTENT, EXTENT, EXTENT));
+    for (int z = 0; z < EXTENT; z++) {
+        for (int x = 0; x < EXTENT; x++) {
+            for (int y = 0; y < 4; y++) {
+                grid.addVoxel(Voxel(glm::ivec3(x, y, z), color));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Primeira edição: cores novas em um chunk e o chunk (1, 0, 1) esvaziado
+ */
+void firstEdit(VoxelGrid& grid) {
+    grid.addVoxel(Voxel(glm::ivec3(3, 10, 3), Voxel::Color(250, 10, 10)));
+    grid.addVoxel(Voxel(glm::ivec3(4, 10, 3), Voxel::Color(10, 10, 250)));
+    for (int z = VoxelChunk::SIZE; z < EXTENT; z++) {
+        for (int x = VoxelChunk::SIZE; x < EXTENT; x++) {
+            for (int y = 0; y < 4; y++) {
+                grid.removeVoxel(glm::ivec3(x, y, z));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Segunda edição, sobre a primeira: outra cor nova em outro chunk
+ */
+void secondEdit(VoxelGrid& grid) {
+    grid.addVoxel(Voxel(glm::ivec3(40, 20, 5), Voxel::Color(250, 250, 10)));
+    grid.removeVoxel(glm::ivec3(0, 0, 0));
+}
+
+} // namespace
+
+/**
+ * @brief O delta leva uma cópia da base ao conteúdo e à paleta do destino
+ */
+TEST(GridDeltaTest, ApplyReachesTarget) {
+    VoxelGrid base;
+    fillGround(base, Voxel::Color(40, 120, 40));
+    VoxelGrid target;
+    fillGround(target, Voxel::Color(40, 120, 40));
+    firstEdit(target);
+
+    GridDelta delta;
+    ASSERT_TRUE(delta.compute(base, target));
+    EXPECT_FALSE(delta.getStats().full);
+    EXPECT_EQ(delta.getStats().removedChunks, 1u);
+    EXPECT_EQ(delta.getStats().paletteEntries, 2u);
+
+    ASSERT_TRUE(delta.apply(base));
+    EXPECT_EQ(base.getContentHash(), target.getContentHash());
+    EXPECT_EQ(base.getVoxelCount(), target.getVoxelCount());
+    EXPECT_EQ(base.getPalette().size(), target.getPalette().size());
+    EXPECT_EQ(base.getChunk(glm::ivec3(1, 0, 1)), nullptr);
+}
+
+/**
+ * @brief O grid corrigido por um delta aceita o delta seguinte da mesma sequência
+ */
+TEST(GridDeltaTest, ChainedDeltasApply) {
+    VoxelGrid base;
+    fillGround(base, Voxel::Color(40, 120, 40));
+    VoxelGrid first;
+    fillGround(first, Voxel::Color(40, 120, 40));
+    firstEdit(first);
+    VoxelGrid second;
+    fillGround(second, Voxel::Color(40, 120, 40));
+    firstEdit(second);
+    secondEdit(second);
+
+    GridDelta toFirst;
+    ASSERT_TRUE(toFirst.compute(base, first));
+    GridDelta toSecond;
+    ASSERT_TRUE(toSecond.compute(first, second));
+
+    ASSERT_TRUE(toFirst.apply(base));
+    EXPECT_EQ(base.getContentHash(), first.getContentHash());
+    ASSERT_TRUE(toSecond.apply(base));
+    EXPECT_EQ(base.getContentHash(), second.getContentHash());
+    EXPECT_EQ(base.getVoxelCount(), second.getVoxelCount());
+}
+
+/**
+ * @brief Mesmos índices com cores diferentes não passam pela conferência da base
+ */
+TEST(GridDeltaTest, DifferentPaletteIsRejected) {
+    VoxelGrid base;
+    fillGround(base, Voxel::Color(40, 120, 40));
+    VoxelGrid target;
+    fillGround(target, Voxel::Color(40, 120, 40));
+    firstEdit(target);
+    GridDelta delta;
+    ASSERT_TRUE(delta.compute(base, target));
+
+    VoxelGrid other;
+    fillGround(other, Voxel::Color(120, 40, 40));
+    ASSERT_EQ(other.getContentHash(), base.getContentHash());
+    uint64_t before = other.getContentHash();
+    EXPECT_FALSE(delta.apply(other));
+    EXPECT_EQ(other.getContentHash(), before);
+    EXPECT_EQ(other.getPalette().size(), 2u);
+}
+
+/**
+ * @brief Paletas que discordam nos índices em comum geram um delta completo
+ */
+TEST(GridDeltaTest, IncompatiblePalettesSendEverything) {
+    VoxelGrid base;
+    fillGround(base, Voxel::Color(40, 120, 40));
+    VoxelGrid target;
+    fillGround(target, Voxel::Color(120, 40, 40));
+    firstEdit(target);
+
+    GridDelta delta;
+    ASSERT_TRUE(delta.compute(base, target));
+    EXPECT_TRUE(delta.getStats().full);
+    EXPECT_EQ(delta.getStats().changedChunks, target.getChunks().size());
+
+    ASSERT_TRUE(delta.apply(base));
+    EXPECT_EQ(base.getContentHash(), target.getContentHash());
+    EXPECT_EQ(base.getPalette().size(), target.getPalette().size());
+    EXPECT_EQ(base.getPalette().get(1).getColor().r, 120);
+}
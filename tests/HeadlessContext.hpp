@@ -0,0 +1,72 @@
+#pragma once
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <glad/glad.h>
+
+namespace VoxelMaker {
+
+/**
+ * @brief Contexto OpenGL 3.3 core sem janela (EGL surfaceless), para testes em CI
+ *
+ * Com Mesa, LIBGL_ALWAYS_SOFTWARE=1 força o llvmpipe. Se a plataforma não suportar
+ * contextos sem superfície, isValid() retorna false e o teste deve ser ignorado.
+ */
+class HeadlessContext {
+private:
+    EGLDisplay display;
+    EGLContext context;
+
+public:
+    HeadlessContext()
+        : display(EGL_NO_DISPLAY)
+        , context(EGL_NO_CONTEXT) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (!getPlatformDisplay) return;
+
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        EGLint major = 0, minor = 0;
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+            display = EGL_NO_DISPLAY;
+            return;
+        }
+        eglBindAPI(EGL_OPENGL_API);
+
+        const EGLint attributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+        if (context == EGL_NO_CONTEXT ||
+            !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) ||
+            !gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+            release();
+        }
+    }
+
+    ~HeadlessContext() {
+        release();
+    }
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    bool isValid() const { return context != EGL_NO_CONTEXT; }
+
+private:
+    void release() {
+        if (display == EGL_NO_DISPLAY) return;
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context != EGL_NO_CONTEXT) {
+            eglDestroyContext(display, context);
+        }
+        eglTerminate(display);
+        display = EGL_NO_DISPLAY;
+        context = EGL_NO_CONTEXT;
+    }
+};
+
+} // namespace VoxelMaker
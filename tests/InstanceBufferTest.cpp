@@ -0,0 +1,173 @@
+#include "graphics/InstanceBuffer.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace VoxelMaker;
+
+namespace {
+
+/**
+ * @brief Índice de paleta de um voxel ativo ou inativo
+ */
+VoxelPalette::Index paletteIndex(VoxelGrid& grid, const Voxel::Color& color, bool active) {
+    Voxel voxel(glm::ivec3(0), color);
+    voxel.setActive(active);
+    return grid.addPaletteEntry(voxel);
+}
+
+/**
+ * @brief Insere um chunk com as células dadas
+ */
+void insertChunk(VoxelGrid& grid, const glm::ivec3& coord, std::vector<VoxelChunk::Cell> cells) {
+    grid.insertChunk(std::unique_ptr<VoxelChunk>(new VoxelChunk(coord, std::move(cells))));
+}
+
+/**
+ * @brief Células de um chunk com os primeiros count voxels preenchidos
+ */
+std::vector<VoxelChunk::Cell> firstCells(int count, VoxelPalette::Index index) {
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+    for (int i = 0; i < count; i++) {
+        cells[i] = index;
+    }
+    return cells;
+}
+
+} // namespace
+
+/**
+ * @brief pack/unpackPosition preservam os 16 bits de cada campo
+ */
+TEST(InstanceBufferTest, PackRoundTrip) {
+    static_assert(sizeof(InstanceBuffer::Instance) == 8, "Instância deve ocupar 8 bytes");
+
+    const glm::ivec3 positions[] = {
+        glm::ivec3(0, 0, 0),
+        glm::ivec3(1, 2, 3),
+        glm::ivec3(InstanceBuffer::MAX_COORDINATE, 0, 31),
+        glm::ivec3(300, InstanceBuffer::MAX_COORDINATE, InstanceBuffer::MAX_COORDINATE),
+    };
+    for (const glm::ivec3& position : positions) {
+        InstanceBuffer::Instance instance = InstanceBuffer::pack(position, 0xBEEF);
+        EXPECT_EQ(InstanceBuffer::unpackPosition(instance), position);
+        EXPECT_EQ(instance.paletteIndex, 0xBEEF);
+    }
+
+    EXPECT_EQ(InstanceBuffer::packColor(Voxel::Color(0x11, 0x22, 0x33, 0x44)), 0x44332211u);
+}
+
+/**
+ * @brief Cada chunk ocupa uma faixa contígua, na ordem z, y, x, com deslocamentos somados
+ */
+TEST(InstanceBufferTest, PerChunkPrefixSumLayout) {
+    VoxelGrid grid(VoxelGrid::Dimensions(128, 64, 128));
+    VoxelPalette::Index solid = paletteIndex(grid, Voxel::Color(200, 10, 10), true);
+
+    // Inseridos fora de ordem; o buffer ordena por z, depois y, depois x
+    insertChunk(grid, glm::ivec3(0, 0, 1), firstCells(5, solid));
+    insertChunk(grid, glm::ivec3(1, 0, 0), firstCells(3, solid));
+    insertChunk(grid, glm::ivec3(0, 1, 0), firstCells(2, solid));
+    insertChunk(grid, glm::ivec3(0, 0, 0), firstCells(7, solid));
+
+    InstanceBuffer buffer;
+    buffer.setExposedOnly(false);
+    ASSERT_TRUE(buffer.update(grid));
+    EXPECT_FALSE(buffer.update(grid));
+
+    const std::vector<glm::ivec3> expectedCoords = {
+        glm::ivec3(0, 0, 0), glm::ivec3(1, 0, 0), glm::ivec3(0, 1, 0), glm::ivec3(0, 0, 1)
+    };
+    const std::vector<size_t> expectedOffsets = { 0, 7, 10, 12, 17 };
+    EXPECT_EQ(buffer.getChunkCoords(), expectedCoords);
+    EXPECT_EQ(buffer.getChunkOffsets(), expectedOffsets);
+    ASSERT_EQ(buffer.getInstanceCount(), 17u);
+
+    // Cada instância está dentro do chunk dono da sua faixa
+    const std::vector<size_t>& offsets = buffer.getChunkOffsets();
+    for (size_t chunk = 0; chunk < expectedCoords.size(); chunk++) {
+        glm::ivec3 origin = expectedCoords[chunk] * VoxelChunk::SIZE;
+        for (size_t i = offsets[chunk]; i < offsets[chunk + 1]; i++) {
+            glm::ivec3 local = InstanceBuffer::unpackPosition(buffer.getInstances()[i]) - origin;
+            EXPECT_EQ(local, glm::ivec3(static_cast<int>(i - offsets[chunk]), 0, 0));
+            EXPECT_EQ(buffer.getInstances()[i].paletteIndex, solid);
+        }
+    }
+
+    ASSERT_EQ(buffer.getPaletteColors().size(), grid.getPalette().size());
+    EXPECT_EQ(buffer.getPaletteColors()[solid], InstanceBuffer::packColor(Voxel::Color(200, 10, 10)));
+}
+
+/**
+ * @brief Só voxels com alguma face livre viram instâncias
+ */
+TEST(InstanceBufferTest, ExposedOnlySkipsHiddenVoxels) {
+    VoxelGrid grid(VoxelGrid::Dimensions(64, 64, 64));
+    VoxelPalette::Index solid = paletteIndex(grid, Voxel::Color(10, 200, 10), true);
+
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+    for (int z = 4; z < 7; z++) {
+        for (int y = 4; y < 7; y++) {
+            for (int x = 4; x < 7; x++) {
+                cells[VoxelChunk::index(x, y, z)] = solid;
+            }
+        }
+    }
+    insertChunk(grid, glm::ivec3(0, 0, 0), std::move(cells));
+
+    InstanceBuffer buffer;
+    buffer.build(grid);
+    EXPECT_EQ(buffer.getInstanceCount(), 26u);
+
+    buffer.setExposedOnly(false);
+    EXPECT_TRUE(buffer.update(grid));
+    EXPECT_EQ(buffer.getInstanceCount(), 27u);
+}
+
+/**
+ * @brief Entradas inativas da paleta não são desenhadas nem escondem vizinhos (como no ChunkMesher)
+ */
+TEST(InstanceBufferTest, InactiveVoxelsAreInvisible) {
+    VoxelGrid grid(VoxelGrid::Dimensions(64, 64, 64));
+    VoxelPalette::Index solid = paletteIndex(grid, Voxel::Color(10, 10, 200), true);
+    VoxelPalette::Index inactive = paletteIndex(grid, Voxel::Color(10, 10, 100), false);
+
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME, inactive);
+    cells[VoxelChunk::index(8, 8, 8)] = solid;
+    insertChunk(grid, glm::ivec3(0, 0, 0), std::move(cells));
+
+    InstanceBuffer buffer;
+    buffer.build(grid);
+    ASSERT_EQ(buffer.getInstanceCount(), 1u);
+    EXPECT_EQ(InstanceBuffer::unpackPosition(buffer.getInstances()[0]), glm::ivec3(8, 8, 8));
+    EXPECT_EQ(buffer.getInstances()[0].paletteIndex, solid);
+
+    buffer.setExposedOnly(false);
+    buffer.build(grid);
+    EXPECT_EQ(buffer.getInstanceCount(), 1u);
+}
+
+/**
+ * @brief Chunks com origem negativa ou além de MAX_COORDINATE ficam de fora (não dão a volta em 16 bits)
+ */
+TEST(InstanceBufferTest, OutOfRangeChunksAreSkipped) {
+    VoxelGrid grid(VoxelGrid::Dimensions(64, 64, 64));
+    VoxelPalette::Index solid = paletteIndex(grid, Voxel::Color(200, 200, 10), true);
+
+    insertChunk(grid, glm::ivec3(0, 0, 0), firstCells(4, solid));
+    insertChunk(grid, glm::ivec3(-1, 0, 0), firstCells(5, solid));
+    insertChunk(grid, glm::ivec3(0, -1, 0), firstCells(6, solid));
+    insertChunk(grid, glm::ivec3(0, 0, (InstanceBuffer::MAX_COORDINATE + 1) / VoxelChunk::SIZE), firstCells(7, solid));
+
+    InstanceBuffer buffer;
+    buffer.setExposedOnly(false);
+    buffer.build(grid);
+    EXPECT_EQ(buffer.getChunkCoords(), std::vector<glm::ivec3>{ glm::ivec3(0, 0, 0) });
+    ASSERT_EQ(buffer.getInstanceCount(), 4u);
+    for (const InstanceBuffer::Instance& instance : buffer.getInstances()) {
+        glm::ivec3 position = InstanceBuffer::unpackPosition(instance);
+        EXPECT_LT(position.x, VoxelChunk::SIZE);
+        EXPECT_LT(position.y, VoxelChunk::SIZE);
+        EXPECT_LT(position.z, VoxelChunk::SIZE);
+    }
+}
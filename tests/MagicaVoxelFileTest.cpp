@@ -0,0 +1,177 @@
+#include "core/MagicaVoxelFile.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace VoxelMaker;
+
+namespace {
+
+/**
+ * @brief Monta o conteúdo de um chunk .vox (inteiros little-endian, strings com tamanho)
+ */
+class ChunkWriter {
+private:
+    std::vector<uint8_t> bytes;
+
+public:
+    ChunkWriter& integer(int32_t value) {
+        for (int i = 0; i < 4; i++) {
+            bytes.push_back(static_cast<uint8_t>(static_cast<uint32_t>(value) >> (8 * i)));
+        }
+        return *this;
+    }
+
+    ChunkWriter& text(const std::string& value) {
+        integer(static_cast<int32_t>(value.size()));
+        bytes.insert(bytes.end(), value.begin(), value.end());
+        return *this;
+    }
+
+    ChunkWriter& emptyDictionary() { return integer(0); }
+
+    const std::vector<uint8_t>& data() const { return bytes; }
+};
+
+/**
+ * @brief Arquivo .vox com um modelo 2x2x2 de um voxel e os nós de cena dados
+ */
+class VoxBuilder {
+private:
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> chunks;
+
+public:
+    VoxBuilder() {
+        chunks.emplace_back("SIZE", ChunkWriter().integer(2).integer(2).integer(2).data());
+        uint32_t voxel = 1u << 24;      // (0, 0, 0) com a cor 1
+        chunks.emplace_back("XYZI", ChunkWriter().integer(1).integer(static_cast<int32_t>(voxel)).data());
+    }
+
+    VoxBuilder& transform(int id, int child, int x) {
+        ChunkWriter writer;
+        writer.integer(id).emptyDictionary().integer(child).integer(-1).integer(-1).integer(1);
+        writer.integer(1).text("_t").text(std::to_string(x) + " 0 0");
+        chunks.emplace_back("nTRN", writer.data());
+        return *this;
+    }
+
+    VoxBuilder& group(int id, const std::vector<int>& children) {
+        ChunkWriter writer;
+        writer.integer(id).emptyDictionary().integer(static_cast<int32_t>(children.size()));
+        for (int child : children) {
+            writer.integer(child);
+        }
+        chunks.emplace_back("nGRP", writer.data());
+        return *this;
+    }
+
+    VoxBuilder& shape(int id) {
+        chunks.emplace_back("nSHP", ChunkWriter().integer(id).emptyDictionary().integer(1)
+                                        .integer(0).emptyDictionary().data());
+        return *this;
+    }
+
+    std::string write(const std::string& name) const {
+        std::vector<uint8_t> children;
+        for (const auto& chunk : chunks) {
+            children.insert(children.end(), chunk.first.begin(), chunk.first.end());
+            std::vector<uint8_t> header = ChunkWriter().integer(static_cast<int32_t>(chunk.second.size()))
+                                                       .integer(0).data();
+            children.insert(children.end(), header.begin(), header.end());
+            children.insert(children.end(), chunk.second.begin(), chunk.second.end());
+        }
+
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        std::vector<uint8_t> header = ChunkWriter().integer(MagicaVoxelFile::FILE_VERSION).data();
+        file.write("VOX ", 4);
+        file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        file.write("MAIN", 4);
+        header = ChunkWriter().integer(0).integer(static_cast<int32_t>(children.size())).data();
+        file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        file.write(reinterpret_cast<const char*>(children.data()), static_cast<std::streamsize>(children.size()));
+        return path;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Cena válida: transformação -> grupo -> duas transformações -> mesmo shape
+ */
+TEST(MagicaVoxelFileTest, SceneGraphInstances) {
+    std::string path = VoxBuilder().transform(0, 1, 0).group(1, {2, 4}).transform(2, 3, 0)
+                                   .shape(3).transform(4, 3, 10).write("voxelmaker_scene.vox");
+    VoxelGrid grid;
+    MagicaVoxelFile file;
+    ASSERT_TRUE(file.load(path, grid));
+    EXPECT_EQ(file.getStats().instances, 2u);
+    EXPECT_EQ(file.getStats().voxels, 2u);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Um grupo que é filho de si mesmo (via transformação) é recusado
+ */
+TEST(MagicaVoxelFileTest, CycleIsRejected) {
+    std::string path = VoxBuilder().transform(0, 1, 0).group(1, {2, 3}).transform(2, 1, 5)
+                                   .shape(3).write("voxelmaker_cycle.vox");
+    VoxelGrid grid;
+    MagicaVoxelFile file;
+    EXPECT_FALSE(file.load(path, grid));
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Um grupo com o mesmo filho repetido passa do limite de instâncias
+ */
+TEST(MagicaVoxelFileTest, TooManyInstancesAreRejected) {
+    std::vector<int> children(100000, 2);
+    std::string path = VoxBuilder().transform(0, 1, 0).group(1, children).transform(2, 3, 0)
+                                   .shape(3).write("voxelmaker_wide.vox");
+    VoxelGrid grid;
+    MagicaVoxelFile file;
+    EXPECT_FALSE(file.load(path, grid));
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Grupos que repetem a mesma subárvore não percorrem um número exponencial de nós
+ */
+TEST(MagicaVoxelFileTest, ExponentialSceneIsRejected) {
+    // Cada nível referencia o próximo duas vezes: 2^40 caminhos (o shape fica além da
+    // profundidade máxima, então nenhuma instância é criada)
+    VoxBuilder builder;
+    const int levels = 40;
+    builder.transform(0, 1, 0);
+    for (int level = 0; level < levels; level++) {
+        int groupId = 1 + 2 * level;
+        builder.group(groupId, {groupId + 1, groupId + 1});
+        builder.transform(groupId + 1, groupId + 2, 0);
+    }
+    builder.shape(1 + 2 * levels);
+    std::string path = builder.write("voxelmaker_exponential.vox");
+
+    VoxelGrid grid;
+    MagicaVoxelFile file;
+    EXPECT_FALSE(file.load(path, grid));
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Nós de cena sem o nó 0: cada modelo é importado na origem, como em arquivos antigos
+ */
+TEST(MagicaVoxelFileTest, MissingRootFallsBackToModels) {
+    std::string path = VoxBuilder().transform(5, 6, 0).shape(6).write("voxelmaker_no_root.vox");
+    VoxelGrid grid;
+    MagicaVoxelFile file;
+    ASSERT_TRUE(file.load(path, grid));
+    EXPECT_EQ(file.getStats().instances, 1u);
+    EXPECT_EQ(file.getStats().voxels, 1u);
+    std::remove(path.c_str());
+}
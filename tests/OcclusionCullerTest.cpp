@@ -0,0 +1,175 @@
+#include "graphics/OcclusionCuller.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace VoxelMaker;
+
+namespace {
+
+const float NEAR_PLANE = 0.1f;
+
+/**
+ * @brief Matriz projeção * view com a proporção do buffer padrão (256x128)
+ */
+glm::mat4 viewProjection(const glm::vec3& eye, const glm::vec3& target) {
+    return glm::perspective(glm::radians(60.0f), 2.0f, NEAR_PLANE, 1000.0f) *
+           glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+/**
+ * @brief Índice de paleta de um voxel ativo ou inativo
+ */
+VoxelPalette::Index paletteIndex(VoxelGrid& grid, bool active) {
+    Voxel voxel(glm::ivec3(0), Voxel::Color(200, 120, 40));
+    voxel.setActive(active);
+    return grid.addPaletteEntry(voxel);
+}
+
+/**
+ * @brief Insere um chunk totalmente preenchido com um índice
+ */
+void fillChunk(VoxelGrid& grid, const glm::ivec3& coord, VoxelPalette::Index index) {
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME, index);
+    grid.insertChunk(std::unique_ptr<VoxelChunk>(new VoxelChunk(coord, std::move(cells))));
+}
+
+/**
+ * @brief Insere um chunk com um único voxel no canto mínimo
+ */
+void sparseChunk(VoxelGrid& grid, const glm::ivec3& coord, VoxelPalette::Index index) {
+    std::vector<VoxelChunk::Cell> cells(VoxelChunk::VOLUME, VoxelPalette::EMPTY);
+    cells[VoxelChunk::index(0, 0, 0)] = index;
+    grid.insertChunk(std::unique_ptr<VoxelChunk>(new VoxelChunk(coord, std::move(cells))));
+}
+
+/**
+ * @brief Lista de chunks visíveis, na ordem dada (da frente para trás), com as caixas dos chunks
+ */
+struct VisibleList {
+    std::vector<std::unique_ptr<ChunkMeshManager::ChunkMesh>> meshes;
+    std::vector<FrustumCuller::VisibleChunk> chunks;
+
+    void add(const glm::ivec3& coord) {
+        std::unique_ptr<ChunkMeshManager::ChunkMesh> mesh(new ChunkMeshManager::ChunkMesh());
+        mesh->boundsMin = glm::vec3(coord * VoxelChunk::SIZE);
+        mesh->boundsMax = mesh->boundsMin + glm::vec3(static_cast<float>(VoxelChunk::SIZE));
+
+        FrustumCuller::VisibleChunk chunk;
+        chunk.coord = coord;
+        chunk.mesh = mesh.get();
+        chunk.distance = static_cast<float>(chunks.size());
+        chunks.push_back(chunk);
+        meshes.push_back(std::move(mesh));
+    }
+
+    bool contains(const glm::ivec3& coord) const {
+        for (const auto& chunk : chunks) {
+            if (chunk.coord == coord) return true;
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Um chunk sólido esconde o chunk logo atrás dele
+ */
+TEST(OcclusionCullerTest, WallHidesChunkBehind) {
+    VoxelGrid grid(VoxelGrid::Dimensions(128, 128, 256));
+    VoxelPalette::Index solid = paletteIndex(grid, true);
+    fillChunk(grid, glm::ivec3(0, 0, 0), solid);
+    sparseChunk(grid, glm::ivec3(0, 0, 2), solid);
+
+    VisibleList list;
+    list.add(glm::ivec3(0, 0, 0));
+    list.add(glm::ivec3(0, 0, 2));
+
+    OcclusionCuller culler;
+    culler.cullChunks(grid, viewProjection(glm::vec3(16.0f, 16.0f, -40.0f), glm::vec3(16.0f, 16.0f, 100.0f)), list.chunks);
+
+    EXPECT_GT(culler.getStats().occludersRasterized, 0u);
+    EXPECT_TRUE(list.contains(glm::ivec3(0, 0, 0)));
+    EXPECT_FALSE(list.contains(glm::ivec3(0, 0, 2)));
+    EXPECT_EQ(culler.getStats().chunksCulled, 1u);
+}
+
+/**
+ * @brief Entradas inativas da paleta não geram faces no ChunkMesher e não podem ocluir
+ */
+TEST(OcclusionCullerTest, InactiveVoxelsDoNotOcclude) {
+    VoxelGrid grid(VoxelGrid::Dimensions(128, 128, 256));
+    VoxelPalette::Index solid = paletteIndex(grid, true);
+    VoxelPalette::Index inactive = paletteIndex(grid, false);
+    EXPECT_FALSE(grid.getPalette().isSolid(inactive));
+    fillChunk(grid, glm::ivec3(0, 0, 0), inactive);
+    sparseChunk(grid, glm::ivec3(0, 0, 2), solid);
+
+    std::vector<OcclusionCuller::Occluder> occluders;
+    OcclusionCuller::extractOccluders(*grid.getChunk(glm::ivec3(0, 0, 0)), grid.getPalette(), 1, occluders);
+    EXPECT_TRUE(occluders.empty());
+
+    VisibleList list;
+    list.add(glm::ivec3(0, 0, 0));
+    list.add(glm::ivec3(0, 0, 2));
+
+    OcclusionCuller culler;
+    culler.cullChunks(grid, viewProjection(glm::vec3(16.0f, 16.0f, -40.0f), glm::vec3(16.0f, 16.0f, 100.0f)), list.chunks);
+
+    EXPECT_TRUE(list.contains(glm::ivec3(0, 0, 2)));
+    EXPECT_EQ(culler.getStats().chunksCulled, 0u);
+}
+
+/**
+ * @brief Um chunk que cruza o plano próximo continua visível, mesmo atrás de um oclusor
+ */
+TEST(OcclusionCullerTest, ChunkAtNearPlaneStaysVisible) {
+    VoxelGrid grid(VoxelGrid::Dimensions(128, 128, 256));
+    VoxelPalette::Index solid = paletteIndex(grid, true);
+    sparseChunk(grid, glm::ivec3(0, 0, 0), solid);
+    fillChunk(grid, glm::ivec3(0, 0, 1), solid);
+    sparseChunk(grid, glm::ivec3(0, 0, 3), solid);
+
+    // Câmera dentro do chunk (0, 0, 0), a um passo do plano próximo da parede em z = 32
+    VisibleList list;
+    list.add(glm::ivec3(0, 0, 0));
+    list.add(glm::ivec3(0, 0, 1));
+    list.add(glm::ivec3(0, 0, 3));
+
+    OcclusionCuller culler;
+    glm::vec3 eye(16.0f, 16.0f, 32.0f - 2.0f * NEAR_PLANE);
+    culler.cullChunks(grid, viewProjection(eye, eye + glm::vec3(0.0f, 0.0f, 1.0f)), list.chunks);
+
+    EXPECT_TRUE(list.contains(glm::ivec3(0, 0, 0)));
+    EXPECT_TRUE(list.contains(glm::ivec3(0, 0, 1)));
+    EXPECT_FALSE(list.contains(glm::ivec3(0, 0, 3)));
+}
+
+/**
+ * @brief Os oclusores de um chunk ficam nas faces da própria caixa e nunca o descartam
+ */
+TEST(OcclusionCullerTest, ChunkNeverOccludesItself) {
+    const glm::vec3 eyes[] = {
+        glm::vec3(16.0f, 16.0f, -40.0f),
+        glm::vec3(-30.0f, 50.0f, -30.0f),
+        glm::vec3(70.0f, -20.0f, 90.0f),
+        glm::vec3(16.0f, 120.0f, 40.0f),
+        glm::vec3(33.0f, 33.0f, 33.0f),
+    };
+
+    VoxelGrid grid(VoxelGrid::Dimensions(128, 128, 128));
+    VoxelPalette::Index solid = paletteIndex(grid, true);
+    fillChunk(grid, glm::ivec3(0, 0, 0), solid);
+
+    OcclusionCuller culler;
+    for (const glm::vec3& eye : eyes) {
+        VisibleList list;
+        list.add(glm::ivec3(0, 0, 0));
+        culler.cullChunks(grid, viewProjection(eye, glm::vec3(16.0f)), list.chunks);
+
+        EXPECT_GT(culler.getStats().occludersRasterized, 0u);
+        EXPECT_TRUE(list.contains(glm::ivec3(0, 0, 0)));
+    }
+}
@@ -0,0 +1,179 @@
+#include "HeadlessContext.hpp"
+#include "graphics/Shader.hpp"
+#include "graphics/ShaderCache.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace VoxelMaker;
+
+namespace {
+
+const char* VERTEX_SOURCE = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+uniform mat4 transform;
+void main() {
+    gl_Position = transform * vec4(aPos, 1.0);
+}
+)";
+
+const char* FRAGMENT_SOURCE = R"(
+#version 330 core
+out vec4 FragColor;
+uniform vec4 color;
+void main() {
+    FragColor = color;
+}
+)";
+
+/**
+ * @brief Arquivos .bin do diretório do cache
+ */
+std::vector<std::filesystem::path> cacheFiles(const std::filesystem::path& directory) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".bin") {
+            files.push_back(entry.path());
+        }
+    }
+    return files;
+}
+
+/**
+ * @brief Compila um programa passando pelo cache global e confere que ele está linkado
+ */
+void compileProgram(const std::string& fragmentSource) {
+    Shader shader;
+    ASSERT_TRUE(shader.compile(VERTEX_SOURCE, fragmentSource));
+    GLint linked = 0;
+    glGetProgramiv(shader.getProgramID(), GL_LINK_STATUS, &linked);
+    EXPECT_NE(linked, 0);
+    EXPECT_GE(glGetUniformLocation(shader.getProgramID(), "color"), 0);
+}
+
+/**
+ * @brief Contexto, diretório temporário e cache global apontando para ele
+ */
+class ShaderCacheGLTest : public ::testing::Test {
+protected:
+    HeadlessContext context;
+    std::filesystem::path directory;
+
+    void SetUp() override {
+        if (!context.isValid()) {
+            GTEST_SKIP() << "Contexto OpenGL sem janela indisponível";
+        }
+        directory = std::filesystem::temp_directory_path() /
+                    ("voxelmaker_shader_cache_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(directory);
+        ASSERT_TRUE(ShaderCache::getInstance().setDirectory(directory.string()));
+        if (!ShaderCache::getInstance().isEnabled()) {
+            GTEST_SKIP() << "Driver sem binários de programa";
+        }
+    }
+
+    void TearDown() override {
+        ShaderCache::getInstance().setDirectory("");
+        if (!directory.empty()) {
+            std::filesystem::remove_all(directory);
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Primeira compilação é um miss e grava o binário; a segunda vem do cache
+ */
+TEST_F(ShaderCacheGLTest, MissThenHit) {
+    ShaderCache& cache = ShaderCache::getInstance();
+    ShaderCache::Stats before = cache.getStats();
+
+    compileProgram(FRAGMENT_SOURCE);
+    ShaderCache::Stats afterMiss = cache.getStats();
+    EXPECT_EQ(afterMiss.misses - before.misses, 1u);
+    EXPECT_EQ(afterMiss.compiles - before.compiles, 1u);
+    EXPECT_EQ(afterMiss.stored - before.stored, 1u);
+    EXPECT_EQ(cacheFiles(directory).size(), 1u);
+
+    compileProgram(FRAGMENT_SOURCE);
+    ShaderCache::Stats afterHit = cache.getStats();
+    EXPECT_EQ(afterHit.hits - afterMiss.hits, 1u);
+    EXPECT_EQ(afterHit.compiles, afterMiss.compiles);
+    EXPECT_EQ(afterHit.misses, afterMiss.misses);
+
+    // Outro fonte é outra chave
+    compileProgram(std::string(FRAGMENT_SOURCE) + "// variante\n");
+    EXPECT_EQ(cache.getStats().misses - afterHit.misses, 1u);
+    EXPECT_EQ(cacheFiles(directory).size(), 2u);
+}
+
+/**
+ * @brief Binário corrompido é apagado e o programa volta a ser compilado do fonte
+ */
+TEST_F(ShaderCacheGLTest, CorruptedBinaryIsInvalidated) {
+    ShaderCache& cache = ShaderCache::getInstance();
+    compileProgram(FRAGMENT_SOURCE);
+    std::vector<std::filesystem::path> files = cacheFiles(directory);
+    ASSERT_EQ(files.size(), 1u);
+
+    // Troca um byte no fim do binário (depois do cabeçalho)
+    {
+        std::fstream file(files[0], std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(-1, std::ios::end);
+        char last = 0;
+        file.read(&last, 1);
+        file.seekp(-1, std::ios::end);
+        last = static_cast<char>(~last);
+        file.write(&last, 1);
+    }
+
+    ShaderCache::Stats before = cache.getStats();
+    compileProgram(FRAGMENT_SOURCE);
+    ShaderCache::Stats after = cache.getStats();
+    EXPECT_EQ(after.invalidated - before.invalidated, 1u);
+    EXPECT_EQ(after.hits, before.hits);
+    EXPECT_EQ(after.compiles - before.compiles, 1u);
+    EXPECT_EQ(after.stored - before.stored, 1u);
+
+    compileProgram(FRAGMENT_SOURCE);
+    EXPECT_EQ(cache.getStats().hits - after.hits, 1u);
+}
+
+/**
+ * @brief Binários de outro driver são apagados ao definir o diretório e ao gravar
+ */
+TEST_F(ShaderCacheGLTest, ForeignDriverEntriesArePruned) {
+    ShaderCache& cache = ShaderCache::getInstance();
+    compileProgram(FRAGMENT_SOURCE);
+    ASSERT_EQ(cacheFiles(directory).size(), 1u);
+    std::string current = cacheFiles(directory)[0].filename().string();
+
+    // Mesmo fonte, outro driver; e um temporário deixado por uma gravação interrompida
+    std::string foreign = current.substr(0, 17) + "0123456789abcdef.bin";
+    std::ofstream(directory / foreign) << "binário de outro driver";
+    std::ofstream(directory / (foreign + ".tmp")) << "pela metade";
+
+    ShaderCache::Stats before = cache.getStats();
+    ASSERT_TRUE(cache.setDirectory(directory.string()));
+    EXPECT_EQ(cache.getStats().pruned - before.pruned, 1u);
+    EXPECT_FALSE(std::filesystem::exists(directory / foreign));
+    EXPECT_FALSE(std::filesystem::exists(directory / (foreign + ".tmp")));
+    EXPECT_TRUE(std::filesystem::exists(directory / current));
+
+    // Sem contexto ativo o driver é desconhecido: nada é apagado até a próxima gravação
+    std::ofstream(directory / foreign) << "binário de outro driver";
+    EGLDisplay display = eglGetCurrentDisplay();
+    EGLContext active = eglGetCurrentContext();
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    ASSERT_TRUE(cache.setDirectory(directory.string()));
+    EXPECT_TRUE(std::filesystem::exists(directory / foreign));
+    ASSERT_TRUE(eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, active));
+
+    compileProgram(std::string(FRAGMENT_SOURCE) + "// variante\n");
+    EXPECT_FALSE(std::filesystem::exists(directory / foreign));
+    EXPECT_EQ(cacheFiles(directory).size(), 2u);
+}
@@ -0,0 +1,79 @@
+#include "graphics/UploadRing.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace VoxelMaker;
+
+// Sem GLAD o anel só faz a contabilidade em CPU e os fences valem como já sinalizados;
+// com GLAD ele é coberto pelo teste em OpenGL (GpuUploadManagerGLTest)
+
+namespace {
+
+const std::vector<uint8_t> DATA(256, 0xAB);
+
+} // namespace
+
+/**
+ * @brief Pedidos inválidos e alinhamento do deslocamento, com o preenchimento contado como usado
+ */
+TEST(UploadRingTest, AlignsOffsets) {
+    UploadRing ring;
+    EXPECT_EQ(ring.write(DATA.data(), 4), UploadRing::INVALID_OFFSET);     // Sem initialize
+    ASSERT_TRUE(ring.initialize(100));
+
+    EXPECT_EQ(ring.write(DATA.data(), 0), UploadRing::INVALID_OFFSET);
+    EXPECT_EQ(ring.write(DATA.data(), 101), UploadRing::INVALID_OFFSET);
+
+    EXPECT_EQ(ring.write(DATA.data(), 3, 1), 0u);
+    EXPECT_EQ(ring.write(DATA.data(), 4, 16), 16u);
+    EXPECT_EQ(ring.getUsedBytes(), 20u);
+    EXPECT_EQ(ring.getStats().bytesWritten, 7u);
+    EXPECT_EQ(ring.getStats().writes, 2u);
+}
+
+/**
+ * @brief Uma escrita que não cabe até o fim volta ao início e o resto do anel conta como usado
+ */
+TEST(UploadRingTest, WrapPaddingIsAccounted) {
+    UploadRing ring;
+    ASSERT_TRUE(ring.initialize(100));
+
+    EXPECT_EQ(ring.write(DATA.data(), 60, 4), 0u);
+    ring.fence();
+    EXPECT_EQ(ring.getUsedBytes(), 60u);
+
+    EXPECT_EQ(ring.write(DATA.data(), 30, 4), 60u);
+    EXPECT_EQ(ring.getUsedBytes(), 90u);
+
+    // 20 bytes não cabem em [90, 100): os 10 bytes finais viram preenchimento e a região
+    // mais antiga (60 bytes) é liberada para abrir espaço no início
+    EXPECT_EQ(ring.write(DATA.data(), 20, 4), 0u);
+    EXPECT_EQ(ring.getUsedBytes(), 30u + 10u + 20u);
+
+    EXPECT_EQ(ring.write(DATA.data(), 40, 4), 20u);
+    EXPECT_EQ(ring.getUsedBytes(), 100u);
+}
+
+/**
+ * @brief Anel cheio sem fence: o lote atual é fechado e reaproveitado
+ */
+TEST(UploadRingTest, FullRingWithoutFenceRecycles) {
+    UploadRing ring;
+    ASSERT_TRUE(ring.initialize(64));
+
+    size_t previous = UploadRing::INVALID_OFFSET;
+    for (int i = 0; i < 100; i++) {
+        size_t offset = ring.write(DATA.data(), 24, 8);
+        ASSERT_NE(offset, UploadRing::INVALID_OFFSET);
+        ASSERT_EQ(offset % 8, 0u);
+        ASSERT_LE(offset + 24, ring.getCapacity());
+        ASSERT_LE(ring.getUsedBytes(), ring.getCapacity());
+        ASSERT_NE(offset, previous);
+        previous = offset;
+    }
+
+    // Um pedido do tamanho do anel sempre cabe depois de liberar tudo
+    EXPECT_EQ(ring.write(DATA.data(), 64, 4), 0u);
+    EXPECT_EQ(ring.getUsedBytes(), 64u);
+    EXPECT_EQ(ring.getStats().writes, 101u);
+}
@@ -0,0 +1,165 @@
+#include "core/VoxelFile.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace VoxelMaker;
+
+namespace {
+
+const size_t DIRECTORY_ENTRY_BYTES = 48;
+
+/**
+ * @brief Grid 64x32x64 com voxels espalhados por vários chunks e algumas cores
+ */
+void fillGrid(VoxelGrid& grid) {
+    grid.setDimensions(VoxelGrid::Dimensions(64, 32, 64));
+    for (int z = 0; z < 64; z++) {
+        for (int y = 0; y < 32; y++) {
+            for (int x = 0; x < 64; x++) {
+                if ((x * 3 + y * 5 + z) % 7 < 3) {
+                    Voxel::Color color(static_cast<uint8_t>(x & 0x30), static_cast<uint8_t>(y * 4), 90);
+                    grid.addVoxel(Voxel(glm::ivec3(x, y, z), color));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Caminho temporário para um arquivo de teste
+ */
+std::string temporaryPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/**
+ * @brief Inverte os bits de um byte do arquivo (posição negativa conta a partir do fim)
+ */
+void flipByte(const std::string& path, std::streamoff position) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(position, position < 0 ? std::ios::end : std::ios::beg);
+    char value = 0;
+    file.read(&value, 1);
+    file.seekp(position, position < 0 ? std::ios::end : std::ios::beg);
+    value = static_cast<char>(~value);
+    file.write(&value, 1);
+}
+
+} // namespace
+
+/**
+ * @brief Gravar e abrir preserva o hash de conteúdo sem decodificar os chunks
+ */
+TEST(VoxelFileTest, RoundTripPreservesContentHash) {
+    VoxelGrid grid;
+    fillGrid(grid);
+    std::string path = temporaryPath("voxelmaker_round_trip.vxm");
+    VoxelFile file;
+    ASSERT_TRUE(file.save(grid, path));
+
+    VoxelGrid loaded;
+    ASSERT_TRUE(file.load(path, loaded));
+    EXPECT_EQ(loaded.getChunks().size(), grid.getChunks().size());
+    EXPECT_EQ(loaded.getVoxelCount(), grid.getVoxelCount());
+    EXPECT_EQ(loaded.getResidentChunkCount(), 0u);
+    EXPECT_EQ(loaded.getContentHash(), grid.getContentHash());
+    EXPECT_EQ(loaded.getResidentChunkCount(), 0u);
+
+    // As células decodificadas conferem com as originais
+    for (const auto& pair : grid.getChunks()) {
+        const VoxelChunk* chunk = loaded.getChunk(pair.first);
+        ASSERT_NE(chunk, nullptr);
+        EXPECT_TRUE(std::equal(chunk->getCells(), chunk->getCells() + VoxelChunk::VOLUME, pair.second->getCells()));
+    }
+    EXPECT_TRUE(file.verify(path));
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief O hash de conteúdo vem do diretório: nem um bloco corrompido é decodificado para calculá-lo
+ */
+TEST(VoxelFileTest, ContentHashComesFromDirectory) {
+    VoxelGrid grid;
+    fillGrid(grid);
+    std::string path = temporaryPath("voxelmaker_stored_hashes.vxm");
+    VoxelFile file;
+    ASSERT_TRUE(file.save(grid, path));
+    std::streamoff directoryBytes = static_cast<std::streamoff>(grid.getChunks().size() * DIRECTORY_ENTRY_BYTES);
+    flipByte(path, -directoryBytes - 1);
+
+    VoxelGrid loaded;
+    ASSERT_TRUE(file.load(path, loaded));
+    EXPECT_EQ(loaded.getContentHash(), grid.getContentHash());
+    EXPECT_EQ(loaded.getResidentChunkCount(), 0u);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Arquivo truncado no diretório de chunks é recusado sem alterar o grid
+ */
+TEST(VoxelFileTest, TruncatedDirectoryIsRejected) {
+    VoxelGrid grid;
+    fillGrid(grid);
+    std::string path = temporaryPath("voxelmaker_truncated.vxm");
+    VoxelFile file;
+    ASSERT_TRUE(file.save(grid, path));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - DIRECTORY_ENTRY_BYTES / 2);
+
+    VoxelGrid loaded;
+    EXPECT_FALSE(file.load(path, loaded));
+    EXPECT_TRUE(loaded.getChunks().empty());
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Um byte alterado no diretório falha no checksum dele
+ */
+TEST(VoxelFileTest, CorruptedDirectoryIsRejected) {
+    VoxelGrid grid;
+    fillGrid(grid);
+    std::string path = temporaryPath("voxelmaker_corrupted_directory.vxm");
+    VoxelFile file;
+    ASSERT_TRUE(file.save(grid, path));
+    flipByte(path, -static_cast<std::streamoff>(DIRECTORY_ENTRY_BYTES) + 3);
+
+    VoxelGrid loaded;
+    EXPECT_FALSE(file.load(path, loaded));
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Um bloco de chunk corrompido abre (preguiçoso), mas carrega vazio e com contagem zerada
+ */
+TEST(VoxelFileTest, CorruptedChunkLoadsEmpty) {
+    VoxelGrid grid;
+    fillGrid(grid);
+    std::string path = temporaryPath("voxelmaker_corrupted_chunk.vxm");
+    VoxelFile file;
+    ASSERT_TRUE(file.save(grid, path));
+
+    // Último byte do último bloco, logo antes do diretório
+    std::streamoff directoryBytes = static_cast<std::streamoff>(grid.getChunks().size() * DIRECTORY_ENTRY_BYTES);
+    flipByte(path, -directoryBytes - 1);
+    EXPECT_FALSE(file.verify(path));
+    EXPECT_EQ(file.getStats().corruptChunks, 1u);
+
+    VoxelGrid loaded;
+    ASSERT_TRUE(file.load(path, loaded));
+    size_t emptyChunks = 0;
+    for (const auto& pair : loaded.getChunks()) {
+        const VoxelChunk& chunk = *pair.second;
+        EXPECT_GT(chunk.getCellCount(), 0);
+        chunk.getCells();
+        if (chunk.isEmpty()) {
+            emptyChunks++;
+            EXPECT_TRUE(std::all_of(chunk.getCells(), chunk.getCells() + VoxelChunk::VOLUME,
+                                    [](VoxelChunk::Cell cell) { return cell == VoxelPalette::EMPTY; }));
+        }
+    }
+    EXPECT_EQ(emptyChunks, 1u);
+    std::remove(path.c_str());
+}